@@ -568,8 +568,8 @@ namespace Seabreeze {
   Elmore* ElmoreExtension::get ( Net* net )
   {
     Elmore* elmore = nullptr;
-    Property* property = net->getProperty( ElmoreProperty::staticGetName() );
-    if (property) elmore = static_cast<ElmoreProperty*>( property )->getElmore();
+    ElmoreProperty* property = net->getProperty<ElmoreProperty>();
+    if (property) elmore = property->getElmore();
     return elmore;
   }
 
@@ -377,6 +377,8 @@ namespace Anabatic {
     , _rpCount   (0)
     , _diodeCount(0)
     , _sparsity  (0)
+    , _expandeds (0)
+    , _searchCost(0)
     , _flags     ()
     , _noMoveUp  ()
   {
@@ -422,12 +424,15 @@ namespace Anabatic {
     , _state            (EngineCreation)
     , _matrix           ()
     , _gcells           ()
+    , _gridView         (NULL)
     , _ovEdges          ()
     , _netOrdering      ()
     , _netDatas         ()
     , _viewer           (NULL)
     , _flags            (Flags::DestroyBaseContact)
     , _stamp            (-1)
+    , _stampBase        (-1)
+    , _stampBatch       (false)
     , _routingMode      (DigitalMode)
     , _densityMode      (MaxDensity)
     , _autoSegmentLut   ()
@@ -486,6 +491,7 @@ namespace Anabatic {
   AnabaticEngine::~AnabaticEngine ()
   {
     delete _configuration;
+    delete _gridView;
     for ( pair<unsigned int,NetData*> data : _netDatas ) delete data.second;
   }
 
@@ -570,6 +576,8 @@ namespace Anabatic {
       for ( GCell* gcell : _gcells ) gcell->destroy();
       _gcells.clear();
       _ovEdges.clear();
+      delete _gridView;
+      _gridView = NULL;
       cmess1 << "  o  Done." << endl;
     }
 
@@ -823,6 +831,13 @@ namespace Anabatic {
   }
 
 
+  void AnabaticEngine::updateGridView ()
+  {
+    delete _gridView;
+    _gridView = new GridView( this );
+  }
+
+
   size_t  AnabaticEngine::getNetsFromEdge ( const Edge* edge, NetSet& nets )
   {
     size_t  count  = 0;
@@ -97,6 +97,7 @@ namespace Anabatic {
     , _edgeHInc         (Cfg::getParamDouble("anabatic.edgeHInc"        ,      1.5)->asDouble())
     , _edgeHScaling     (Cfg::getParamDouble("anabatic.edgeHScaling"    ,      1.0)->asDouble())
     , _globalIterations (Cfg::getParamInt   ("anabatic.globalIterations",     10  )->asInt())
+    , _dijkstraQueue    (Cfg::getParamString("anabatic.dijkstraQueue"   ,   "heap")->asString() )
     , _diodeName        (Cfg::getParamString("etesian.diodeName"        , "dio_x0")->asString() )
     , _antennaGateMaxWL (Cfg::getParamInt   ("etesian.antennaGateMaxWL" ,      0  )->asInt())
     , _antennaDiodeMaxWL(Cfg::getParamInt   ("etesian.antennaDiodeMaxWL",      0  )->asInt())
@@ -206,6 +207,7 @@ namespace Anabatic {
     , _edgeHInc         (other._edgeHInc)
     , _edgeHScaling     (other._edgeHScaling)
     , _globalIterations (other._globalIterations)
+    , _dijkstraQueue    (other._dijkstraQueue)
     , _diodeName        (other._diodeName)
     , _antennaGateMaxWL (other._antennaGateMaxWL)
     , _antennaDiodeMaxWL(other._antennaDiodeMaxWL)
@@ -698,6 +700,7 @@ namespace Anabatic {
     cout << Dots::asIdentifier("     - Routing Gauge"               ,getString(_rg->getName())) << endl;
     cout << Dots::asString    ("     - Top routing layer"           ,topLayerName) << endl;
     cout << Dots::asUInt      ("     - Maximum GR iterations"       ,_globalIterations) << endl;
+    cout << Dots::asString    ("     - Dijkstra priority queue"     ,_dijkstraQueue) << endl;
   }
 
 
@@ -735,6 +738,7 @@ namespace Anabatic {
     record->add( getSlot( "_edgeHInc"        , _edgeHInc         ) );
     record->add( getSlot( "_edgeHScaling"    , _edgeHScaling     ) );
     record->add( getSlot( "_globalIterations", _globalIterations ) );
+    record->add( getSlot( "_dijkstraQueue"   , _dijkstraQueue    ) );
     record->add( DbU::getValueSlot( "_antennaGateMaxWL" , &_antennaGateMaxWL  ) );
     record->add( DbU::getValueSlot( "_antennaDiodeMaxWL", &_antennaDiodeMaxWL ) );
                                      
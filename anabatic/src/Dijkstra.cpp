@@ -14,7 +14,9 @@
 // +-----------------------------------------------------------------+
 
 
+#include <new>
 #include <limits>
+#include <queue>
 #include <algorithm>
 #include "hurricane/Error.h"
 #include "hurricane/Warning.h"
@@ -210,11 +212,11 @@ namespace Anabatic {
 
 
   bool  Vertex::hasValidStamp () const
-  { return _stamp == getAnabatic()->getStamp(); }
+  { return getStamp() >= getAnabatic()->getStampBase(); }
 
   Edge* Vertex::getFrom() const 
   {
-    if (hasValidStamp()) return _from;
+    if (hasValidStamp()) return _getFrom();
     else                 return NULL;
   }
 
@@ -903,11 +905,11 @@ namespace Anabatic {
   {
     if (_adata)  return _adata->getIAxis();
     else {
-      if (_from){
+      if (_getFrom()){
       //cdebug_log(112,0) << "DbU::Unit Vertex::getIAxis() const: Digital vertex. " <<  endl;
       
         GCell*  gcurr = getGCell();
-        GCell*  gprev = _from->getOpposite(gcurr);
+        GCell*  gprev = _getFrom()->getOpposite(gcurr);
         Vertex* vprev = gprev->getObserver<Vertex>(GCell::Observable::Vertex);
         if      (isNorth(vprev)||isSouth(vprev)) 
           return calcMidIntersection(gcurr->getXMin(), gcurr->getXMax(), gprev->getXMin(), gprev->getXMax());
@@ -930,10 +932,10 @@ namespace Anabatic {
     if (_adata){
       return _adata->getIMax();
     } else {
-      if (_from){
+      if (_getFrom()){
       //cdebug_log(112,0) << "DbU::Unit Vertex::getIMax() const: Digital vertex. " <<  endl;
         GCell*  gcurr = getGCell();
-        GCell*  gprev = _from->getOpposite(gcurr);
+        GCell*  gprev = _getFrom()->getOpposite(gcurr);
         Vertex* vprev = gprev->getObserver<Vertex>(GCell::Observable::Vertex);
         if (isH()){
           if      (isNorth(vprev)||isSouth(vprev)||isWest (vprev)) return getGCell()->getXCenter();
@@ -964,9 +966,9 @@ namespace Anabatic {
     if (_adata){
       return _adata->getIMin();
     } else {
-      if (_from) {
+      if (_getFrom()) {
         GCell*  gcurr = getGCell();
-        GCell*  gprev = _from->getOpposite(gcurr);
+        GCell*  gprev = _getFrom()->getOpposite(gcurr);
         Vertex* vprev = gprev->getObserver<Vertex>( GCell::Observable::Vertex );
         if (isH()){
           if      (isNorth(vprev) or isSouth(vprev) or isEast (vprev)) return getGCell()->getXCenter();
@@ -997,9 +999,9 @@ namespace Anabatic {
       return _adata->getPIAxis();
     } else {
     //cdebug_log(112,0) << "DbU::Unit Vertex::getPIAxis() const: Digital vertex. " <<  endl;
-      if (_from){
+      if (_getFrom()){
         GCell*  gcurr = getGCell();
-        GCell*  gprev = _from->getOpposite(gcurr);
+        GCell*  gprev = _getFrom()->getOpposite(gcurr);
         Vertex* vprev = gprev->getObserver<Vertex>(GCell::Observable::Vertex);
 
         if (vprev->isH()){
@@ -1033,9 +1035,9 @@ namespace Anabatic {
       return _adata->getPIMax();
     } else {
     //cdebug_log(112,0) << "DbU::Unit Vertex::getPIMax() const: Digital vertex. " <<  endl;
-      if (_from){
+      if (_getFrom()){
         GCell*  gcurr = getGCell();
-        GCell*  gprev = _from->getOpposite(gcurr);
+        GCell*  gprev = _getFrom()->getOpposite(gcurr);
         Vertex* vprev = gprev->getObserver<Vertex>(GCell::Observable::Vertex);
         
         if (vprev->isH()){
@@ -1067,9 +1069,9 @@ namespace Anabatic {
       return _adata->getPIMin();
     } else {
     //cdebug_log(112,0) << "DbU::Unit Vertex::getPIMin() const: Digital vertex. " <<  endl;
-      if (_from){
+      if (_getFrom()){
         GCell*  gcurr = getGCell();
-        GCell*  gprev = _from->getOpposite(gcurr);
+        GCell*  gprev = _getFrom()->getOpposite(gcurr);
         Vertex* vprev = gprev->getObserver<Vertex>(GCell::Observable::Vertex);
         
         if (vprev->isH()){
@@ -1254,7 +1256,7 @@ namespace Anabatic {
             return _adata->getFrom2()->getOpposite(getGCell());
           } else {
             cdebug_log(112,0) << "getGPrev:From2Mode:UseFrom1. " <<  endl;
-            if (_from) return getFrom()->getOpposite(getGCell());
+            if (_getFrom()) return getFrom()->getOpposite(getGCell());
             else       return NULL;
           }
         case Vertex::UseFromFrom2:
@@ -1263,20 +1265,20 @@ namespace Anabatic {
             return _adata->getFrom2()->getOpposite(getGCell());
           } else {
             cdebug_log(112,0) << "getGPrev:UseFromFrom2:UseFrom1. " <<  endl;
-            if (_from) return getFrom()->getOpposite(getGCell());
+            if (_getFrom()) return getFrom()->getOpposite(getGCell());
             else       return NULL;
           }
         case 0:
           cdebug_log(112,0) << "getGPrev:Default:UseFrom1. " <<  endl;
-          if (_from) return getFrom()->getOpposite(getGCell());
+          if (_getFrom()) return getFrom()->getOpposite(getGCell());
           else       return NULL;
         default:
           cdebug_log(112,0) << "getGPrev:Default:UseFrom1. " <<  endl;
-          if (_from) return getFrom()->getOpposite(getGCell());
+          if (_getFrom()) return getFrom()->getOpposite(getGCell());
           else       return NULL;
       }
     } else {
-      if (_from) return getFrom()->getOpposite(getGCell());
+      if (_getFrom()) return getFrom()->getOpposite(getGCell());
       else       return NULL;
     }
   }
@@ -1327,12 +1329,10 @@ namespace Anabatic {
            //+ " rps:" +  getString(_rpCount)
              + " deg:" +  getString(_degree)
              + " connexId:" + ((_connexId >= 0) ? getString(_connexId) : "None")
-             + " d:" + ((_distance == unreached) ? "unreached"
-                                                 : ((_distance == unreachable) ? "unreachable"
-                                                                               : DbU::getValueString(_distance)) )
+             + " d:" + getValueString( _grid->getDistance(_index) )
            //+   "+" + getString(_branchId)
            //+ " stamp:" + (hasValidStamp() ? "valid" : "outdated")
-             + " from:" + ((_from) ? "set" : "NULL")
+             + " from:" + ((_getFrom()) ? "set" : "NULL")
            //+ " from2:" + ((_adata) ? _adata->getFrom2() : "NULL")
              + " restricted:"
              + (isNRestricted() ? "N" : "-")
@@ -1349,16 +1349,116 @@ namespace Anabatic {
   {
     cdebug_log(111,0) << "Vertex::notify() " << vertex << endl;
   // Take into account the GCell modification here.
+    if (flags & GCell::Observable::Destroy) vertex->_gcell = NULL;
   }
 
 
 // -------------------------------------------------------------------
-// Class  :  "Anabatic::PrioriryQueue::CompareByDistance".
+// Class  :  "Anabatic::Estimator".
 
-  
-  PriorityQueue2* PriorityQueue2::CompareByDistance::_pqueue = NULL;
+
+  Estimator::Estimator ()
+    : _scale        (0.0)
+    , _landmarkCount(0)
+    , _vertexCount  (0)
+    , _landmarks    ()
+    , _targets      ()
+    , _targetsBox   ()
+  { }
+
+
+  void  Estimator::clearLandmarks ()
+  {
+    _landmarks.reset();
+    _landmarkCount = 0;
+    _vertexCount   = 0;
+  }
+
+
+// The landmarks are the Vertexes that are the farthest along the two
+// diagonals then the two axes (corners first, then sides middles).
+// The table is shared (read only) with the copies of the Estimator,
+// that is, with the Dijkstra workers.
+  void  Estimator::buildLandmarks ( const GridView* grid, const vector<Vertex*>& vertexes, size_t count, LowerBound lowerBound )
+  {
+    clearLandmarks();
+    count = std::min( count, MaxLandmarks );
+    if (not grid or vertexes.empty() or not count) return;
+
+    vector<Vertex*>  landmarks;
+    for ( size_t direction=0 ; direction<MaxLandmarks ; ++direction ) {
+      Vertex*   extremum = NULL;
+      DbU::Unit best     = 0;
+      for ( Vertex* vertex : vertexes ) {
+        Point     c     = vertex->getCenter();
+        DbU::Unit value = 0;
+        switch ( direction ) {
+          case 0: value = - c.getX() - c.getY(); break;
+          case 1: value =   c.getX() + c.getY(); break;
+          case 2: value =   c.getX() - c.getY(); break;
+          case 3: value = - c.getX() + c.getY(); break;
+          case 4: value = - c.getX(); break;
+          case 5: value =   c.getX(); break;
+          case 6: value = - c.getY(); break;
+          case 7: value =   c.getY(); break;
+        }
+        if (not extremum or (value > best)) { extremum = vertex; best = value; }
+      }
+      if (std::find(landmarks.begin(),landmarks.end(),extremum) == landmarks.end())
+        landmarks.push_back( extremum );
+      if (landmarks.size() >= count) break;
+    }
+
+    typedef std::pair<DbU::Unit,uint32_t>  Item;
+    _vertexCount   = vertexes.size();
+    _landmarkCount = landmarks.size();
+    _landmarks     = std::make_shared< vector<DbU::Unit> >( _landmarkCount*_vertexCount, Vertex::unreachable );
+
+    for ( size_t ilandmark=0 ; ilandmark<_landmarkCount ; ++ilandmark ) {
+      DbU::Unit* row = _landmarks->data() + ilandmark*_vertexCount;
+      std::priority_queue< Item, vector<Item>, std::greater<Item> >  queue;
+
+      row[ landmarks[ilandmark]->getIndex() ] = 0;
+      queue.push( Item( 0, landmarks[ilandmark]->getIndex() ));
+      while ( not queue.empty() ) {
+        Item current = queue.top();
+        queue.pop();
+        if (current.first > row[current.second]) continue;
+
+        for ( uint32_t ilink =grid->getFirstLink(current.second)
+            ;          ilink<grid->getEndLink  (current.second) ; ++ilink ) {
+          DbU::Unit bound = lowerBound( grid->getEdge( grid->getLinkEdge(ilink) ));
+          if (bound == Vertex::unreachable) continue;
+
+          uint32_t  ineighbor = grid->getLinkGCell( ilink );
+          DbU::Unit distance  = current.first + bound;
+          if (distance < row[ ineighbor ]) {
+            row[ ineighbor ] = distance;
+            queue.push( Item( distance, ineighbor ));
+          }
+        }
+      }
+    }
+  }
+
+
+  void  Estimator::setTargets ( const VertexSet& targets )
+  {
+    _targets.clear();
+    _targetsBox.makeEmpty();
+    if (not isEnabled()) return;
+
+    if (targets.size() > MaxExactTargets) {
+      for ( const Vertex* target : targets ) _targetsBox.merge( target->getCenter() );
+      return;
+    }
+    _targets.insert( _targets.end(), targets.begin(), targets.end() );
+  }
 
 
+// -------------------------------------------------------------------
+// Class  :  "Anabatic::PrioriryQueue::CompareByDistance".
+
   bool PriorityQueue2::CompareByDistance::operator() ( const Vertex* lhs, const Vertex* rhs ) const
   {
     if (lhs->getDistance() == rhs->getDistance()) {
@@ -1380,10 +1480,6 @@ namespace Anabatic {
 // -------------------------------------------------------------------
 // Class  :  "Anabatic::PrioriryQueue::CompareByDistance".
 
-  
-  PriorityQueue* PriorityQueue::CompareByDistance::_pqueue = NULL;
-
-
   bool PriorityQueue::CompareByDistance::operator() ( const Vertex* lhs, const Vertex* rhs ) const
   {
     if (lhs->getDistance() == rhs->getDistance()) {
@@ -1457,6 +1553,9 @@ namespace Anabatic {
 
   Dijkstra::Dijkstra ( AnabaticEngine* anabatic )
     : _anabatic      (anabatic)
+    , _master        (NULL)
+    , _grid          (NULL)
+    , _arena         (NULL)
     , _vertexes      ()
     , _distanceCb    (_distance)
     , _mode          (Mode::Standart)
@@ -1468,19 +1567,112 @@ namespace Anabatic {
     , _searchAreaHalo(0)
     , _connectedsId  (-1)
     , _queue         ()
+    , _estimator     ()
+    , _landmarks     (0)
+    , _lowerBound    (nullptr)
+    , _expandeds     (0)
+    , _searchCost    (0)
+    , _flags         (0)
+  {
+    _createVertexes();
+    _anabatic->getMatrix()->show();
+    _queue.setKind( PriorityQueue::getKindFromName( _anabatic->getConfiguration()->getDijkstraQueue() ));
+  }
+
+
+// A worker shares the Vertexes of it's master (there can be only one
+// Vertex per GCell), so it can only be used on search areas that are
+// disjoints from the ones of the master and of the other workers.
+  Dijkstra::Dijkstra ( Dijkstra* master )
+    : _anabatic      (master->_anabatic)
+    , _master        (master)
+    , _grid          (master->_grid)
+    , _arena         (NULL)
+    , _vertexes      ()
+    , _distanceCb    (master->_distanceCb)
+    , _mode          (Mode::Standart)
+    , _net           (NULL)
+    , _stamp         (-1)
+    , _sources       ()
+    , _targets       ()
+    , _searchArea    ()
+    , _searchAreaHalo(master->_searchAreaHalo)
+    , _connectedsId  (-1)
+    , _queue         ()
+    , _estimator     (master->_estimator)
+    , _landmarks     (0)
+    , _lowerBound    (nullptr)
+    , _expandeds     (0)
+    , _searchCost    (0)
     , _flags         (0)
   {
+    _queue.setKind( master->getQueueKind() );
+  }
+
+
+// A scale of zero disables the A* search (plain Dijkstra). The landmarks
+// are computed on the current Vertexes, they are computed again when the
+// GCell grid is modified (see _updateGridView()).
+  void  Dijkstra::setAStar ( float scale, size_t landmarks, Estimator::LowerBound lowerBound )
+  {
+    _landmarks  = landmarks;
+    _lowerBound = lowerBound;
+    _estimator.setScale( std::max( 0.0f, scale ));
+    if (landmarks and lowerBound and _estimator.isEnabled())
+      _estimator.buildLandmarks( _grid, _vertexes, landmarks, lowerBound );
+    else
+      _estimator.clearLandmarks();
+  }
+
+
+  Dijkstra::~Dijkstra ()
+  {
+    for ( Vertex* vertex : _vertexes ) vertex->~Vertex();
+    ::operator delete ( _arena );
+  }
+
+
+// The Vertexes are allocated in one block, in the order of the GCells
+// (and of the GridView), so the propagation walks through contiguous
+// memory.
+  void  Dijkstra::_createVertexes ()
+  {
+    for ( Vertex* vertex : _vertexes ) vertex->~Vertex();
+    ::operator delete ( _arena );
+    _vertexes.clear();
+
+    _anabatic->updateGridView();
+    _grid = _anabatic->getGridView();
+
     const vector<GCell*>& gcells = _anabatic->getGCells();
+    _arena = static_cast<Vertex*>( ::operator new ( gcells.size()*sizeof(Vertex) ));
+    _vertexes.reserve( gcells.size() );
     for ( GCell* gcell : gcells ) {
-      _vertexes.push_back( new Vertex (gcell) );
+      uint32_t index = _vertexes.size();
+      _vertexes.push_back( new ( _arena+index ) Vertex (gcell,_grid,index) );
     }
-    _anabatic->getMatrix()->show();
   }
 
 
-  Dijkstra::~Dijkstra ()
+// Called before each search. When the GCell grid has been modified since
+// the Vertexes creation, the GridView, the Vertexes and the landmarks are
+// all rebuilt. A worker asks it's master, it must not be done while other
+// workers are running (the loads are sequential, see GlobalBatch).
+  void  Dijkstra::_updateGridView ()
   {
-    for ( Vertex* vertex : _vertexes ) delete vertex;
+    if (_master) {
+      _master->_updateGridView();
+      if (_grid != _master->_grid) {
+        _grid      = _master->_grid;
+        _estimator = _master->_estimator;
+      }
+      return;
+    }
+    if ((_grid == _anabatic->getGridView()) and _grid->isValid()) return;
+
+    cdebug_log(112,0) << "Dijkstra::_updateGridView(): GCell grid modified, rebuilding." << endl;
+    _createVertexes();
+    setAStar( _estimator.getScale(), _landmarks, _lowerBound );
   }
 
 
@@ -1553,6 +1745,7 @@ namespace Anabatic {
 
   void  Dijkstra::load ( Net* net )
   {
+    _updateGridView();
     _cleanup();
 
     _net   = net;
@@ -1951,19 +2144,29 @@ namespace Anabatic {
     _queue.clear();
     _searchArea.makeEmpty();
     _connectedsId = 0;
+    _expandeds    = 0;
+    _searchCost   = 0;
   }
 
 
   bool  Dijkstra::_propagate ( Flags enabledSides )
   {
     cdebug_log(112,1) << "Dijkstra::_propagate() " << _net <<  endl;
+
+  // Neighbors are taken from the flat view of the grid, the Vertexes
+  // are always the ones of the master (see Dijkstra::Dijkstra()).
+    const GridView*        grid     = _grid;
+    const vector<Vertex*>& vertexes = (_master) ? _master->_vertexes : _vertexes;
+
     while ( not _queue.empty() ) {
       cdebug_log(111,0) << "Number of targets left: " << _targets.size()
                         << " and needaxis? " << needAxisTarget() << endl;
 
       _queue.dump();
-      Vertex* current  = _queue.top();
-      GCell*  gcurrent = current->getGCell();
+      if (_queue.refreshTop()) continue;
+      Vertex*  current  = _queue.top();
+      GCell*   gcurrent = current->getGCell();
+      uint32_t icurrent = current->getIndex();
 
       cdebug_log(111,1) << "Current:" << current << endl;
     //cdebug_log(111,0) << "isAxisTarget():" << current->isAxisTarget() << endl;
@@ -1973,11 +2176,14 @@ namespace Anabatic {
       if      ( current->isAxisTarget() and needAxisTarget()) unsetFlags(Mode::AxisTarget);
       else if ((current->getConnexId() == _connectedsId) or (current->getConnexId() < 0)) {
         cdebug_log(111,0) << "Looking for neighbors:" << endl;
+        ++_expandeds;
 
-        for ( Edge* edge : current->getGCell()->getEdges() ) {
+        for ( uint32_t ilink=grid->getFirstLink(icurrent) ; ilink<grid->getEndLink(icurrent) ; ++ilink ) {
+          uint32_t iedge = grid->getLinkEdge( ilink );
+          Edge*    edge  = grid->getEdge( iedge );
           cdebug_log(111,0) << "@ Edge " << edge << endl;
 
-          if (edge == current->getFrom()) {
+          if (iedge == grid->getFromEdge(icurrent)) {
             cdebug_log(111,0) << "> Reject: edge == current->getFrom()" << endl;
             continue;
           }
@@ -1987,7 +2193,7 @@ namespace Anabatic {
             continue;
           }
 
-          Vertex* vneighbor = current->getNeighbor( edge );
+          Vertex* vneighbor = vertexes[ grid->getLinkGCell(ilink) ];
           if (vneighbor->isAnalog()) vneighbor->createAData();
 
           cdebug_log(111,0) << "| Neighbor:" << vneighbor << endl;
@@ -2141,7 +2347,9 @@ namespace Anabatic {
       cdebug_tabw(111,-1);
     // We did reach another target (different <connexId>).
     // Tag back the path, with a higher <branchId>.
+      _searchCost += current->getDistance();
       _traceback( current );
+      _estimator.setTargets( _targets );
     
       cdebug_tabw(112,-1);
       return true;
@@ -2372,15 +2580,25 @@ namespace Anabatic {
   void  Dijkstra::run ( Dijkstra::Mode mode )
   {
     DebugSession::open( _net, 111, 120 );
+    if (search(mode)) materialize();
+    DebugSession::close();
+  }
+
 
-    cdebug_log(112,1) << "Dijkstra::run() on " << _net << " mode:" << mode << endl;
+// The search only modify the Vertexes of the search area, it doesn't
+// touch the database nor the Edges. So the searchs of nets loaded in
+// disjoint areas can be run concurrently, provided the materializations
+// are done afterwards, sequentially.
+  bool  Dijkstra::search ( Dijkstra::Mode mode )
+  {
+    cdebug_log(112,1) << "Dijkstra::search() on " << _net << " mode:" << mode << endl;
     _mode = mode;
 
     _selectFirstSource();
     if (_sources.empty()) {
       cdebug_log(112,0) << "No source to start, not routed." << endl;
       cdebug_tabw(112,-1);
-      return;
+      return false;
     }
 
     Flags enabledEdges = Flags::AllSides;
@@ -2393,10 +2611,14 @@ namespace Anabatic {
 
     _queue.clear();
     _queue.setAttractor( _searchArea.getCenter() );
+    if (_estimator.isEnabled() and not needAxisTarget()) {
+      _estimator.setTargets( _targets );
+      _queue.setEstimator( &_estimator );
+    }
     _connectedsId = (*_sources.begin())->getConnexId();
     for ( Vertex* source : _sources ) {
-      _queue.push( source );
       source->setDistance( 0.0 );
+      _queue.push( source );
       cdebug_log(112,0) << "Push source: (size:" << _queue.size() << ") "
                         << source
                         << " _connectedsId:" << _connectedsId << endl;
@@ -2404,13 +2626,23 @@ namespace Anabatic {
     while ( ((not _targets.empty()) ||  needAxisTarget()) and _propagate(enabledEdges) );
       
     _queue.clear();
+    cdebug_tabw(112,-1);
+    return true;
+  }
+
+
+  void  Dijkstra::materialize ()
+  {
+    cdebug_log(112,1) << "Dijkstra::materialize() on " << _net << endl;
+
     _materialize();
     unsetAxisTargets();
 
-    _anabatic->getNetData( _net )->setGlobalRouted( true );
-    
+    NetData* netData = _anabatic->getNetData( _net );
+    netData->setGlobalRouted( true );
+    netData->incExpandeds( _expandeds );
+    netData->incSearchCost( _searchCost );
     cdebug_tabw(112,-1);
-    DebugSession::close();
   }
 
 
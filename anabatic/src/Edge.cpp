@@ -84,6 +84,7 @@ namespace Anabatic {
     , _realOccupancy    (0)
     , _estimateOccupancy(0.0)
     , _historicCost     (0.0)
+    , _viewIndex        ((uint32_t)-1)
     , _source           (source)
     , _target           (target)
     , _axis             (0)
@@ -225,12 +226,36 @@ namespace Anabatic {
     if ((_realOccupancy <= getCapacity()) and (occupancy >  getCapacity())) getAnabatic()->addOv   ( this );
     if ((_realOccupancy >  getCapacity()) and (occupancy <= getCapacity())) getAnabatic()->removeOv( this );
     _realOccupancy = occupancy;
+    _updateView();
   }
 
 
   void  Edge::incRealOccupancy2 ( int value )
   {
     _realOccupancy += value;
+    _updateView();
+  }
+
+
+// The EdgeCapacity may be shared with other Edges, which copies in the
+// GridView cannot be reached from here, so the view is invalidated.
+  void  Edge::forceCapacity ( int capacity )
+  {
+    if (not _capacities) return;
+    _capacities->forceCapacity( capacity );
+    getAnabatic()->invalidateGridView();
+  }
+
+
+// Write through of the capacity & occupancy into the GridView arrays.
+// An Edge created after the view has no number in it.
+  void  Edge::_updateView ()
+  {
+    if (_viewIndex == GridView::npos) return;
+    GridView* grid = getAnabatic()->getGridView();
+    if (not grid) return;
+    grid->setEdgeCapacity ( _viewIndex, getCapacity() );
+    grid->setEdgeOccupancy( _viewIndex, _realOccupancy );
   }
 
 
@@ -559,6 +584,7 @@ namespace Anabatic {
     record->add( getSlot("_reservedCapacity" ,  _reservedCapacity ) );
     record->add( getSlot("_realOccupancy"    ,  _realOccupancy    ) );
     record->add( getSlot("_estimateOccupancy",  _estimateOccupancy) );
+    record->add( getSlot("_viewIndex"        ,  _viewIndex        ) );
     record->add( getSlot("_source"           ,  _source           ) );
     record->add( getSlot("_target"           ,  _target           ) );
     record->add( DbU::getValueSlot("_axis", &_axis) );
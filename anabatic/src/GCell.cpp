@@ -300,6 +300,7 @@ namespace Anabatic {
     , _pinDepth      (0)
     , _satProcessed  (0)
     , _rpCount       (0)
+    , _viewIndex     ((uint32_t)-1)
     , _blockages     (new DbU::Unit [_depth])
     , _cDensity      (0.0)
     , _densities     (new float [_depth])
@@ -387,6 +388,7 @@ namespace Anabatic {
 
   void  GCell::_preDestroy ()
   {
+    notify( Observable::Destroy );
     _destroyEdges();
     _anabatic->_remove( this );
     Super::_preDestroy();
@@ -1966,6 +1968,7 @@ namespace Anabatic {
     record->add( getSlot( "_pinDepth"     , &_pinDepth     ) );
     record->add( getSlot( "_satProcessed" , &_satProcessed ) );
     record->add( getSlot( "_rpCount"      , &_rpCount      ) );
+    record->add( getSlot( "_viewIndex"    ,  _viewIndex    ) );
 
     RoutingGauge* rg = getAnabatic()->getConfiguration()->getRoutingGauge();
 
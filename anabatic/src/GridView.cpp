@@ -0,0 +1,107 @@
+// -*- mode: C++; explicit-buffer-name: "GridView.cpp<anabatic>" -*-
+//
+// This file is part of the Coriolis Software.
+// Copyright (c) Sorbonne Université 2026-2026, All Rights Reserved
+//
+// +-----------------------------------------------------------------+
+// |                   C O R I O L I S                               |
+// |     A n a b a t i c  -  Global Routing Toolbox                  |
+// |                                                                 |
+// |  Author      :                    Jean-Paul CHAPUT              |
+// |  E-mail      :            Jean-Paul.Chaput@lip6.fr              |
+// | =============================================================== |
+// |  C++ Module  :  "./GridView.cpp"                                |
+// +-----------------------------------------------------------------+
+
+
+#include <limits>
+#include "anabatic/AnabaticEngine.h"
+#include "anabatic/GridView.h"
+
+
+namespace Anabatic {
+
+
+// -------------------------------------------------------------------
+// Class  :  "Anabatic::GridView".
+
+
+  GridView::GridView ( const AnabaticEngine* anabatic )
+    : _valid          (true)
+    , _gcells         (anabatic->getGCells())
+    , _xMins          ()
+    , _yMins          ()
+    , _xMaxs          ()
+    , _yMaxs          ()
+    , _distances      (_gcells.size(),std::numeric_limits<DbU::Unit>::max())
+    , _stamps         (_gcells.size(),-1)
+    , _froms          (_gcells.size(),npos)
+    , _firstLinks     ()
+    , _linkGCells     ()
+    , _linkEdges      ()
+    , _edges          ()
+    , _edgeSources    ()
+    , _edgeTargets    ()
+    , _edgeCapacities ()
+    , _edgeOccupancies()
+  {
+    size_t gcellCount = _gcells.size();
+    _xMins     .reserve( gcellCount );
+    _yMins     .reserve( gcellCount );
+    _xMaxs     .reserve( gcellCount );
+    _yMaxs     .reserve( gcellCount );
+    _firstLinks.reserve( gcellCount*SideCount + 1 );
+
+    for ( size_t igcell=0 ; igcell<gcellCount ; ++igcell ) {
+      GCell* gcell = _gcells[igcell];
+      _xMins.push_back( gcell->getXMin() );
+      _yMins.push_back( gcell->getYMin() );
+      _xMaxs.push_back( gcell->getXMax() );
+      _yMaxs.push_back( gcell->getYMax() );
+      gcell->_setViewIndex( igcell );
+    }
+
+  // Each Edge is numbered once, from it's source GCell (East & North).
+    for ( GCell* gcell : _gcells ) {
+      for ( const vector<Edge*>* edges : { &gcell->getEastEdges(), &gcell->getNorthEdges() } ) {
+        for ( Edge* edge : *edges ) {
+          edge->_setViewIndex( _edges.size() );
+          _edges          .push_back( edge );
+          _edgeSources    .push_back( edge->getSource()->getViewIndex() );
+          _edgeTargets    .push_back( edge->getTarget()->getViewIndex() );
+          _edgeCapacities .push_back( edge->getCapacity() );
+          _edgeOccupancies.push_back( edge->getRealOccupancy() );
+        }
+      }
+    }
+
+    for ( size_t igcell=0 ; igcell<gcellCount ; ++igcell ) {
+      GCell* gcell = _gcells[igcell];
+      for ( const vector<Edge*>* edges : { &gcell->getEastEdges()
+                                         , &gcell->getNorthEdges()
+                                         , &gcell->getWestEdges()
+                                         , &gcell->getSouthEdges() } ) {
+        _firstLinks.push_back( _linkEdges.size() );
+        for ( Edge* edge : *edges ) {
+          _linkEdges .push_back( edge->getViewIndex() );
+          _linkGCells.push_back( edge->getOpposite(gcell)->getViewIndex() );
+        }
+      }
+    }
+    _firstLinks.push_back( _linkEdges.size() );
+  }
+
+
+// Mirror of GCell::getEdgeAt().
+  uint32_t  GridView::getEdgeAt ( uint32_t igcell, Side side, DbU::Unit u ) const
+  {
+    for ( uint32_t ilink=getFirstLink(igcell,side) ; ilink<getEndLink(igcell,side) ; ++ilink ) {
+      uint32_t opposite = _linkGCells[ilink];
+      if ((side == West ) or (side == East )) { if (u < _yMaxs[opposite]) return _linkEdges[ilink]; }
+      else                                    { if (u < _xMaxs[opposite]) return _linkEdges[ilink]; }
+    }
+    return npos;
+  }
+
+
+}  // Anabatic namespace.
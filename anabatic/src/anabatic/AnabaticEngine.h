@@ -28,6 +28,7 @@ namespace Hurricane {
 #include "anabatic/Configuration.h"
 #include "anabatic/Matrix.h"
 #include "anabatic/GCell.h"
+#include "anabatic/GridView.h"
 #include "anabatic/AutoContact.h"
 #include "anabatic/AutoSegments.h"
 #include "anabatic/ChipTools.h"
@@ -116,6 +117,8 @@ namespace Anabatic {
       inline       size_t           getRpCount         () const;
       inline       size_t           getDiodeRpCount    () const;
       inline       DbU::Unit        getSparsity        () const;
+      inline       uint64_t         getExpandeds       () const;
+      inline       DbU::Unit        getSearchCost      () const;
       inline       void             setNetRoutingState ( NetRoutingState* );
       inline       void             setSearchArea      ( Box );
       inline       void             setGlobalEstimated ( bool );
@@ -124,6 +127,8 @@ namespace Anabatic {
       inline       void             setExcluded        ( bool );
       inline       void             setRpCount         ( size_t );
       inline       void             setNoMoveUp        ( Segment* );
+      inline       void             incExpandeds       ( uint64_t );
+      inline       void             incSearchCost      ( DbU::Unit );
     private:                                     
                               NetData            ( const NetData& );
              NetData&         operator=          ( const NetData& );
@@ -135,6 +140,8 @@ namespace Anabatic {
       size_t                               _rpCount;
       size_t                               _diodeCount;
       DbU::Unit                            _sparsity;
+      uint64_t                             _expandeds;
+      DbU::Unit                            _searchCost;
       Flags                                _flags;
       std::set<Segment*,DBo::CompareById>  _noMoveUp;
   };
@@ -161,6 +168,10 @@ namespace Anabatic {
   inline void             NetData::setExcluded        ( bool state ) { _flags.set(Flags::ExcludeRoute   ,state); }
   inline void             NetData::setRpCount         ( size_t count ) { _rpCount=count; _update(); }
   inline void             NetData::setNoMoveUp        ( Segment* segment ) { _noMoveUp.insert(segment); }
+  inline uint64_t         NetData::getExpandeds       () const { return _expandeds; }
+  inline void             NetData::incExpandeds       ( uint64_t count ) { _expandeds += count; }
+  inline DbU::Unit        NetData::getSearchCost      () const { return _searchCost; }
+  inline void             NetData::incSearchCost      ( DbU::Unit cost ) { _searchCost += cost; }
 
 
   inline void  NetData::_update ()
@@ -225,6 +236,8 @@ namespace Anabatic {
       inline        EngineState       getState                () const;
       inline  const Matrix*           getMatrix               () const;
       inline  const vector<GCell*>&   getGCells               () const;
+      inline  const GridView*         getGridView             () const;
+      inline        GridView*         getGridView             ();
       inline  const vector<Edge*>&    getOvEdges              () const;
       inline        GCell*            getSouthWestGCell       () const;
       inline        GCell*            getGCellUnder           ( DbU::Unit x, DbU::Unit y ) const;
@@ -249,10 +262,15 @@ namespace Anabatic {
                     void              exclude                 ( const Name& netName );
                     void              exclude                 ( Net* );
                     void              updateMatrix            ();
+                    void              updateGridView          ();
+      inline        void              invalidateGridView      ();
                     bool              checkPlacement          () const;
     // Dijkstra related functions.                            
       inline        int               getStamp                () const;
+      inline        int               getStampBase            () const;
       inline        int               incStamp                ();
+      inline        void              openStampBatch          ();
+      inline        void              closeStampBatch         ();
                     Contact*          breakAt                 ( Segment*, GCell* );
                     void              ripup                   ( Segment*, Flags );
                     void              ripupAll                ();
@@ -362,12 +380,15 @@ namespace Anabatic {
              EngineState         _state;
              Matrix              _matrix;
              vector<GCell*>      _gcells;
+             GridView*           _gridView;
              vector<Edge*>       _ovEdges;
              vector<NetData*>    _netOrdering;
              NetDatas            _netDatas;
              CellViewer*         _viewer;
              Flags               _flags;
              int                 _stamp;
+             int                 _stampBase;
+             bool                _stampBatch;
              uint32_t            _routingMode;
              uint64_t            _densityMode;
              AutoSegmentLut      _autoSegmentLut;
@@ -391,6 +412,9 @@ namespace Anabatic {
   inline       void              AnabaticEngine::setViewer                ( CellViewer* viewer ) { _viewer=viewer; }
   inline const Matrix*           AnabaticEngine::getMatrix                () const { return &_matrix; }
   inline const vector<GCell*>&   AnabaticEngine::getGCells                () const { return _gcells; }
+  inline const GridView*         AnabaticEngine::getGridView              () const { return _gridView; }
+  inline       GridView*         AnabaticEngine::getGridView              () { return _gridView; }
+  inline       void              AnabaticEngine::invalidateGridView       () { if (_gridView) _gridView->invalidate(); }
   inline const vector<Edge*>&    AnabaticEngine::getOvEdges               () const { return _ovEdges; }
   inline       GCell*            AnabaticEngine::getSouthWestGCell        () const { return _gcells[0]; }
   inline       GCell*            AnabaticEngine::getGCellUnder            ( DbU::Unit x, DbU::Unit y ) const { return _matrix.getUnder(x,y); }
@@ -438,6 +462,7 @@ namespace Anabatic {
   inline void  AnabaticEngine::_add ( GCell* gcell )
   {
     _gcells.push_back( gcell );
+    invalidateGridView();
   //std::sort( _gcells.begin(), _gcells.end(), Entity::CompareById() );
   }
 
@@ -448,12 +473,27 @@ namespace Anabatic {
       if (*igcell == gcell) {
         if (_inDestroy()) (*igcell) = NULL;
         else              _gcells.erase(igcell);
+        invalidateGridView();
         break;
       }
   }
 
-  inline       int    AnabaticEngine::getStamp () const { return _stamp; }
-  inline       int    AnabaticEngine::incStamp () { return ++_stamp; }
+  inline       int    AnabaticEngine::getStamp        () const { return _stamp; }
+  inline       int    AnabaticEngine::getStampBase    () const { return _stampBase; }
+  inline       void   AnabaticEngine::openStampBatch  () { _stampBatch = true;  _stampBase = _stamp+1; }
+  inline       void   AnabaticEngine::closeStampBatch () { _stampBatch = false; _stampBase = _stamp; }
+
+// A Vertex is valid when it's stamp is at least the stamp base. Outside
+// a batch, the base follows the last stamp, so only the Vertexes of the
+// last loaded net are valid. Inside a batch, the Vertexes of all the
+// nets loaded since the batch was opened stays valid, they belongs to
+// disjoint areas (see KatanaEngine::runGlobalRouter()).
+  inline int  AnabaticEngine::incStamp ()
+  {
+    ++_stamp;
+    if (not _stampBatch) _stampBase = _stamp;
+    return _stamp;
+  }
 
   inline void  AnabaticEngine::addOv ( Edge* edge ) {
     _ovEdges.push_back(edge);
@@ -139,6 +139,7 @@ namespace Anabatic {
               float              getEdgeHInc          () const;
               float              getEdgeHScaling      () const;
               int                getGlobalIterations  () const;
+      inline  std::string        getDijkstraQueue     () const;
               DbU::Unit          isOnRoutingGrid      ( RoutingPad* ) const;
               void               getPositions         ( RoutingPad* , Point& source, Point& target ) const;
               void               checkRoutingPadSize  ( RoutingPad* ) const;
@@ -176,6 +177,7 @@ namespace Anabatic {
       float                   _edgeHInc;
       float                   _edgeHScaling;
       int                     _globalIterations;
+      std::string             _dijkstraQueue;
       std::string             _diodeName;
       DbU::Unit               _antennaGateMaxWL;
       DbU::Unit               _antennaDiodeMaxWL;
@@ -186,6 +188,7 @@ namespace Anabatic {
 
 
   inline  std::string  Configuration::getNetBuilderStyle   () const { return _netBuilderStyle; }
+  inline  std::string  Configuration::getDijkstraQueue     () const { return _dijkstraQueue; }
   inline  StyleFlags   Configuration::getRoutingStyle      () const { return _routingStyle; }
   inline  bool         Configuration::isGLayer             ( const Layer* layer ) const { return isGMetal(layer) or isGContact(layer); }
   inline  size_t       Configuration::getGHorizontalDepth  () const { return _gdepthh; }
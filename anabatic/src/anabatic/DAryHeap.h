@@ -0,0 +1,211 @@
+// -*- mode: C++; explicit-buffer-name: "DAryHeap.h<anabatic>" -*-
+//
+// This file is part of the Coriolis Software.
+// Copyright (c) Sorbonne Université 2026-2026, All Rights Reserved
+//
+// +-----------------------------------------------------------------+
+// |                   C O R I O L I S                               |
+// |     A n a b a t i c  -  Global Routing Toolbox                  |
+// |                                                                 |
+// |  Author      :                    Jean-Paul CHAPUT              |
+// |  E-mail      :            Jean-Paul.Chaput@lip6.fr              |
+// | =============================================================== |
+// |  C++ Header  :  "./anabatic/DAryHeap.h"                         |
+// +-----------------------------------------------------------------+
+
+
+#pragma  once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+
+
+namespace Anabatic {
+
+
+// -------------------------------------------------------------------
+// Class  :  "Anabatic::DAryHeap".
+//
+// Indexed min-heap of arity D. The key is stored along with the
+// element pointer so the comparisons do not have to go back to the
+// elements. The position of an element inside the heap is kept in the
+// element itself, which must supply:
+//
+//     uint32_t  getHeapIndex () const;
+//     void      setHeapIndex ( uint32_t );
+//
+// So erase and decrease-key (push of an already queued element) are
+// done in O(log_D n) without any allocation once the array has grown.
+// Key must be strictly ordered by operator<, to get a deterministic
+// pop order, ties should be broken in the key itself.
+
+  template< typename Element, typename Key, unsigned int D=4 >
+  class DAryHeap {
+    public:
+      static const uint32_t  npos = (uint32_t)-1;
+    public:
+      struct Entry {
+        Key       _key;
+        Element*  _element;
+      };
+    public:
+      inline                            DAryHeap    ();
+      inline  bool                      empty       () const;
+      inline  size_t                    size        () const;
+      inline  bool                      contains    ( const Element* ) const;
+      inline  Element*                  top         () const;
+      inline  const Key&                topKey      () const;
+      inline  const std::vector<Entry>& getEntries  () const;
+      inline  void                      reserve     ( size_t );
+      inline  void                      push        ( Element*, const Key& );
+      inline  void                      pop         ();
+      inline  bool                      erase       ( Element* );
+      inline  void                      clear       ();
+    private:
+      inline  void                      _place      ( uint32_t, const Entry& );
+      inline  void                      _siftUp     ( uint32_t );
+      inline  void                      _siftDown   ( uint32_t );
+    private:
+      std::vector<Entry>  _entries;
+  };
+
+
+  template< typename Element, typename Key, unsigned int D >
+  inline DAryHeap<Element,Key,D>::DAryHeap () : _entries() { }
+
+  template< typename Element, typename Key, unsigned int D >
+  inline bool  DAryHeap<Element,Key,D>::empty () const { return _entries.empty(); }
+
+  template< typename Element, typename Key, unsigned int D >
+  inline size_t  DAryHeap<Element,Key,D>::size () const { return _entries.size(); }
+
+  template< typename Element, typename Key, unsigned int D >
+  inline Element* DAryHeap<Element,Key,D>::top () const { return _entries.empty() ? NULL : _entries[0]._element; }
+
+  template< typename Element, typename Key, unsigned int D >
+  inline const Key& DAryHeap<Element,Key,D>::topKey () const { return _entries[0]._key; }
+
+  template< typename Element, typename Key, unsigned int D >
+  inline const std::vector<typename DAryHeap<Element,Key,D>::Entry>& DAryHeap<Element,Key,D>::getEntries () const { return _entries; }
+
+  template< typename Element, typename Key, unsigned int D >
+  inline void  DAryHeap<Element,Key,D>::reserve ( size_t size ) { _entries.reserve( size ); }
+
+
+// The stored index may be a leftover of another heap, so it is only
+// trusted when the slot it points to really holds the element.
+  template< typename Element, typename Key, unsigned int D >
+  inline bool  DAryHeap<Element,Key,D>::contains ( const Element* element ) const
+  {
+    uint32_t index = element->getHeapIndex();
+    return (index < _entries.size()) and (_entries[index]._element == element);
+  }
+
+
+  template< typename Element, typename Key, unsigned int D >
+  inline void  DAryHeap<Element,Key,D>::_place ( uint32_t index, const Entry& entry )
+  {
+    _entries[index] = entry;
+    entry._element->setHeapIndex( index );
+  }
+
+
+  template< typename Element, typename Key, unsigned int D >
+  inline void  DAryHeap<Element,Key,D>::_siftUp ( uint32_t index )
+  {
+    Entry entry = _entries[index];
+    while ( index ) {
+      uint32_t parent = (index-1) / D;
+      if (not (entry._key < _entries[parent]._key)) break;
+      _place( index, _entries[parent] );
+      index = parent;
+    }
+    _place( index, entry );
+  }
+
+
+  template< typename Element, typename Key, unsigned int D >
+  inline void  DAryHeap<Element,Key,D>::_siftDown ( uint32_t index )
+  {
+    Entry    entry = _entries[index];
+    uint32_t size  = _entries.size();
+    while ( true ) {
+      uint32_t first = index*D + 1;
+      if (first >= size) break;
+
+      uint32_t last  = std::min( first+D, size );
+      uint32_t child = first;
+      for ( uint32_t i=first+1 ; i<last ; ++i ) {
+        if (_entries[i]._key < _entries[child]._key) child = i;
+      }
+      if (not (_entries[child]._key < entry._key)) break;
+      _place( index, _entries[child] );
+      index = child;
+    }
+    _place( index, entry );
+  }
+
+
+// Pushing an element already in the heap updates it's key, whether it
+// is decreased or increased.
+  template< typename Element, typename Key, unsigned int D >
+  inline void  DAryHeap<Element,Key,D>::push ( Element* element, const Key& key )
+  {
+    if (contains(element)) {
+      uint32_t index = element->getHeapIndex();
+      bool     up    = key < _entries[index]._key;
+      _entries[index]._key = key;
+      if (up) _siftUp  ( index );
+      else    _siftDown( index );
+      return;
+    }
+    _entries.push_back( Entry{ key, element } );
+    _siftUp( _entries.size()-1 );
+  }
+
+
+  template< typename Element, typename Key, unsigned int D >
+  inline void  DAryHeap<Element,Key,D>::pop ()
+  {
+    if (_entries.empty()) return;
+    _entries[0]._element->setHeapIndex( npos );
+    if (_entries.size() > 1) {
+      _place( 0, _entries.back() );
+      _entries.pop_back();
+      _siftDown( 0 );
+    } else
+      _entries.pop_back();
+  }
+
+
+  template< typename Element, typename Key, unsigned int D >
+  inline bool  DAryHeap<Element,Key,D>::erase ( Element* element )
+  {
+    if (not contains(element)) return false;
+
+    uint32_t index = element->getHeapIndex();
+    element->setHeapIndex( npos );
+    if (index+1 == _entries.size()) {
+      _entries.pop_back();
+      return true;
+    }
+
+    Key removed = _entries[index]._key;
+    _place( index, _entries.back() );
+    _entries.pop_back();
+    if (_entries[index]._key < removed) _siftUp  ( index );
+    else                                _siftDown( index );
+    return true;
+  }
+
+
+  template< typename Element, typename Key, unsigned int D >
+  inline void  DAryHeap<Element,Key,D>::clear ()
+  {
+    for ( Entry& entry : _entries ) entry._element->setHeapIndex( npos );
+    _entries.clear();
+  }
+
+
+}  // Anabatic namespace.
@@ -16,6 +16,8 @@
 
 #pragma  once
 #include <set>
+#include <memory>
+#include <functional>
 #include <iomanip>
 #include <boost/multi_index_container.hpp>
 #include <boost/multi_index/ordered_index.hpp>
@@ -28,6 +30,8 @@ namespace Hurricane {
   class RoutingPad;
 }
 #include "anabatic/GCell.h"
+#include "anabatic/GridView.h"
+#include "anabatic/DAryHeap.h"
 
 
 namespace Anabatic {
@@ -203,7 +207,7 @@ namespace Anabatic {
       static         void            notify            ( Vertex*, unsigned flags );
       static inline  Vertex*         lookup            ( GCell* );
     public:                                            
-             inline                  Vertex            ( GCell* );
+             inline                  Vertex            ( GCell*, GridView*, uint32_t index );
            //inline                  Vertex            ( size_t id );
              inline                 ~Vertex            ();
              inline  bool            isDriver          () const;
@@ -211,6 +215,8 @@ namespace Anabatic {
              inline  bool            hasDoneAllRps     () const;
              inline  Contact*        hasGContact       ( Net* ) const;
              inline  unsigned int    getId             () const;
+             inline  uint32_t        getIndex          () const;
+             inline  const GridView* getGridView       () const;
              inline  GCell*          getGCell          () const;
              inline  Box             getBoundingBox    () const;
              inline  Edges           getEdges          ( Flags sides=Flags::AllSides ) const;
@@ -269,6 +275,8 @@ namespace Anabatic {
               inline bool            isQueued          () const;
               inline void            setFlags          ( uint32_t );
               inline void            unsetFlags        ( uint32_t );
+              inline uint32_t        getHeapIndex      () const;
+              inline void            setHeapIndex      ( uint32_t );
                      bool            isH               () const;
                      bool            isV               () const;
               inline void            createAData       ();
@@ -305,35 +313,38 @@ namespace Anabatic {
     private:                        
                                      Vertex            ( const Vertex& );
                      Vertex&         operator=         ( const Vertex& );
+             inline  Edge*           _getFrom          () const;
     private:
       size_t               _id;
       GCell*               _gcell;
+      GridView*            _grid;
       Observer<Vertex>     _observer;
       int                  _connexId;
       int                  _branchId;
       int                  _degree  : 8;
 
       int                  _rpCount : 8;
-      int                  _stamp;
-      DbU::Unit            _distance;
-      Edge*                _from;
       uint32_t             _flags;
+      uint32_t             _heapIndex;
+      uint32_t             _index;
       GRAData*             _adata;
   }; 
 
 
-  inline Vertex::Vertex ( GCell* gcell )
+// The distance, stamp & from Edge are stored in the GridView arrays, at
+// the index of the GCell.
+  inline Vertex::Vertex ( GCell* gcell, GridView* grid, uint32_t index )
     : _id      (gcell->getId())
     , _gcell   (gcell)
+    , _grid    (grid)
     , _observer(this)
     , _connexId(-1)
     , _branchId( 0)
     , _degree  ( 0)
     , _rpCount ( 0)
-    , _stamp   (-1)
-    , _distance(unreached)
-    , _from    (NULL)
     , _flags   (NoRestriction)
+    , _heapIndex((uint32_t)-1)
+    , _index   (index)
     , _adata   (NULL)
   {
     gcell->setObserver( GCell::Observable::Vertex, &_observer );
@@ -341,7 +352,7 @@ namespace Anabatic {
 
 
   inline Vertex*         Vertex::lookup         ( GCell* gcell ) { return gcell->getObserver<Vertex>(GCell::Observable::Vertex); }
-  inline                 Vertex::~Vertex        () { _gcell->setObserver( GCell::Observable::Vertex, NULL ); }
+  inline                 Vertex::~Vertex        () { if (_gcell) _gcell->setObserver( GCell::Observable::Vertex, NULL ); }
   inline bool            Vertex::isDriver       () const { return _flags & Driver; }
   inline bool            Vertex::isAnalog       () const { return _gcell->isAnalog(); }
   inline bool            Vertex::isQueued       () const { return _flags & Queued; }
@@ -353,16 +364,17 @@ namespace Anabatic {
   inline AnabaticEngine* Vertex::getAnabatic    () const { return _gcell->getAnabatic(); }
   inline Contact*        Vertex::getGContact    ( Net* net ) { return _gcell->getGContact(net); }
   inline Point           Vertex::getCenter      () const { return _gcell->getBoundingBox().getCenter(); }
-  inline DbU::Unit       Vertex::getDistance    () const { return hasValidStamp() ? _distance : unreached; }
-  inline int             Vertex::getStamp       () const { return _stamp; }
+  inline DbU::Unit       Vertex::getDistance    () const { return hasValidStamp() ? _grid->getDistance(_index) : unreached; }
+  inline int             Vertex::getStamp       () const { return _grid->getStamp(_index); }
   inline int             Vertex::getConnexId    () const { return hasValidStamp() ? _connexId : -1; }
   inline int             Vertex::getBranchId    () const { return hasValidStamp() ? _branchId :  0; }
   inline int             Vertex::getDegree      () const { return hasValidStamp() ? _degree   :  0; }
   inline int             Vertex::getRpCount     () const { return hasValidStamp() ? _rpCount  :  0; }
 //inline Edge*           Vertex::getFrom        () const { return _from; }
-  inline void            Vertex::setDistance    ( DbU::Unit distance ) { _distance=distance; }
-  inline void            Vertex::setFrom        ( Edge* from ) { _from=from; }
-  inline void            Vertex::setStamp       ( int stamp ) { _stamp=stamp; }
+  inline void            Vertex::setDistance    ( DbU::Unit distance ) { _grid->setDistance(_index,distance); }
+  inline void            Vertex::setFrom        ( Edge* from ) { _grid->setFromEdge(_index,(from) ? from->getViewIndex() : GridView::npos); }
+  inline void            Vertex::setStamp       ( int stamp ) { _grid->setStamp(_index,stamp); }
+  inline Edge*           Vertex::_getFrom       () const { return _grid->getFrom(_index); }
   inline void            Vertex::setConnexId    ( int id ) { _connexId=id; }
   inline void            Vertex::setBranchId    ( int id ) { _branchId=id; }
   inline void            Vertex::setDegree      ( int degree ) { _degree=degree; }
@@ -372,7 +384,7 @@ namespace Anabatic {
   inline Contact*        Vertex::breakGoThrough ( Net* net ) { return _gcell->breakGoThrough(net); }
 
   inline Vertex* Vertex::getPredecessor () const
-  { return (hasValidStamp() and _from) ? _from->getOpposite(_gcell)->getObserver<Vertex>(GCell::Observable::Vertex) : NULL; }
+  { return (hasValidStamp() and _getFrom()) ? _getFrom()->getOpposite(_gcell)->getObserver<Vertex>(GCell::Observable::Vertex) : NULL; }
 
   inline Vertex* Vertex::getNeighbor ( Edge* edge ) const
   {
@@ -417,6 +429,11 @@ namespace Anabatic {
   inline bool         Vertex::isiVertical  () const { return (_flags & Vertex::iVertical   ); }
   inline void         Vertex::setFlags     ( uint32_t mask ) { _flags |= mask ; }
   inline void         Vertex::unsetFlags   ( uint32_t mask ) { _flags &= ~mask; }
+  inline uint32_t     Vertex::getHeapIndex () const { return _heapIndex; }
+  inline void         Vertex::setHeapIndex ( uint32_t index ) { _heapIndex = index; }
+  inline uint32_t     Vertex::getIndex     () const { return _index; }
+  inline const GridView*
+                      Vertex::getGridView  () const { return _grid; }
 
   inline std::string  Vertex::getValueString ( DbU::Unit distance )
   {
@@ -426,6 +443,98 @@ namespace Anabatic {
   }
 
 
+// -------------------------------------------------------------------
+// Class  :  "Anabatic::Estimator".
+//
+// Under-estimate of the distance still to be covered from a Vertex to
+// the nearest target, which turns the Dijkstra into an A*. Two lower
+// bounds are used, the largest one is kept:
+// 1. The Manhattan distance, multiplied by <scale>, the smallest cost
+//    per unit of length the distance callback can ever return.
+// 2. ALT (A*, Landmarks & Triangle inequality). The distances from a
+//    few landmarks (the corners of the area) to every Vertex are
+//    computed once, with the static lower bound of each Edge supplied
+//    by the caller. Then |d(L,t) - d(L,v)| <= d(v,t). It is tighter
+//    than Manhattan around blockages (Edges without capacity).
+//
+// Above MaxExactTargets, the nearest target is not searched any more,
+// the Manhattan distance to the bounding box of the targets is used.
+// Both bounds must be admissible, the caller is responsible for that
+// through <scale> and the Edge lower bound. The Edge lower bound must
+// only be Vertex::unreachable for Edges the distance callback always
+// rejects, and the landmarks must be rebuilt (Dijkstra::setAStar())
+// when the Edges capacities are changed.
+
+  class Estimator {
+    public:
+      typedef std::function<DbU::Unit(const Edge*)>  LowerBound;
+      static const size_t  MaxExactTargets = 8;
+      static const size_t  MaxLandmarks    = 8;
+    public:
+                              Estimator         ();
+      inline  bool            isEnabled         () const;
+      inline  float           getScale          () const;
+      inline  size_t          getLandmarkCount  () const;
+      inline  void            setScale          ( float );
+              void            buildLandmarks    ( const GridView*, const vector<Vertex*>&, size_t count, LowerBound );
+              void            clearLandmarks    ();
+              void            setTargets        ( const VertexSet& );
+      inline  DbU::Unit       estimate          ( const Vertex* ) const;
+    private:
+      inline  DbU::Unit       _getLandmarkBound ( uint32_t vindex, uint32_t tindex ) const;
+    private:
+      float                                     _scale;
+      size_t                                    _landmarkCount;
+      size_t                                    _vertexCount;
+      std::shared_ptr< vector<DbU::Unit> >      _landmarks;
+      vector<const Vertex*>                     _targets;
+      Box                                       _targetsBox;
+  };
+
+
+  inline  bool    Estimator::isEnabled        () const { return (_scale > 0.0); }
+  inline  float   Estimator::getScale         () const { return _scale; }
+  inline  size_t  Estimator::getLandmarkCount () const { return _landmarkCount; }
+  inline  void    Estimator::setScale         ( float scale ) { _scale = scale; }
+
+
+  inline DbU::Unit  Estimator::_getLandmarkBound ( uint32_t vindex, uint32_t tindex ) const
+  {
+    DbU::Unit bound = 0;
+    for ( size_t ilandmark=0 ; ilandmark<_landmarkCount ; ++ilandmark ) {
+      const DbU::Unit* row = _landmarks->data() + ilandmark*_vertexCount;
+      DbU::Unit        dv  = row[ vindex ];
+      DbU::Unit        dt  = row[ tindex ];
+      if ((dv == Vertex::unreachable) or (dt == Vertex::unreachable)) continue;
+      bound = std::max( bound, (dv > dt) ? dv-dt : dt-dv );
+    }
+    return bound;
+  }
+
+
+  inline DbU::Unit  Estimator::estimate ( const Vertex* v ) const
+  {
+    if (_targets.empty()) {
+      if (_targetsBox.isEmpty()) return 0;
+      Point     center = v->getCenter();
+      DbU::Unit dx     = std::max( (DbU::Unit)0, std::max( _targetsBox.getXMin() - center.getX()
+                                                         , center.getX() - _targetsBox.getXMax() ));
+      DbU::Unit dy     = std::max( (DbU::Unit)0, std::max( _targetsBox.getYMin() - center.getY()
+                                                         , center.getY() - _targetsBox.getYMax() ));
+      return (DbU::Unit)( _scale * (float)(dx+dy) );
+    }
+
+    Point     center  = v->getCenter();
+    DbU::Unit nearest = Vertex::unreachable;
+    for ( const Vertex* target : _targets ) {
+      DbU::Unit bound = (DbU::Unit)( _scale * (float)center.manhattanDistance(target->getCenter()) );
+      if (_landmarkCount) bound = std::max( bound, _getLandmarkBound(v->getIndex(),target->getIndex()) );
+      nearest = std::min( nearest, bound );
+    }
+    return nearest;
+  }
+
+
 // -------------------------------------------------------------------
 // Class  :  "Anabatic::PriorityQueue2".
 
@@ -447,11 +556,10 @@ namespace Anabatic {
     private:
       class CompareByDistance {
         public:
-                 inline      CompareByDistance ();
-                        bool operator()        ( const Vertex* lhs, const Vertex* rhs ) const;
-          static inline void setQueue          ( PriorityQueue2* );
+          inline      CompareByDistance ( const PriorityQueue2* pqueue=NULL );
+                 bool operator()        ( const Vertex* lhs, const Vertex* rhs ) const;
         private:
-          static PriorityQueue2* _pqueue;
+          const PriorityQueue2* _pqueue;
       };
     private:
       struct  IndexByDistance { };
@@ -470,19 +578,30 @@ namespace Anabatic {
                   >
                 >
               > DualQueue;
+    private:
+      static inline DualQueue::ctor_args_list  _getQueueArgs ( const PriorityQueue2* );
     private:
       bool       _hasAttractor;
       Point      _attractor;
       DualQueue  _queue;
+    private:
+                      PriorityQueue2 ( const PriorityQueue2& );
+      PriorityQueue2& operator=      ( const PriorityQueue2& );
   };
 
 
-  inline      PriorityQueue2::CompareByDistance::CompareByDistance () { }
+  inline PriorityQueue2::CompareByDistance::CompareByDistance ( const PriorityQueue2* pqueue ) : _pqueue(pqueue) { }
 
-  inline void PriorityQueue2::CompareByDistance::setQueue ( PriorityQueue2* pqueue ) { _pqueue = pqueue; }
+
+  inline PriorityQueue2::DualQueue::ctor_args_list  PriorityQueue2::_getQueueArgs ( const PriorityQueue2* pqueue )
+  {
+    DualQueue::ctor_args_list args;
+    boost::get<0>(args) = boost::make_tuple( boost::multi_index::identity<Vertex*>(), CompareByDistance(pqueue) );
+    return args;
+  }
 
 
-  inline               PriorityQueue2::PriorityQueue2  () : _hasAttractor(false), _attractor(), _queue() { PriorityQueue2::CompareByDistance::setQueue(this); }
+  inline               PriorityQueue2::PriorityQueue2  () : _hasAttractor(false), _attractor(), _queue(_getQueueArgs(this)) { }
   inline               PriorityQueue2::~PriorityQueue2 () { }
   inline       bool    PriorityQueue2::empty          () const { return _queue.empty(); }
   inline       size_t  PriorityQueue2::size           () const { return _queue.size(); }
@@ -519,11 +638,33 @@ namespace Anabatic {
 
 // -------------------------------------------------------------------
 // Class  :  "Anabatic::PriorityQueue".
+//
+// Two interchangeables implementations, selected at run time:
+// 1. Multiset : the original std::multiset, a decrease-key is an erase
+//               (linear search) followed by a re-insertion.
+// 2. Heap     : an indexed 4-ary heap, the Vertex knows it's position
+//               in the heap. The ordering key is computed once, at push
+//               time. An insertion counter ends the key so equal vertexes
+//               are popped in FIFO order, like in the multiset.
+//
+// When an Estimator is set (A* search, Heap only), the Vertex estimate
+// is added to it's distance in the key. As the targets are removed from
+// the Estimator during the search, the estimates of the queued Vertexes
+// may only grow. They are refreshed lazily, when they reach the top
+// (see refreshTop()).
 
   class PriorityQueue {
+    public:
+      enum Kind { Multiset = 0
+                , Heap     = 1
+                };
+    public:
+      static inline Kind    getKindFromName ( const std::string& );
     public:
       inline                PriorityQueue ();
       inline               ~PriorityQueue ();
+      inline        Kind    getKind       () const;
+      inline        void    setKind       ( Kind );
       inline        bool    empty         () const;
       inline        size_t  size          () const;
       inline        void    push          ( Vertex* );
@@ -535,66 +676,156 @@ namespace Anabatic {
       inline        void    setAttractor  ( const Point& );
       inline  const Point&  getAttractor  () const;
       inline        bool    hasAttractor  () const;
+      inline        void    setEstimator  ( const Estimator* );
+      inline        bool    refreshTop    ();
     private:
       class CompareByDistance {
         public:
-                 inline      CompareByDistance ();
-                        bool operator()        ( const Vertex* lhs, const Vertex* rhs ) const;
-          static inline void setQueue          ( PriorityQueue* );
+          inline      CompareByDistance ( const PriorityQueue* );
+                 bool operator()        ( const Vertex* lhs, const Vertex* rhs ) const;
         private:
-          static PriorityQueue* _pqueue;
+          const PriorityQueue* _pqueue;
+      };
+      class Key {
+        public:
+          inline      Key        ( DbU::Unit distance=0, DbU::Unit attraction=0, int branchId=0, uint64_t order=0 );
+          inline bool operator<  ( const Key& ) const;
+        public:
+          DbU::Unit  _distance;
+          DbU::Unit  _attraction;
+          int        _branchId;
+          uint64_t   _order;
       };
     private:
+      inline        Key     _getKey       ( Vertex* );
+    private:
+      Kind                                 _kind;
+      const Estimator*                     _estimator;
       bool                                 _hasAttractor;
       Point                                _attractor;
       multiset<Vertex*,CompareByDistance>  _queue;
+      DAryHeap<Vertex,Key>                 _heap;
+      uint64_t                             _order;
+    private:
+                     PriorityQueue ( const PriorityQueue& );
+      PriorityQueue& operator=     ( const PriorityQueue& );
   };
 
 
-  inline      PriorityQueue::CompareByDistance::CompareByDistance () { }
+  inline PriorityQueue::CompareByDistance::CompareByDistance ( const PriorityQueue* pqueue ) : _pqueue(pqueue) { }
+
+
+  inline  PriorityQueue::Key::Key ( DbU::Unit distance, DbU::Unit attraction, int branchId, uint64_t order )
+    : _distance(distance), _attraction(attraction), _branchId(branchId), _order(order)
+  { }
+
+// Must stay the mirror of CompareByDistance.
+  inline bool  PriorityQueue::Key::operator< ( const Key& other ) const
+  {
+    if (_distance   != other._distance  ) return _distance   < other._distance;
+    if (_attraction != other._attraction) return _attraction < other._attraction;
+    if (_branchId   != other._branchId  ) return _branchId   > other._branchId;
+    return _order < other._order;
+  }
+
 
-  inline void PriorityQueue::CompareByDistance::setQueue ( PriorityQueue* pqueue ) { _pqueue = pqueue; }
+  inline PriorityQueue::Kind  PriorityQueue::getKindFromName ( const std::string& name )
+  { return (name == "multiset") ? Multiset : Heap; }
 
 
-  inline               PriorityQueue::PriorityQueue  () : _hasAttractor(false), _attractor(), _queue() { PriorityQueue::CompareByDistance::setQueue(this); }
+  inline               PriorityQueue::PriorityQueue  () : _kind(Heap), _estimator(NULL), _hasAttractor(false), _attractor(), _queue(CompareByDistance(this)), _heap(), _order(0) { }
   inline               PriorityQueue::~PriorityQueue () { }
-  inline       bool    PriorityQueue::empty          () const { return _queue.empty(); }
-  inline       size_t  PriorityQueue::size           () const { return _queue.size(); }
-  inline       void    PriorityQueue::push           ( Vertex* v ) { _queue.insert(v); v->setFlags(Vertex::Queued); }
-  inline       Vertex* PriorityQueue::top            () { return _queue.empty() ? NULL : *_queue.begin(); }
-  inline       void    PriorityQueue::clear          () { _queue.clear(); _hasAttractor=false; }
+  inline       PriorityQueue::Kind
+                       PriorityQueue::getKind        () const { return _kind; }
+  inline       bool    PriorityQueue::empty          () const { return (_kind == Heap) ? _heap.empty() : _queue.empty(); }
+  inline       size_t  PriorityQueue::size           () const { return (_kind == Heap) ? _heap.size () : _queue.size (); }
   inline       void    PriorityQueue::setAttractor   ( const Point& p ) { _attractor=p;  _hasAttractor=true; }
   inline       bool    PriorityQueue::hasAttractor   () const { return _hasAttractor; }
   inline const Point&  PriorityQueue::getAttractor   () const { return _attractor; }
 
+  inline void  PriorityQueue::setKind ( Kind kind )
+  {
+    clear();
+    _kind = kind;
+  }
+
+  inline Vertex* PriorityQueue::top ()
+  {
+    if (_kind == Heap) return _heap.top();
+    return _queue.empty() ? NULL : *_queue.begin();
+  }
+
+  inline void  PriorityQueue::setEstimator ( const Estimator* estimator )
+  { _estimator = (estimator and estimator->isEnabled()) ? estimator : NULL; }
+
+  inline void  PriorityQueue::clear ()
+  {
+    if (_kind == Heap) {
+      for ( auto& entry : _heap.getEntries() ) entry._element->unsetFlags( Vertex::Queued );
+      _heap.clear();
+    } else
+      _queue.clear();
+    _estimator    = NULL;
+    _hasAttractor = false;
+    _order        = 0;
+  }
+
+  inline PriorityQueue::Key  PriorityQueue::_getKey ( Vertex* v )
+  {
+    DbU::Unit distance   = v->getDistance();
+    DbU::Unit attraction = (_hasAttractor) ? _attractor.manhattanDistance( v->getCenter() ) : 0;
+    if (_estimator and (distance != Vertex::unreached) and (distance != Vertex::unreachable))
+      distance += _estimator->estimate( v );
+    return Key( distance, attraction, v->getBranchId(), _order++ );
+  }
+
+  inline void  PriorityQueue::push ( Vertex* v )
+  {
+    v->setFlags( Vertex::Queued );
+    if (_kind == Heap) {
+      _heap.push( v, _getKey(v) );
+      return;
+    }
+    _queue.insert( v );
+  }
+
+// Returns true if the estimate of the top Vertex has grown since it was
+// pushed. It is then re-queued with it's new key and the caller must
+// look at the (possibly different) new top.
+  inline bool  PriorityQueue::refreshTop ()
+  {
+    if (not _estimator or (_kind != Heap) or _heap.empty()) return false;
+    Vertex* v   = _heap.top();
+    Key     key = _getKey( v );
+    if (not (_heap.topKey()._distance < key._distance)) return false;
+    key._order = _heap.topKey()._order;
+    _heap.push( v, key );
+    return true;
+  }
+
   inline void  PriorityQueue::pop ()
   {
-    cdebug_log(112,0) << "Pop: (size:" << _queue.size() << ") " << *_queue.begin() << std::endl;
-    (*_queue.begin())->unsetFlags( Vertex::Queued );
-    _queue.erase(_queue.begin());
+    Vertex* v = top();
+    if (not v) return;
+    cdebug_log(112,0) << "Pop: (size:" << size() << ") " << v << std::endl;
+    v->unsetFlags( Vertex::Queued );
+    if (_kind == Heap) _heap.pop();
+    else                   _queue.erase( _queue.begin() );
   }
 
   inline void  PriorityQueue::erase ( Vertex* v )
   {
-    // auto ivertex = _queue.upper_bound( v );
-    // while ( true ) {
-    //   if (*ivertex == v) {
-    //     _queue.erase( ivertex );
-    //     return;
-    //   }
-    //   if (ivertex == _queue.begin()) break;
-    //   --ivertex;
-    // }
-    // for ( ; ivertex != _queue.end() ; ++ivertex ) {
-    //   if (*ivertex == v) { _queue.erase( ivertex ); break; }
-    // }
     if (not v->isQueued())
       return;
-    // for ( auto ivertex=_queue.begin(); ivertex != _queue.end() ; ++ivertex ) {
-    //   if (*ivertex == v) { _queue.erase( ivertex ); return; }
-    // }
-    for ( auto ivertex=_queue.begin(); ivertex != _queue.end() ; ++ivertex ) {
-      if (*ivertex == v) { _queue.erase( ivertex ); return; }
+    if (_kind == Heap) {
+      if (_heap.erase(v)) {
+        v->unsetFlags( Vertex::Queued );
+        return;
+      }
+    } else {
+      for ( auto ivertex=_queue.begin(); ivertex != _queue.end() ; ++ivertex ) {
+        if (*ivertex == v) { _queue.erase( ivertex ); return; }
+      }
     }
     std::cerr << Error( "PriorityQueue::erase(): Unable to remove %s."
                       , v->_getString().c_str() ) << std::endl;
@@ -605,8 +836,13 @@ namespace Anabatic {
     if (cdebug.enabled(112)) {
       cdebug_log(112,1) << "PriorityQueue::dump() size:" << size() << std::endl;
       size_t order = 0;
-      for ( Vertex* v : _queue )
-        cdebug_log(112,0) << "[" << tsetw(3) << order++ << "] " << v << std::endl;
+      if (_kind == Heap) {
+        for ( auto& entry : _heap.getEntries() )
+          cdebug_log(112,0) << "[" << tsetw(3) << order++ << "] " << entry._element << std::endl;
+      } else {
+        for ( Vertex* v : _queue )
+          cdebug_log(112,0) << "[" << tsetw(3) << order++ << "] " << v << std::endl;
+      }
       cdebug_tabw(112,-1);
     }
   }
@@ -636,26 +872,40 @@ namespace Anabatic {
       typedef std::function<DbU::Unit(const Vertex*,const Vertex*,const Edge*)>  distance_t;
     public:
                               Dijkstra                 ( AnabaticEngine* );
+                              Dijkstra                 ( Dijkstra* master );
                              ~Dijkstra                 ();
     public:                                            
       inline       bool       isBipoint                () const;
+      inline       bool       isWorker                 () const;
       inline       bool       isSourceVertex           ( Vertex* ) const;
       inline       Net*       getNet                   () const;
       inline       bool       isTargetVertex           ( Vertex* ) const;
                    DbU::Unit  getAntennaGateMaxWL      () const;
       inline       DbU::Unit  getSearchAreaHalo        () const;
+      inline const Estimator& getEstimator             () const;
+      inline       size_t     getExpandedCount         () const;
+      inline       DbU::Unit  getSearchCost            () const;
+      inline       PriorityQueue::Kind
+                              getQueueKind             () const;
+      inline       void       setQueueKind             ( PriorityQueue::Kind );
       template<typename DistanceT>                     
       inline       DistanceT* setDistance              ( DistanceT );
       inline       void       setSearchAreaHalo        ( DbU::Unit );
+                   void       setAStar                 ( float scale, size_t landmarks=0, Estimator::LowerBound lowerBound=nullptr );
                    void       load                     ( Net* net ); 
                    void       loadFixedGlobal          ( Net* net ); 
                    void       run                      ( Mode mode=Mode::Standart );
+                   bool       search                   ( Mode mode=Mode::Standart );
+                   void       materialize              ();
+      inline const Box&       getSearchArea            () const;
       inline const VertexSet& getSources               () const;
     private:                                           
                                Dijkstra                ( const Dijkstra& );
                    Dijkstra&  operator=                ( const Dijkstra& );
       static       DbU::Unit  _distance                ( const Vertex*, const Vertex*, const Edge* );
                    Point      _getPonderedPoint        () const;
+                   void       _createVertexes          ();
+                   void       _updateGridView          ();
                    void       _cleanup                 ();
                    bool       _propagate               ( Flags enabledSides );
                    void       _traceback               ( Vertex* );
@@ -684,19 +934,27 @@ namespace Anabatic {
                    bool       _updateIntervals         ( bool&, Vertex*, bool&, int&, Edge* );
                    void       _updateRealOccupancy     ( Vertex* );
     private:
-      AnabaticEngine*  _anabatic;
-      vector<Vertex*>  _vertexes;
-      distance_t       _distanceCb;
-      Mode             _mode;
-      Net*             _net;
-      int              _stamp;
-      VertexSet        _sources;
-      VertexSet        _targets;
-      Box              _searchArea;
-      DbU::Unit        _searchAreaHalo;
-      int              _connectedsId;
-      PriorityQueue    _queue;
-      Flags            _flags;
+      AnabaticEngine*        _anabatic;
+      Dijkstra*              _master;
+      GridView*              _grid;
+      Vertex*                _arena;
+      vector<Vertex*>        _vertexes;
+      distance_t             _distanceCb;
+      Mode                   _mode;
+      Net*                   _net;
+      int                    _stamp;
+      VertexSet              _sources;
+      VertexSet              _targets;
+      Box                    _searchArea;
+      DbU::Unit              _searchAreaHalo;
+      int                    _connectedsId;
+      PriorityQueue          _queue;
+      Estimator              _estimator;
+      size_t                 _landmarks;
+      Estimator::LowerBound  _lowerBound;
+      size_t                 _expandeds;
+      DbU::Unit              _searchCost;
+      Flags                  _flags;
   };
 
 
@@ -704,11 +962,20 @@ namespace Anabatic {
   inline Dijkstra::Mode::Mode ( BaseFlags            base  ) : BaseFlags(base)  { }
 
   inline bool       Dijkstra::isBipoint         () const { return _net and (_targets.size()+_sources.size() == 2); }
+  inline bool       Dijkstra::isWorker          () const { return _master; }
+  inline const Box& Dijkstra::getSearchArea     () const { return _searchArea; }
   inline bool       Dijkstra::isSourceVertex    ( Vertex* v ) const { return (_sources.find(v) != _sources.end()); }
   inline bool       Dijkstra::isTargetVertex    ( Vertex* v ) const { return (_targets.find(v) != _targets.end()); }
   inline Net*       Dijkstra::getNet            () const { return _net; }
   inline DbU::Unit  Dijkstra::getSearchAreaHalo () const { return _searchAreaHalo; }
   inline void       Dijkstra::setSearchAreaHalo ( DbU::Unit halo ) { _searchAreaHalo = halo; }
+  inline const Estimator&
+                    Dijkstra::getEstimator      () const { return _estimator; }
+  inline size_t     Dijkstra::getExpandedCount  () const { return _expandeds; }
+  inline DbU::Unit  Dijkstra::getSearchCost     () const { return _searchCost; }
+  inline void       Dijkstra::setQueueKind      ( PriorityQueue::Kind kind ) { _queue.setKind(kind); }
+  inline PriorityQueue::Kind
+                    Dijkstra::getQueueKind      () const { return _queue.getKind(); }
 
   template<typename DistanceT>
   inline DistanceT* Dijkstra::setDistance       ( DistanceT cb ) { _distanceCb = cb; return _distanceCb.target<DistanceT>(); }
@@ -65,6 +65,7 @@ namespace Anabatic {
       inline        unsigned int      getRealOccupancy     () const;
       inline        float             getEstimateOccupancy () const;
       inline        float             getHistoricCost      () const;
+      inline        uint32_t          getViewIndex         () const;
                     DbU::Unit         getDistance          () const;
       inline        GCell*            getSource            () const;
       inline        GCell*            getTarget            () const;
@@ -77,7 +78,7 @@ namespace Anabatic {
       inline const  vector<Segment*>& getSegments          () const;
     //inline        void              setCapacity          ( int );
     //inline        void              incCapacity          ( int );
-      inline        void              forceCapacity        ( int );
+                    void              forceCapacity        ( int );
       inline        void              reserveCapacity      ( int );
       inline        int               decreaseCapacity     ( int delta, size_t depth );
       inline        void              setRealOccupancy     ( int );
@@ -98,6 +99,8 @@ namespace Anabatic {
       inline        Flags&            setFlags             ( Flags mask );
                     void              _setSource           ( GCell* );
                     void              _setTarget           ( GCell* );
+      inline        void              _setViewIndex        ( uint32_t );
+                    void              _updateView          ();
     public:                                    
     // ExtensionGo support.                    
       inline  const Name&             staticGetName        (); 
@@ -127,6 +130,7 @@ namespace Anabatic {
               unsigned int      _realOccupancy;
               float             _estimateOccupancy;
               float             _historicCost;
+              uint32_t          _viewIndex;
               GCell*            _source;
               GCell*            _target;
               DbU::Unit         _axis;
@@ -145,22 +149,21 @@ namespace Anabatic {
   inline       unsigned int      Edge::getRealOccupancy     () const { return _realOccupancy; }
   inline       float             Edge::getEstimateOccupancy () const { return _estimateOccupancy; }
   inline       float             Edge::getHistoricCost      () const { return _historicCost; }
+  inline       uint32_t          Edge::getViewIndex         () const { return _viewIndex; }
   inline       GCell*            Edge::getSource            () const { return _source; }
   inline       GCell*            Edge::getTarget            () const { return _target; }
   inline       DbU::Unit         Edge::getAxis              () const { return _axis; }
   inline const vector<Segment*>& Edge::getSegments          () const { return _segments; }
 //inline       void              Edge::incCapacity          ( int delta ) { _capacity  = ((int)_capacity+delta > 0) ? _capacity+delta : 0; }
 //inline       void              Edge::setCapacity          ( int c     ) { _capacity  = ((int) c > 0) ? c : 0; }
-  inline       void              Edge::setRealOccupancy     ( int c     ) { _realOccupancy = ((int) c > 0) ? c : 0; }
+  inline       void              Edge::setRealOccupancy     ( int c     ) { _realOccupancy = ((int) c > 0) ? c : 0; _updateView(); }
   inline       void              Edge::setHistoricCost      ( float hcost ) { _historicCost = hcost; }
   inline       void              Edge::incEstimateOccupancy ( float delta ) { _estimateOccupancy += delta; }
   inline const Flags&            Edge::flags                () const { return _flags; }
   inline       Flags&            Edge::flags                () { return _flags; }
   inline       Flags&            Edge::setFlags             ( Flags mask ) { _flags |= mask; return _flags; }
-  inline       void              Edge::reserveCapacity      ( int delta ) { _reservedCapacity = ((int)_reservedCapacity+delta > 0) ? _reservedCapacity+delta : 0; }
-
-  inline void  Edge::forceCapacity ( int capacity )
-  { if (_capacities) _capacities->forceCapacity( capacity ); }
+  inline       void              Edge::reserveCapacity      ( int delta ) { _reservedCapacity = ((int)_reservedCapacity+delta > 0) ? _reservedCapacity+delta : 0; _updateView(); }
+  inline       void              Edge::_setViewIndex        ( uint32_t index ) { _viewIndex = index; }
 
   inline int  Edge::decreaseCapacity ( int delta, size_t depth )
   {
@@ -178,6 +181,7 @@ namespace Anabatic {
       sharedCapacities->decref();
     }
     int remains = _capacities->decreaseCapacity( delta, depth );
+    _updateView();
     cdebug_log(159,0) << "decreaseCapacity() " << this << std::endl;
     return remains;
   }
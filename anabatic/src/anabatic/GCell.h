@@ -92,6 +92,8 @@ namespace Anabatic {
         public:
           enum Indexes { Vertex = 0
                        };
+          enum Events  { Destroy = (1<<0)
+                       };
         public:
           inline             Observable ();
         private:
@@ -235,6 +237,7 @@ namespace Anabatic {
       inline        size_t                getDepth             () const;
                     size_t                getNetCount          () const;
       inline        int                   getRpCount           () const;
+      inline        uint32_t              getViewIndex         () const;
                     int                   getHCapacity         () const;
                     int                   getVCapacity         () const;
                     int                   getCapacity          ( size_t depth ) const;
@@ -295,6 +298,7 @@ namespace Anabatic {
                     void                  _add                 ( Edge* edge, Flags side );
                     void                  _remove              ( Edge* edge, Flags side=Flags::AllSides );
                     void                  _destroyEdges        ();
+      inline        void                  _setViewIndex        ( uint32_t );
     private:                                                   
                     void                  _moveEdges           ( GCell* dest, size_t ibegin, Flags flags );
     public:                                                    
@@ -346,6 +350,7 @@ namespace Anabatic {
               size_t                _pinDepth;
               uint32_t              _satProcessed;
               int                   _rpCount;
+              uint32_t              _viewIndex;
               DbU::Unit*            _blockages;
               float                 _cDensity;
               float*                _densities;
@@ -402,6 +407,8 @@ namespace Anabatic {
   inline const vector<Contact*>&     GCell::getGContacts     () const { return _gcontacts; }
   inline       size_t                GCell::getDepth         () const { return _depth; }
   inline       int                   GCell::getRpCount       () const { return _rpCount; }
+  inline       uint32_t              GCell::getViewIndex     () const { return _viewIndex; }
+  inline       void                  GCell::_setViewIndex    ( uint32_t index ) { _viewIndex = index; }
          const vector<AutoSegment*>& GCell::getVSegments     () const { return _vsegments; }
   inline const vector<AutoSegment*>& GCell::getHSegments     () const { return _hsegments; }
   inline const vector<AutoContact*>& GCell::getContacts      () const { return _contacts; }
@@ -0,0 +1,235 @@
+// -*- mode: C++; explicit-buffer-name: "GridView.h<anabatic>" -*-
+//
+// This file is part of the Coriolis Software.
+// Copyright (c) Sorbonne Université 2026-2026, All Rights Reserved
+//
+// +-----------------------------------------------------------------+
+// |                   C O R I O L I S                               |
+// |     A n a b a t i c  -  Global Routing Toolbox                  |
+// |                                                                 |
+// |  Author      :                    Jean-Paul CHAPUT              |
+// |  E-mail      :            Jean-Paul.Chaput@lip6.fr              |
+// | =============================================================== |
+// |  C++ Header  :  "./anabatic/GridView.h"                         |
+// +-----------------------------------------------------------------+
+
+
+#pragma  once
+#include <cstdint>
+#include <vector>
+#include "hurricane/Interval.h"
+#include "anabatic/Constants.h"
+#include "anabatic/GCell.h"
+
+
+namespace Anabatic {
+
+  using std::vector;
+  using Hurricane::DbU;
+  using Hurricane::Interval;
+  class AnabaticEngine;
+  class Edge;
+
+
+// -------------------------------------------------------------------
+// Class  :  "Anabatic::GridView".
+//
+// Flat view of the GCell grid, for the loops that walk it (Dijkstra
+// propagation, density estimates). The GCells are numbered in the order
+// of AnabaticEngine::getGCells(), which is also the index of the
+// Vertexes, each GCell and Edge keeps it's own number (getViewIndex()).
+// All the data are stored as arrays indexed by those numbers (structure
+// of arrays):
+//
+// * GCells : the four sides of the bounding box.
+// * Search : the state of the Vertex of the GCell during a Dijkstra
+//            search, distance, stamp and the number of the Edge it has
+//            been reached from. They are the only storage of that state
+//            (see Vertex::getDistance()).
+// * Links  : the adjacency, in compressed rows. For each GCell, the
+//            links are sorted by side (East, North, West, South) then
+//            in the order of the Edges vectors of the GCell, that is,
+//            the order of GCell::getEdges().
+// * Edges  : the Edge itself, its source & target GCells numbers, its
+//            capacity and its real occupancy. The last two are copies,
+//            the Edge writes them through each time it modifies them
+//            (see Edge::_updateView()).
+//
+// The view is built when the grid is complete. When a GCell is added or
+// removed it is only invalidated (so the Vertexes can still reach their
+// state), the Dijkstra rebuilds it, and it's Vertexes, before the next
+// search (see Dijkstra::_updateGridView()).
+
+  class GridView {
+    public:
+      static const uint32_t  npos = (uint32_t)-1;
+      enum Side { East=0, North=1, West=2, South=3, SideCount=4 };
+    public:
+                                  GridView          ( const AnabaticEngine* );
+      inline  bool                isValid           () const;
+      inline  void                invalidate        ();
+      inline  size_t              getGCellCount     () const;
+      inline  size_t              getEdgeCount      () const;
+      inline  uint32_t            getIndex          ( const GCell* ) const;
+      inline  GCell*              getGCell          ( uint32_t igcell ) const;
+      inline  DbU::Unit           getXMin           ( uint32_t igcell ) const;
+      inline  DbU::Unit           getYMin           ( uint32_t igcell ) const;
+      inline  DbU::Unit           getXMax           ( uint32_t igcell ) const;
+      inline  DbU::Unit           getYMax           ( uint32_t igcell ) const;
+      inline  Interval            getHSide          ( uint32_t igcell ) const;
+      inline  Interval            getVSide          ( uint32_t igcell ) const;
+      inline  DbU::Unit           getDistance       ( uint32_t igcell ) const;
+      inline  int                 getStamp          ( uint32_t igcell ) const;
+      inline  uint32_t            getFromEdge       ( uint32_t igcell ) const;
+      inline  Edge*               getFrom           ( uint32_t igcell ) const;
+      inline  void                setDistance       ( uint32_t igcell, DbU::Unit );
+      inline  void                setStamp          ( uint32_t igcell, int );
+      inline  void                setFromEdge       ( uint32_t igcell, uint32_t iedge );
+      inline  uint32_t            getFirstLink      ( uint32_t igcell, Side side=East ) const;
+      inline  uint32_t            getEndLink        ( uint32_t igcell, Side side=South ) const;
+      inline  uint32_t            getLinkGCell      ( uint32_t ilink ) const;
+      inline  uint32_t            getLinkEdge       ( uint32_t ilink ) const;
+      inline  Edge*               getEdge           ( uint32_t iedge ) const;
+      inline  uint32_t            getEdgeSource     ( uint32_t iedge ) const;
+      inline  uint32_t            getEdgeTarget     ( uint32_t iedge ) const;
+      inline  int                 getEdgeCapacity   ( uint32_t iedge ) const;
+      inline  uint32_t            getEdgeOccupancy  ( uint32_t iedge ) const;
+      inline  void                setEdgeCapacity   ( uint32_t iedge, int );
+      inline  void                setEdgeOccupancy  ( uint32_t iedge, uint32_t );
+              uint32_t            getEdgeAt         ( uint32_t igcell, Side, DbU::Unit u ) const;
+      template< typename Visitor >
+      inline  void                visitEdgesUnderPath ( uint32_t source, uint32_t target, Flags pathFlags, Visitor ) const;
+    private:
+      bool                _valid;
+      vector<GCell*>      _gcells;
+      vector<DbU::Unit>   _xMins;
+      vector<DbU::Unit>   _yMins;
+      vector<DbU::Unit>   _xMaxs;
+      vector<DbU::Unit>   _yMaxs;
+      vector<DbU::Unit>   _distances;
+      vector<int>         _stamps;
+      vector<uint32_t>    _froms;
+      vector<uint32_t>    _firstLinks;
+      vector<uint32_t>    _linkGCells;
+      vector<uint32_t>    _linkEdges;
+      vector<Edge*>       _edges;
+      vector<uint32_t>    _edgeSources;
+      vector<uint32_t>    _edgeTargets;
+      vector<int>         _edgeCapacities;
+      vector<uint32_t>    _edgeOccupancies;
+    private:
+                 GridView  ( const GridView& );
+      GridView&  operator= ( const GridView& );
+  };
+
+
+  inline bool       GridView::isValid          () const { return _valid; }
+  inline void       GridView::invalidate       () { _valid = false; }
+  inline size_t     GridView::getGCellCount    () const { return _gcells.size(); }
+  inline size_t     GridView::getEdgeCount     () const { return _edges.size(); }
+  inline uint32_t   GridView::getIndex         ( const GCell* gcell ) const { return gcell->getViewIndex(); }
+  inline GCell*     GridView::getGCell         ( uint32_t igcell ) const { return _gcells[igcell]; }
+  inline DbU::Unit  GridView::getXMin          ( uint32_t igcell ) const { return _xMins[igcell]; }
+  inline DbU::Unit  GridView::getYMin          ( uint32_t igcell ) const { return _yMins[igcell]; }
+  inline DbU::Unit  GridView::getXMax          ( uint32_t igcell ) const { return _xMaxs[igcell]; }
+  inline DbU::Unit  GridView::getYMax          ( uint32_t igcell ) const { return _yMaxs[igcell]; }
+  inline DbU::Unit  GridView::getDistance      ( uint32_t igcell ) const { return _distances[igcell]; }
+  inline int        GridView::getStamp         ( uint32_t igcell ) const { return _stamps[igcell]; }
+  inline uint32_t   GridView::getFromEdge      ( uint32_t igcell ) const { return _froms[igcell]; }
+  inline Edge*      GridView::getFrom          ( uint32_t igcell ) const { return (_froms[igcell] != npos) ? _edges[_froms[igcell]] : NULL; }
+  inline void       GridView::setDistance      ( uint32_t igcell, DbU::Unit distance ) { _distances[igcell] = distance; }
+  inline void       GridView::setStamp         ( uint32_t igcell, int stamp ) { _stamps[igcell] = stamp; }
+  inline void       GridView::setFromEdge      ( uint32_t igcell, uint32_t iedge ) { _froms[igcell] = iedge; }
+  inline uint32_t   GridView::getFirstLink     ( uint32_t igcell, Side side ) const { return _firstLinks[ igcell*SideCount + side ]; }
+  inline uint32_t   GridView::getEndLink       ( uint32_t igcell, Side side ) const { return _firstLinks[ igcell*SideCount + side + 1 ]; }
+  inline uint32_t   GridView::getLinkGCell     ( uint32_t ilink ) const { return _linkGCells[ilink]; }
+  inline uint32_t   GridView::getLinkEdge      ( uint32_t ilink ) const { return _linkEdges[ilink]; }
+  inline Edge*      GridView::getEdge          ( uint32_t iedge ) const { return _edges[iedge]; }
+  inline uint32_t   GridView::getEdgeSource    ( uint32_t iedge ) const { return _edgeSources[iedge]; }
+  inline uint32_t   GridView::getEdgeTarget    ( uint32_t iedge ) const { return _edgeTargets[iedge]; }
+  inline int        GridView::getEdgeCapacity  ( uint32_t iedge ) const { return _edgeCapacities[iedge]; }
+  inline uint32_t   GridView::getEdgeOccupancy ( uint32_t iedge ) const { return _edgeOccupancies[iedge]; }
+  inline void       GridView::setEdgeCapacity  ( uint32_t iedge, int capacity ) { _edgeCapacities[iedge] = capacity; }
+  inline void       GridView::setEdgeOccupancy ( uint32_t iedge, uint32_t occupancy ) { _edgeOccupancies[iedge] = occupancy; }
+
+
+// Same as GCell::getHSide() & GCell::getVSide(), the constraint side
+// is shrunk by one when there is a neighbor.
+  inline Interval  GridView::getHSide ( uint32_t igcell ) const
+  {
+    DbU::Unit shrink = (getFirstLink(igcell,East) != getEndLink(igcell,East)) ? 1 : 0;
+    return Interval( _xMins[igcell], _xMaxs[igcell] - shrink );
+  }
+
+  inline Interval  GridView::getVSide ( uint32_t igcell ) const
+  {
+    DbU::Unit shrink = (getFirstLink(igcell,North) != getEndLink(igcell,North)) ? 1 : 0;
+    return Interval( _yMins[igcell], _yMaxs[igcell] - shrink );
+  }
+
+
+// Mirror of Path_Edges (see Edges.cpp), the Edges are visited in the
+// same order, but without the Collection allocations and only on the
+// arrays of the view.
+  template< typename Visitor >
+  inline void  GridView::visitEdgesUnderPath ( uint32_t source, uint32_t target, Flags pathFlags, Visitor visitor ) const
+  {
+    if ((source == target) or (source == npos) or (target == npos)) return;
+
+    Interval  hoverlap = getHSide(source).getIntersection( getHSide(target) );
+    Interval  voverlap = getVSide(source).getIntersection( getVSide(target) );
+    Side      side     = East;
+    DbU::Unit uprobe   = 0;
+
+    if (not voverlap.isEmpty()) {
+      if (_xMins[source] > _xMins[target]) std::swap( source, target );
+      side   = East;
+      uprobe = voverlap.getCenter();
+    } else if (not hoverlap.isEmpty()) {
+      if (_yMins[source] > _yMins[target]) std::swap( source, target );
+      side   = North;
+      uprobe = hoverlap.getCenter();
+    } else {
+      if (_xMins[source] > _xMins[target]) std::swap( source, target );
+
+      DbU::Unit xCenter = (_xMins[source] + _xMaxs[source]) / 2;
+      DbU::Unit yCenter = (_yMins[source] + _yMaxs[source]) / 2;
+      if (_yMins[source] < _yMins[target]) {
+        if (pathFlags & Flags::NorthPath) { side = North; uprobe = xCenter; }
+        else                              { side = East;  uprobe = yCenter; }
+      } else {
+        if (pathFlags & Flags::NorthPath) { side = East;  uprobe = yCenter; }
+        else                              { side = South; uprobe = xCenter; }
+      }
+    }
+
+    uint32_t iedge = getEdgeAt( source, side, uprobe );
+    while ( iedge != npos ) {
+      visitor( _edges[iedge] );
+
+      uint32_t neighbor = ((side == South) or (side == West)) ? _edgeSources[iedge] : _edgeTargets[iedge];
+      if (neighbor == target) return;
+
+      if (side == East) {
+        Interval overlap = getHSide(neighbor).getIntersection( getHSide(target) );
+        if (not overlap.isEmpty()) {
+          overlap = getVSide(neighbor).getIntersection( getVSide(target) );
+          if (not overlap.isEmpty()) return;
+          side   = (_yMins[target] < _yMins[source]) ? South : North;
+          uprobe = overlap.getCenter();
+        }
+      } else if ((side == South) or (side == North)) {
+        Interval overlap = getVSide(neighbor).getIntersection( getVSide(target) );
+        if (not overlap.isEmpty()) {
+          overlap = getHSide(neighbor).getIntersection( getHSide(target) );
+          if (not overlap.isEmpty()) return;
+          side   = East;
+          uprobe = overlap.getCenter();
+        }
+      }
+      iedge = getEdgeAt( neighbor, side, uprobe );
+    }
+  }
+
+
+}  // Anabatic namespace.
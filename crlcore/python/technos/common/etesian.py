@@ -26,6 +26,7 @@ Cfg.getParamString    ( 'etesian.feedNames'        ).setString    ( 'tie_x0,rowe
 Cfg.getParamString    ( 'etesian.cell.zero'        ).setString    ( 'zero_x0' )
 Cfg.getParamString    ( 'etesian.cell.one'         ).setString    ( 'one_x0' )
 Cfg.getParamString    ( 'etesian.bloat'            ).setString    ( 'disabled' )
+Cfg.getParamInt       ( 'etesian.nbThreads'        ).setInt       ( 1 )
 
 param = Cfg.getParamEnumerate( 'etesian.effort' )
 param.setInt( 2 )
@@ -51,4 +52,5 @@ layout.addParameter( 'Placer', 'etesian.densityVariation' , 'Density variation'
 layout.addParameter( 'Placer', 'etesian.routingDriven'    , 'Routing driven'    , 0 )
 layout.addParameter( 'Placer', 'etesian.effort'           , 'Placement effort'  , 1 )
 layout.addParameter( 'Placer', 'etesian.graphics'         , 'Placement view'    , 1 )
+layout.addParameter( 'Placer', 'etesian.nbThreads'        , 'Global place threads', 0 )
 layout.addRule     ( 'Placer' )
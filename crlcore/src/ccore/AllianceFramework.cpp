@@ -14,6 +14,10 @@
 // +-----------------------------------------------------------------+
 
 #include <unistd.h>
+#include <atomic>
+#include <fstream>
+#include <sstream>
+#include <thread>
 #include "hurricane/utilities/Path.h"
 #include "hurricane/Initializer.h"
 #include "hurricane/Warning.h"
@@ -419,6 +423,105 @@ namespace CRL {
   }
 
 
+  size_t  AllianceFramework::prefetchCells ( const vector<string>& names, unsigned int mode, unsigned int threads )
+  {
+    struct PrefetchJob {
+      vector<string>  _candidates;
+      string          _path;
+      string          _contents;
+    };
+
+    vector<string>  cellNames = names;
+    if (cellNames.empty()) {
+      for ( auto& item : *_catalog.getStates() ) {
+        if (not item.second->isInMemory()) cellNames.push_back( getString(item.first) );
+      }
+    }
+
+  // Main thread: list the files that getCell() could open, in the
+  // same order as _readLocate() (extensions, then directories).
+    SearchPath&          LIBRARIES = _environment.getLIBRARIES();
+    vector<PrefetchJob>  jobs;
+    for ( const string& name : cellNames ) {
+      Catalog::State* state    = _catalog.getState( name );
+      unsigned int    cellMode = mode;
+      if (state and state->isTerminalNetlist()) cellMode |= Catalog::State::Physical;
+
+      for ( unsigned int view : { Catalog::State::Logical, Catalog::State::Physical } ) {
+        if (not (cellMode & view)) continue;
+        if (state and state->getFlags(view)) continue;
+
+        ParserFormatSlot& format = _parsers.getParserSlot( name, view, _environment );
+        PrefetchJob       job;
+        for ( format.cbegin() ; not format.cend() ; format++ ) {
+        // Only the parsers reading through IoFile benefit from the staging.
+          if ((format.getTag() != "ap") and (format.getTag() != "vst")) continue;
+          for ( size_t i=0 ; i<LIBRARIES.getSize() ; ++i )
+            job._candidates.push_back( LIBRARIES[i].getPath() + "/" + name + "." + format.getExt() );
+        }
+        if (not job._candidates.empty()) jobs.push_back( std::move(job) );
+      }
+    }
+
+  // Worker threads: probe the candidates & read the first one found.
+    if (not threads) threads = std::max( 1U, std::thread::hardware_concurrency() );
+    threads = std::min( threads, std::max( (unsigned int)1, (unsigned int)jobs.size() ));
+    std::atomic<size_t>  next ( 0 );
+
+    auto worker = [&] () {
+      while ( true ) {
+        size_t ijob = next++;
+        if (ijob >= jobs.size()) break;
+
+        PrefetchJob& job = jobs[ijob];
+        for ( const string& candidate : job._candidates ) {
+          ifstream stream ( candidate, ios::in|ios::binary );
+          if (not stream.is_open()) continue;
+
+          ostringstream contents;
+          contents << stream.rdbuf();
+          job._path     = candidate;
+          job._contents = contents.str();
+          break;
+        }
+      }
+    };
+
+    vector<std::thread> workers;
+    for ( unsigned int i=1 ; i<threads ; ++i ) workers.push_back( std::thread(worker) );
+    worker();
+    for ( std::thread& thread : workers ) thread.join();
+
+  // Main thread: stage the contents, then build the Cells through the
+  // usual getCell(), as the parsers and the DataBase are not reentrant.
+    size_t fileCount = 0;
+    size_t byteCount = 0;
+    for ( PrefetchJob& job : jobs ) {
+      if (job._path.empty()) continue;
+      ++fileCount;
+      byteCount += job._contents.size();
+      IoFile::stage( job._path, std::move(job._contents) );
+    }
+    cmess2 << "  o  Prefetched " << fileCount << " files (" << (byteCount >> 10) << " Kb) with "
+           << threads << " threads." << endl;
+
+    size_t loadeds = 0;
+    try {
+      for ( const string& name : cellNames ) {
+        Catalog::State* state = _catalog.getState( name );
+        if (state and state->isInMemory()) continue;
+        if (getCell( name, mode )) ++loadeds;
+      }
+    } catch ( ... ) {
+      IoFile::clearStaged();
+      throw;
+    }
+    IoFile::clearStaged();
+
+    return loadeds;
+  }
+
+
   AllianceLibrary* AllianceFramework::createLibrary ( const string& path, unsigned int flags, string libName )
   {
     if ( libName.empty() ) libName = SearchPath::extractLibName(path);
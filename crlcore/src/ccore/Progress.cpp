@@ -0,0 +1,204 @@
+// -*- C++ -*-
+//
+// This file is part of the Coriolis Software.
+// Copyright (c) Sorbonne Universite 2026-2026, All Rights Reserved
+//
+// +-----------------------------------------------------------------+
+// |                   C O R I O L I S                               |
+// |          Alliance / Hurricane  Interface                        |
+// |                                                                 |
+// |  Author      :                    Jean-Paul Chaput              |
+// |  E-mail      :            Jean-Paul.Chaput@lip6.fr              |
+// | =============================================================== |
+// |  C++ Module  :       "./Progress.cpp"                           |
+// +-----------------------------------------------------------------+
+
+
+#include  <fcntl.h>
+#include  <unistd.h>
+#include  <sys/socket.h>
+#include  <sys/un.h>
+#include  <cerrno>
+#include  <cstring>
+#include  <chrono>
+#include  <iomanip>
+#include  <sstream>
+#include  "hurricane/configuration/Configuration.h"
+#include  "hurricane/Warning.h"
+#include  "crlcore/Utilities.h"
+#include  "crlcore/Progress.h"
+
+
+namespace {
+
+  using namespace std;
+
+
+  int64_t  nowNs ()
+  {
+    return chrono::duration_cast<chrono::nanoseconds>
+      ( chrono::steady_clock::now().time_since_epoch() ).count();
+  }
+
+
+}  // Anonymous namespace.
+
+
+namespace CRL {
+
+  using std::string;
+  using std::ostringstream;
+  using std::setw;
+  using std::setfill;
+  using std::setprecision;
+  using std::fixed;
+  using std::right;
+  using std::cerr;
+  using std::endl;
+  using Hurricane::Warning;
+
+
+// -------------------------------------------------------------------
+// Class  :  "CRL::Progress".
+
+
+  Progress::Progress ( const string& label, const string& indent )
+    : _label     (label)
+    , _indent    (indent)
+    , _size      (0)
+    , _names     ()
+    , _values    ()
+    , _ticks     (0)
+    , _lastReport(0)
+    , _emitting  ()
+    , _start     (nowNs())
+    , _period    (Cfg::getParamInt("misc.progressPeriod",250)->asInt() * 1000000LL)
+    , _lastValue (0)
+    , _sink      (-1)
+    , _socket    (false)
+    , _printed   (false)
+  {
+    _emitting.clear();
+    for ( size_t i=0 ; i<MaxCounters ; ++i ) _values[i].store( 0, std::memory_order_relaxed );
+    _lastReport.store( _start, std::memory_order_relaxed );
+
+    string sinkPath = Cfg::getParamString("misc.progressFile","")->asString();
+    if (not sinkPath.empty()) _openSink( sinkPath );
+  }
+
+
+  Progress::~Progress ()
+  {
+    if (_sink >= 0) ::close( _sink );
+  }
+
+
+  void  Progress::_openSink ( const string& path )
+  {
+    if (path.compare(0,5,"unix:") == 0) {
+      struct sockaddr_un address;
+      string             socketPath = path.substr( 5 );
+
+      memset( &address, 0, sizeof(address) );
+      address.sun_family = AF_UNIX;
+      if (socketPath.size() >= sizeof(address.sun_path)) {
+        cerr << Warning( "Progress::_openSink(): Socket path too long, ignored.\n"
+                         "        \"%s\"", socketPath.c_str() ) << endl;
+        return;
+      }
+      strncpy( address.sun_path, socketPath.c_str(), sizeof(address.sun_path)-1 );
+
+      _sink   = ::socket( AF_UNIX, SOCK_STREAM, 0 );
+      _socket = true;
+      if ((_sink >= 0) and (::connect(_sink,(struct sockaddr*)&address,sizeof(address)) < 0)) {
+        ::close( _sink );
+        _sink = -1;
+      }
+    } else {
+      _sink = ::open( path.c_str(), O_WRONLY|O_CREAT|O_APPEND|O_NONBLOCK, 0644 );
+    }
+
+    if (_sink < 0) {
+      cerr << Warning( "Progress::_openSink(): Unable to open progress sink, ignored.\n"
+                       "        \"%s\" (%s)", path.c_str(), strerror(errno) ) << endl;
+      return;
+    }
+    ::fcntl( _sink, F_SETFL, ::fcntl(_sink,F_GETFL) | O_NONBLOCK );
+  }
+
+
+  size_t  Progress::addCounter ( const string& name )
+  {
+    if (_size >= MaxCounters) {
+      cerr << Warning( "Progress::addCounter(): Too many counters on \"%s\", \"%s\" ignored."
+                     , _label.c_str(), name.c_str() ) << endl;
+      return MaxCounters-1;
+    }
+    _names[_size] = name;
+    return _size++;
+  }
+
+
+  void  Progress::report ( bool force )
+  {
+    if (not (tty::enabled() and cmess2.enabled()) and (_sink < 0)) return;
+
+    int64_t now = nowNs();
+    if (not force and (now - _lastReport.load(std::memory_order_relaxed) < _period)) return;
+    if (_emitting.test_and_set(std::memory_order_acquire)) return;
+
+    _emit( now );
+    _lastReport.store( now, std::memory_order_relaxed );
+    _emitting.clear( std::memory_order_release );
+  }
+
+
+  void  Progress::_emit ( int64_t now )
+  {
+    uint64_t values[MaxCounters];
+    for ( size_t i=0 ; i<_size ; ++i ) values[i] = get( i );
+
+    double elapsed = (double)(now - _start) / 1e9;
+    double delta   = (double)(now - _lastReport.load(std::memory_order_relaxed)) / 1e9;
+    double rate    = 0.0;
+    if (_size and (delta > 0.0)) rate = (double)(values[0] - _lastValue) / delta;
+    if (_size) _lastValue = values[0];
+
+    if (tty::enabled() and cmess2.enabled()) {
+      cmess2 << _indent << "<" << _label << ":";
+      for ( size_t i=0 ; i<_size ; ++i ) {
+        if (i) cmess2 << " " << _names[i] << ":";
+        cmess2 << tty::bold << right << setw(8) << setfill('0') << values[i] << tty::reset;
+      }
+      cmess2 << setfill(' ') << " " << (uint64_t)rate << "/s>" << tty::cr;
+      cmess2.flush();
+      _printed = true;
+    }
+
+    if (_sink >= 0) {
+      ostringstream os;
+      os << "{\"label\":\"" << _label << "\""
+         << ",\"time\":" << fixed << setprecision(3) << elapsed
+         << ",\"rate\":" << setprecision(1) << rate;
+      for ( size_t i=0 ; i<_size ; ++i )
+        os << ",\"" << _names[i] << "\":" << values[i];
+      os << "}\n";
+
+    // On EAGAIN (the reader is late), the report is simply dropped.
+      string  line    = os.str();
+      ssize_t written = (_socket) ? ::send ( _sink, line.c_str(), line.size(), MSG_NOSIGNAL )
+                                  : ::write( _sink, line.c_str(), line.size() );
+      (void)written;
+    }
+  }
+
+
+  void  Progress::finish ()
+  {
+    report( true );
+    if (_printed) cmess2 << endl;
+    _printed = false;
+  }
+
+
+}  // CRL namespace.
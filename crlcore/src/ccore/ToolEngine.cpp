@@ -51,6 +51,7 @@ namespace {
   class ToolEnginesRelation : public Relation {
     public:
     // Static Methods.
+      static const Name&          staticGetName                   ();
       static ToolEnginesRelation* getToolEnginesRelation          ( const Cell* cell );
       static void                 destroyAllToolEnginesRelations  ();
     // Constructor.
@@ -109,6 +110,10 @@ namespace {
   }
 
 
+  const Name& ToolEnginesRelation::staticGetName ()
+  { return ToolEnginesRelationName; }
+
+
   Name  ToolEnginesRelation::getName () const
   { return ToolEnginesRelationName; }
 
@@ -148,15 +153,7 @@ namespace {
   {
     if ( !cell )
       throw Error ( "Can't get " + _TName("ToolEnginesRelation") + " : empty cell" );
-    Property* property = cell->getProperty(ToolEnginesRelationName);
-    if ( !property )
-      return NULL;
-    else {
-      ToolEnginesRelation* enginesRelation = dynamic_cast<ToolEnginesRelation*>(property);
-      if ( !enginesRelation )
-        throw Error ( "Bad Property type: Must be a ToolEnginesRelation" );
-      return enginesRelation;
-    }
+    return cell->getProperty<ToolEnginesRelation>();
   }
 
 
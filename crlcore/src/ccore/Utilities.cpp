@@ -409,16 +409,46 @@ namespace CRL {
 // Class  :  "CRL::IoFile".
 
 
+  std::map<string,string>  IoFile::_staged;
+
+
+  void  IoFile::stage ( const string& path, string&& contents )
+  {
+    if (contents.empty()) return;
+    _staged[ path ] = std::move( contents );
+  }
+
+
+  size_t  IoFile::getStagedCount ()
+  { return _staged.size(); }
+
+
+  void  IoFile::clearStaged ()
+  { _staged.clear(); }
+
+
   bool  IoFile::open ( const string& mode )
   {
     if ( isOpen() )
       throw Error ( "IoFile::Open():\n  Attempt to reopen file %s\n", _path.c_str() );
 
     _mode       = mode;
-    _file       = fopen ( _path.c_str(), mode.c_str() );
+    _file       = NULL;
     _lineNumber = 0;
     _eof        = false;
 
+    if (mode == "r") {
+      auto istaged = _staged.find( _path );
+      if (istaged != _staged.end()) {
+        _contents = std::move( (*istaged).second );
+        _staged.erase( istaged );
+      }
+    // Kept until destruction, for parsers that read the file twice.
+      if (not _contents.empty())
+        _file = fmemopen( _contents.data(), _contents.size(), "r" );
+    }
+    if (not _file) _file = fopen ( _path.c_str(), mode.c_str() );
+
     return _file;
   }
 
@@ -1312,7 +1312,11 @@ void  vstParser ( const string cellPath, Cell *cell )
   yyin = ccell.getFile ();
   yyrestart ( VSTin );
   UpdateSession::open ();
-  yyparse ();
+  {
+    Cell::BulkBuildGuard bulkBuild ( cell );
+    yyparse ();
+    bulkBuild.close ();
+  }
   UpdateSession::close ();
   Vst::states.pop_back();
 
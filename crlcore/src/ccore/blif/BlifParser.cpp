@@ -17,11 +17,16 @@
 #include <stdio.h>
 #include <string.h>
 #include <string>
+#include <string_view>
 #include <sstream>
 #include <algorithm>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 using namespace std;
 
 #include "hurricane/configuration/Configuration.h"
@@ -55,6 +60,13 @@ namespace {
 
 // -------------------------------------------------------------------
 // Class  :  "::Tokenize".
+//
+// The whole BLIF file is memory mapped (or read in one go when it
+// cannot be) and the tokens are string_views inside that image. A
+// line continuation (backslash at end of line) is simply skipped
+// over. So the tokens, and the entries built from them, are valid
+// only while the Tokenize object is alive. Signal names that must be
+// kept are converted once into Names through intern().
 
 
   class Tokenize {
@@ -76,48 +88,103 @@ namespace {
                  , CoverLogic = 0x00004000
                  , CoverAlias = 0x00008000
                  };
-      typedef  vector< pair<string,string> >  CoverTable;
+      typedef  vector< pair<string_view,string_view> >  CoverTable;
     public:
-                                   Tokenize   ( string blifFile );
-      inline size_t                lineno     () const;
-      inline unsigned int          state      () const;
-             const vector<string>& blifLine   () const;
-             const CoverTable&     coverTable () const;
-             bool                  readEntry  ();
+                                        Tokenize   ( string blifFile );
+                                       ~Tokenize   ();
+      inline size_t                     lineno     () const;
+      inline unsigned int               state      () const;
+      inline size_t                     size       () const;
+      inline const vector<string_view>& blifLine   () const;
+      inline const CoverTable&          coverTable () const;
+             const Name&                intern     ( string_view );
+             bool                       readEntry  ();
     private:                                  
-             bool                  _readline  ();
+             bool                       _readline  ();
+    private:
+      const char*                        _data;
+            size_t                       _size;
+            size_t                       _offset;
+            bool                         _mapped;
+            string                       _copy;
+            size_t                       _lineno;
+            unsigned int                 _state;
+            vector<string_view>          _tokens;
+            vector<string_view>          _blifLine;
+            CoverTable                   _coverTable;
+            unordered_map<string_view,Name>  _names;
     private:
-      size_t          _lineno;
-      unsigned int    _state;
-      ifstream        _stream;
-      vector<string>  _tokens;
-      vector<string>  _blifLine;
-      CoverTable      _coverTable;
+                 Tokenize  ( const Tokenize& );
+      Tokenize&  operator= ( const Tokenize& );
   };
 
 
   Tokenize::Tokenize ( string blifFile )
-    : _lineno    (0)
+    : _data      (NULL)
+    , _size      (0)
+    , _offset    (0)
+    , _mapped    (false)
+    , _copy      ()
+    , _lineno    (0)
     , _state     (Init)
-    , _stream    ()
     , _tokens    ()
     , _blifLine  ()
     , _coverTable()
+    , _names     ()
   { 
-    _stream.open( blifFile+".blif" );
-    if (_stream.fail())
-      throw Error( "Unable to open BLIF file %s.blif\n", blifFile.c_str() );
+    blifFile += ".blif";
+    int fd = ::open( blifFile.c_str(), O_RDONLY );
+    if (fd < 0)
+      throw Error( "Unable to open BLIF file %s\n", blifFile.c_str() );
+
+    struct stat infos;
+    if ((::fstat(fd,&infos) == 0) and S_ISREG(infos.st_mode) and (infos.st_size > 0)) {
+      void* data = ::mmap( NULL, infos.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+      if (data != MAP_FAILED) {
+        ::madvise( data, infos.st_size, MADV_SEQUENTIAL );
+        _data   = (const char*)data;
+        _size   = infos.st_size;
+        _mapped = true;
+      }
+    }
 
+    if (not _mapped) {
+      char    chunk [ 1<<16 ];
+      ssize_t count = 0;
+      while ( (count = ::read(fd,chunk,sizeof(chunk))) > 0 )
+        _copy.append( chunk, count );
+      _data = _copy.data();
+      _size = _copy.size();
+    }
+    ::close( fd );
+
+    _names.reserve( _size / 32 );
     _readline();
   }
 
 
+  Tokenize::~Tokenize ()
+  {
+    if (_mapped) ::munmap( (void*)_data, _size );
+  }
+
+
   inline size_t                      Tokenize::lineno    () const { return (_lineno) ? _lineno-1 : 0; }
   inline unsigned int                Tokenize::state     () const { return _state; }
-  inline const vector<string>&       Tokenize::blifLine  () const { return _blifLine; }
+  inline size_t                      Tokenize::size      () const { return _size; }
+  inline const vector<string_view>&  Tokenize::blifLine  () const { return _blifLine; }
   inline const Tokenize::CoverTable& Tokenize::coverTable() const { return _coverTable; }
 
 
+  const Name& Tokenize::intern ( string_view token )
+  {
+    auto iname = _names.find( token );
+    if (iname == _names.end())
+      iname = _names.emplace( token, Name(string(token)) ).first;
+    return (*iname).second;
+  }
+
+
   bool  Tokenize::readEntry ()
   {
     _blifLine  .clear();
@@ -125,7 +192,7 @@ namespace {
     _blifLine = _tokens;
     _state    = 0;
 
-    if (_stream.eof()) return false;
+    if (_tokens.empty()) return false;
 
     if (_tokens.front() == ".model"  ) { _state = Model;   }
     if (_tokens.front() == ".end"    ) { _state = End;     }
@@ -142,7 +209,7 @@ namespace {
       while ( _readline() and (_tokens.front()[0] != '.')) {
         switch ( _tokens.size() ) {
           case 0: break;
-          case 1: _coverTable.push_back( make_pair(_tokens[0],string()) ); break;
+          case 1: _coverTable.push_back( make_pair(_tokens[0],string_view()) ); break;
           default: 
           case 2: _coverTable.push_back( make_pair(_tokens[0],_tokens[1]) ); break;
         }
@@ -169,39 +236,42 @@ namespace {
     bool nextLine = true;
 
     while ( nextLine ) {
-      if (_stream.eof()) return false;
+    // The end of file counts as a last empty line, as with getline().
+      if (_offset >= _size) {
+        if (_offset == _size) { ++_lineno; ++_offset; }
+        return false;
+      }
 
       nextLine = false;
       ++_lineno;
 
-      string line;
-      getline( _stream, line );
+      const char* eol  = (const char*)memchr( _data+_offset, '\n', _size-_offset );
+      size_t      end  = (eol) ? eol-_data : _size;
+      string_view line ( _data+_offset, end-_offset );
+      _offset = end + 1;
+
+      size_t comment = line.find( '#' );
+      if (comment != string_view::npos)
+        line = line.substr( 0, comment );
+      else if (not line.empty() and (line.back() == '\\')) {
+        line.remove_suffix( 1 );
+        nextLine = true;
+      }
 
-      bool   comment  = false;
       size_t tokstart = 0;
-      for ( size_t i=0 ; i<line.size() ; ++i ) {
-        size_t nextTokstart = i+1;
-  
-        switch ( line[i] ) {
-          case '\\':
-            if (i == line.size()-1) nextLine = true;
-          default:   continue;
-          case ' ':
-          case '\t': break;
-          case '#':  comment  = true; break;
+      for ( size_t i=0 ; i<=line.size() ; ++i ) {
+        if (i < line.size()) {
+          switch ( line[i] ) {
+            default:   continue;
+            case ' ':
+            case '\t':
+            case '\r': break;
+          }
         }
-  
-        if (i > tokstart)
-          _tokens.push_back( line.substr(tokstart,i-tokstart) );
-  
-        tokstart = nextTokstart;
-
-        if (comment) break;
+        if (i > tokstart) _tokens.push_back( line.substr(tokstart,i-tokstart) );
+        tokstart = i+1;
       }
 
-      if ( (not comment) and (tokstart < line.size()) )
-        _tokens.push_back( line.substr(tokstart) );
-
       if (_tokens.empty())
         nextLine = true;
     }
@@ -219,7 +289,7 @@ namespace {
 
   class Subckt {
     public:
-      typedef  vector< pair<string,string> >  Connections;
+      typedef  vector< pair<Name,Name> >  Connections;
     public:
                                 Subckt          ( string modelName, string instanceName );
       static Model*             createModel     ( string modelName );
@@ -229,7 +299,7 @@ namespace {
       inline size_t             getDepth        () const;
       inline Model*             getModel        () const;
       inline void               setModel        ( Model* );
-      inline void               addConnection   ( const pair<string,string>& );
+      inline void               addConnection   ( const Name& masterNetName, const Name& netName );
              void               connectSubckts  ();
     private:
       string       _modelName;
@@ -278,8 +348,8 @@ namespace {
              Subckt*        addSubckt      ( string modelName );
              size_t         computeDepth   ();
              void           connectSubckts ();
-             Net*           mergeNet       ( string name, bool isExternal, unsigned int );
-             Net*           mergeAlias     ( string name1, string name2 );
+             Net*           mergeNet       ( const Name& name, bool isExternal, unsigned int );
+             Net*           mergeAlias     ( Name name1, Name name2 );
              Net*           newDummyNet    ();
     private:
       Cell*         _cell;
@@ -341,7 +411,7 @@ namespace {
                     Subckt::getConnections  () const { return _connections; }
   inline size_t     Subckt::getDepth        () const { return (_model) ? _model->getDepth() : 0; }
   inline void       Subckt::setModel        ( Model* model ) { _model = model; }
-  inline void       Subckt::addConnection   ( const pair<string,string>& connection ) { _connections.push_back(connection); }
+  inline void       Subckt::addConnection   ( const Name& masterNetName, const Name& netName ) { _connections.push_back( make_pair(masterNetName,netName) ); }
 
 
 // -------------------------------------------------------------------
@@ -560,7 +630,7 @@ namespace {
   }
 
 
-  Net* Model::mergeNet ( string name, bool isExternal, unsigned int direction )
+  Net* Model::mergeNet ( const Name& name, bool isExternal, unsigned int direction )
   {
     bool isClock = AllianceFramework::get()->isCLOCK( name );
 
@@ -588,7 +658,7 @@ namespace {
   }
 
 
-  Net* Model::mergeAlias ( string name1, string name2 )
+  Net* Model::mergeAlias ( Name name1, Name name2 )
   {
     Net* net1 = _cell->getNet( name1 );
     Net* net2 = _cell->getNet( name2 );
@@ -689,6 +759,11 @@ namespace {
 
   void  Model::connectSubckts ()
   {
+  // Size the Cell maps once, a net links at least two plugs.
+    size_t connections = 0;
+    for ( Subckt* subckt : _subckts ) connections += subckt->getConnections().size();
+    Cell::BulkBuildGuard bulkBuild ( _cell, connections/2, _subckts.size() );
+
     for ( Subckt* subckt : _subckts ) {
       if(not subckt->getModel())
         throw Error( "No .model or cell named <%s> has been found.\n"
@@ -699,9 +774,9 @@ namespace {
                                            , subckt->getModel()->getCell()
                                            );
 
-      for ( auto connection : subckt->getConnections() ) {
-        string masterNetName = connection.first;
-        string netName       = connection.second;
+      for ( const auto& connection : subckt->getConnections() ) {
+        const Name& masterNetName = connection.first;
+        const Name& netName       = connection.second;
         //cparanoid << "\tConnection "
         //          << "plug: <" << masterNetName << ">, "
         //          << "external: <" << netName << ">."
@@ -804,6 +879,8 @@ namespace {
         }
       }
     }
+
+    bulkBuild.close();
   }
 
 
@@ -849,8 +926,8 @@ namespace CRL {
 
     Cell*                 mainModel = NULL;
     Model*                blifModel = NULL;
-    Tokenize              tokenize  ( blifFile );
-    const vector<string>& blifLine  = tokenize.blifLine();
+    Tokenize                   tokenize  ( blifFile );
+    const vector<string_view>& blifLine  = tokenize.blifLine();
 
     UpdateSession::open();
     while ( tokenize.readEntry() ) {
@@ -866,7 +943,7 @@ namespace CRL {
           --tab;
         }
 
-        Cell* cell = framework->createCell( blifLine[1] );
+        Cell* cell = framework->createCell( string(blifLine[1]) );
         cell->setTerminalNetlist( false );
         blifModel = new Model ( cell );
 
@@ -908,7 +985,7 @@ namespace CRL {
       if (not blifModel) {
         cerr << Error( "Blif::load() Unexpected command \"%s\" outside of .model definition.\n"
                        "                    File %s.blif at line %u."
-                     , blifLine[0].c_str()
+                     , string(blifLine[0]).c_str()
                      , blifFile.c_str()
                      , tokenize.lineno()
                      ) << endl;
@@ -918,7 +995,7 @@ namespace CRL {
       if (tokenize.state() == Tokenize::Inputs) {
       //cerr << "Reading .inputs of " << blifModel->getCell() << endl;
         for ( size_t i=1 ; i<blifLine.size() ; ++i ) {
-          blifModel->mergeNet( blifLine[i], true, Net::Direction::IN );
+          blifModel->mergeNet( tokenize.intern(blifLine[i]), true, Net::Direction::IN );
         }
       //cerr << "Reading .inputs of " << blifModel->getCell() << " DONE" << endl;
       }
@@ -926,32 +1003,32 @@ namespace CRL {
       if (tokenize.state() == Tokenize::Outputs) {
       //cerr << "Reading .outputs of " << blifModel->getCell() << endl;
         for ( size_t i=1 ; i<blifLine.size() ; ++i ) {
-          blifModel->mergeNet( blifLine[i], true, Net::Direction::OUT );
+          blifModel->mergeNet( tokenize.intern(blifLine[i]), true, Net::Direction::OUT );
         }
       //cerr << "Reading .outputs of " << blifModel->getCell() << " DONE" << endl;
       }
 
       if (tokenize.state() & Tokenize::Names) {
         if (tokenize.state() & Tokenize::CoverAlias) {
-          blifModel->mergeAlias( blifLine[1], blifLine[2] );
+          blifModel->mergeAlias( tokenize.intern(blifLine[1]), tokenize.intern(blifLine[2]) );
         } else if (tokenize.state() & Tokenize::CoverZero) {
           cparanoid << Warning( "Blif::load() Definition of an alias <%s> of VSS in a \".names\". Maybe you should use tie cells?\n"
                                 "          File \"%s.blif\" at line %u."
-                              , blifLine[1].c_str()
+                              , string(blifLine[1]).c_str()
                               , blifFile.c_str()
                               , tokenize.lineno()
                               ) << endl;
           //blifModel->mergeAlias( blifLine[1], "vss" );
-          blifModel->getCell()->getNet( blifModel->getGroundName() )->addAlias( blifLine[1] );
+          blifModel->getCell()->getNet( blifModel->getGroundName() )->addAlias( tokenize.intern(blifLine[1]) );
         } else if (tokenize.state() & Tokenize::CoverOne ) {
           cparanoid << Warning( "Blif::load() Definition of an alias <%s> of VDD in a \".names\". Maybe you should use tie cells?\n"
                                 "          File \"%s.blif\" at line %u."
-                              , blifLine[1].c_str()
+                              , string(blifLine[1]).c_str()
                               , blifFile.c_str()
                               , tokenize.lineno()
                               ) << endl;
           //blifModel->mergeAlias( blifLine[1], "vdd" );
-          blifModel->getCell()->getNet( blifModel->getPowerName() )->addAlias( blifLine[1] );
+          blifModel->getCell()->getNet( blifModel->getPowerName() )->addAlias( tokenize.intern(blifLine[1]) );
         } else {
           cerr << Error( "Blif::load() Unsupported \".names\" cover construct.\n"
                          "          File \"%s.blif\" at line %u."
@@ -964,20 +1041,20 @@ namespace CRL {
 
       if (tokenize.state() == Tokenize::Subckt or tokenize.state() == Tokenize::Gate) {
         if (blifLine[1] == "$print") continue;
-        Subckt* subckt = blifModel->addSubckt( blifLine[1] );
+        Subckt* subckt = blifModel->addSubckt( string(blifLine[1]) );
         for ( size_t i=2 ; i<blifLine.size() ; ++i ) {
           size_t equal = blifLine[i].find('=');
-          if (equal == string::npos) {
+          if (equal == string_view::npos) {
             cerr << Error( "Blif::load() Bad affectation in \".subckt\": %s.\n"
                           "                    File %s.blif at line %u."
-                         , blifLine[i].c_str()
+                         , string(blifLine[i]).c_str()
                          , blifFile.c_str()
                          , tokenize.lineno()
                          ) << endl;
             continue;
           }
-          subckt->addConnection( make_pair(blifLine[i].substr(0,equal)
-                                          ,blifLine[i].substr(  equal+1)) );
+          subckt->addConnection( tokenize.intern(blifLine[i].substr(0,equal))
+                               , tokenize.intern(blifLine[i].substr(  equal+1)) );
 
         }
       }
@@ -121,6 +121,9 @@ namespace CRL {
               Cell*                    getCell                  ( const string& name
                                                                 , unsigned int  mode
                                                                 , unsigned int  depth=(unsigned int)-1 );
+              size_t                   prefetchCells            ( const vector<string>& names
+                                                                , unsigned int          mode
+                                                                , unsigned int          threads=0 );
               Cell*                    createCell               ( const string& name, AllianceLibrary* library=NULL );
               void                     saveCell                 ( Cell* , unsigned int mode );
               void                     bindLibraries            ();
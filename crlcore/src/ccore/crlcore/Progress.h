@@ -0,0 +1,97 @@
+// -*- C++ -*-
+//
+// This file is part of the Coriolis Software.
+// Copyright (c) Sorbonne Universite 2026-2026, All Rights Reserved
+//
+// +-----------------------------------------------------------------+
+// |                   C O R I O L I S                               |
+// |          Alliance / Hurricane  Interface                        |
+// |                                                                 |
+// |  Author      :                    Jean-Paul Chaput              |
+// |  E-mail      :            Jean-Paul.Chaput@lip6.fr              |
+// | =============================================================== |
+// |  C++ Header  :       "./crlcore/Progress.h"                     |
+// +-----------------------------------------------------------------+
+
+
+#pragma  once
+#include  <cstdint>
+#include  <atomic>
+#include  <string>
+
+
+namespace CRL {
+
+
+// -------------------------------------------------------------------
+// Class  :  "CRL::Progress".
+//
+// Progress report of the long loops (negociation, sweep line, netlist
+// conversion). The counters are relaxed atomics, they may be updated
+// from any thread without locking. The report is throttled on the wall
+// time: tick() reads the clock only once every TickMask+1 calls and a
+// report is emitted at most once per "misc.progressPeriod" (ms). When
+// a thread is already emitting, the others skip it instead of waiting.
+//
+// The first counter is the main one, the rate (per second) is computed
+// on it. The report goes to:
+//
+// * The terminal (cmess2), as one line rewritten in place, only when
+//   tty is enabled (not in log mode).
+// * The "misc.progressFile" sink, if set, one JSON object per line.
+//   It may be a regular file, a named pipe or, with the "unix:" prefix,
+//   the path of an Unix socket. The sink is non-blocking, a report that
+//   cannot be written immediately is dropped.
+
+  class Progress {
+    public:
+      static const size_t    MaxCounters = 8;
+      static const uint64_t  TickMask    = 0x3f;
+    public:
+                            Progress   ( const std::string& label, const std::string& indent="        " );
+                           ~Progress   ();
+             size_t         addCounter ( const std::string& name );
+      inline void           inc        ( size_t icounter, uint64_t delta=1 );
+      inline void           set        ( size_t icounter, uint64_t value );
+      inline uint64_t       get        ( size_t icounter ) const;
+      inline void           tick       ();
+             void           report     ( bool force=false );
+             void           finish     ();
+    private:
+             void           _emit      ( int64_t now );
+             void           _openSink  ( const std::string& );
+    private:
+      std::string            _label;
+      std::string            _indent;
+      size_t                 _size;
+      std::string            _names    [MaxCounters];
+      std::atomic<uint64_t>  _values   [MaxCounters];
+      std::atomic<uint64_t>  _ticks;
+      std::atomic<int64_t>   _lastReport;
+      std::atomic_flag       _emitting;
+      int64_t                _start;
+      int64_t                _period;
+      uint64_t               _lastValue;
+      int                    _sink;
+      bool                   _socket;
+      bool                   _printed;
+    private:
+                 Progress  ( const Progress& );
+      Progress&  operator= ( const Progress& );
+  };
+
+
+  inline void  Progress::inc ( size_t icounter, uint64_t delta )
+  { _values[icounter].fetch_add( delta, std::memory_order_relaxed ); }
+
+  inline void  Progress::set ( size_t icounter, uint64_t value )
+  { _values[icounter].store( value, std::memory_order_relaxed ); }
+
+  inline uint64_t  Progress::get ( size_t icounter ) const
+  { return _values[icounter].load( std::memory_order_relaxed ); }
+
+  inline void  Progress::tick ()
+  { if ((_ticks.fetch_add(1,std::memory_order_relaxed) & TickMask) == 0) report(); }
+
+
+}  // CRL namespace.
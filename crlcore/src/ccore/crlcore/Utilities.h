@@ -19,6 +19,7 @@
 #include <cstdio>
 #include <ostream>
 #include <iostream>
+#include <map>
 #include <string>
 #include "hurricane/utilities/Path.h"
 #include "hurricane/Commons.h"
@@ -70,6 +71,11 @@ namespace CRL {
 // Class  :  "CRL::IoFile ()".
 //
 // Class wrapper for the C FILE* stream.
+//
+// The contents of a file can be staged in memory beforehand (see
+// AllianceFramework::prefetchCells()). The next open() in read mode
+// of that path is then served from memory, through fmemopen(). The
+// contents are moved into the IoFile and released with it.
 
 
   class IoFile {
@@ -85,6 +91,10 @@ namespace CRL {
              bool    open          ( const string& mode );
              void    close         ();
       inline void    rewind        ();
+    // Staged contents.
+      static void    stage         ( const string& path, string&& contents );
+      static size_t  getStagedCount();
+      static void    clearStaged   ();
     // Hurricane management.
       inline string  _getTypeName  () const;
              string  _getString    () const;
@@ -97,6 +107,8 @@ namespace CRL {
              string  _mode;
              size_t  _lineNumber;
              bool    _eof;
+             string  _contents;
+      static std::map<string,string>  _staged;
 
     // Internal - Constructor.
                      IoFile       ( const IoFile& );
@@ -121,7 +133,8 @@ namespace CRL {
                                                        , _path(path)
                                                        , _mode("")
                                                        , _lineNumber(0)
-                                                       , _eof(false) {}
+                                                       , _eof(false)
+                                                       , _contents() {}
   inline bool    IoFile::isOpen         () const { return _file!=NULL; }
   inline bool    IoFile::eof            () const { return _eof; }
   inline FILE*   IoFile::getFile        () { return _file; }
@@ -16,7 +16,9 @@
 
 #include <ctime>
 #include <cstdio>
+#include <cstring>
 #include <string>
+#include <string_view>
 #include <bitset>
 #include <sstream>
 #include <fstream>
@@ -24,6 +26,10 @@
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 using namespace std;
 
 #include "hurricane/configuration/Configuration.h"
@@ -58,6 +64,113 @@ using namespace CRL;
 namespace {
 
 
+// -------------------------------------------------------------------
+// Class  :  "::GdsBuffer".
+//
+// Read only image of a whole GDSII file. The file is memory mapped
+// when possible, otherwise (pipes, some network file systems) it is
+// read in one go. Records are decoded straight from that memory, the
+// GdsRecord keeping pointers inside it (strings), so the GdsBuffer
+// must outlive the records it has produced.
+
+  class GdsBuffer {
+    public:
+                                   GdsBuffer   ();
+                                  ~GdsBuffer   ();
+                   bool            open        ( const string& path );
+                   void            close       ();
+      inline       bool            isOpen      () const;
+      inline       size_t          getSize     () const;
+      inline       size_t          getOffset   () const;
+      inline const uint8_t*        consume     ( size_t );
+    private:
+      const uint8_t*   _data;
+            size_t     _size;
+            size_t     _offset;
+            bool       _mapped;
+            bool       _opened;
+      vector<uint8_t>  _copy;
+    private:
+                   GdsBuffer   ( const GdsBuffer& );
+      GdsBuffer&   operator=   ( const GdsBuffer& );
+  };
+
+
+  inline bool    GdsBuffer::isOpen    () const { return _opened; }
+  inline size_t  GdsBuffer::getSize   () const { return _size; }
+  inline size_t  GdsBuffer::getOffset () const { return _offset; }
+
+
+// Returns the next "size" bytes, or NULL if the file is too short.
+  inline const uint8_t* GdsBuffer::consume ( size_t size )
+  {
+    if (size > _size - _offset) { _offset = _size; return NULL; }
+    const uint8_t* data = _data + _offset;
+    _offset += size;
+    return data;
+  }
+
+
+  GdsBuffer::GdsBuffer ()
+    : _data  (NULL)
+    , _size  (0)
+    , _offset(0)
+    , _mapped(false)
+    , _opened(false)
+    , _copy  ()
+  { }
+
+
+  GdsBuffer::~GdsBuffer ()
+  { close(); }
+
+
+  bool  GdsBuffer::open ( const string& path )
+  {
+    close();
+
+    int fd = ::open( path.c_str(), O_RDONLY );
+    if (fd < 0) return false;
+
+    struct stat infos;
+    if ((::fstat(fd,&infos) == 0) and S_ISREG(infos.st_mode) and (infos.st_size > 0)) {
+      void* data = ::mmap( NULL, infos.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+      if (data != MAP_FAILED) {
+        ::madvise( data, infos.st_size, MADV_SEQUENTIAL );
+        _data   = (const uint8_t*)data;
+        _size   = infos.st_size;
+        _mapped = true;
+      }
+    }
+
+    if (not _mapped) {
+      uint8_t chunk [ 1<<16 ];
+      ssize_t count = 0;
+      while ( (count = ::read(fd,chunk,sizeof(chunk))) > 0 )
+        _copy.insert( _copy.end(), chunk, chunk+count );
+      _data = _copy.data();
+      _size = _copy.size();
+    }
+
+    ::close( fd );
+    _opened = true;
+    return true;
+  }
+
+
+  void  GdsBuffer::close ()
+  {
+    if (_mapped) ::munmap( (void*)_data, _size );
+    _copy.clear();
+    _copy.shrink_to_fit();
+    _data   = NULL;
+    _size   = 0;
+    _offset = 0;
+    _mapped = false;
+    _opened = false;
+  }
+
+
 // -------------------------------------------------------------------
 // Class  :  "::GdsRecord".
 
@@ -130,6 +243,8 @@ namespace {
       static const uint16_t  LIBDIRSIZE      = 0x3900 | TwoByteInteger;
       static const uint16_t  SRFNAME         = 0x3a00 | String;
       static const uint16_t  LIBSECUR        = 0x3b00 | TwoByteInteger;
+    // Not a GDSII record, end of file or truncated record.
+      static const uint16_t  ENDOFSTREAM     = 0xffff;
     public:
                                      GdsRecord      ();
       inline       bool              isHEADER       () const;   
@@ -198,8 +313,10 @@ namespace {
       inline const vector<int32_t >& getInt32s      () const;
       inline const vector<double  >& getDoubles     () const;
       inline       string            getName        () const;
+      inline       string_view       getNameView    () const;
+      inline       bool              isValid        () const;
                    void              clear          ();
-                   void              read           ( istream* );
+                   void              read           ( GdsBuffer* );
                    void              readDummy      ( bool showError );
                    void              readStrans     ();
                    void              readString     ();
@@ -216,17 +333,18 @@ namespace {
       static       string            toStrType      ( uint16_t );
                    GdsRecord&        operator=      ( const GdsRecord& );
     private:
-      template< typename IntType> IntType  _readInt    ();
-                                  string   _readString ();
-                                  double   _readDouble ();
+      template< typename IntType> IntType      _readInt    ();
+                                  string_view  _readString ();
+                                  double       _readDouble ();
     private:
-      istream*          _stream;
-      uint32_t          _offset;
+      const uint8_t*    _data;
+      size_t            _offset;
       uint16_t          _length;
       uint16_t          _count;
       uint16_t          _type;
       bool              _xReflection;
-      string            _name;
+      bool              _valid;
+      string_view       _name;
       vector<uint16_t>  _masks;
       vector<int16_t>   _int16s;
       vector<int32_t>   _int32s;
@@ -300,16 +418,19 @@ namespace {
   inline const vector<int16_t >& GdsRecord::getInt16s      () const { return _int16s; }
   inline const vector<int32_t >& GdsRecord::getInt32s      () const { return _int32s; }
   inline const vector<double  >& GdsRecord::getDoubles     () const { return _doubles; }
-  inline       string            GdsRecord::getName        () const { return _name; }
+  inline       string            GdsRecord::getName        () const { return string( _name ); }
+  inline       string_view       GdsRecord::getNameView    () const { return _name; }
+  inline       bool              GdsRecord::isValid        () const { return _valid; }
 
 
   GdsRecord::GdsRecord ()
-    : _stream     (NULL)
+    : _data       (NULL)
     , _offset     (0)
     , _length     (0)
     , _count      (0)
     , _type       (0)
     , _xReflection(false)
+    , _valid      (true)
     , _name       ()
     , _masks      ()
     , _int16s     ()
@@ -319,12 +440,13 @@ namespace {
 
 
   void  GdsRecord::clear ()
-  { _stream      = NULL;
+  { _data        = NULL;
     _length      = 0;
     _count       = 0;
     _type        = 0;
     _xReflection = false;
-    _name   .clear();
+    _valid       = true;
+    _name        = string_view();
     _masks  .clear();
     _int16s .clear();
     _int32s .clear();
@@ -332,13 +454,31 @@ namespace {
   }
 
 
-  void  GdsRecord::read ( istream* stream )
+// The record (header & data) is taken as a whole from the buffer, the
+// fields are then decoded in place.
+  void  GdsRecord::read ( GdsBuffer* buffer )
   {
     clear();
 
-    _stream = stream;
-    _length = _readInt<uint16_t>();
-    _type   = _readInt<uint16_t>();
+    _offset = buffer->getOffset();
+    const uint8_t* header = buffer->consume( 4 );
+    if (header) {
+      _data   = header;
+      _length = 4;
+      _length = _readInt<uint16_t>();
+      _type   = _readInt<uint16_t>();
+      if ((_length < 4) or not buffer->consume(_length-4)) header = NULL;
+    }
+    if (not header) {
+      if (_offset < buffer->getSize())
+        cerr << Error( "GdsRecord::read(): Truncated or corrupted record at offset %s."
+                     , getString(_offset).c_str() ) << endl;
+      _data   = NULL;
+      _length = 0;
+      _count  = 0;
+      _type   = ENDOFSTREAM;
+      return;
+    }
 
     switch ( _type ) {
       case HEADER:       readDummy( false ); break;
@@ -401,21 +541,35 @@ namespace {
       case LIBSECUR:     readDummy( false ); break;
     }
 
+    if (not _valid) {
+      cerr << Error( "GdsRecord::read(): Record %s too short (%s bytes) at offset %s."
+                   , toStrType(_type).c_str()
+                   , getString(_length).c_str()
+                   , getString(_offset).c_str() ) << endl;
+      _data   = NULL;
+      _length = 0;
+      _count  = 0;
+      _type   = ENDOFSTREAM;
+      return;
+    }
+
     ostringstream s;
     s << " (0x" << std::setfill('0') << std::setw(4) << std::hex << _type << ")";
     cdebug_log(101,0) << "GdsRecord::read() " << toStrType(_type)
                       << s.str()
                       << " _bytes:"  <<  _length
-                      << " (offset:" << (_offset-4) << ")"
+                      << " (offset:" << _offset << ")"
                       << endl;
   }
 
 
   GdsRecord& GdsRecord::operator= ( const GdsRecord& other )
   {
+    _data     = other._data;
     _length   = other._length;
     _count    = other._count;
     _type     = other._type;
+    _valid    = other._valid;
     _name     = other._name;
     _masks    = other._masks;
     _int16s   = other._int16s;
@@ -425,6 +579,8 @@ namespace {
   }
 
 
+// GDSII is big endian. Reading past the record length marks it invalid
+// (the bytes would belong to the next record or be beyond the buffer).
   template< typename IntType>
   IntType  GdsRecord::_readInt ()
   {
@@ -435,15 +591,14 @@ namespace {
         unsigned char bytes[ typeSize ];
     };
 
-    unsigned char bytes[typeSize];
-    _stream->read( (char*)(&bytes[0]), typeSize );
-    _count  += typeSize;
+    if (_count + typeSize > _length) {
+      _valid = false;
+      _count = _length;
+      return 0;
+    }
 
-    // cdebug_log(101,0) << "GdsRecord::_readInt() " << endl;
-    // for ( size_t i=0 ; i<typeSize ; ++i ) {
-    //   sprintf( _buffer, "0x%02x", bytes[i] );
-    //   cdebug(101,0) << setw(6) << hex << _offset++ << " | " << _buffer << endl; 
-    // }
+    const uint8_t* bytes = _data + _count;
+    _count  += typeSize;
 
     UType uvalue;
   // Little endian (x86).
@@ -460,15 +615,14 @@ namespace {
         unsigned char bytes[8];
     };
 
-    char bytes[8];
-    _stream->read( bytes, 8 );
-    _count += 8;
+    if (_count + 8 > _length) {
+      _valid = false;
+      _count = _length;
+      return 0.0;
+    }
 
-    // cdebug_log(101,0) << "GdsRecord::_readDouble() " << endl;
-    // for ( size_t i=0 ; i<8 ; ++i ) {
-    //   sprintf( _buffer, "0x%02x", bytes[i] );
-    //   cdebug(101,0) << setw(6) << hex << _offset++ << " | " << _buffer << endl; 
-    // }
+    const uint8_t* bytes = _data + _count;
+    _count += 8;
 
     gdsUInt64 mantisse;
     for ( size_t i=0 ; i<7 ; ++i ) mantisse.bytes[i] = bytes[7-i];
@@ -484,32 +638,30 @@ namespace {
   }
 
 
-  string  GdsRecord::_readString ()
+// The string is *not* copied, it points into the GdsBuffer. Strings are
+// padded by NULs to an even length, which are removed.
+  string_view  GdsRecord::_readString ()
   {
-    cdebug_log(101,0) << "GdsRecord::_readDouble() " << endl;
-    string s;
-    char c;
-    for ( ; _count<_length ; ++_count ) {
-      _stream->get( c );
-      // sprintf( _buffer, "0x%02x", c );
-      // cdebug_log(101,0) << setw(6) << hex << _offset++ << " | " << _buffer << endl; 
-
-      if (c != (char)0) s.push_back(c);
-    }
-    cdebug_log(101,0) << "GdsRecord::_readString(): \"" << s << "\"" << endl;
-    return s;
+    const char* s      = (const char*)(_data + _count);
+    size_t      length = _length - _count;
+    _count = _length;
+
+    while ( length and (s[length-1] == (char)0) ) --length;
+    cdebug_log(101,0) << "GdsRecord::_readString(): \"" << string(s,length) << "\"" << endl;
+    return string_view( s, length );
   }
 
 
   void  GdsRecord::readDummy ( bool showError )
   {
     cdebug_log(101,0) << "GdsRecord::readDummy() " << endl;
-    char c;
-    for ( ; _count<_length ; ++_count ) {
-      _stream->get( c );   
-      sprintf( _buffer, "0x%02x", c );
-      cdebug_log(101,0) << tsetw(6) << hex << _offset++ << " | " << _buffer << endl; 
+    if (cdebug.enabled(101)) {
+      for ( size_t offset=_offset+_count ; _count<_length ; ++_count, ++offset ) {
+        sprintf( _buffer, "0x%02x", _data[_count] );
+        cdebug_log(101,0) << tsetw(6) << hex << offset << " | " << _buffer << endl; 
+      }
     }
+    _count = _length;
     if (showError) {
       cdebug_log(101,0) << Error( "GdsRecord type %s unsupported.", toStrType(_type).c_str() ) << endl;
     }
@@ -572,13 +724,22 @@ namespace {
   }
 
 
+// Coordinates are decoded in bulk, the byte swap loop is simple enough
+// to be vectorized by the compiler.
   void  GdsRecord::readXy ()
-  { while ( _count < _length ) _int32s.push_back( _readInt<int32_t>() ); }
+  {
+    size_t count = (_length - _count) / sizeof(uint32_t);
+    _int32s.resize( count );
+    memcpy( _int32s.data(), _data+_count, count*sizeof(uint32_t) );
+    _count += count * sizeof(uint32_t);
+    for ( int32_t& value : _int32s ) value = (int32_t)__builtin_bswap32( (uint32_t)value );
+  }
 
 
   string  GdsRecord::toStrType ( uint16_t type )
   {
     switch ( type ) {
+      case ENDOFSTREAM: return "ENDOFSTREAM";
       case HEADER:      return "HEADER";
       case BGNLIB:      return "BGNLIB";
       case LIBNAME:     return "LIBNAME";
@@ -645,8 +806,8 @@ namespace {
   }
 
 
-  istream& operator>> ( istream& stream, GdsRecord& record )
-  { record.read( &stream ); return stream; }
+  GdsBuffer& operator>> ( GdsBuffer& buffer, GdsRecord& record )
+  { record.read( &buffer ); return buffer; }
 
 
 // -------------------------------------------------------------------
@@ -710,7 +871,7 @@ namespace {
              vector<Cell*>               _cells;
              uint32_t                    _flags;
              string                      _gdsPath;
-             ifstream                    _stream;
+             GdsBuffer                   _stream;
              GdsRecord                   _record;
              double                      _angle;
              bool                        _xReflection;
@@ -793,8 +954,7 @@ namespace {
   {
     if (_gdsLayerTable.empty()) _staticInit();
     
-    _stream.open( gdsPath, ios_base::in|ios_base::binary );
-    if (not _stream.is_open()) {
+    if (not _stream.open(gdsPath)) {
       cerr << Error( "GdsStream::GdsStream(): Unable to open stream, check path.\n"
                      "        \"%s\""
                    , _gdsPath.c_str() ) << endl;
@@ -949,9 +1109,9 @@ namespace {
     cdebug_log(101,1) << "GdsStream::readStructure()" << endl;
     
     if (_record.isSTRNAME()) {
-      cdebug_log(101,0) << "name " << _record.getName() << endl;
+      cdebug_log(101,0) << "name " << _record.getNameView() << endl;
       if (_library) {
-        string cellName = _record.getName();
+        string cellName ( _record.getNameView() );
         if (isLefForeign()) cellName += "_lef_foreign";
         _cell = getCell( cellName, true );
         _stream >> _record;
@@ -1105,7 +1265,7 @@ namespace {
 
     if (_record.isXY()) {
       cdebug_log(101,0) << "Current record is XY" << endl;
-      vector<int32_t> coordinates = _record.getInt32s();
+      const vector<int32_t>& coordinates = _record.getInt32s();
       if (coordinates.size() != 2) {
         _validSyntax = false;
         cdebug_tabw(101,-1);
@@ -1121,7 +1281,7 @@ namespace {
     }
 
     if (_record.isSTRING()) {
-      _text = _record.getName();
+      _text.assign( _record.getNameView() );
       _stream >> _record;
       if (not layer) {
         cerr << Error( "GdsStream::readTextbody(): Discarted text is \"%s\"."
@@ -1207,7 +1367,7 @@ namespace {
         _stream >> _record;
       }
     } else {
-      cdebug_log(101,0) << "Unsupported RECORD type " << _record.getName() << endl;
+      cdebug_log(101,0) << "Unsupported RECORD type " << _record.getNameView() << endl;
       _validSyntax = false;
       cdebug_tabw(101,-1);
       return _validSyntax;
@@ -1281,7 +1441,7 @@ namespace {
     if (_record.isPLEX   ()) { _stream >> _record; }
 
     if (_record.isSNAME()) {
-      masterName = _record.getName();
+      masterName.assign( _record.getNameView() );
       if (isLefForeign()) masterName += "_lef_foreign";
       _stream >> _record;
     } else {
@@ -1380,7 +1540,7 @@ namespace {
     if (_record.isPLEX   ()) { _stream >> _record; }
 
     if (_record.isSNAME()) {
-      masterName = _record.getName();
+      masterName.assign( _record.getNameView() );
       cdebug_log(101,0) << "SNAME " << masterName << endl;
       _stream >> _record;
     } else {
@@ -1438,7 +1598,7 @@ namespace {
     if (_record.isXY()) {
       if (_cell) {
         DbU::Unit       oneGrid = DbU::fromGrid( 1 );
-        const vector<int32_t> coordinates = _record.getInt32s();
+        const vector<int32_t>& coordinates = _record.getInt32s();
         if (coordinates.size() != 6) {
           _validSyntax = false;
           cdebug_tabw(101,-1);
@@ -1599,7 +1759,7 @@ namespace {
     DbU::Unit oneGrid = DbU::fromGrid( 1 );
     
     vector<Point>   points;
-    vector<int32_t> coordinates = _record.getInt32s();
+    const vector<int32_t>& coordinates = _record.getInt32s();
     vector<size_t>  offgrids;
     for ( size_t i=0 ; i<coordinates.size() ; i += 2 ) {
       points.push_back( Point( coordinates[i  ]*_scale
@@ -1680,7 +1840,7 @@ namespace {
     DbU::Unit oneGrid = DbU::fromGrid( 1 );
     
     vector<Point>   points;
-    vector<int32_t> coordinates = _record.getInt32s();
+    const vector<int32_t>& coordinates = _record.getInt32s();
     vector<size_t>  offgrids;
     bool            isRectilinear = true;
     for ( size_t i=0 ; i<coordinates.size() ; i += 2 ) {
@@ -1808,7 +1968,7 @@ namespace {
     }
 
     vector<Point>   points;
-    vector<int32_t> coordinates = _record.getInt32s();
+    const vector<int32_t>& coordinates = _record.getInt32s();
     for ( size_t i=0 ; i<coordinates.size() ; i += 2 )
       points.push_back( Point( coordinates[i  ]*_scale
                              , coordinates[i+1]*_scale ) );
@@ -2115,7 +2275,8 @@ namespace CRL {
 
     GdsStream gstream ( gdsPath, flags );
 
-    if (not gstream.read( library ))
+    bool      status  = gstream.read( library );
+    if (not status)
       cerr << Error( "Gds::load(): An error occurred while reading GDSII stream\n"
                      "        \"%s\"."
                    , gdsPath.c_str()
@@ -2127,7 +2288,7 @@ namespace CRL {
     // if (library->getName() == "working")
     //   DebugSession::close();
 
-    return true;
+    return status;
   }
 
 
@@ -49,7 +49,7 @@ namespace CRL {
 
   const Name& NetExtension::getPort ( const Net* net )
   {
-    Extension* extension = Extension::get ( net );
+    Extension* extension = net->getProperty<Extension>();
     if ( !extension )
       return Name::emptyName();
 
@@ -59,7 +59,7 @@ namespace CRL {
 
   const PortSet* NetExtension::getPorts ( const Net* net )
   {
-    Extension* extension = Extension::get ( net );
+    Extension* extension = net->getProperty<Extension>();
     if ( !extension )
       return NULL;
 
@@ -69,7 +69,7 @@ namespace CRL {
 
   const Net* NetExtension::getNetByPort ( const Cell* cell, const Name& port )
   {
-    Extension* extension = Extension::get ( cell );
+    Extension* extension = cell->getProperty<Extension>();
     if ( !extension )
       return NULL;
 
@@ -93,7 +93,7 @@ namespace CRL {
 
   NetExtension::Extension* NetExtension::_getOrCreate ( Net* net )
   {
-    Extension* extension = Extension::get ( net );
+    Extension* extension = net->getProperty<Extension>();
     if ( !extension ) {
       extension = Extension::create ();
       net->put ( extension );
@@ -623,6 +623,47 @@ extern "C" {
     return Py_BuildValue( "I", count );
   }
 
+
+  static PyObject* PyAllianceFramework_prefetchCells ( PyAllianceFramework* self, PyObject* args )
+  {
+    cdebug_log(30,0) << "PyAllianceFramework_prefetchCells()" << endl;
+
+    size_t count = 0;
+
+    HTRY
+    METHOD_HEAD("AllianceFramework.prefetchCells()")
+
+    PyObject*    pyNames = NULL;
+    unsigned int mode    = 0;
+    unsigned int threads = 0;
+    if (not PyArg_ParseTuple( args, "OI|I:AllianceFramework.prefetchCells", &pyNames, &mode, &threads )) {
+      PyErr_SetString( ConstructorError, "Invalid number of parameters for AllianceFramework.prefetchCells()." );
+      return NULL;
+    }
+
+    vector<string> names;
+    if (pyNames != Py_None) {
+      if (not PyList_Check(pyNames)) {
+        PyErr_SetString( ConstructorError, "AllianceFramework.prefetchCells(): First argument must be a list of names or None." );
+        return NULL;
+      }
+      for ( Py_ssize_t i=0 ; i<PyList_Size(pyNames) ; ++i ) {
+        PyObject* pyName = PyList_GetItem( pyNames, i );
+        if (not PyUnicode_Check(pyName)) {
+          PyErr_SetString( ConstructorError, "AllianceFramework.prefetchCells(): Cell names must be strings." );
+          return NULL;
+        }
+        names.push_back( PyString_AsString(pyName) );
+      }
+    }
+    count = af->prefetchCells( names, mode, threads );
+
+    HCATCH
+
+    return Py_BuildValue( "n", (Py_ssize_t)count );
+  }
+
+
   
   // Standart Accessors (Attributes).
 
@@ -660,6 +701,8 @@ extern "C" {
                                , "Wrap an Alliance Library around an existing Hurricane Library." }
     , { "loadLibraryCells"     , (PyCFunction)PyAllianceFramework_loadLibraryCells     , METH_VARARGS
                                , "Load in memory all Cells from an Alliance Library." }                           
+    , { "prefetchCells"        , (PyCFunction)PyAllianceFramework_prefetchCells        , METH_VARARGS
+                               , "Read the Cells files in parallel, then load them (all the Catalog if None)." }
     , { "isPad"                , (PyCFunction)PyAllianceFramework_isPad                , METH_VARARGS
                                , "Tells if a cell name is a Pad." }
     , { "isRegister"           , (PyCFunction)PyAllianceFramework_isRegister           , METH_VARARGS
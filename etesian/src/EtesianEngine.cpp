@@ -44,6 +44,7 @@
 #include "crlcore/Utilities.h"
 #include "crlcore/Measures.h"
 #include "crlcore/Histogram.h"
+#include "crlcore/Progress.h"
 #include "crlcore/AllianceFramework.h"
 #include "etesian/EtesianEngine.h"
 
@@ -270,6 +271,7 @@ namespace Etesian {
   using CRL::AllianceFramework;
   using CRL::Catalog;
   using CRL::addMeasure;
+  using CRL::Progress;
   using CRL::Measures;
   using CRL::MeasuresSet;
   using CRL::CatalogExtension;
@@ -727,8 +729,10 @@ namespace Etesian {
     DbU::Unit usedLength     = 0;
     DbU::Unit registerLength = 0;
 
-    Dots  dots ( cmess2, "       ", 80, 1000 );
-    if (not cmess2.enabled()) dots.disable();
+    Progress  progress  ( "toColoquinte", "       " );
+    size_t    items     = progress.addCounter( "items" );
+    size_t    instances = progress.addCounter( "instances" );
+    size_t    nets      = progress.addCounter( "nets" );
     
     size_t  instancesNb = 0;
     size_t  fixedNb     = 0;
@@ -840,7 +844,7 @@ namespace Etesian {
     cmess1 << "     - Building RoutingPads (transhierarchical)" << endl;
   //getCell()->flattenNets( Cell::Flags::BuildRings|Cell::Flags::NoClockFlatten );
   //getCell()->flattenNets( getBlockInstance(), Cell::Flags::NoClockFlatten );
-    getCell()->flattenNets( NULL, _excludedNets, Cell::Flags::NoClockFlatten );
+    getCell()->flattenNets( NULL, _excludedNets, Cell::Flags::NoClockFlatten|Cell::Flags::ParallelFlatten, getNbThreads() );
 
     int instanceId       = 0;
     if (getBlockInstance()) {
@@ -867,7 +871,9 @@ namespace Etesian {
             _instsToIds.insert( make_pair(instance,instanceId) );
             _idsToInsts.push_back( make_tuple(instance,vector<RoutingPad*>()) );
             ++instanceId;
-            dots.dot();
+            progress.inc( items );
+            progress.inc( instances );
+            progress.tick();
           }
         }
       }
@@ -927,7 +933,9 @@ namespace Etesian {
       _instsToIds.insert( make_pair(instance,instanceId) );
       _idsToInsts.push_back( make_tuple(instance,vector<RoutingPad*>()) );
       ++instanceId;
-      dots.dot();
+      progress.inc( items );
+      progress.inc( instances );
+      progress.tick();
     }
 
     if (instanceId != (int) instancesNb) {
@@ -945,8 +953,6 @@ namespace Etesian {
     cellIsFixed[instanceId] = true;
     cellIsObstruction[instanceId] = true;
 
-    dots.finish( Dots::Reset|Dots::FirstDot );
-
     size_t netsNb = 0;
     for ( Net* net : getCell()->getNets() )
     {
@@ -985,7 +991,9 @@ namespace Etesian {
       if (excludedType) continue;
       if (af->isBLOCKAGE(net->getName())) continue;
 
-      dots.dot();
+      progress.inc( items );
+      progress.inc( nets );
+      progress.tick();
       
       string topCellInstancePin = getString(getCell()->getName()) + ":C";
       vector<int> netCells, pinX, pinY;
@@ -1043,7 +1051,7 @@ namespace Etesian {
       }
       _circuit->addNet(netCells, pinX, pinY);
     }
-    dots.finish( Dots::Reset );
+    progress.finish();
 
     cmess1 << "     - Standard cells widths:" << endl;
     cmess2 << stdCellSizes.toString(0) << endl;
@@ -1125,6 +1133,7 @@ namespace Etesian {
   void  EtesianEngine::globalPlace ()
   {
     coloquinte::ColoquinteParameters params(getPlaceEffort());
+    params.global.nbThreads = getNbThreads();
     coloquinte::PlacementCallback callback =std::bind(&EtesianEngine::_coloquinteCallback, this, std::placeholders::_1);
     _circuit->placeGlobal(params, callback);
     *_placementUB = _circuit->solution();
@@ -1209,6 +1218,8 @@ namespace Etesian {
         instance->setPlacementStatus( Instance::PlacementStatus::PLACED );
     }
     UpdateSession::close();
+    cmess2 << "     - Final update session: " << UpdateSession::getLastInvalidations()
+           << " invalidated objects." << endl;
   }
 
 
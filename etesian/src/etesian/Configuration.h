@@ -73,6 +73,7 @@ namespace Etesian {
       inline DbU::Unit        getLatchUpDistance        () const;
       inline DbU::Unit        getAntennaGateMaxWL       () const;
       inline DbU::Unit        getAntennaDiodeMaxWL      () const;
+      inline unsigned int     getNbThreads              () const;
       inline void             setSpaceMargin            ( double );
       inline void             setDensityVariation       ( double );
       inline void             setAspectRatio            ( double );
@@ -99,6 +100,7 @@ namespace Etesian {
       DbU::Unit      _latchUpDistance;
       DbU::Unit      _antennaGateMaxWL;
       DbU::Unit      _antennaDiodeMaxWL;
+      unsigned int   _nbThreads;
     private:
                              Configuration ( const Configuration& );
       Configuration& operator=             ( const Configuration& );
@@ -122,6 +124,7 @@ namespace Etesian {
   inline DbU::Unit     Configuration::getLatchUpDistance        () const { return _latchUpDistance; }
   inline DbU::Unit     Configuration::getAntennaGateMaxWL       () const { return _antennaGateMaxWL; }
   inline DbU::Unit     Configuration::getAntennaDiodeMaxWL      () const { return _antennaDiodeMaxWL; }
+  inline unsigned int  Configuration::getNbThreads              () const { return _nbThreads; }
   inline void          Configuration::setSpaceMargin            ( double margin ) { _spaceMargin = margin; }
   inline void          Configuration::setDensityVariation       ( double margin ) { _densityVariation = margin; }
   inline void          Configuration::setAspectRatio            ( double ratio  ) { _aspectRatio = ratio; }
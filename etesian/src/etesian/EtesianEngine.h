@@ -99,6 +99,7 @@ namespace Etesian {
       inline  DbU::Unit               getAntennaGateMaxWL       () const;
       inline  DbU::Unit               getAntennaDiodeMaxWL      () const;
       inline  DbU::Unit               getLatchUpDistance        () const;
+      inline  unsigned int            getNbThreads              () const;
       inline  const FeedCells&        getFeedCells              () const;
       inline  const BufferCells&      getBufferCells            () const;
       inline  Cell*                   getDiodeCell              () const;
@@ -220,6 +221,7 @@ namespace Etesian {
   inline  DbU::Unit              EtesianEngine::getAntennaGateMaxWL       () const { return getConfiguration()->getAntennaGateMaxWL(); }
   inline  DbU::Unit              EtesianEngine::getAntennaDiodeMaxWL      () const { return getConfiguration()->getAntennaDiodeMaxWL(); }
   inline  DbU::Unit              EtesianEngine::getLatchUpDistance        () const { return getConfiguration()->getLatchUpDistance(); }
+  inline  unsigned int           EtesianEngine::getNbThreads              () const { return getConfiguration()->getNbThreads(); }
   inline  void                   EtesianEngine::useFeed                   ( Cell* cell ) { _feedCells.useFeed(cell); }
   inline  const FeedCells&       EtesianEngine::getFeedCells              () const { return _feedCells; }
   inline  const BufferCells&     EtesianEngine::getBufferCells            () const { return _bufferCells; }
@@ -19,6 +19,9 @@
 
 //#define  TEST_INTRUSIVESET
 
+#include <atomic>
+#include <mutex>
+#include <thread>
 #include "hurricane/DebugSession.h"
 #include "hurricane/Warning.h"
 #include "hurricane/SharedName.h"
@@ -602,6 +605,26 @@ Box Cell::getBoundingBox() const
     return _boundingBox;
 }
 
+size_t Cell::getSharedPathCount() const
+// ************************************
+// The SharedPathes owned by this Cell, that is, whose head Instance belongs to it.
+{
+    size_t count = 0;
+    for ( Instance* instance : getInstances() ) count += instance->_getSharedPathes().size();
+    return count;
+}
+
+size_t Cell::getSharedPathMemorySize() const
+// *****************************************
+{
+    size_t size = 0;
+    for ( Instance* instance : getInstances() ) {
+      for ( SharedPath* sharedPath : instance->_getSharedPathes() )
+        size += sharedPath->_getMemorySize();
+    }
+    return size;
+}
+
 bool Cell::isCalledBy ( Cell* cell ) const
 {
   for ( Instance* instance : cell->getInstances() ) {
@@ -819,8 +842,77 @@ void Cell::flattenNets ( const Instance* instance, uint64_t flags )
   flattenNets( instance, excludeds, flags );
 }
 
-void Cell::flattenNets ( const Instance* instance, const std::set<string>& excludeds, uint64_t flags )
-// ***************************************************************************************************
+namespace {
+
+// Parallel flattening (Flags::ParallelFlatten). The HyperNets are
+// walked by a pool of threads (at most the requested count, capped by
+// the hardware concurrency), each one picking the next HyperNet to
+// process and storing it's terminal plug occurrences. The walks only
+// read the netlist, the SharedPathes they create are serialized by
+// the SharedPath table lock. The DeepNets & RoutingPads are created
+// afterwards, sequentially and in the same order as in the serial
+// mode, under the UpdateSession of Cell::flattenNets().
+
+  struct HyperNetWalk {
+    bool                _needRoutingPads;
+    vector<Occurrence>  _plugOccurrences;
+  };
+
+
+  void  walkHyperNets ( const Cell*             cell
+                      , vector<HyperNet>&       hyperNets
+                      , vector<HyperNet>&       topHyperNets
+                      , vector<HyperNetWalk>&   walks
+                      , unsigned int            maxThreads )
+  {
+    size_t               deepCount = hyperNets.size();
+    size_t               count     = deepCount + topHyperNets.size();
+    unsigned int         threads   = std::min( std::max( 1U, maxThreads )
+                                             , std::max( 1U, std::thread::hardware_concurrency() ));
+    std::atomic<size_t>  next      ( 0 );
+    std::mutex           errorLock;
+    string               error;
+
+    walks.resize( count, HyperNetWalk{ true, vector<Occurrence>() } );
+
+    auto worker = [&] () {
+      try {
+        while ( true ) {
+          size_t iwalk = next++;
+          if (iwalk >= count) break;
+
+          HyperNetWalk& walk     = walks[iwalk];
+          HyperNet&     hyperNet = (iwalk < deepCount) ? hyperNets[iwalk] : topHyperNets[iwalk-deepCount];
+          if (iwalk < deepCount) {
+            walk._needRoutingPads = DeepNet::_needRoutingPads( hyperNet, cell );
+            if (not walk._needRoutingPads) continue;
+          }
+          for ( Occurrence plugOccurrence : hyperNet.getTerminalNetlistPlugOccurrences() )
+            walk._plugOccurrences.push_back( plugOccurrence );
+        }
+      }
+      catch ( std::exception& e ) {
+        std::lock_guard<std::mutex> guard ( errorLock );
+        if (error.empty()) error = e.what();
+        next = count;
+      }
+    };
+
+    vector<std::thread> workers;
+    for ( unsigned int i=1 ; i<threads ; ++i ) workers.push_back( std::thread(worker) );
+    worker();
+    for ( std::thread& thread : workers ) thread.join();
+
+    if (not error.empty())
+      throw Error( "Cell::flattenNets(): A HyperNet walk failed.\n%s", error.c_str() );
+  }
+
+
+}  // Anonymous namespace.
+
+
+void Cell::flattenNets ( const Instance* instance, const std::set<string>& excludeds, uint64_t flags, unsigned int threads )
+// ************************************************************************************************************************
 {
   cdebug_log(18,1) << "Cell::flattenNets() flags:0x" << hex << flags << endl;
 
@@ -871,10 +963,19 @@ void Cell::flattenNets ( const Instance* instance, const std::set<string>& exclu
     topHyperNets.push_back( HyperNet(occurrence) );
   }
 
+  bool                  parallel = (flags & Flags::ParallelFlatten);
+  vector<HyperNetWalk>  walks;
+  if (parallel) walkHyperNets( this, hyperNets, topHyperNets, walks, threads );
+
   for ( size_t i=0 ; i<hyperNets.size() ; ++i ) {
     DeepNet* deepNet = DeepNet::create( hyperNets[i] );
     cdebug_log(18,1) << "Flattening hyper net: " << deepNet << endl;
-    if (deepNet) deepNet->_createRoutingPads( flags );
+    if (deepNet) {
+      if (not parallel)
+        deepNet->_createRoutingPads( flags );
+      else if (walks[i]._needRoutingPads)
+        deepNet->_createRoutingPads( walks[i]._plugOccurrences, flags );
+    }
     cdebug_log(18,0) << "Done: " << deepNet << endl;
     cdebug_tabw(18,-1);
   }
@@ -889,8 +990,12 @@ void Cell::flattenNets ( const Instance* instance, const std::set<string>& exclu
     cdebug_log(18,1) << "Flattening top net: " << net << endl;
 
     vector<Occurrence>  plugOccurrences;
-    for ( Occurrence plugOccurrence : topHyperNets[i].getTerminalNetlistPlugOccurrences() )
-      plugOccurrences.push_back( plugOccurrence );
+    if (parallel)
+      plugOccurrences.swap( walks[hyperNets.size()+i]._plugOccurrences );
+    else {
+      for ( Occurrence plugOccurrence : topHyperNets[i].getTerminalNetlistPlugOccurrences() )
+        plugOccurrences.push_back( plugOccurrence );
+    }
 
     for ( Occurrence plugOccurrence : plugOccurrences ) {
       RoutingPad* rp = RoutingPad::create( net, plugOccurrence, rpFlags );
@@ -1134,6 +1239,91 @@ void Cell::materialize()
   cdebug_tabw(18,-1);
 }
 
+// Bulk build: while a netlist is loaded, the Gos are not invalidated
+// one by one (no UpdateSession put, no QuadTree or Slice insertion,
+// no observer notification). They are all materialized at once when
+// the session is closed. The auto-materialization state being global,
+// it is saved by the first opened session and restored by the last
+// closed one. A Cell closed while other sessions are still opened (a
+// master loaded during the parse of it's owner) is materialized all the
+// same, auto-materialization being temporarily enabled.
+
+namespace {
+
+  unsigned int  bulkBuildCount          = 0;
+  bool          bulkAutoMaterialization = false;
+
+}
+
+void Cell::openBulkBuild(size_t nets, size_t instances)
+// ****************************************************
+{
+  if (_flags.isset(Flags::BulkBuild))
+    throw Error( "Cell::openBulkBuild(): %s is already in bulk build.", getString(this).c_str() );
+
+  cdebug_log(18,0) << "Cell::openBulkBuild() " << this << endl;
+
+  _flags |= Flags::BulkBuild;
+  if (not bulkBuildCount++) {
+    bulkAutoMaterialization = not Go::autoMaterializationIsDisabled();
+    Go::disableAutoMaterialization();
+  }
+
+  if (nets     ) reserveNets     ( nets );
+  if (instances) reserveInstances( instances );
+}
+
+void Cell::closeBulkBuild()
+// ************************
+{
+  if (not _flags.isset(Flags::BulkBuild))
+    throw Error( "Cell::closeBulkBuild(): %s is not in bulk build.", getString(this).c_str() );
+
+  cdebug_log(18,1) << "Cell::closeBulkBuild() " << this << endl;
+
+  _flags &= ~Flags::BulkBuild;
+  if (not --bulkBuildCount and bulkAutoMaterialization)
+    Go::enableAutoMaterialization();
+
+// Already materialized objects are skipped, so, even if the Cell was
+// not empty, only the ones created during the session are inserted.
+  bool materializationState = Go::autoMaterializationIsDisabled();
+  Go::enableAutoMaterialization();
+  _flags &= ~Flags::Materialized;
+  materialize();
+  if (materializationState) Go::disableAutoMaterialization();
+  notify( Flags::CellChanged );
+
+  cdebug_tabw(18,-1);
+}
+
+Cell::BulkBuildGuard::BulkBuildGuard(Cell* cell, size_t nets, size_t instances)
+// ****************************************************************************
+  : _cell(cell)
+{
+  _cell->openBulkBuild( nets, instances );
+}
+
+Cell::BulkBuildGuard::~BulkBuildGuard()
+// ************************************
+{
+  if (not _cell) return;
+  try {
+    close();
+  } catch ( const Error& e ) {
+    cerr << e << endl;
+  }
+}
+
+void Cell::BulkBuildGuard::close()
+// *******************************
+{
+  if (not _cell) return;
+  Cell* cell = _cell;
+  _cell = NULL;
+  cell->closeBulkBuild();
+}
+
 void Cell::unmaterialize()
 // ***********************
 {
@@ -1146,6 +1336,25 @@ void Cell::unmaterialize()
   for ( Marker*   marker   : getMarkers()  ) marker  ->unmaterialize();
 }
 
+void Cell::packQuadTrees()
+// ***********************
+// Freeze the instances and slices QuadTrees into packed R-Trees. Any
+// later insertion or removal (i.e. an UpdateSession) silently falls
+// back to the incremental QuadTree of the modified slice.
+{
+  cdebug_log(18,0) << "Cell::packQuadTrees() " << this << endl;
+
+  _quadTree->pack();
+  for ( Slice* slice : getSlices() ) slice->_getQuadTree()->pack();
+}
+
+void Cell::unpackQuadTrees()
+// *************************
+{
+  _quadTree->unpack();
+  for ( Slice* slice : getSlices() ) slice->_getQuadTree()->unpack();
+}
+
 void Cell::slaveAbutmentBox ( Cell* topCell )
 // ******************************************
 {
@@ -1276,6 +1485,8 @@ Record* Cell::_getRecord() const
         record->add( getSlot("_abutmentBox"    , &_abutmentBox     ) );
         record->add( getSlot("_boundingBox"    , &_boundingBox     ) );
         record->add( getSlot("_flags"          , &_flags           ) );
+        record->add( getSlot("_sharedPathCount", getSharedPathCount()      ) );
+        record->add( getSlot("_sharedPathSize" , getSharedPathMemorySize() ) );
     }
     return record;
 }
@@ -1410,6 +1621,7 @@ void Cell::_toJsonCollections(JsonWriter* writer) const
     if (_flags & AbstractedSupply) { if (s.size() > 1) s += "|"; s += "AbstractedSupply"; }
     if (_flags & SlavedAb        ) { if (s.size() > 1) s += "|"; s += "SlavedAb"; }
     if (_flags & Materialized    ) { if (s.size() > 1) s += "|"; s += "Materialized"; }
+    if (_flags & BulkBuild       ) { if (s.size() > 1) s += "|"; s += "BulkBuild"; }
     s += ">";
 
     return s;
@@ -1546,28 +1758,16 @@ Cell::InstanceMap::InstanceMap()
 {
 }
 
-Name Cell::InstanceMap::_getKey(Instance* instance) const
-// ******************************************************
+const Name& Cell::InstanceMap::_getKey(Instance* instance) const
+// *************************************************************
 {
     return instance->getName();
 }
 
-unsigned int  Cell::InstanceMap::_getHashValue(Name name) const
-// *******************************************************
-{
-  return name._getSharedName()->getHash() / 8;
-}
-
-Instance* Cell::InstanceMap::_getNextElement(Instance* instance) const
+unsigned int  Cell::InstanceMap::_getHashValue(const Name& name) const
 // *******************************************************************
 {
-    return instance->_getNextOfCellInstanceMap();
-}
-
-void Cell::InstanceMap::_setNextElement(Instance* instance, Instance* nextInstance) const
-// **************************************************************************************
-{
-    instance->_setNextOfCellInstanceMap(nextInstance);
+  return name._getSharedName()->getHash();
 }
 
 
@@ -1621,33 +1821,7 @@ const Name& Cell::NetMap::_getKey(Net* net) const
 unsigned Cell::NetMap::_getHashValue(const Name& name) const
 // *********************************************************
 {
-  unsigned long hash = 0;
-  unsigned long sum4 = 0;
-  const string& s = name._getSharedName()->_getSString();
-  for ( size_t i=0 ; i<s.size() ; ++i ) {
-    sum4 |= ((unsigned long)s[i]) << ((i%4) * 8);
-    if (i%4 == 3) {
-      hash += sum4;
-      sum4  = 0;
-    }
-  }
-  hash += sum4;
-
-  return hash;
-  
-//return (unsigned int)name._getSharedName()->getId() / 8;
-}
-
-Net* Cell::NetMap::_getNextElement(Net* net) const
-// ***********************************************
-{
-    return net->_getNextOfCellNetMap();
-}
-
-void Cell::NetMap::_setNextElement(Net* net, Net* nextNet) const
-// *************************************************************
-{
-    net->_setNextOfCellNetMap(nextNet);
+  return name._getSharedName()->getHash();
 }
 
 
@@ -1661,28 +1835,16 @@ Cell::PinMap::PinMap()
 {
 }
 
-Name Cell::PinMap::_getKey(Pin* pin) const
-// ***************************************
+const Name& Cell::PinMap::_getKey(Pin* pin) const
+// **********************************************
 {
     return pin->getName();
 }
 
-unsigned Cell::PinMap::_getHashValue(Name name) const
-// **************************************************
-{
-  return (unsigned int)name._getSharedName()->getHash() / 8;
-}
-
-Pin* Cell::PinMap::_getNextElement(Pin* pin) const
-// ***********************************************
-{
-    return pin->_getNextOfCellPinMap();
-}
-
-void Cell::PinMap::_setNextElement(Pin* pin, Pin* nextPin) const
-// *************************************************************
+unsigned Cell::PinMap::_getHashValue(const Name& name) const
+// *********************************************************
 {
-    pin->_setNextOfCellPinMap(nextPin);
+  return name._getSharedName()->getHash();
 }
 
 
@@ -131,7 +131,8 @@ namespace Hurricane {
 
   DBo::DBo ()
     : _id         (getNextId())
-    , _propertySet()
+    , _properties   ()
+    , _propertyNames()
   {
     if (_idCounterLimit and (_id > _idCounterLimit)) {
       throw Error( "DBo::DBo(): Identifier counter has reached user's limit (%d)."
@@ -190,19 +191,33 @@ namespace Hurricane {
 
   Property* DBo::getProperty ( const Name& name ) const
   {
-    set<Property*>::const_iterator iterator = _propertySet.begin();
-    while ( iterator != _propertySet.end() ) {
-      Property* property = *iterator;
-      if (property->getName() == name) return property;
-      ++iterator;
+    const SharedName* key = name._getSharedName();
+    for ( size_t i=0 ; i<_propertyNames.size() ; ++i ) {
+      if (_propertyNames[i]._getSharedName() == key) return _properties[i];
     }
     return NULL;
   }
 
 
+  size_t  DBo::_findProperty ( const Property* property ) const
+  {
+    for ( size_t i=0 ; i<_properties.size() ; ++i ) {
+      if (_properties[i] == property) return i;
+    }
+    return _properties.size();
+  }
+
+
+  void  DBo::_eraseProperty ( size_t i )
+  {
+    _properties   .erase( _properties   .begin() + i );
+    _propertyNames.erase( _propertyNames.begin() + i );
+  }
+
+
   Properties  DBo::getProperties () const
   {
-    return getCollection(_propertySet);
+    return getCollection(_properties);
   }
 
 
@@ -222,13 +237,15 @@ namespace Hurricane {
     if ( !property )
       throw Error("DBo::put(): Can't put property : NULL property.");
 
-    Property* oldProperty = getProperty ( property->getName() );
+    Name      name        = property->getName();
+    Property* oldProperty = getProperty ( name );
     if ( property != oldProperty ) {
       if ( oldProperty ) {
-        _propertySet.erase ( oldProperty );
+        _eraseProperty ( _findProperty(oldProperty) );
         oldProperty->onReleasedBy ( this );
       }
-      _propertySet.insert ( property );
+      _properties   .push_back ( property );
+      _propertyNames.push_back ( name );
       property->onCapturedBy ( this );
     }
   }
@@ -239,10 +256,11 @@ namespace Hurricane {
     if ( !property )
       throw Error("DBo::remove(): Can't remove property : NULL property.");
 
-    if ( _propertySet.find(property) != _propertySet.end() ) {
-      _propertySet.erase ( property );
+    size_t i = _findProperty ( property );
+    if ( i < _properties.size() ) {
+      _eraseProperty ( i );
       property->onReleasedBy ( this );
-      if ( dynamic_cast<Quark*>(this) && _propertySet.empty() )
+      if ( dynamic_cast<Quark*>(this) && _properties.empty() )
         destroy();
     }
   }
@@ -252,9 +270,9 @@ namespace Hurricane {
   {
     Property* property = getProperty ( name );
     if ( property ) {
-      _propertySet.erase ( property );
+      _eraseProperty ( _findProperty(property) );
       property->onReleasedBy ( this );
-      if ( dynamic_cast<Quark*>(this) && _propertySet.empty() )
+      if ( dynamic_cast<Quark*>(this) && _properties.empty() )
         destroy();
     }
   }
@@ -262,9 +280,12 @@ namespace Hurricane {
 
   void  DBo::_onDestroyed ( Property* property )
   {
-    if ( property && ( _propertySet.find(property) != _propertySet.end() ) ) {
-      _propertySet.erase ( property );
-      if ( dynamic_cast<Quark*>(this) && _propertySet.empty() )
+    if ( !property ) return;
+
+    size_t i = _findProperty ( property );
+    if ( i < _properties.size() ) {
+      _eraseProperty ( i );
+      if ( dynamic_cast<Quark*>(this) && _properties.empty() )
         destroy();
     }
   }
@@ -272,9 +293,10 @@ namespace Hurricane {
 
   void  DBo::clearProperties ()
   {
-    while ( !_propertySet.empty() ) {
-      Property* property = *_propertySet.begin();
-      _propertySet.erase ( property );
+    while ( !_properties.empty() ) {
+      Property* property = _properties.back();
+      _properties   .pop_back ();
+      _propertyNames.pop_back ();
       property->onReleasedBy ( this );
     }
   }
@@ -315,7 +337,7 @@ namespace Hurricane {
   {
     Record* record = new Record ( getString(this) );
     record->add( getSlot("_id"         , _id          ) );
-    record->add( getSlot("_propertySet", &_propertySet) );
+    record->add( getSlot("_properties" , &_properties ) );
     return record;
   }
 
@@ -92,31 +92,49 @@ namespace Hurricane {
 
   
 
+// No RoutingPad is created if the HyperNet already has some in the
+// Cell of the DeepNet or has any Segment (wired by hand). Only reads
+// the netlist, so it may be run concurrently (see Cell::flattenNets()).
+  bool  DeepNet::_needRoutingPads ( HyperNet& hyperNet, const Cell* cell )
+  {
+    for ( Occurrence occurrence : hyperNet.getComponentOccurrences() ) {
+      RoutingPad* rp = dynamic_cast<RoutingPad*>( occurrence.getEntity() );
+      if (rp and (rp->getCell() == cell)) return false;
+      if (dynamic_cast<Segment*>(occurrence.getEntity())) return false;
+    }
+    return true;
+  }
+
+
   size_t  DeepNet::_createRoutingPads ( unsigned int flags )
   {
     cdebug_log(18,1) << "DeepNet::_createRoutingPads(): " << this << endl;
 
-    size_t        nbRoutingPads = 0;
-    HyperNet      hyperNet      ( _netOccurrence );
-    RoutingPad*   currentRp     = NULL;
-    bool          createRp      = true;
+    HyperNet  hyperNet ( _netOccurrence );
   //unsigned int  rpFlags       = (flags & Cell::Flags::StayOnPlugs) ? 0 : RoutingPad::BiggestArea;
 
-    for ( Occurrence occurrence : hyperNet.getComponentOccurrences() ) {
-      cdebug_log(18,0) << "| occurrence=" << occurrence << endl;
-      RoutingPad* rp = dynamic_cast<RoutingPad*>( occurrence.getEntity() );
-      cdebug_log(18,0) << "| rp=" << rp << endl;
-      if (rp and (rp->getCell() == getCell())) { createRp = false; break; }
-      if (dynamic_cast<Segment*>(occurrence.getEntity())) { createRp = false; break; }
-      cdebug_log(18,0) << "| dynamic_cast OK createRp=" << createRp << endl;
-    }
-    if (not createRp) {
+    if (not _needRoutingPads(hyperNet,getCell())) {
       cdebug_log(18,0) << "DeepNet::_createRoutingPads(): No RoutingPad created" << endl;
       cdebug_tabw(18,-1);
       return 0;
     }
 
-    for ( Occurrence occurrence : hyperNet.getTerminalNetlistPlugOccurrences() ) {
+    vector<Occurrence>  plugOccurrences;
+    for ( Occurrence occurrence : hyperNet.getTerminalNetlistPlugOccurrences() )
+      plugOccurrences.push_back( occurrence );
+
+    size_t nbRoutingPads = _createRoutingPads( plugOccurrences, flags );
+    cdebug_tabw(18,-1);
+    return nbRoutingPads;
+  }
+
+
+  size_t  DeepNet::_createRoutingPads ( const vector<Occurrence>& plugOccurrences, unsigned int flags )
+  {
+    size_t       nbRoutingPads = 0;
+    RoutingPad*  currentRp     = NULL;
+
+    for ( const Occurrence& occurrence : plugOccurrences ) {
       nbRoutingPads++;
 
       currentRp = RoutingPad::create( this, occurrence, RoutingPad::BiggestArea );
@@ -129,7 +147,6 @@ namespace Hurricane {
     }
 
     cdebug_log(18,0) << "DeepNet::_createRoutingPads(): done on " << this << endl;
-    cdebug_tabw(18,-1);
     return nbRoutingPads;
   }
 
@@ -193,8 +193,7 @@ Instance::Instance(Cell* cell, const Name& name, Cell* masterCell, const Transfo
     _transformation(transformation),
     _placementStatus(placementstatus),
     _plugMap(),
-    _sharedPathMap(),
-    _nextOfCellInstanceMap(NULL),
+    _sharedPathes(),
     _nextOfCellSlaveInstanceSet(NULL)
 {
     if (!_cell)
@@ -480,11 +479,11 @@ void Instance::setMasterCell(Cell* masterCell, bool secureFlag)
       end_for;
     }
 
-    for_each_shared_path(sharedPath, _getSharedPathes()) {
+    vector<SharedPath*> sharedPathes = _sharedPathes;
+    for (SharedPath* sharedPath : sharedPathes) {
       if (!sharedPath->getTailSharedPath())
       // if the tail is empty the SharedPath isn't impacted by the change
-        delete sharedPath;
-      end_for;
+        sharedPath->destroy();
     }
 
     invalidate(true);
@@ -536,12 +535,12 @@ void Instance::uniquify()
     return;
   }
 
-  if (not _getSharedPathMap().isEmpty()) {
-    cerr << Warning( "Instance::uniquify(): While uniquifying model %s of instance %s, SharedPathMap is not empty.\n"
+  if (not _sharedPathes.empty()) {
+    cerr << Warning( "Instance::uniquify(): While uniquifying model %s of instance %s, SharedPathes are not empty.\n"
                      "          (%u Entity's Occurrences will still uses the original master Cell)"
                    , getString(_masterCell->getName()).c_str()
                    , getString(getName()).c_str()
-                   , _getSharedPathMap()._getSize()
+                   , (unsigned int)_sharedPathes.size()
                    ) << endl;
   }
 
@@ -568,8 +567,8 @@ Instance* Instance::getClone(Cell* cloneCell) const
                                     , getPlacementStatus()
                                     );
 
-  if (not clone->_getSharedPathMap().isEmpty()) {
-    cerr << Warning( "Instance::getClone(): While cloning instance %s, SharedPathMap is not empty.\n"
+  if (not clone->_getSharedPathes().empty()) {
+    cerr << Warning( "Instance::getClone(): While cloning instance %s, SharedPathes are not empty.\n"
                      "          (Occurrence will still uses the original instance)"
                    , getString(getName()).c_str()
                    ) << endl;
@@ -618,8 +617,7 @@ void Instance::_postCreate()
 void Instance::_preDestroy()
 // ************************
 {
-  SharedPathes pathes = _getSharedPathes();
-  while ( pathes.getFirst() ) delete pathes.getFirst();
+  while ( not _sharedPathes.empty() ) _sharedPathes.back()->destroy();
 
   Inherit::_preDestroy();
 
@@ -654,7 +652,7 @@ Record* Instance::_getRecord() const
       //record->add(getSlot("XCenter", DbU::getValueString(getAbutmentBox().getXCenter())));
       //record->add(getSlot("YCenter", DbU::getValueString(getAbutmentBox().getYCenter())));
         record->add(getSlot("Plugs", &_plugMap));
-        record->add(getSlot("SharedPathes", &_sharedPathMap));
+        record->add(getSlot("SharedPathes", &_sharedPathes));
     }
     return record;
 }
@@ -677,6 +675,26 @@ void Instance::_toJsonCollections(JsonWriter* writer) const
   Inherit::_toJsonCollections( writer );
 }
 
+void Instance::_insertSharedPath(SharedPath* sharedPath)
+// *****************************************************
+{
+  sharedPath->_setInstanceIndex( _sharedPathes.size() );
+  _sharedPathes.push_back( sharedPath );
+}
+
+void Instance::_removeSharedPath(SharedPath* sharedPath)
+// *****************************************************
+// The last SharedPath takes the place of the removed one.
+{
+  uint32_t index = sharedPath->_getInstanceIndex();
+  if ((index >= _sharedPathes.size()) or (_sharedPathes[index] != sharedPath)) return;
+
+  _sharedPathes[index] = _sharedPathes.back();
+  _sharedPathes[index]->_setInstanceIndex( index );
+  _sharedPathes.pop_back();
+  sharedPath->_setInstanceIndex( SharedPath::npos );
+}
+
 // ****************************************************************************************************
 // Instance::PlugMap implementation
 // ****************************************************************************************************
@@ -713,40 +731,6 @@ void Instance::PlugMap::_setNextElement(Plug* plug, Plug* nextPlug) const
 
 
 
-// ****************************************************************************************************
-// Instance::SharedPathMap implementation
-// ****************************************************************************************************
-
-Instance::SharedPathMap::SharedPathMap()
-// *************************************
-:    Inherit()
-{
-}
-
-const SharedPath* Instance::SharedPathMap::_getKey(SharedPath* sharedPath) const
-// *****************************************************************************
-{
-    return sharedPath->getTailSharedPath();
-}
-
-unsigned Instance::SharedPathMap::_getHashValue(const SharedPath* tailSharedPath) const
-// ************************************************************************************
-{
-  return (tailSharedPath) ? (tailSharedPath->getHash()/8) : 0;
-}
-
-SharedPath* Instance::SharedPathMap::_getNextElement(SharedPath* sharedPath) const
-// *******************************************************************************
-{
-    return sharedPath->_getNextOfInstanceSharedPathMap();
-}
-
-void Instance::SharedPathMap::_setNextElement(SharedPath* sharedPath, SharedPath* nextSharedPath) const
-// ****************************************************************************************************
-{
-    sharedPath->_setNextOfInstanceSharedPathMap(nextSharedPath);
-};
-
 // ****************************************************************************************************
 // Instance::PlacementStatus implementation
 // ****************************************************************************************************
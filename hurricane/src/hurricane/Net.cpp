@@ -266,7 +266,6 @@ Net::Net(Cell* cell, const Name& name)
     _position(0,0),
     _componentSet(),
     _rubberSet(),
-    _nextOfCellNetMap(NULL),
     _mainName(this)
 {
   if (not _cell)      throw Error( "Net::Net(): Can't create Hurricane::Net, NULL cell" );
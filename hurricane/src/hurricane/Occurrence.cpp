@@ -118,7 +118,19 @@ bool Occurrence::operator<(const Occurrence& occurrence) const
   // if (_entity->getId() < occurrence._entity->getId()) return true;
   // if (_entity->getId() > occurrence._entity->getId()) return false;
 
-  return _sharedPath->getHash() < occurrence._sharedPath->getHash();
+  if (_sharedPath->getHash() != occurrence._sharedPath->getHash())
+    return _sharedPath->getHash() < occurrence._sharedPath->getHash();
+
+// Hash collision (or same path), fall back on the Instance ids.
+  SharedPath* lhs = _sharedPath;
+  SharedPath* rhs = occurrence._sharedPath;
+  while ( lhs and rhs ) {
+    if (lhs->getHeadInstance() != rhs->getHeadInstance())
+      return lhs->getHeadInstance()->getId() < rhs->getHeadInstance()->getId();
+    lhs = lhs->getTailSharedPath();
+    rhs = rhs->getTailSharedPath();
+  }
+  return (not lhs) and rhs;
   
 //return ((_entity  < occurrence._entity) or 
 //       ((_entity == occurrence._entity) and (_sharedPath < occurrence._sharedPath)));
@@ -0,0 +1,506 @@
+// -*- C++ -*-
+//
+// Copyright (c) BULL S.A. 2000-2026, All Rights Reserved
+//
+// This file is part of Hurricane.
+//
+// Hurricane is free software: you can redistribute it  and/or  modify
+// it under the terms of the GNU  Lesser  General  Public  License  as
+// published by the Free Software Foundation, either version 3 of  the
+// License, or (at your option) any later version.
+//
+// Hurricane is distributed in the hope that it will  be  useful,  but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHAN-
+// TABILITY or FITNESS FOR A PARTICULAR PURPOSE. See  the  Lesser  GNU
+// General Public License for more details.
+//
+// You should have received a copy of the Lesser  GNU  General  Public
+// License along with Hurricane. If not, see
+//                                     <http://www.gnu.org/licenses/>.
+//
+// +-----------------------------------------------------------------+
+// |                  H U R R I C A N E                              |
+// |     V L S I   B a c k e n d   D a t a - B a s e                 |
+// |                                                                 |
+// |  Author      :                    Jean-Paul CHAPUT              |
+// |  E-mail      :            Jean-Paul.Chaput@lip6.fr              |
+// | =============================================================== |
+// |  C++ Module  :  "./PackedRTree.cpp"                             |
+// +-----------------------------------------------------------------+
+
+
+#include <cmath>
+#include <algorithm>
+#include "hurricane/Go.h"
+#include "hurricane/PackedRTree.h"
+
+
+namespace {
+
+  using namespace std;
+  using namespace Hurricane;
+
+  typedef  PackedRTree::Node  Node;
+
+
+  class CompareByXCenter {
+    public:
+      inline bool  operator() ( const Node& lhs, const Node& rhs ) const
+      {
+        DbU::Unit  lhsCenter = lhs._xMin + lhs._xMax;
+        DbU::Unit  rhsCenter = rhs._xMin + rhs._xMax;
+        if (lhsCenter != rhsCenter) return lhsCenter < rhsCenter;
+        return lhs._first < rhs._first;
+      }
+  };
+
+
+  class CompareByYCenter {
+    public:
+      inline bool  operator() ( const Node& lhs, const Node& rhs ) const
+      {
+        DbU::Unit  lhsCenter = lhs._yMin + lhs._yMax;
+        DbU::Unit  rhsCenter = rhs._yMin + rhs._yMax;
+        if (lhsCenter != rhsCenter) return lhsCenter < rhsCenter;
+        return lhs._first < rhs._first;
+      }
+  };
+
+
+// Sort-Tile-Recursive ordering: cut the rectangles in vertical slabs
+// of sqrt(P) nodes along X, then order each slab along Y. Consecutive
+// runs of NodeCapacity rectangles are then grouped under one parent.
+  void  strSort ( vector<Node>& rects )
+  {
+    size_t  capacity = PackedRTree::NodeCapacity;
+    if (rects.size() <= capacity) return;
+
+    size_t  parents   = (rects.size() + capacity - 1) / capacity;
+    size_t  slabs     = (size_t)ceil( sqrt( (double)parents ) );
+    size_t  slabSize  = slabs * capacity;
+
+    sort( rects.begin(), rects.end(), CompareByXCenter() );
+    for ( size_t begin=0 ; begin < rects.size() ; begin += slabSize ) {
+      size_t  end = std::min( begin+slabSize, rects.size() );
+      sort( rects.begin()+begin, rects.begin()+end, CompareByYCenter() );
+    }
+  }
+
+
+  void  setEmpty ( Node& node )
+  {
+    node._xMin = DbU::Max;
+    node._yMin = DbU::Max;
+    node._xMax = DbU::Min;
+    node._yMax = DbU::Min;
+  }
+
+
+// -------------------------------------------------------------------
+// Class  :  "PackedRTree_Gos".
+
+  class PackedRTree_Gos : public Collection<Go*> {
+    public:
+      typedef Collection<Go*>  Super;
+    public:
+      class Locator : public Hurricane::Locator<Go*> {
+        public:
+          inline                               Locator    ( const PackedRTree* );
+          inline                               Locator    ( const Locator& );
+          virtual                             ~Locator    ();
+          virtual Go*                          getElement () const;
+          virtual Hurricane::Locator<Go*>*     getClone   () const;
+          virtual bool                         isValid    () const;
+          virtual void                         progress   ();
+          virtual string                       _getString () const;
+        private:
+          const PackedRTree* _rtree;
+          size_t             _index;
+      };
+    public:
+      inline                             PackedRTree_Gos ( const PackedRTree* );
+      inline                             PackedRTree_Gos ( const PackedRTree_Gos& );
+      virtual                           ~PackedRTree_Gos ();
+      virtual Collection<Go*>*           getClone        () const;
+      virtual Hurricane::Locator<Go*>*   getLocator      () const;
+      virtual string                     _getString      () const;
+    private:
+      const PackedRTree* _rtree;
+  };
+
+
+  inline  PackedRTree_Gos::Locator::Locator ( const PackedRTree* rtree )
+    : Hurricane::Locator<Go*>()
+    , _rtree(rtree)
+    , _index(0)
+  { if (_rtree) _rtree->_ref(); }
+
+
+  inline  PackedRTree_Gos::Locator::Locator ( const Locator& other )
+    : Hurricane::Locator<Go*>()
+    , _rtree(other._rtree)
+    , _index(other._index)
+  { if (_rtree) _rtree->_ref(); }
+
+
+  PackedRTree_Gos::Locator::~Locator ()
+  { if (_rtree) _rtree->_unref(); }
+
+
+  Go*                       PackedRTree_Gos::Locator::getElement () const { return (isValid()) ? _rtree->getGo(_index) : NULL; }
+  Hurricane::Locator<Go*>*  PackedRTree_Gos::Locator::getClone   () const { return new Locator(*this); }
+  bool                      PackedRTree_Gos::Locator::isValid    () const { return _rtree and (_index < _rtree->getSize()); }
+  void                      PackedRTree_Gos::Locator::progress   () { if (isValid()) ++_index; }
+
+
+  string  PackedRTree_Gos::Locator::_getString () const
+  {
+    string s = "<" + _TName("PackedRTree::Gos::Locator")
+             + " " + getString(_index)
+             + ">";
+    return s;
+  }
+
+
+  inline  PackedRTree_Gos::PackedRTree_Gos ( const PackedRTree* rtree )
+    : Super()
+    , _rtree(rtree)
+  { if (_rtree) _rtree->_ref(); }
+
+
+  inline  PackedRTree_Gos::PackedRTree_Gos ( const PackedRTree_Gos& other )
+    : Super()
+    , _rtree(other._rtree)
+  { if (_rtree) _rtree->_ref(); }
+
+
+  PackedRTree_Gos::~PackedRTree_Gos ()
+  { if (_rtree) _rtree->_unref(); }
+
+
+  Collection<Go*>*          PackedRTree_Gos::getClone   () const { return new PackedRTree_Gos(*this); }
+  Hurricane::Locator<Go*>*  PackedRTree_Gos::getLocator () const { return new Locator(_rtree); }
+
+
+  string  PackedRTree_Gos::_getString () const
+  {
+    string s = "<" + _TName("PackedRTree::Gos");
+    if (_rtree) s += " " + getString(_rtree);
+    s += ">";
+    return s;
+  }
+
+
+// -------------------------------------------------------------------
+// Class  :  "PackedRTree_GosUnder".
+//
+// Depth first walk over the node array with an explicit stack of node
+// indexes, no recursion and no pointer dereferencing.
+
+  class PackedRTree_GosUnder : public Collection<Go*> {
+    public:
+      typedef Collection<Go*>  Super;
+    public:
+      class Locator : public Hurricane::Locator<Go*> {
+        public:
+                                               Locator    ( const PackedRTree*, const Box& area, DbU::Unit threshold );
+                                               Locator    ( const Locator& );
+          virtual                             ~Locator    ();
+          virtual Go*                          getElement () const;
+          virtual Hurricane::Locator<Go*>*     getClone   () const;
+          virtual bool                         isValid    () const;
+          virtual void                         progress   ();
+          virtual string                       _getString () const;
+        private:
+                  bool                         _isAccepted ( uint32_t igo ) const;
+                  void                         _nextLeaf   ();
+        private:
+          const PackedRTree*     _rtree;
+          Box                    _area;
+          DbU::Unit              _threshold;
+          std::vector<uint32_t>  _stack;
+          uint32_t               _current;
+          uint32_t               _end;
+      };
+    public:
+      inline                             PackedRTree_GosUnder ( const PackedRTree*, const Box& area, DbU::Unit threshold );
+      inline                             PackedRTree_GosUnder ( const PackedRTree_GosUnder& );
+      virtual                           ~PackedRTree_GosUnder ();
+      virtual Collection<Go*>*           getClone             () const;
+      virtual Hurricane::Locator<Go*>*   getLocator           () const;
+      virtual string                     _getString           () const;
+    private:
+      const PackedRTree* _rtree;
+      Box                _area;
+      DbU::Unit          _threshold;
+  };
+
+
+  PackedRTree_GosUnder::Locator::Locator ( const PackedRTree* rtree, const Box& area, DbU::Unit threshold )
+    : Hurricane::Locator<Go*>()
+    , _rtree    (rtree)
+    , _area     (area)
+    , _threshold(threshold)
+    , _stack    ()
+    , _current  (0)
+    , _end      (0)
+  {
+    if (not _rtree) return;
+    _rtree->_ref();
+    if (_rtree->isEmpty() or _area.isEmpty()) return;
+    _stack.reserve( 32 );
+    _stack.push_back( _rtree->getRoot() );
+    _nextLeaf();
+    while ( isValid() and not _isAccepted(_current) ) progress();
+  }
+
+
+  PackedRTree_GosUnder::Locator::Locator ( const Locator& other )
+    : Hurricane::Locator<Go*>()
+    , _rtree    (other._rtree)
+    , _area     (other._area)
+    , _threshold(other._threshold)
+    , _stack    (other._stack)
+    , _current  (other._current)
+    , _end      (other._end)
+  { if (_rtree) _rtree->_ref(); }
+
+
+  PackedRTree_GosUnder::Locator::~Locator ()
+  { if (_rtree) _rtree->_unref(); }
+
+
+  inline bool  PackedRTree_GosUnder::Locator::_isAccepted ( uint32_t igo ) const
+  {
+    const Box& bb = _rtree->getGoBox( igo );
+    if (not bb.intersect(_area)) return false;
+    if (_threshold <= 0) return true;
+    return (bb.getWidth() >= _threshold) or (bb.getHeight() >= _threshold);
+  }
+
+
+  void  PackedRTree_GosUnder::Locator::_nextLeaf ()
+  {
+    _current = _end = 0;
+    while ( not _stack.empty() ) {
+      uint32_t  inode = _stack.back();
+      _stack.pop_back();
+
+      const PackedRTree::Node& node = _rtree->getNode( inode );
+      if (not node.intersect(_area) or node.isPruned(_threshold)) continue;
+      if (_rtree->isLeaf(inode)) {
+        _current = node._first;
+        _end     = node._first + node._count;
+        return;
+      }
+    // Pushed in reverse so the children are visited in storage order.
+      for ( uint32_t ichild=node._first+node._count ; ichild > node._first ; --ichild )
+        _stack.push_back( ichild-1 );
+    }
+  }
+
+
+  Go*                       PackedRTree_GosUnder::Locator::getElement () const { return (isValid()) ? _rtree->getGo(_current) : NULL; }
+  Hurricane::Locator<Go*>*  PackedRTree_GosUnder::Locator::getClone   () const { return new Locator(*this); }
+  bool                      PackedRTree_GosUnder::Locator::isValid    () const { return _current < _end; }
+
+
+  void  PackedRTree_GosUnder::Locator::progress ()
+  {
+    while ( isValid() ) {
+      ++_current;
+      if (_current >= _end) _nextLeaf();
+      if (isValid() and _isAccepted(_current)) break;
+    }
+  }
+
+
+  string  PackedRTree_GosUnder::Locator::_getString () const
+  {
+    string s = "<" + _TName("PackedRTree::GosUnder::Locator")
+             + " " + getString(_area)
+             + " t:" + DbU::getValueString(_threshold)
+             + ">";
+    return s;
+  }
+
+
+  inline  PackedRTree_GosUnder::PackedRTree_GosUnder ( const PackedRTree* rtree, const Box& area, DbU::Unit threshold )
+    : Super()
+    , _rtree    (rtree)
+    , _area     (area)
+    , _threshold(threshold)
+  { if (_rtree) _rtree->_ref(); }
+
+
+  inline  PackedRTree_GosUnder::PackedRTree_GosUnder ( const PackedRTree_GosUnder& other )
+    : Super()
+    , _rtree    (other._rtree)
+    , _area     (other._area)
+    , _threshold(other._threshold)
+  { if (_rtree) _rtree->_ref(); }
+
+
+  PackedRTree_GosUnder::~PackedRTree_GosUnder ()
+  { if (_rtree) _rtree->_unref(); }
+
+
+  Collection<Go*>*          PackedRTree_GosUnder::getClone   () const { return new PackedRTree_GosUnder(*this); }
+  Hurricane::Locator<Go*>*  PackedRTree_GosUnder::getLocator () const { return new Locator(_rtree,_area,_threshold); }
+
+
+  string  PackedRTree_GosUnder::_getString () const
+  {
+    string s = "<" + _TName("PackedRTree::GosUnder");
+    if (_rtree) {
+      s += " " + getString(_rtree);
+      s += " " + getString(_area);
+      s += " t:" + DbU::getValueString(_threshold);
+    }
+    s += ">";
+    return s;
+  }
+
+
+}  // Anonymous namespace.
+
+
+namespace Hurricane {
+
+
+// -------------------------------------------------------------------
+// Class  :  "Hurricane::PackedRTree".
+
+
+  PackedRTree::PackedRTree ( Gos gos )
+    : _nodes()
+    , _boxes()
+    , _gos     ()
+    , _leafs   (0)
+    , _refs    (0)
+    , _detached(false)
+  {
+    vector<Node>  level;
+    vector<Go*>   unordereds;
+
+    for ( Go* go : gos ) {
+      Box   bb   = go->getBoundingBox();
+      Node  item;
+      if (bb.isEmpty()) setEmpty( item );
+      else {
+        item._xMin = bb.getXMin();
+        item._yMin = bb.getYMin();
+        item._xMax = bb.getXMax();
+        item._yMax = bb.getYMax();
+      }
+      item._first = unordereds.size();
+      level     .push_back( item );
+      unordereds.push_back( go );
+    }
+    if (level.empty()) return;
+
+    strSort( level );
+    _gos  .reserve( level.size() );
+    _boxes.reserve( level.size() );
+    for ( const Node& item : level ) {
+      _gos  .push_back( unordereds[item._first] );
+      _boxes.push_back( (item._xMin <= item._xMax) ? Box(item._xMin,item._yMin,item._xMax,item._yMax) : Box() );
+    }
+
+    vector<Node>  parents;
+    uint32_t      childBase = 0;
+    while ( true ) {
+      parents.clear();
+      for ( uint32_t ichild=0 ; ichild<level.size() ; ichild+=NodeCapacity ) {
+        Node  parent;
+        setEmpty( parent );
+        parent._first = childBase + ichild;
+        parent._count = std::min( (uint32_t)level.size() - ichild, NodeCapacity );
+        for ( uint32_t i=ichild ; i<ichild+parent._count ; ++i )
+          parent.merge( level[i]._xMin, level[i]._yMin, level[i]._xMax, level[i]._yMax );
+        parents.push_back( parent );
+      }
+
+      strSort( parents );
+      childBase = _nodes.size();
+      _nodes.insert( _nodes.end(), parents.begin(), parents.end() );
+      if (not _leafs) _leafs = _nodes.size();
+      if (parents.size() == 1) break;
+      level.swap( parents );
+    }
+    _nodes.shrink_to_fit();
+  }
+
+
+  PackedRTree::~PackedRTree ()
+  { }
+
+
+// Called by the QuadTree instead of deleting the tree. If collections
+// or locators are still referencing it, it is kept alive (and stale)
+// until the last of them is destroyed.
+  void  PackedRTree::_detach ()
+  {
+    _detached = true;
+    if (not _refs) delete this;
+  }
+
+
+  void  PackedRTree::_unref () const
+  {
+    if ((--_refs == 0) and _detached) delete this;
+  }
+
+
+  Box  PackedRTree::getBoundingBox () const
+  {
+    if (_nodes.empty()) return Box();
+    const Node& root = _nodes.back();
+    if (root._xMin > root._xMax) return Box();
+    return Box( root._xMin, root._yMin, root._xMax, root._yMax );
+  }
+
+
+  Gos  PackedRTree::getGos () const
+  { return PackedRTree_Gos( this ); }
+
+
+  Gos  PackedRTree::getGosUnder ( const Box& area, DbU::Unit threshold ) const
+  { return PackedRTree_GosUnder( this, area, threshold ); }
+
+
+  size_t  PackedRTree::getMemorySize () const
+  {
+    return sizeof(PackedRTree)
+         + _nodes.capacity() * sizeof(Node)
+         + _boxes.capacity() * sizeof(Box)
+         + _gos  .capacity() * sizeof(Go*);
+  }
+
+
+  string  PackedRTree::_getTypeName () const
+  { return "PackedRTree"; }
+
+
+  string  PackedRTree::_getString () const
+  {
+    string s = "<" + _getTypeName()
+             + " " + getString(_gos.size())
+             + " nodes:" + getString(_nodes.size())
+             + ">";
+    return s;
+  }
+
+
+  Record* PackedRTree::_getRecord () const
+  {
+    Record* record = new Record( _getString() );
+    record->add( getSlot("_leafs"   , _leafs      ) );
+    record->add( getSlot("_refs"    , _refs.load()) );
+    record->add( getSlot("_detached", _detached   ) );
+    record->add( getSlot("_gos"     , &_gos       ) );
+    return record;
+  }
+
+
+} // Hurricane namespace.
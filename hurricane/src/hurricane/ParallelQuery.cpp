@@ -0,0 +1,308 @@
+// -*- C++ -*-
+//
+// Copyright (c) BULL S.A. 2000-2026, All Rights Reserved
+//
+// This file is part of Hurricane.
+//
+// Hurricane is free software: you can redistribute it  and/or  modify
+// it under the terms of the GNU  Lesser  General  Public  License  as
+// published by the Free Software Foundation, either version 3 of  the
+// License, or (at your option) any later version.
+//
+// Hurricane is distributed in the hope that it will  be  useful,  but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHAN-
+// TABILITY or FITNESS FOR A PARTICULAR PURPOSE. See  the  Lesser  GNU
+// General Public License for more details.
+//
+// You should have received a copy of the Lesser  GNU  General  Public
+// License along with Hurricane. If not, see
+//                                     <http://www.gnu.org/licenses/>.
+//
+// +-----------------------------------------------------------------+
+// |                  H U R R I C A N E                              |
+// |     V L S I   B a c k e n d   D a t a - B a s e                 |
+// |                                                                 |
+// |  Author      :                    Jean-Paul CHAPUT              |
+// |  E-mail      :            Jean-Paul.Chaput@lip6.fr              |
+// | =============================================================== |
+// |  C++ Module  :  "./ParallelQuery.cpp"                           |
+// +-----------------------------------------------------------------+
+
+
+#include <limits>
+#include <thread>
+#include <set>
+#include "hurricane/Error.h"
+#include "hurricane/BasicLayer.h"
+#include "hurricane/Slice.h"
+#include "hurricane/PackedRTree.h"
+#include "hurricane/Cell.h"
+#include "hurricane/Instance.h"
+#include "hurricane/ParallelQuery.h"
+
+
+namespace Hurricane {
+
+  using std::thread;
+  using std::lock_guard;
+  using std::mutex;
+
+
+// -------------------------------------------------------------------
+// Class  :  "ParallelQuery".
+
+
+  ParallelQuery::ParallelQuery ()
+    : _cell          (NULL)
+    , _area          ()
+    , _transformation()
+    , _inverse       ()
+    , _basicLayer    (NULL)
+    , _filter        (Query::DoAll)
+    , _threshold     (0)
+    , _startLevel    (0)
+    , _stopLevel     (std::numeric_limits<unsigned int>::max())
+    , _stopCellFlags (Cell::Flags::NoFlags)
+    , _threads       (std::max(1U,thread::hardware_concurrency()))
+    , _tilesPerSide  (0)
+    , _nextTile      (0)
+    , _instanceCount (0)
+    , _errorLock     ()
+    , _error         ()
+  { }
+
+
+  ParallelQuery::~ParallelQuery ()
+  { }
+
+
+  bool  ParallelQuery::hasGoCallback () const
+  { return false; }
+
+
+  bool  ParallelQuery::hasMasterCellCallback () const
+  { return false; }
+
+
+  void  ParallelQuery::masterCellCallback ( QueryStack&, unsigned int )
+  { }
+
+
+  void  ParallelQuery::setQuery ( Cell*                 cell
+                                , const Box&            area
+                                , const Transformation& transformation
+                                , const BasicLayer*     basicLayer
+                                , Mask                  filter
+                                , DbU::Unit             threshold
+                                )
+  {
+    _cell           = cell;
+    _area           = area;
+    _transformation = transformation;
+    _basicLayer     = basicLayer;
+    _filter         = filter;
+    _threshold      = threshold;
+  }
+
+
+  void  ParallelQuery::setThreads ( unsigned int threads )
+  { _threads = std::max( 1U, threads ); }
+
+
+  void  ParallelQuery::setTilesPerSide ( unsigned int tiles )
+  { _tilesPerSide = tiles; }
+
+
+  Box  ParallelQuery::_getTile ( size_t itile ) const
+  {
+    DbU::Unit  width  = _area.getWidth ();
+    DbU::Unit  height = _area.getHeight();
+    DbU::Unit  ix     = itile % _tilesPerSide;
+    DbU::Unit  iy     = itile / _tilesPerSide;
+
+    return Box( _area.getXMin() + (ix  *width)/_tilesPerSide
+              , _area.getYMin() + (iy  *height)/_tilesPerSide
+              , _area.getXMin() + ((ix+1)*width)/_tilesPerSide
+              , _area.getYMin() + ((iy+1)*height)/_tilesPerSide );
+  }
+
+
+// Tiles are half-open on their upper sides (except the last row and
+// column) so every point of the top area belongs to exactly one tile.
+// The box is given in the stack coordinates, that is with the top
+// transformation applied, which must be removed first.
+  size_t  ParallelQuery::_getOwnerTile ( const Box& bb ) const
+  {
+    Box clipped = _inverse.getBox( bb ).getIntersection( _area );
+    if (clipped.isEmpty()) return std::numeric_limits<size_t>::max();
+
+    DbU::Unit  width  = _area.getWidth ();
+    DbU::Unit  height = _area.getHeight();
+    DbU::Unit  dx     = clipped.getXMin() - _area.getXMin();
+    DbU::Unit  dy     = clipped.getYMin() - _area.getYMin();
+    DbU::Unit  ix     = (width ) ? (dx*_tilesPerSide)/width  : 0;
+    DbU::Unit  iy     = (height) ? (dy*_tilesPerSide)/height : 0;
+    DbU::Unit  tiles  = _tilesPerSide;
+
+    while ((ix+1 < tiles) and (((ix+1)*width )/tiles <= dx)) ++ix;
+    while ((ix   > 0    ) and (( ix   *width )/tiles >  dx)) --ix;
+    while ((iy+1 < tiles) and (((iy+1)*height)/tiles <= dy)) ++iy;
+    while ((iy   > 0    ) and (( iy   *height)/tiles >  dy)) --iy;
+
+    return iy*_tilesPerSide + ix;
+  }
+
+
+// The QuadTrees packed here (and only them) are recorded in packeds,
+// by Cell & Layer (NULL for the instances one) as a Slice becoming
+// empty is destroyed.
+  void  ParallelQuery::freeze ( Cell* cell, Frozens* packeds )
+  {
+    std::set<Cell*>  visiteds;
+    std::vector<Cell*>  stack;
+    stack.push_back( cell );
+    visiteds.insert( cell );
+
+    while ( not stack.empty() ) {
+      Cell* current = stack.back();
+      stack.pop_back();
+
+      if (packeds) {
+        if (not current->_getQuadTree()->isPacked())
+          packeds->push_back( make_pair(current,(const Layer*)NULL) );
+        for ( Slice* slice : current->getSlices() ) {
+          if (not slice->_getQuadTree()->isPacked())
+            packeds->push_back( make_pair(current,slice->getLayer()) );
+        }
+      }
+      current->packQuadTrees();
+      current->getBoundingBox();
+      for ( Instance* instance : current->getInstances() ) {
+        Cell* master = instance->getMasterCell();
+        if (visiteds.insert(master).second) stack.push_back( master );
+      }
+    }
+  }
+
+
+  void  ParallelQuery::unfreeze ( const Frozens& packeds )
+  {
+    for ( auto& packed : packeds ) {
+      if (not packed.second) {
+        packed.first->_getQuadTree()->unpack();
+        continue;
+      }
+      Slice* slice = packed.first->getSlice( packed.second );
+      if (slice) slice->_getQuadTree()->unpack();
+    }
+  }
+
+
+  void  ParallelQuery::doQuery ()
+  {
+    if (_area.isEmpty() or not _cell) return;
+
+    if (not _tilesPerSide) {
+      _tilesPerSide = 1;
+      while ( _tilesPerSide*_tilesPerSide < 4*_threads ) ++_tilesPerSide;
+    }
+
+    Frozens packeds;
+    freeze( _cell, &packeds );
+    _inverse       = _transformation.getInvert();
+    _nextTile      = 0;
+    _instanceCount = 0;
+    _error.clear();
+
+    if (_threads == 1) {
+      _runWorker( 0 );
+    } else {
+      std::vector<thread>  workers;
+      for ( unsigned int i=0 ; i<_threads ; ++i )
+        workers.push_back( thread( &ParallelQuery::_runWorker, this, i ) );
+      for ( thread& worker : workers ) worker.join();
+    }
+    unfreeze( packeds );
+
+    if (not _error.empty())
+      throw Error( "ParallelQuery::doQuery(): A worker failed.\n%s", _error.c_str() );
+  }
+
+
+  void  ParallelQuery::_runWorker ( unsigned int worker )
+  {
+    QueryStack  stack;
+    stack.setTopCell          ( _cell );
+    stack.setTopTransformation( _transformation );
+    stack.setThreshold        ( _threshold );
+    stack.setStartLevel       ( _startLevel );
+    stack.setStopLevel        ( _stopLevel );
+    stack.setStopCellFlags    ( _stopCellFlags );
+
+    size_t tiles = _tilesPerSide * _tilesPerSide;
+    try {
+      while ( true ) {
+        size_t itile = _nextTile++;
+        if (itile >= tiles) break;
+        _doTile( stack, itile, worker );
+      }
+    }
+    catch ( std::exception& e ) {
+      lock_guard<mutex> guard ( _errorLock );
+      if (_error.empty()) _error = e.what();
+      _nextTile = tiles;
+    }
+  }
+
+
+  void  ParallelQuery::_doTile ( QueryStack& stack, size_t itile, unsigned int worker )
+  {
+    stack.setTopArea( _getTile(itile) );
+    stack.init();
+
+    while ( not stack.empty() ) {
+      Cell* master = stack.getMasterCell();
+      Box   ab     = master->getAbutmentBox();
+      if (  (_threshold <= 0)
+         or (ab.getWidth () > _threshold)
+         or (ab.getHeight() > _threshold) ) {
+        bool skipTerminal = master->isTerminal() and not _filter.isSet(Query::DoTerminalCells);
+
+        if (hasGoCallback() and _basicLayer and _filter.isSet(Query::DoComponents) and not skipTerminal) {
+          for ( Slice* slice : master->getSlices() ) {
+            if (not slice->getLayer()->contains(_basicLayer)) continue;
+            if (not slice->getBoundingBox().intersect(stack.getArea())) continue;
+
+            const Box&   area   = stack.getArea();
+            PackedRTree* rtree  = slice->_getQuadTree()->_getPackedRTree();
+            auto         visit  = [&]( Go* go, const Box& bb ) {
+            // Fast path: strictly inside the tile, cannot be owned by another one.
+              if (   (bb.getXMin() <= area.getXMin()) or (bb.getXMax() >= area.getXMax())
+                  or (bb.getYMin() <= area.getYMin()) or (bb.getYMax() >= area.getYMax()) ) {
+                if (_getOwnerTile(stack.getTransformation().getBox(bb)) != itile) return;
+              }
+              goCallback( go, stack, worker );
+            };
+            if (rtree) rtree->visitGosUnder( area, _threshold, visit );
+            else {
+              for ( Go* go : slice->getGosUnder(area,_threshold) )
+                visit( go, go->getBoundingBox() );
+            }
+          }
+        }
+
+        bool owned = (itile == 0);
+        if (stack.size() > 1) {
+          owned = (_getOwnerTile(stack.getTransformation().getBox(master->getBoundingBox())) == itile);
+          if (owned) ++_instanceCount;
+        }
+        if (owned and _filter.isSet(Query::DoMasterCells) and hasMasterCellCallback())
+          masterCellCallback( stack, worker );
+      }
+
+      stack.progress();
+    }
+  }
+
+
+} // Hurricane namespace.
@@ -42,8 +42,7 @@ Path::Path(Instance* instance)
 :  _sharedPath(NULL)
 {
     if (instance) {
-        _sharedPath = instance->_getSharedPath(NULL);
-        if (!_sharedPath) _sharedPath = new SharedPath(instance);
+        _sharedPath = SharedPath::get(instance);
     }
 }
 
@@ -55,16 +54,14 @@ Path::Path(Instance* headInstance, const Path& tailPath)
         throw Error("Cant't create " + _TName("Path") + " : null head instance");
 
     if (!tailPath._getSharedPath()) {
-        _sharedPath = headInstance->_getSharedPath(NULL);
-        if (!_sharedPath) _sharedPath = new SharedPath(headInstance);
+        _sharedPath = SharedPath::get(headInstance);
     }
     else {
         SharedPath* tailSharedPath = tailPath._getSharedPath();
         if (tailSharedPath->getOwnerCell() != headInstance->getMasterCell())
             throw Error("Cant't create " + _TName("Path") + " : incompatible tail path");
 
-        _sharedPath = headInstance->_getSharedPath(tailSharedPath);
-        if (!_sharedPath) _sharedPath = new SharedPath(headInstance, tailSharedPath);
+        _sharedPath = SharedPath::get(headInstance, tailSharedPath);
     }
 }
 
@@ -76,14 +73,12 @@ Path::Path(const Path& headPath, Instance* tailInstance)
         throw Error("Cant't create " + _TName("Path") + " : null tail instance");
 
     if (!headPath._getSharedPath()) {
-        _sharedPath = tailInstance->_getSharedPath(NULL);
-        if (!_sharedPath) _sharedPath = new SharedPath(tailInstance);
+        _sharedPath = SharedPath::get(tailInstance);
     }
     else {
         Instance* headInstance = headPath.getHeadInstance();
         SharedPath* tailSharedPath = Path(headPath.getTailPath(), tailInstance)._getSharedPath();
-        _sharedPath = headInstance->_getSharedPath(tailSharedPath);
-        if (!_sharedPath) _sharedPath = new SharedPath(headInstance, tailSharedPath);
+        _sharedPath = SharedPath::get(headInstance, tailSharedPath);
     }
 }
 
@@ -97,8 +92,7 @@ Path::Path(const Path& headPath, const Path& tailPath)
     for (vector<Instance*>::reverse_iterator rit=instances.rbegin() ; rit != instances.rend() ; rit++)
     { Instance* instance=*rit;
         SharedPath* sharedPath = _sharedPath;
-        _sharedPath = instance->_getSharedPath(sharedPath);
-        if (!_sharedPath) _sharedPath = new SharedPath(instance,sharedPath);
+        _sharedPath = SharedPath::get(instance, sharedPath);
     }
 }
 
@@ -123,8 +117,7 @@ Path::Path(Cell* cell, const string& pathName)
             while (instanceIterator != instanceList.rend()) {
                 Instance* headInstance = *instanceIterator;
                 SharedPath* tailSharedPath = _sharedPath;
-                _sharedPath = headInstance->_getSharedPath(tailSharedPath);
-                if (!_sharedPath) _sharedPath = new SharedPath(headInstance, tailSharedPath);
+                _sharedPath = SharedPath::get(headInstance, tailSharedPath);
                 ++instanceIterator;
             }
         }
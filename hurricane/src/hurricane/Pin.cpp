@@ -34,8 +34,7 @@ Pin::Pin(Net* net, const Name& name, const AccessDirection& accessDirection, con
 :  Inherit(net, layer, x, y, width, height),
     _name(name),
     _accessDirection(accessDirection),
-    _placementStatus(placementStatus),
-    _nextOfCellPinMap(NULL)
+    _placementStatus(placementStatus)
 {
     if (getCell()->getPin(name))
       throw Error("Can't create " + _TName("Pin") + " <" + getString(name) + "> : already exists");
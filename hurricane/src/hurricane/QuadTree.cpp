@@ -18,6 +18,7 @@
 // ****************************************************************************************************
 
 #include "hurricane/QuadTree.h"
+#include "hurricane/PackedRTree.h"
 #include "hurricane/Go.h"
 #include "hurricane/Instance.h"
 #include "hurricane/Error.h"
@@ -34,6 +35,11 @@ namespace Hurricane {
 #define QUAD_TREE_IMPLODE_THRESHOLD 80
 #define QUAD_TREE_EXPLODE_THRESHOLD 100
 
+// Batch mode (see QuadTree::openBatch()): the roots of the trees modified since the batch has been
+// opened, they are rebalanced when it is closed.
+static unsigned BATCH_DEPTH = 0;
+static set<QuadTree*>* BATCH_ROOTS = NULL;
+
 
 
 // ****************************************************************************************************
@@ -199,7 +205,8 @@ QuadTree::QuadTree()
     _ulChild(NULL),
     _urChild(NULL),
     _llChild(NULL),
-    _lrChild(NULL)
+    _lrChild(NULL),
+    _packedRTree(NULL)
 {
 }
 
@@ -214,7 +221,8 @@ QuadTree::QuadTree(QuadTree* parent)
     _ulChild(NULL),
     _urChild(NULL),
     _llChild(NULL),
-    _lrChild(NULL)
+    _lrChild(NULL),
+    _packedRTree(NULL)
 {
 }
 
@@ -225,6 +233,8 @@ QuadTree::~QuadTree()
     if (_urChild) delete _urChild;
     if (_llChild) delete _llChild;
     if (_lrChild) delete _lrChild;
+    if (_packedRTree) _packedRTree->_detach();
+    if (!_parent && BATCH_ROOTS) BATCH_ROOTS->erase(this);
 }
 
 //size_t  QuadTree::getLocatorAllocateds ()
@@ -251,12 +261,14 @@ const Box& QuadTree::getBoundingBox() const
 Gos QuadTree::getGos() const
 // *************************
 {
+    if (_packedRTree) return _packedRTree->getGos();
     return QuadTree_Gos(this);
 }
 
 Gos QuadTree::getGosUnder(const Box& area, DbU::Unit threshold) const
 // ******************************************************************
 {
+  if (_packedRTree) return _packedRTree->getGosUnder(area, threshold);
   return QuadTree_GosUnder(this, area, threshold);
 }
 
@@ -267,18 +279,23 @@ void QuadTree::insert(Go* go)
         throw Error("Can't insert go : null go");
 
     if (!go->isMaterialized()) {
+        unpack();
         Box boundingBox = go->getBoundingBox();
         QuadTree* child = _getDeepestChild(boundingBox);
         child->_goSet._insert(go);
         go->_quadTree = child;
         QuadTree* parent = child;
+        QuadTree* root = child;
         while (parent) {
             parent->_size++;
             if (parent->isEmpty() || !parent->_boundingBox.isEmpty())
                 parent->_boundingBox.merge(boundingBox);
+            root = parent;
             parent = parent->_parent;
         }
-        if (QUAD_TREE_EXPLODE_THRESHOLD <= child->_size)
+        if (BATCH_DEPTH)
+            BATCH_ROOTS->insert(root);
+        else if (QUAD_TREE_EXPLODE_THRESHOLD <= child->_size)
             child->_explode();
     }
 }
@@ -290,17 +307,24 @@ void QuadTree::remove(Go* go)
         throw Error("Can't remove go : null go");
 
     if (go->isMaterialized()) {
+        unpack();
         Box boundingBox = go->getBoundingBox();
         QuadTree* child = go->_quadTree;
         child->_goSet._remove(go);
         go->_quadTree = NULL;
         QuadTree* parent = child;
+        QuadTree* root = child;
         while (parent) {
             parent->_size--;
             if (parent->_boundingBox.isConstrainedBy(boundingBox))
                 parent->_boundingBox = Box();
+            root = parent;
             parent = parent->_parent;
         }
+        if (BATCH_DEPTH) {
+            BATCH_ROOTS->insert(root);
+            return;
+        }
         parent = child;
         while (parent) {
             if (!(parent->_size <= QUAD_TREE_IMPLODE_THRESHOLD))
@@ -311,6 +335,60 @@ void QuadTree::remove(Go* go)
     }
 }
 
+void QuadTree::pack()
+// ******************
+// Build the packed R-Tree over the current contents. It is dropped
+// as soon as a Go is inserted or removed, so it must only be built
+// once a Cell is no longer edited (after loading or placement).
+// Collections still iterating over a dropped tree keep it alive.
+{
+    if (_parent)
+        throw Error("Can't pack QuadTree : not the root of the tree");
+
+    if (_packedRTree) return;
+    getBoundingBox();
+    _packedRTree = new PackedRTree(QuadTree_Gos(this));
+}
+
+void QuadTree::unpack()
+// ********************
+{
+    if (_packedRTree) {
+        _packedRTree->_detach();
+        _packedRTree = NULL;
+    }
+}
+
+void QuadTree::openBatch()
+// ***********************
+// While a batch is opened, insert() & remove() only update the sizes and bounding boxes, the nodes
+// are neither exploded nor imploded. The modified trees are rebalanced at once when the outermost
+// batch is closed. This avoids the implode/explode churn when a large number of Gos are moved
+// (removed, then inserted back) in the same UpdateSession. The trees stay valid (only unbalanced)
+// during the batch.
+{
+    if (!BATCH_ROOTS) BATCH_ROOTS = new set<QuadTree*>();
+    BATCH_DEPTH++;
+}
+
+void QuadTree::closeBatch()
+// ************************
+{
+    if (!BATCH_DEPTH)
+        throw Error("Can't close QuadTree batch : no batch opened");
+
+    if (--BATCH_DEPTH) return;
+
+    for (QuadTree* root : *BATCH_ROOTS) root->_rebalance();
+    BATCH_ROOTS->clear();
+}
+
+bool QuadTree::isInBatch()
+// ***********************
+{
+    return (BATCH_DEPTH != 0);
+}
+
 string QuadTree::_getString() const
 // ********************************
 {
@@ -319,6 +397,7 @@ string QuadTree::_getString() const
         s += " empty";
     else
         s += " " + getString(_size);
+    if (_packedRTree) s += " packed";
     s += ">";
     return s;
 }
@@ -339,6 +418,7 @@ Record* QuadTree::_getRecord() const
     record->add( getSlot("_urChild"    ,  _urChild    ) );
     record->add( getSlot("_llChild"    ,  _llChild    ) );
     record->add( getSlot("_lrChild"    ,  _lrChild    ) );
+    record->add( getSlot("_packedRTree",  _packedRTree) );
   }
   return record;
 }
@@ -528,6 +608,30 @@ void QuadTree::_implode()
 
 
 
+void QuadTree::_rebalance()
+// ************************
+// Bring back the tree in the state the incremental insert() & remove() would have kept it in: the
+// sub-trees under the implode threshold are imploded, the leaves over the explode threshold are
+// exploded, recursively.
+{
+    if (_hasBeenExploded()) {
+        if (_size <= QUAD_TREE_IMPLODE_THRESHOLD) {
+            _implode();
+            return;
+        }
+    }
+    else {
+        if (_size < QUAD_TREE_EXPLODE_THRESHOLD) return;
+        _explode();
+    }
+    _ulChild->_rebalance();
+    _urChild->_rebalance();
+    _llChild->_rebalance();
+    _lrChild->_rebalance();
+}
+
+
+
 // ****************************************************************************************************
 // QuadTree::GoSet implementation
 // ****************************************************************************************************
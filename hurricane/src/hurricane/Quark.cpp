@@ -69,7 +69,7 @@ void Quark::_postCreate()
     SharedPath* sharedPath = _occurrence._getSharedPath();
 
     if (sharedPath)
-        sharedPath->_getQuarkMap()._insert(this);
+        sharedPath->_insertQuark(this);
     else {
         if (!NULL_SHARED_PATH_QUARK_MAP) NULL_SHARED_PATH_QUARK_MAP = new Quark_QuarkMap();
         NULL_SHARED_PATH_QUARK_MAP->_insert(this);
@@ -88,7 +88,7 @@ void Quark::_preDestroy()
   SharedPath* sharedPath = _occurrence._getSharedPath();
 
   if (sharedPath)
-    sharedPath->_getQuarkMap()._remove(this);
+    sharedPath->_removeQuark(this);
   else
     if (NULL_SHARED_PATH_QUARK_MAP) NULL_SHARED_PATH_QUARK_MAP->_remove(this);
 
@@ -18,6 +18,9 @@
 // ****************************************************************************************************
 
 #include <limits>
+#include <new>
+#include <mutex>
+#include <shared_mutex>
 #include "hurricane/SharedPath.h"
 #include "hurricane/Instance.h"
 #include "hurricane/Cell.h"
@@ -100,71 +103,200 @@ class SharedPath_Instances : public Collection<Instance*> {
 static char NAME_SEPARATOR = '.';
 
 
-SharedPath::SharedPath(Instance* headInstance, SharedPath* tailSharedPath)
-// ***********************************************************************
-  : _hash(0)
-  , _headInstance(headInstance)
-  , _tailSharedPath(tailSharedPath)
-  , _quarkMap()
-  , _nextOfInstanceSharedPathMap(NULL)
+
+// ****************************************************************************************************
+// SharedPath::Arena declaration
+// ****************************************************************************************************
+
+class SharedPath::Arena {
+// **********************
+// SharedPathes are allocated by chunks, the id of a SharedPath is it's index in the Arena. The ids
+// of the destroyed SharedPathes are reused first (LIFO), a bit per id tells if it is in use.
+
+    public: static const uint32_t ChunkShift = 12;
+    public: static const uint32_t ChunkSize  = 1 << ChunkShift;
+
+    private: vector<char*> _chunks;
+    private: vector<uint64_t> _alives;
+    private: vector<uint32_t> _frees;
+    private: uint32_t _next;
+    private: size_t _count;
+
+    public: Arena();
+
+    public: size_t getCount() const {return _count;};
+    public: size_t getAllocatedSize() const;
+    public: SharedPath* getSharedPath(uint32_t id) const;
+    public: void* allocate(uint32_t& id);
+    public: void release(uint32_t id);
+
+    private: void* _getMemory(uint32_t id) const;
+
+};
+
+static SharedPath::Table& getTable()
+// *********************************
+// Never destroyed, SharedPathes may be released by static destructors.
 {
-    if (!_headInstance)
+    static SharedPath::Table* table = new SharedPath::Table();
+    return *table;
+}
+
+static SharedPath::Arena& getArena()
+// *********************************
+{
+    static SharedPath::Arena* arena = new SharedPath::Arena();
+    return *arena;
+}
+
+
+
+// ****************************************************************************************************
+// SharedPath implementation
+// ****************************************************************************************************
+
+SharedPath* SharedPath::get(Instance* headInstance, SharedPath* tailSharedPath)
+// ****************************************************************************
+{
+    if (!headInstance)
         throw Error("Can't create " + _TName("SharedPath") + " : null head instance");
 
-    if (_headInstance->_getSharedPath(_tailSharedPath))
-        throw Error("Can't create " + _TName("SharedPath") + " : already exists");
+    SharedPath* sharedPath = find(headInstance, tailSharedPath);
+    if (sharedPath) return sharedPath;
+
+    // Another thread may have created it between the two locks.
+    std::unique_lock<std::shared_mutex> guard(getTable().getLock());
+    sharedPath = getTable().getElement(Key{headInstance, tailSharedPath});
+    if (!sharedPath) {
+        uint32_t id = npos;
+        void* memory = getArena().allocate(id);
+        try {
+            sharedPath = new (memory) SharedPath(id, headInstance, tailSharedPath);
+        }
+        catch ( ... ) {
+            getArena().release(id);
+            throw;
+        }
+    }
+    return sharedPath;
+}
+
+SharedPath* SharedPath::find(const Instance* headInstance, const SharedPath* tailSharedPath)
+// *****************************************************************************************
+{
+    if (!headInstance) return NULL;
+    std::shared_lock<std::shared_mutex> guard(getTable().getLock());
+    return getTable().getElement(Key{headInstance, tailSharedPath});
+}
+
+SharedPath* SharedPath::getFromId(uint32_t id)
+// *******************************************
+{
+    std::shared_lock<std::shared_mutex> guard(getTable().getLock());
+    return getArena().getSharedPath(id);
+}
+
+size_t SharedPath::getCount()
+// **************************
+{
+    std::shared_lock<std::shared_mutex> guard(getTable().getLock());
+    return getArena().getCount();
+}
 
-    if (_tailSharedPath && (_tailSharedPath->getOwnerCell() != _headInstance->getMasterCell()))
+size_t SharedPath::getAllocatedSize()
+// **********************************
+{
+    std::shared_lock<std::shared_mutex> guard(getTable().getLock());
+    return getArena().getAllocatedSize() + getTable()._getLength() * sizeof(Table::Slot);
+}
+
+unsigned long SharedPath::computeHash(const Instance* headInstance, const SharedPath* tailSharedPath)
+// *************************************************************************************************
+// Tail hash and head id are mixed through a 64 bits finalizer (splitmix64), so the paths sharing
+// the same head or the same tail do not collide as they did with the previous shifted sum.
+{
+    uint64_t hash = ((tailSharedPath) ? tailSharedPath->getHash() : 0) * 0x9e3779b97f4a7c15ULL;
+    hash += headInstance->getId() + 1;
+    hash ^= hash >> 30; hash *= 0xbf58476d1ce4e5b9ULL;
+    hash ^= hash >> 27; hash *= 0x94d049bb133111ebULL;
+    hash ^= hash >> 31;
+    return hash;
+}
+
+SharedPath::SharedPath(uint32_t id, Instance* headInstance, SharedPath* tailSharedPath)
+// ************************************************************************************
+// Only called by get(), with the Table lock held.
+  : _id(id)
+  , _instanceIndex(npos)
+  , _hash(0)
+  , _key{headInstance, tailSharedPath}
+  , _quarkMap(NULL)
+{
+    if (tailSharedPath && (tailSharedPath->getOwnerCell() != headInstance->getMasterCell()))
         throw Error( "Can't create %s, incompatible tail path between:\n"
                      "        - head instance %s\n"
                      "        - tail path %s\n"
                      "        - head owner %s\n"
                      "        - tail owner %s\n"
                    , _TName("SharedPath").c_str()
-                   , getString(_headInstance  ).c_str()
-                   , getString(_tailSharedPath).c_str()
-                   , getString(_headInstance  ->getMasterCell()).c_str()
-                   , getString(_tailSharedPath->getOwnerCell ()).c_str()
+                   , getString(headInstance  ).c_str()
+                   , getString(tailSharedPath).c_str()
+                   , getString(headInstance  ->getMasterCell()).c_str()
+                   , getString(tailSharedPath->getOwnerCell ()).c_str()
                    );
 
-    _hash = (_headInstance->getId() << 1) + ((_tailSharedPath) ? _tailSharedPath->getHash() << 1: 0);
-    _headInstance->_getSharedPathMap()._insert(this);
+    _hash = computeHash(headInstance, tailSharedPath);
+    getTable()._insert(this);
+    headInstance->_insertSharedPath(this);
 
-    cdebug_log(0,0) << "SharedPath::SharedPath() pathHash:" << getHash() << " \"" << this << "\"" << endl;
+    cdebug_log(0,0) << "SharedPath::SharedPath() id:" << _id << " pathHash:" << getHash() << " \"" << this << "\"" << endl;
 }
 
 SharedPath::~SharedPath()
 // **********************
 {
-    for_each_quark(quark, _getQuarks()) quark->destroy(); end_for;
+    if (_quarkMap) {
+        vector<Quark*> quarks;
+        _quarkMap->getElements().fill(quarks);
+        for (Quark* quark : quarks) quark->destroy();
+        delete _quarkMap;
+        _quarkMap = NULL;
+    }
 
-    Cell* cell = _headInstance->getCell();
+    Cell* cell = getOwnerCell();
     for_each_instance(instance, cell->getSlaveInstances()) {
-        SharedPath* sharedPath = instance->_getSharedPath(this);
-        if (sharedPath) delete sharedPath;
+        SharedPath* sharedPath = find(instance, this);
+        if (sharedPath) sharedPath->destroy();
         end_for;
     }
-    _headInstance->_getSharedPathMap()._remove(this);
+    std::unique_lock<std::shared_mutex> guard(getTable().getLock());
+    getTable()._remove(this);
+    getHeadInstance()->_removeSharedPath(this);
+}
+
+void SharedPath::destroy()
+// ***********************
+{
+    uint32_t id = _id;
+    this->~SharedPath();
+    std::unique_lock<std::shared_mutex> guard(getTable().getLock());
+    getArena().release(id);
 }
 
 SharedPath* SharedPath::getHeadSharedPath() const
 // **********************************************
 {
-    if (!_tailSharedPath) return NULL;
-
-    SharedPath* tailSharedPath = _tailSharedPath->getHeadSharedPath();
+    if (!getTailSharedPath()) return NULL;
 
-    SharedPath* headSharedPath = _headInstance->_getSharedPath(tailSharedPath);
+    SharedPath* tailSharedPath = getTailSharedPath()->getHeadSharedPath();
 
-    if (!headSharedPath) headSharedPath = new SharedPath(_headInstance, tailSharedPath);
-
-    return headSharedPath;
+    return get(getHeadInstance(), tailSharedPath);
 }
 
 Instance* SharedPath::getTailInstance() const
 // ******************************************
 {
-    return (_tailSharedPath) ? _tailSharedPath->getTailInstance() : _headInstance;
+    return (getTailSharedPath()) ? getTailSharedPath()->getTailInstance() : getHeadInstance();
 }
 
 char SharedPath::getNameSeparator()
@@ -187,11 +319,6 @@ string SharedPath::getName() const
     return name;
 }
 
-unsigned long  SharedPath::getHash() const
-// ***************************************
-//{ return (_headInstance->getId() << 1) + ((_tailSharedPath) ? _tailSharedPath->getHash() << 1: 0); }
-{ return _hash; }
-
 string SharedPath::getJsonString(unsigned long flags) const
 // ********************************************************
 {
@@ -212,7 +339,7 @@ string SharedPath::getJsonString(unsigned long flags) const
 Cell* SharedPath::getOwnerCell() const
 // ***********************************
 {
-    return _headInstance->getCell();
+    return getHeadInstance()->getCell();
 }
 
 Cell* SharedPath::getMasterCell() const
@@ -236,9 +363,9 @@ Instances SharedPath::getInstances() const
 Transformation SharedPath::getTransformation(const Transformation& transformation) const
 // *************************************************************************************
 {
-    Transformation headTransformation = _headInstance->getTransformation();
+    Transformation headTransformation = getHeadInstance()->getTransformation();
     Transformation tailTransformation =
-        (!_tailSharedPath) ? transformation : _tailSharedPath->getTransformation(transformation);
+        (!getTailSharedPath()) ? transformation : getTailSharedPath()->getTransformation(transformation);
     return headTransformation.getTransformation(tailTransformation);
 }
 
@@ -267,13 +394,131 @@ Record* SharedPath::_getRecord() const
 {
      Record* record = new Record(getString(this));
     if (record) {
-        record->add(getSlot("HeadInstance", _headInstance));
-        record->add(getSlot("TailSharedPath", _tailSharedPath));
-        record->add(getSlot("Quarks", &_quarkMap));
+        record->add(getSlot("Id", _id));
+        record->add(getSlot("Hash", _hash));
+        record->add(getSlot("HeadInstance", getHeadInstance()));
+        record->add(getSlot("TailSharedPath", getTailSharedPath()));
+        record->add(getSlot("Quarks", _quarkMap));
     }
     return record;
 }
 
+size_t SharedPath::_getMemorySize() const
+// **************************************
+{
+    size_t size = sizeof(SharedPath);
+    if (_quarkMap) size += sizeof(QuarkMap) + _quarkMap->_getLength() * sizeof(Quark*);
+    return size;
+}
+
+void SharedPath::_insertQuark(Quark* quark)
+// ****************************************
+{
+    if (!_quarkMap) _quarkMap = new QuarkMap();
+    _quarkMap->_insert(quark);
+}
+
+void SharedPath::_removeQuark(Quark* quark)
+// ****************************************
+{
+    if (!_quarkMap) return;
+    _quarkMap->_remove(quark);
+    if (_quarkMap->isEmpty()) {
+        delete _quarkMap;
+        _quarkMap = NULL;
+    }
+}
+
+
+
+// ****************************************************************************************************
+// SharedPath::Table implementation
+// ****************************************************************************************************
+
+SharedPath::Table::Table()
+// ***********************
+:    Inherit()
+{
+}
+
+const SharedPath::Key& SharedPath::Table::_getKey(SharedPath* sharedPath) const
+// ****************************************************************************
+{
+    return sharedPath->_key;
+}
+
+unsigned SharedPath::Table::_getHashValue(const Key& key) const
+// ************************************************************
+{
+    unsigned long hash = computeHash(key._headInstance, key._tailSharedPath);
+    return (unsigned)(hash ^ (hash >> 32));
+}
+
+
+
+// ****************************************************************************************************
+// SharedPath::Arena implementation
+// ****************************************************************************************************
+
+SharedPath::Arena::Arena()
+// ***********************
+:    _chunks(),
+    _alives(),
+    _frees(),
+    _next(0),
+    _count(0)
+{
+}
+
+size_t SharedPath::Arena::getAllocatedSize() const
+// ***********************************************
+{
+    return _chunks.size() * ChunkSize * sizeof(SharedPath)
+         + _alives.capacity() * sizeof(uint64_t)
+         + _frees .capacity() * sizeof(uint32_t);
+}
+
+void* SharedPath::Arena::_getMemory(uint32_t id) const
+// ***************************************************
+{
+    return _chunks[id >> ChunkShift] + (id & (ChunkSize-1)) * sizeof(SharedPath);
+}
+
+SharedPath* SharedPath::Arena::getSharedPath(uint32_t id) const
+// ************************************************************
+{
+    if ((id >= _next) || !(_alives[id/64] & (1ULL << (id%64)))) return NULL;
+    return static_cast<SharedPath*>(_getMemory(id));
+}
+
+void* SharedPath::Arena::allocate(uint32_t& id)
+// ********************************************
+{
+    if (!_frees.empty()) {
+        id = _frees.back();
+        _frees.pop_back();
+    }
+    else {
+        if (_next == npos)
+            throw Error("SharedPath::Arena::allocate(): No more SharedPath id available.");
+        id = _next++;
+        if (_chunks.size() <= (id >> ChunkShift))
+            _chunks.push_back(static_cast<char*>(::operator new(ChunkSize * sizeof(SharedPath))));
+        if (_alives.size() <= id/64) _alives.push_back(0);
+    }
+    _alives[id/64] |= (1ULL << (id%64));
+    ++_count;
+    return _getMemory(id);
+}
+
+void SharedPath::Arena::release(uint32_t id)
+// *****************************************
+{
+    _alives[id/64] &= ~(1ULL << (id%64));
+    _frees.push_back(id);
+    --_count;
+}
+
 
 
 // ****************************************************************************************************
@@ -0,0 +1,1442 @@
+// -*- C++ -*-
+//
+// Copyright (c) BULL S.A. 2000-2026, All Rights Reserved
+//
+// This file is part of Hurricane.
+//
+// Hurricane is free software: you can redistribute it  and/or  modify
+// it under the terms of the GNU  Lesser  General  Public  License  as
+// published by the Free Software Foundation, either version 3 of  the
+// License, or (at your option) any later version.
+//
+// Hurricane is distributed in the hope that it will  be  useful,  but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHAN-
+// TABILITY or FITNESS FOR A PARTICULAR PURPOSE. See  the  Lesser  GNU
+// General Public License for more details.
+//
+// You should have received a copy of the Lesser  GNU  General  Public
+// License along with Hurricane. If not, see
+//                                     <http://www.gnu.org/licenses/>.
+//
+// +-----------------------------------------------------------------+
+// |                  H U R R I C A N E                              |
+// |     V L S I   B a c k e n d   D a t a - B a s e                 |
+// |                                                                 |
+// |  Author      :                    Jean-Paul CHAPUT              |
+// |  E-mail      :            Jean-Paul.Chaput@lip6.fr              |
+// | =============================================================== |
+// |  C++ Module  :  "./Snapshot.cpp"                                |
+// +-----------------------------------------------------------------+
+
+
+#include <cstdio>
+#include <cstring>
+#include <unordered_map>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "hurricane/Error.h"
+#include "hurricane/Warning.h"
+#include "hurricane/DataBase.h"
+#include "hurricane/Technology.h"
+#include "hurricane/Layer.h"
+#include "hurricane/Library.h"
+#include "hurricane/SharedPath.h"
+#include "hurricane/Cell.h"
+#include "hurricane/Net.h"
+#include "hurricane/DeepNet.h"
+#include "hurricane/HyperNet.h"
+#include "hurricane/Instance.h"
+#include "hurricane/Plug.h"
+#include "hurricane/Contact.h"
+#include "hurricane/Pin.h"
+#include "hurricane/Horizontal.h"
+#include "hurricane/Vertical.h"
+#include "hurricane/Pad.h"
+#include "hurricane/RoutingPad.h"
+#include "hurricane/NetExternalComponents.h"
+#include "hurricane/UpdateSession.h"
+#include "hurricane/Snapshot.h"
+
+
+namespace {
+
+  using namespace std;
+  using namespace Hurricane;
+
+
+  const char      SnapshotMagic [8] = { 'H', 'U', 'R', 'S', 'N', 'A', 'P', '\n' };
+
+// The Cell states that are saved, the others are transient.
+  const uint64_t  SnapshotCellFlags = Cell::Flags::TerminalNetlist
+                                    | Cell::Flags::Pad
+                                    | Cell::Flags::Feed
+                                    | Cell::Flags::Diode
+                                    | Cell::Flags::PowerFeed
+                                    | Cell::Flags::FlattenedNets
+                                    | Cell::Flags::AbstractedSupply
+                                    | Cell::Flags::Placed
+                                    | Cell::Flags::Routed;
+
+  enum SectionKind   { StringSection     = 1
+                     , LayerSection      = 2
+                     , ExternalSection   = 3
+                     , CellSection       = 4
+                     , NetlistSection    = 5
+                     , ComponentSection  = 6
+                     , SectionCount      = 6
+                     };
+  enum ComponentKind { ContactKind       = 1
+                     , PinKind           = 2
+                     , HorizontalKind    = 3
+                     , VerticalKind      = 4
+                     , PadKind           = 5
+                     , RoutingPadKind    = 6
+                     };
+  enum EntityKind    { NetEntity         = 0
+                     , PlugEntity        = 1
+                     , LocalEntity       = 2
+                     , ComponentEntity   = 3
+                     };
+  enum NetBits       { NetExternal       = (1 << 0)
+                     , NetGlobal         = (1 << 1)
+                     , NetAutomatic      = (1 << 2)
+                     , NetDeep           = (1 << 3)
+                     };
+
+// Size of the fixed parts of the file.
+  const size_t  HeaderSize     = 32;
+  const size_t  SectionSize    = 24;
+  const size_t  CellRecordSize = 80;
+
+
+// Full path of a Library, from the root one, as expected by
+// DataBase::getLibrary() (Library::getHierarchicalName() omits the
+// root Library).
+  string  getLibraryPath ( const Library* library )
+  {
+    string rpath = getString( library->getName() );
+    for ( library=library->getLibrary() ; library ; library=library->getLibrary() )
+      rpath.insert( 0, getString(library->getName())+SharedPath::getNameSeparator() );
+    return rpath;
+  }
+
+
+// -------------------------------------------------------------------
+// Class  :  "::SnapshotBuffer".
+//
+// Growable output buffer, with the fixed size & variable length
+// encodings of the format.
+
+  class SnapshotBuffer {
+    public:
+      inline        SnapshotBuffer ();
+      inline size_t size           () const;
+      inline const  uint8_t* data  () const;
+      inline void   putU8          ( uint8_t );
+      inline void   putU32         ( uint32_t );
+      inline void   putU64         ( uint64_t );
+      inline void   putVarint      ( uint64_t );
+      inline void   putSigned      ( int64_t );
+      inline void   putDelta       ( DbU::Unit, DbU::Unit& last );
+      inline void   append         ( const SnapshotBuffer& );
+      inline void   align          ();
+    private:
+      vector<uint8_t>  _bytes;
+  };
+
+
+  inline                SnapshotBuffer::SnapshotBuffer () : _bytes() { }
+  inline size_t         SnapshotBuffer::size           () const { return _bytes.size(); }
+  inline const uint8_t* SnapshotBuffer::data           () const { return _bytes.data(); }
+  inline void           SnapshotBuffer::putU8          ( uint8_t value ) { _bytes.push_back( value ); }
+  inline void           SnapshotBuffer::append         ( const SnapshotBuffer& other ) { _bytes.insert( _bytes.end(), other._bytes.begin(), other._bytes.end() ); }
+  inline void           SnapshotBuffer::align          () { while (_bytes.size() % 8) _bytes.push_back( 0 ); }
+
+  inline void  SnapshotBuffer::putU32 ( uint32_t value )
+  { for ( size_t i=0 ; i<4 ; ++i ) _bytes.push_back( (value >> (8*i)) & 0xff ); }
+
+  inline void  SnapshotBuffer::putU64 ( uint64_t value )
+  { for ( size_t i=0 ; i<8 ; ++i ) _bytes.push_back( (value >> (8*i)) & 0xff ); }
+
+  inline void  SnapshotBuffer::putVarint ( uint64_t value )
+  {
+    while (value >= 0x80) {
+      _bytes.push_back( (value & 0x7f) | 0x80 );
+      value >>= 7;
+    }
+    _bytes.push_back( value );
+  }
+
+  inline void  SnapshotBuffer::putSigned ( int64_t value )
+  { putVarint( ((uint64_t)value << 1) ^ (uint64_t)(value >> 63) ); }
+
+  inline void  SnapshotBuffer::putDelta ( DbU::Unit value, DbU::Unit& last )
+  {
+    putSigned( value - last );
+    last = value;
+  }
+
+
+// -------------------------------------------------------------------
+// Class  :  "::SnapshotReader".
+//
+// Decoding counterpart of SnapshotBuffer, over a slice of the mapped
+// file. Reading past the end of the slice throws an Error (truncated
+// or corrupted file).
+
+  class SnapshotReader {
+    public:
+      inline           SnapshotReader ( const uint8_t* data, size_t size );
+      inline bool      atEnd          () const;
+      inline uint8_t   getU8          ();
+      inline uint32_t  getU32         ();
+      inline uint64_t  getU64         ();
+      inline uint64_t  getVarint      ();
+      inline int64_t   getSigned      ();
+      inline DbU::Unit getDelta       ( DbU::Unit& last );
+    private:
+      inline void      _check         ( size_t );
+    private:
+      const uint8_t*  _data;
+      const uint8_t*  _end;
+  };
+
+
+  inline  SnapshotReader::SnapshotReader ( const uint8_t* data, size_t size )
+    : _data(data), _end(data+size)
+  { }
+
+  inline bool  SnapshotReader::atEnd () const { return _data >= _end; }
+
+  inline void  SnapshotReader::_check ( size_t size )
+  {
+    if ((size_t)(_end - _data) < size)
+      throw Error( "Snapshot: Truncated or corrupted file." );
+  }
+
+  inline uint8_t  SnapshotReader::getU8 ()
+  {
+    _check( 1 );
+    return *_data++;
+  }
+
+  inline uint32_t  SnapshotReader::getU32 ()
+  {
+    _check( 4 );
+    uint32_t value = 0;
+    for ( size_t i=0 ; i<4 ; ++i ) value |= (uint32_t)_data[i] << (8*i);
+    _data += 4;
+    return value;
+  }
+
+  inline uint64_t  SnapshotReader::getU64 ()
+  {
+    _check( 8 );
+    uint64_t value = 0;
+    for ( size_t i=0 ; i<8 ; ++i ) value |= (uint64_t)_data[i] << (8*i);
+    _data += 8;
+    return value;
+  }
+
+  inline uint64_t  SnapshotReader::getVarint ()
+  {
+    uint64_t value = 0;
+    for ( unsigned shift=0 ; shift<64 ; shift+=7 ) {
+      uint8_t byte = getU8();
+      value |= (uint64_t)(byte & 0x7f) << shift;
+      if (not (byte & 0x80)) return value;
+    }
+    throw Error( "Snapshot: Corrupted varint." );
+  }
+
+  inline int64_t  SnapshotReader::getSigned ()
+  {
+    uint64_t value = getVarint();
+    return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+  }
+
+  inline DbU::Unit  SnapshotReader::getDelta ( DbU::Unit& last )
+  {
+    last += getSigned();
+    return last;
+  }
+
+
+// -------------------------------------------------------------------
+// Class  :  "::SnapshotFile".
+//
+// Read only image of the whole snapshot file, memory mapped, or read
+// in one go when it cannot be mapped.
+
+  class SnapshotFile {
+    public:
+                            SnapshotFile ( const string& path );
+                           ~SnapshotFile ();
+      inline const uint8_t* getData      () const;
+      inline       size_t   getSize      () const;
+    private:
+      const uint8_t*   _data;
+            size_t     _size;
+            bool       _mapped;
+      vector<uint8_t>  _copy;
+    private:
+                    SnapshotFile ( const SnapshotFile& );
+      SnapshotFile& operator=    ( const SnapshotFile& );
+  };
+
+
+  inline const uint8_t* SnapshotFile::getData () const { return _data; }
+  inline       size_t   SnapshotFile::getSize () const { return _size; }
+
+
+  SnapshotFile::SnapshotFile ( const string& path )
+    : _data  (NULL)
+    , _size  (0)
+    , _mapped(false)
+    , _copy  ()
+  {
+    int fd = ::open( path.c_str(), O_RDONLY );
+    if (fd < 0)
+      throw Error( "Snapshot::load(): Cannot open \"%s\".", path.c_str() );
+
+    struct stat infos;
+    if ((::fstat(fd,&infos) == 0) and S_ISREG(infos.st_mode) and (infos.st_size > 0)) {
+      void* data = ::mmap( NULL, infos.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+      if (data != MAP_FAILED) {
+        _data   = (const uint8_t*)data;
+        _size   = infos.st_size;
+        _mapped = true;
+      }
+    }
+
+    if (not _mapped) {
+      uint8_t chunk [ 1<<16 ];
+      ssize_t count = 0;
+      while ( (count = ::read(fd,chunk,sizeof(chunk))) > 0 )
+        _copy.insert( _copy.end(), chunk, chunk+count );
+      _data = _copy.data();
+      _size = _copy.size();
+    }
+
+    ::close( fd );
+  }
+
+
+  SnapshotFile::~SnapshotFile ()
+  {
+    if (_mapped) ::munmap( (void*)_data, _size );
+  }
+
+
+// -------------------------------------------------------------------
+// Class  :  "::SnapshotWriter".
+
+  class SnapshotWriter {
+    public:
+                     SnapshotWriter    ( Cell* );
+             void    write             ( const string& path );
+    private:
+             void    _collectCells     ();
+             uint32_t _getString       ( const string& );
+      inline uint32_t _getString       ( const Name& );
+             uint32_t _getLayer        ( const Layer* );
+             void    _writeCell        ( Cell* );
+             void    _writeNetlist     ( Cell*, SnapshotBuffer& );
+             void    _writeComponents  ( Cell*, SnapshotBuffer& );
+             void    _sortComponents   ( Cell*, vector<Component*>& );
+             void    _writeRef         ( Component*, SnapshotBuffer& );
+             void    _writeOccurrence  ( const Occurrence&, SnapshotBuffer& );
+    private:
+      struct CellEntry {
+        Cell*     _cell;
+        uint64_t  _netlistOffset;
+        uint64_t  _netlistSize;
+        uint64_t  _componentsOffset;
+        uint64_t  _componentsSize;
+      };
+    private:
+      Cell*                                     _top;
+      vector<string>                            _strings;
+      unordered_map<string,uint32_t>            _stringIds;
+      vector<const Layer*>                      _layers;
+      unordered_map<const Layer*,uint32_t>      _layerIds;
+      vector<Cell*>                             _externals;
+      unordered_map<const Cell*,uint32_t>       _externalIds;
+      vector<CellEntry>                         _cells;
+      unordered_map<const Cell*,uint32_t>       _cellIds;
+      unordered_map<const Component*,uint32_t>  _componentIds;
+      SnapshotBuffer                            _netlists;
+      SnapshotBuffer                            _components;
+      size_t                                    _skippeds;
+  };
+
+
+  SnapshotWriter::SnapshotWriter ( Cell* top )
+    : _top         (top)
+    , _strings     ()
+    , _stringIds   ()
+    , _layers      ()
+    , _layerIds    ()
+    , _externals   ()
+    , _externalIds ()
+    , _cells       ()
+    , _cellIds     ()
+    , _componentIds()
+    , _netlists    ()
+    , _components  ()
+    , _skippeds    (0)
+  { }
+
+
+  uint32_t  SnapshotWriter::_getString ( const string& s )
+  {
+    auto istring = _stringIds.find( s );
+    if (istring != _stringIds.end()) return (*istring).second;
+
+    uint32_t id = _strings.size();
+    _strings.push_back( s );
+    _stringIds.insert( make_pair(s,id) );
+    return id;
+  }
+
+
+  inline uint32_t  SnapshotWriter::_getString ( const Name& name )
+  { return _getString( getString(name) ); }
+
+
+  uint32_t  SnapshotWriter::_getLayer ( const Layer* layer )
+  {
+    auto ilayer = _layerIds.find( layer );
+    if (ilayer != _layerIds.end()) return (*ilayer).second;
+
+    uint32_t id = _layers.size();
+    _layers.push_back( layer );
+    _layerIds.insert( make_pair(layer,id) );
+    return id;
+  }
+
+
+// Depth first walk of the hierarchy, a Cell is appended after all the
+// Cells it instanciates, so they can be re-created in that order.
+  void  SnapshotWriter::_collectCells ()
+  {
+    vector< pair<Cell*,bool> >  stack;
+    unordered_map<const Cell*,bool>  visiteds;
+    stack.push_back( make_pair(_top,false) );
+
+    while ( not stack.empty() ) {
+      Cell* cell     = stack.back().first;
+      bool  expanded = stack.back().second;
+      if (expanded) {
+        stack.pop_back();
+        if (_cellIds.count(cell)) continue;
+        _cellIds.insert( make_pair(cell,(uint32_t)_cells.size()) );
+        _cells.push_back( CellEntry{ cell, 0, 0, 0, 0 } );
+        continue;
+      }
+      stack.back().second = true;
+      if (not visiteds.insert(make_pair(cell,true)).second) continue;
+
+      for ( Instance* instance : cell->getInstances() ) {
+        Cell* master = instance->getMasterCell();
+        if (master->isTerminalNetlist()) {
+          if (not _externalIds.count(master)) {
+            _externalIds.insert( make_pair(master,(uint32_t)_externals.size()) );
+            _externals.push_back( master );
+          }
+          continue;
+        }
+        if (not visiteds.count(master)) stack.push_back( make_pair(master,false) );
+      }
+    }
+  }
+
+
+  void  SnapshotWriter::_writeOccurrence ( const Occurrence& occurrence, SnapshotBuffer& buffer )
+  {
+    vector<Instance*>  instances;
+    Path path = occurrence.getPath();
+    while ( not path.isEmpty() ) {
+      instances.push_back( path.getHeadInstance() );
+      path = path.getTailPath();
+    }
+    buffer.putVarint( instances.size() );
+    for ( Instance* instance : instances ) buffer.putVarint( _getString(instance->getName()) );
+
+    Entity*    entity    = occurrence.getEntity();
+    Net*       net       = dynamic_cast<Net*>( entity );
+    Plug*      plug      = dynamic_cast<Plug*>( entity );
+    Component* component = dynamic_cast<Component*>( entity );
+    if (net) {
+      buffer.putU8    ( NetEntity );
+      buffer.putVarint( _getString(net->getName()) );
+    } else if (plug) {
+      buffer.putU8    ( PlugEntity );
+      buffer.putVarint( _getString(plug->getInstance()->getName()) );
+      buffer.putVarint( _getString(plug->getMasterNet()->getName()) );
+    } else if (component and instances.empty() and _componentIds.count(component)) {
+      buffer.putU8    ( LocalEntity );
+      buffer.putVarint( _componentIds[component] );
+    } else if (component) {
+      const Layer* layer = component->getLayer();
+      Box          bb    = component->getBoundingBox();
+      buffer.putU8    ( ComponentEntity );
+      buffer.putVarint( _getString(component->getNet()->getName()) );
+      buffer.putVarint( (layer) ? _getLayer(layer)+1 : 0 );
+      buffer.putSigned( bb.getXMin() );
+      buffer.putSigned( bb.getYMin() );
+      buffer.putSigned( bb.getXMax() );
+      buffer.putSigned( bb.getYMax() );
+    } else
+      throw Error( "Snapshot::save(): Unsupported occurrence %s.", getString(occurrence).c_str() );
+  }
+
+
+  void  SnapshotWriter::_writeNetlist ( Cell* cell, SnapshotBuffer& buffer )
+  {
+    unordered_map<const Net*,uint32_t>  netIds;
+    vector<Instance*>                   instances;
+    for ( Instance* instance : cell->getInstances() ) instances.push_back( instance );
+
+    DbU::Unit lastX = 0;
+    DbU::Unit lastY = 0;
+    buffer.putVarint( instances.size() );
+    for ( Instance* instance : instances ) {
+      Cell*                 master         = instance->getMasterCell();
+      const Transformation& transformation = instance->getTransformation();
+      uint64_t              masterRef      = (master->isTerminalNetlist())
+                                             ? ((uint64_t)_externalIds[master] << 1) | 1
+                                             : ((uint64_t)_cellIds    [master] << 1);
+      buffer.putVarint( _getString(instance->getName()) );
+      buffer.putVarint( masterRef );
+      buffer.putU8    ( transformation.getOrientation().getCode() );
+      buffer.putU8    ( instance->getPlacementStatus().getCode() );
+      buffer.putDelta ( transformation.getTx(), lastX );
+      buffer.putDelta ( transformation.getTy(), lastY );
+    }
+
+    vector<Net*>  nets;
+    for ( Net* net : cell->getNets() ) {
+      netIds.insert( make_pair(net,(uint32_t)nets.size()) );
+      nets.push_back( net );
+    }
+    buffer.putVarint( nets.size() );
+    for ( Net* net : nets ) {
+      uint8_t bits = 0;
+      if (net->isExternal ()) bits |= NetExternal;
+      if (net->isGlobal   ()) bits |= NetGlobal;
+      if (net->isAutomatic()) bits |= NetAutomatic;
+      if (net->isDeepNet  ()) bits |= NetDeep;
+      buffer.putVarint( _getString(net->getName()) );
+      buffer.putU8    ( bits );
+      buffer.putVarint( net->getType().getCode() );
+      buffer.putVarint( net->getDirection().getCode() );
+      if (net->isDeepNet())
+        _writeOccurrence( static_cast<DeepNet*>(net)->getRootNetOccurrence(), buffer );
+    }
+
+    for ( Instance* instance : instances ) {
+      vector<Plug*>  plugs;
+      for ( Plug* plug : instance->getConnectedPlugs() ) plugs.push_back( plug );
+      buffer.putVarint( plugs.size() );
+      for ( Plug* plug : plugs ) {
+        buffer.putVarint( _getString(plug->getMasterNet()->getName()) );
+        buffer.putVarint( netIds[plug->getNet()] );
+      }
+    }
+  }
+
+
+// The Components are ordered so that the ones a Component depends on
+// (Contact anchor, Segment source & target, RoutingPad on a local
+// Component) come before it. Plugs are not saved, they are referenced
+// through their Instance. Unsupported Components are skipped.
+  void  SnapshotWriter::_sortComponents ( Cell* cell, vector<Component*>& components )
+  {
+    enum State { Unvisited=0, Visiting, Done };
+    unordered_map<const Component*,State>  states;
+    vector< pair<Component*,bool> >        stack;
+
+    auto isSupported = [&]( Component* component ) {
+      if (dynamic_cast<Plug*>(component)) return false;
+      return (dynamic_cast<Contact   *>(component) != NULL)
+          or (dynamic_cast<Horizontal*>(component) != NULL)
+          or (dynamic_cast<Vertical  *>(component) != NULL)
+          or (dynamic_cast<Pad       *>(component) != NULL)
+          or (dynamic_cast<RoutingPad*>(component) != NULL);
+    };
+    auto pushDependency = [&]( Component* dependency ) {
+      if (dependency and isSupported(dependency) and (states[dependency] == Unvisited))
+        stack.push_back( make_pair(dependency,false) );
+    };
+
+    for ( Net* net : cell->getNets() ) {
+      for ( Component* root : net->getComponents() ) {
+        if (dynamic_cast<Plug*>(root)) continue;
+        if (not isSupported(root)) { ++_skippeds; continue; }
+        if (states[root] != Unvisited) continue;
+
+        stack.push_back( make_pair(root,false) );
+        while ( not stack.empty() ) {
+          Component* component = stack.back().first;
+          if (stack.back().second) {
+            stack.pop_back();
+            if (states[component] == Done) continue;
+            states[component] = Done;
+            _componentIds.insert( make_pair(component,(uint32_t)components.size()) );
+            components.push_back( component );
+            continue;
+          }
+          if (states[component] == Done) { stack.pop_back(); continue; }
+          if (states[component] == Visiting)
+            throw Error( "Snapshot::save(): Cycle in the anchors of %s.", getString(component).c_str() );
+          states[component] = Visiting;
+          stack.back().second = true;
+
+          Contact*    contact    = dynamic_cast<Contact*>   ( component );
+          Segment*    segment    = dynamic_cast<Segment*>   ( component );
+          RoutingPad* routingPad = dynamic_cast<RoutingPad*>( component );
+          if (contact) pushDependency( contact->getAnchor() );
+          if (segment) {
+            pushDependency( segment->getSource() );
+            pushDependency( segment->getTarget() );
+          }
+          if (routingPad and routingPad->getOccurrence().getPath().isEmpty())
+            pushDependency( dynamic_cast<Component*>(routingPad->getOccurrence().getEntity()) );
+        }
+      }
+    }
+  }
+
+
+  void  SnapshotWriter::_writeRef ( Component* component, SnapshotBuffer& buffer )
+  {
+    if (not component) { buffer.putVarint( 0 ); return; }
+
+    Plug* plug = dynamic_cast<Plug*>( component );
+    if (plug) {
+      buffer.putVarint( ((uint64_t)_getString(plug->getInstance()->getName()) << 1) | 1 );
+      buffer.putVarint( _getString(plug->getMasterNet()->getName()) );
+      return;
+    }
+
+    auto icomponent = _componentIds.find( component );
+    if (icomponent == _componentIds.end()) {
+      ++_skippeds;
+      buffer.putVarint( 0 );
+      return;
+    }
+    buffer.putVarint( ((uint64_t)(*icomponent).second + 1) << 1 );
+  }
+
+
+  void  SnapshotWriter::_writeComponents ( Cell* cell, SnapshotBuffer& buffer )
+  {
+    vector<Component*>  components;
+    _componentIds.clear();
+    _sortComponents( cell, components );
+
+    DbU::Unit lastX = 0;
+    DbU::Unit lastY = 0;
+    buffer.putVarint( components.size() );
+    for ( Component* component : components ) {
+      Pin*        pin        = dynamic_cast<Pin*>       ( component );
+      Contact*    contact    = dynamic_cast<Contact*>   ( component );
+      Horizontal* horizontal = dynamic_cast<Horizontal*>( component );
+      Vertical*   vertical   = dynamic_cast<Vertical*>  ( component );
+      Pad*        pad        = dynamic_cast<Pad*>       ( component );
+      RoutingPad* routingPad = dynamic_cast<RoutingPad*>( component );
+
+      uint8_t kind = 0;
+      if      (pin       ) kind = PinKind;
+      else if (contact   ) kind = ContactKind;
+      else if (horizontal) kind = HorizontalKind;
+      else if (vertical  ) kind = VerticalKind;
+      else if (pad       ) kind = PadKind;
+      else if (routingPad) kind = RoutingPadKind;
+
+      buffer.putU8    ( kind );
+      buffer.putVarint( _getString(component->getNet()->getName()) );
+      buffer.putU8    ( NetExternalComponents::isExternal(component) ? 1 : 0 );
+
+      switch ( kind ) {
+        case PinKind:
+          buffer.putVarint( _getString(pin->getName()) );
+          buffer.putU8    ( pin->getAccessDirection().getCode() );
+          buffer.putU8    ( pin->getPlacementStatus().getCode() );
+          buffer.putVarint( _getLayer(pin->getLayer()) );
+          buffer.putDelta ( pin->getX(), lastX );
+          buffer.putDelta ( pin->getY(), lastY );
+          buffer.putSigned( pin->getWidth () );
+          buffer.putSigned( pin->getHeight() );
+          break;
+        case ContactKind: {
+          Component* anchor = contact->getAnchor();
+          buffer.putVarint( _getLayer(contact->getLayer()) );
+          _writeRef( anchor, buffer );
+          if (anchor) {
+            buffer.putSigned( contact->getDx() );
+            buffer.putSigned( contact->getDy() );
+          } else {
+            buffer.putDelta( contact->getDx(), lastX );
+            buffer.putDelta( contact->getDy(), lastY );
+          }
+          buffer.putSigned( contact->getWidth () );
+          buffer.putSigned( contact->getHeight() );
+          break;
+        }
+        case HorizontalKind:
+          buffer.putVarint( _getLayer(horizontal->getLayer()) );
+          _writeRef( horizontal->getSource(), buffer );
+          _writeRef( horizontal->getTarget(), buffer );
+          buffer.putDelta ( horizontal->getY(), lastY );
+          buffer.putSigned( horizontal->getWidth() );
+          buffer.putDelta ( horizontal->getDxSource(), lastX );
+          buffer.putSigned( horizontal->getDxTarget() - horizontal->getDxSource() );
+          break;
+        case VerticalKind:
+          buffer.putVarint( _getLayer(vertical->getLayer()) );
+          _writeRef( vertical->getSource(), buffer );
+          _writeRef( vertical->getTarget(), buffer );
+          buffer.putDelta ( vertical->getX(), lastX );
+          buffer.putSigned( vertical->getWidth() );
+          buffer.putDelta ( vertical->getDySource(), lastY );
+          buffer.putSigned( vertical->getDyTarget() - vertical->getDySource() );
+          break;
+        case PadKind: {
+          Box bb = pad->getBoundingBox();
+          buffer.putVarint( _getLayer(pad->getLayer()) );
+          buffer.putDelta ( bb.getXMin(), lastX );
+          buffer.putDelta ( bb.getYMin(), lastY );
+          buffer.putSigned( bb.getWidth () );
+          buffer.putSigned( bb.getHeight() );
+          break;
+        }
+        case RoutingPadKind:
+          _writeOccurrence( routingPad->getOccurrence(), buffer );
+          buffer.putVarint( routingPad->getFlags() );
+          if (routingPad->hasUserCenter()) {
+            buffer.putSigned( routingPad->getUserCenter().getX() );
+            buffer.putSigned( routingPad->getUserCenter().getY() );
+          }
+          break;
+      }
+    }
+  }
+
+
+  void  SnapshotWriter::_writeCell ( Cell* cell )
+  {
+    CellEntry& entry = _cells[ _cellIds[cell] ];
+    if (Snapshot::isPending(cell)) Snapshot::materialize( cell );
+
+    entry._netlistOffset = _netlists.size();
+    _writeNetlist( cell, _netlists );
+    entry._netlistSize   = _netlists.size() - entry._netlistOffset;
+
+    entry._componentsOffset = _components.size();
+    _writeComponents( cell, _components );
+    entry._componentsSize   = _components.size() - entry._componentsOffset;
+  }
+
+
+  void  SnapshotWriter::write ( const string& path )
+  {
+    _collectCells();
+    for ( CellEntry& entry : _cells ) _writeCell( entry._cell );
+
+    SnapshotBuffer layers;
+    layers.putU32( _layers.size() );
+    for ( const Layer* layer : _layers ) layers.putU32( _getString(layer->getName()) );
+
+    SnapshotBuffer externals;
+    externals.putU32( _externals.size() );
+    for ( Cell* cell : _externals ) externals.putU32( _getString(getLibraryPath(cell->getLibrary())
+                                                   +SharedPath::getNameSeparator()
+                                                   +getString(cell->getName())) );
+
+    SnapshotBuffer cells;
+    cells.putU32( _cells.size() );
+    cells.putU32( 0 );
+    for ( const CellEntry& entry : _cells ) {
+      const Box& ab = entry._cell->getAbutmentBox();
+      cells.putU32( _getString(entry._cell->getName()) );
+      cells.putU32( _getString(getLibraryPath(entry._cell->getLibrary())) );
+      cells.putU64( entry._cell->getFlags() & SnapshotCellFlags );
+      cells.putU64( ab.getXMin() );
+      cells.putU64( ab.getYMin() );
+      cells.putU64( ab.getXMax() );
+      cells.putU64( ab.getYMax() );
+      cells.putU64( entry._netlistOffset );
+      cells.putU64( entry._netlistSize );
+      cells.putU64( entry._componentsOffset );
+      cells.putU64( entry._componentsSize );
+    }
+
+  // The string table is built last, the other sections add names to it.
+    SnapshotBuffer strings;
+    strings.putU32( _strings.size() );
+    uint32_t stringOffset = 0;
+    for ( const string& s : _strings ) {
+      strings.putU32( stringOffset );
+      stringOffset += s.size();
+    }
+    strings.putU32( stringOffset );
+    for ( const string& s : _strings ) {
+      for ( char c : s ) strings.putU8( c );
+    }
+
+    const SnapshotBuffer* sections [SectionCount] = { &strings, &layers, &externals, &cells, &_netlists, &_components };
+
+    SnapshotBuffer file;
+    for ( char c : SnapshotMagic ) file.putU8( c );
+    file.putU32( Snapshot::Version );
+    file.putU32( SectionCount );
+    uint64_t resolution = 0;
+    double   dbuResolution = DbU::getResolution();
+    memcpy( &resolution, &dbuResolution, sizeof(double) );
+    file.putU64( resolution );
+    file.putU64( 0 );
+
+    uint64_t offset = HeaderSize + SectionCount*SectionSize;
+    for ( size_t isection=0 ; isection<SectionCount ; ++isection ) {
+      offset = (offset + 7) & ~(uint64_t)7;
+      file.putU32( isection+1 );
+      file.putU32( 0 );
+      file.putU64( offset );
+      file.putU64( sections[isection]->size() );
+      offset += sections[isection]->size();
+    }
+    for ( size_t isection=0 ; isection<SectionCount ; ++isection ) {
+      file.align();
+      file.append( *sections[isection] );
+    }
+
+    FILE* fd = fopen( path.c_str(), "wb" );
+    if (not fd)
+      throw Error( "Snapshot::save(): Cannot open \"%s\" for writing.", path.c_str() );
+    size_t written = fwrite( file.data(), 1, file.size(), fd );
+    fclose( fd );
+    if (written != file.size())
+      throw Error( "Snapshot::save(): Failed to write \"%s\".", path.c_str() );
+
+    if (_skippeds)
+      cerr << Warning( "Snapshot::save(): %u unsupported components (or references to) were not saved."
+                     , (unsigned int)_skippeds ) << endl;
+  }
+
+
+}  // Anonymous namespace.
+
+
+namespace Hurricane {
+
+
+// -------------------------------------------------------------------
+// Class  :  "Snapshot::Loader".
+//
+// Keeps the snapshot file mapped and decodes it. Shared with the
+// Pending properties of the Cells whose Components are not created
+// yet, so the file is unmapped when the last one is materialized.
+
+  class Snapshot::Loader : public std::enable_shared_from_this<Snapshot::Loader> {
+    public:
+                  Loader            ( const string& path );
+      Cell*       load              ( uint32_t flags );
+      void        materialize       ( uint32_t icell );
+    private:
+      struct CellEntry {
+        Cell*           _cell;
+        const uint8_t*  _netlist;
+        uint64_t        _netlistSize;
+        const uint8_t*  _components;
+        uint64_t        _componentsSize;
+      };
+    private:
+      void        _readSections     ();
+      Cell*       _readCell         ( SnapshotReader&, uint32_t icell );
+      void        _readNetlist      ( CellEntry& );
+      Occurrence  _readOccurrence   ( SnapshotReader&, Cell*, const vector<Component*>* );
+      Component*  _readRef          ( SnapshotReader&, Cell*, const vector<Component*>& );
+      Net*        _getNet           ( Cell*, uint32_t sid, unordered_map<uint32_t,Net*>& );
+      Name        _getName          ( uint64_t sid ) const;
+      const Layer* _getLayer        ( uint64_t ilayer ) const;
+    private:
+      string                _path;
+      SnapshotFile          _file;
+      vector<string>        _strings;
+      vector<Name>          _names;
+      vector<const Layer*>  _layers;
+      vector<Cell*>         _externals;
+      vector<CellEntry>     _cells;
+  };
+
+
+  Snapshot::Loader::Loader ( const string& path )
+    : _path     (path)
+    , _file     (path)
+    , _strings  ()
+    , _names    ()
+    , _layers   ()
+    , _externals()
+    , _cells    ()
+  { }
+
+
+  Name  Snapshot::Loader::_getName ( uint64_t sid ) const
+  {
+    if (sid >= _names.size())
+      throw Error( "Snapshot::load(): Bad string index %llu in \"%s\"."
+                 , (unsigned long long)sid, _path.c_str() );
+    return _names[sid];
+  }
+
+
+  const Layer* Snapshot::Loader::_getLayer ( uint64_t ilayer ) const
+  {
+    if (ilayer >= _layers.size())
+      throw Error( "Snapshot::load(): Bad layer index %llu in \"%s\"."
+                 , (unsigned long long)ilayer, _path.c_str() );
+    return _layers[ilayer];
+  }
+
+
+  void  Snapshot::Loader::_readSections ()
+  {
+    SnapshotReader header ( _file.getData(), _file.getSize() );
+    for ( char c : SnapshotMagic ) {
+      if (header.getU8() != (uint8_t)c)
+        throw Error( "Snapshot::load(): \"%s\" is not a snapshot file.", _path.c_str() );
+    }
+    uint32_t version = header.getU32();
+    if (version != Snapshot::Version)
+      throw Error( "Snapshot::load(): \"%s\" is version %u, only version %u is supported."
+                 , _path.c_str(), version, Snapshot::Version );
+
+    uint32_t sectionCount  = header.getU32();
+    uint64_t resolution    = header.getU64();
+    double   dbuResolution = 0.0;
+    memcpy( &dbuResolution, &resolution, sizeof(double) );
+    header.getU64();
+    if (dbuResolution != DbU::getResolution())
+      throw Error( "Snapshot::load(): \"%s\" was saved with a DbU resolution of %g (current is %g)."
+                 , _path.c_str(), dbuResolution, DbU::getResolution() );
+
+    const uint8_t* sections [SectionCount+1];
+    uint64_t       sizes    [SectionCount+1];
+    for ( size_t i=0 ; i<=SectionCount ; ++i ) { sections[i] = NULL; sizes[i] = 0; }
+    for ( uint32_t isection=0 ; isection<sectionCount ; ++isection ) {
+      uint32_t kind   = header.getU32();
+      header.getU32();
+      uint64_t offset = header.getU64();
+      uint64_t size   = header.getU64();
+      if ((offset > _file.getSize()) or (size > _file.getSize() - offset))
+        throw Error( "Snapshot::load(): Section %u out of the file \"%s\".", kind, _path.c_str() );
+      if ((kind == 0) or (kind > SectionCount)) continue;
+      sections[kind] = _file.getData() + offset;
+      sizes   [kind] = size;
+    }
+    for ( size_t kind=1 ; kind<=SectionCount ; ++kind ) {
+      if (not sections[kind])
+        throw Error( "Snapshot::load(): Missing section %u in \"%s\".", (unsigned)kind, _path.c_str() );
+    }
+
+    SnapshotReader strings ( sections[StringSection], sizes[StringSection] );
+    uint32_t stringCount = strings.getU32();
+    vector<uint32_t>  offsets;
+    offsets.reserve( stringCount+1 );
+    for ( uint32_t i=0 ; i<=stringCount ; ++i ) offsets.push_back( strings.getU32() );
+    const char* chars    = (const char*)sections[StringSection] + 4*(stringCount+2);
+    uint64_t    maxChars = sizes[StringSection] - 4*(stringCount+2);
+    if (offsets.back() > maxChars)
+      throw Error( "Snapshot::load(): Corrupted string table in \"%s\".", _path.c_str() );
+    _strings.reserve( stringCount );
+    _names  .reserve( stringCount );
+    for ( uint32_t i=0 ; i<stringCount ; ++i ) {
+      _strings.push_back( string( chars+offsets[i], offsets[i+1]-offsets[i] ) );
+      _names  .push_back( Name(_strings.back()) );
+    }
+
+    Technology*    technology = DataBase::getDB()->getTechnology();
+    SnapshotReader layers ( sections[LayerSection], sizes[LayerSection] );
+    uint32_t       layerCount = layers.getU32();
+    for ( uint32_t i=0 ; i<layerCount ; ++i ) {
+      Name         name  = _getName( layers.getU32() );
+      const Layer* layer = (technology) ? technology->getLayer( name ) : NULL;
+      if (not layer)
+        throw Error( "Snapshot::load(): Unknown layer \"%s\".", getString(name).c_str() );
+      _layers.push_back( layer );
+    }
+
+    SnapshotReader externals ( sections[ExternalSection], sizes[ExternalSection] );
+    uint32_t       externalCount = externals.getU32();
+    for ( uint32_t i=0 ; i<externalCount ; ++i ) {
+      uint32_t sid  = externals.getU32();
+      _getName( sid );
+      Cell*    cell = DataBase::getDB()->getCell( _strings[sid], DataBase::NoFlags );
+      if (not cell)
+        throw Error( "Snapshot::load(): Cannot find master cell \"%s\".", _strings[sid].c_str() );
+      _externals.push_back( cell );
+    }
+
+    SnapshotReader cells     ( sections[CellSection], sizes[CellSection] );
+    uint32_t       cellCount = cells.getU32();
+    cells.getU32();
+    if ((cellCount == 0) or (sizes[CellSection] < 8 + (uint64_t)cellCount*CellRecordSize))
+      throw Error( "Snapshot::load(): Corrupted cell table in \"%s\".", _path.c_str() );
+    for ( uint32_t icell=0 ; icell<cellCount ; ++icell ) {
+      Cell* cell = _readCell( cells, icell );
+      uint64_t netlistOffset    = cells.getU64();
+      uint64_t netlistSize      = cells.getU64();
+      uint64_t componentsOffset = cells.getU64();
+      uint64_t componentsSize   = cells.getU64();
+      if (   (netlistOffset    > sizes[NetlistSection  ]) or (netlistSize    > sizes[NetlistSection  ] - netlistOffset   )
+          or (componentsOffset > sizes[ComponentSection]) or (componentsSize > sizes[ComponentSection] - componentsOffset) )
+        throw Error( "Snapshot::load(): Corrupted cell table in \"%s\".", _path.c_str() );
+      _cells.push_back( CellEntry{ cell
+                                 , sections[NetlistSection  ] + netlistOffset   , netlistSize
+                                 , sections[ComponentSection] + componentsOffset, componentsSize } );
+    }
+  }
+
+
+  Cell* Snapshot::Loader::_readCell ( SnapshotReader& reader, uint32_t icell )
+  {
+    Name      name     = _getName( reader.getU32() );
+    uint32_t  libSid   = reader.getU32();
+    uint64_t  flags    = reader.getU64();
+    DbU::Unit xMin     = (DbU::Unit)reader.getU64();
+    DbU::Unit yMin     = (DbU::Unit)reader.getU64();
+    DbU::Unit xMax     = (DbU::Unit)reader.getU64();
+    DbU::Unit yMax     = (DbU::Unit)reader.getU64();
+
+    _getName( libSid );
+    Library* library = DataBase::getDB()->getLibrary( _strings[libSid]
+                                                    , DataBase::CreateLib|DataBase::WarnCreateLib );
+    if (library->getCell(name))
+      throw Error( "Snapshot::load(): Cell \"%s\" already exists in library \"%s\"."
+                 , getString(name).c_str(), _strings[libSid].c_str() );
+
+    Cell* cell = Cell::create( library, name );
+    cell->setAbutmentBox( Box(xMin,yMin,xMax,yMax) );
+    cell->setFlags( flags & SnapshotCellFlags );
+    return cell;
+  }
+
+
+  Occurrence  Snapshot::Loader::_readOccurrence ( SnapshotReader& reader, Cell* cell, const vector<Component*>* locals )
+  {
+    Path     path;
+    Cell*    master = cell;
+    uint64_t depth  = reader.getVarint();
+    for ( uint64_t i=0 ; i<depth ; ++i ) {
+      Name      name     = _getName( reader.getVarint() );
+      Instance* instance = master->getInstance( name );
+      if (not instance)
+        throw Error( "Snapshot::load(): No instance \"%s\" in %s."
+                   , getString(name).c_str(), getString(master).c_str() );
+      path   = Path( path, instance );
+      master = instance->getMasterCell();
+    }
+
+    Entity* entity = NULL;
+    switch ( reader.getU8() ) {
+      case NetEntity:
+        entity = master->getNet( _getName(reader.getVarint()) );
+        break;
+      case PlugEntity: {
+        Instance* instance  = master->getInstance( _getName(reader.getVarint()) );
+        Name      netName   = _getName( reader.getVarint() );
+        Net*      masterNet = (instance) ? instance->getMasterCell()->getNet( netName ) : NULL;
+        if (masterNet) entity = instance->getPlug( masterNet );
+        break;
+      }
+      case LocalEntity: {
+        uint64_t icomponent = reader.getVarint();
+        if (locals and (icomponent < locals->size())) entity = (*locals)[icomponent];
+        break;
+      }
+      case ComponentEntity: {
+        Name         netName = _getName( reader.getVarint() );
+        uint64_t     ilayer  = reader.getVarint();
+        const Layer* layer   = (ilayer) ? _getLayer( ilayer-1 ) : NULL;
+        DbU::Unit    xMin    = reader.getSigned();
+        DbU::Unit    yMin    = reader.getSigned();
+        DbU::Unit    xMax    = reader.getSigned();
+        DbU::Unit    yMax    = reader.getSigned();
+        Box          bb      ( xMin, yMin, xMax, yMax );
+
+        if (Snapshot::isPending(master)) Snapshot::materialize( master );
+        Net* net = master->getNet( netName );
+        if (net) {
+          for ( Component* component : net->getComponents() ) {
+            if (dynamic_cast<Plug*>(component)) continue;
+            if ((component->getLayer() == layer) and (component->getBoundingBox() == bb)) {
+              entity = component;
+              break;
+            }
+          }
+        }
+        break;
+      }
+      default:
+        throw Error( "Snapshot::load(): Bad occurrence entity in \"%s\".", _path.c_str() );
+    }
+
+    if (not entity)
+      throw Error( "Snapshot::load(): Cannot find the entity of an occurrence in %s (path:\"%s\")."
+                 , getString(master).c_str(), path.getName().c_str() );
+    return Occurrence( entity, path );
+  }
+
+
+  Component* Snapshot::Loader::_readRef ( SnapshotReader& reader, Cell* cell, const vector<Component*>& components )
+  {
+    uint64_t ref = reader.getVarint();
+    if (not ref) return NULL;
+
+    if (ref & 1) {
+      Name      instanceName = _getName( ref >> 1 );
+      Name      netName      = _getName( reader.getVarint() );
+      Instance* instance     = cell->getInstance( instanceName );
+      Net*      masterNet    = (instance) ? instance->getMasterCell()->getNet( netName ) : NULL;
+      if (not masterNet)
+        throw Error( "Snapshot::load(): No plug \"%s.%s\" in %s."
+                   , getString(instanceName).c_str(), getString(netName).c_str(), getString(cell).c_str() );
+      return instance->getPlug( masterNet );
+    }
+
+    uint64_t icomponent = (ref >> 1) - 1;
+    if (icomponent >= components.size())
+      throw Error( "Snapshot::load(): Forward component reference in %s.", getString(cell).c_str() );
+    return components[icomponent];
+  }
+
+
+  Net* Snapshot::Loader::_getNet ( Cell* cell, uint32_t sid, unordered_map<uint32_t,Net*>& nets )
+  {
+    auto inet = nets.find( sid );
+    if (inet != nets.end()) return (*inet).second;
+
+    Net* net = cell->getNet( _getName(sid) );
+    if (not net)
+      throw Error( "Snapshot::load(): No net \"%s\" in %s."
+                 , _strings[sid].c_str(), getString(cell).c_str() );
+    nets.insert( make_pair(sid,net) );
+    return net;
+  }
+
+
+  void  Snapshot::Loader::_readNetlist ( CellEntry& entry )
+  {
+    Cell*          cell   = entry._cell;
+    SnapshotReader reader ( entry._netlist, entry._netlistSize );
+
+    uint64_t          instanceCount = reader.getVarint();
+    vector<Instance*> instances;
+    instances.reserve( instanceCount );
+    cell->openBulkBuild( 0, instanceCount );
+
+    DbU::Unit lastX = 0;
+    DbU::Unit lastY = 0;
+    for ( uint64_t i=0 ; i<instanceCount ; ++i ) {
+      Name     name        = _getName( reader.getVarint() );
+      uint64_t masterRef   = reader.getVarint();
+      uint8_t  orientation = reader.getU8();
+      uint8_t  status      = reader.getU8();
+      DbU::Unit tx         = reader.getDelta( lastX );
+      DbU::Unit ty         = reader.getDelta( lastY );
+
+      uint64_t imaster = masterRef >> 1;
+      Cell*    master  = NULL;
+      if (masterRef & 1) { if (imaster < _externals.size()) master = _externals[imaster]; }
+      else               { if (imaster < _cells.size()   ) master = _cells[imaster]._cell; }
+      if (not master or (master == cell) or (orientation > Transformation::Orientation::YR))
+        throw Error( "Snapshot::load(): Corrupted instance \"%s\" in %s."
+                   , getString(name).c_str(), getString(cell).c_str() );
+
+      instances.push_back( Instance::create( cell
+                                           , name
+                                           , master
+                                           , Transformation( tx, ty, (Transformation::Orientation::Code)orientation )
+                                           , Instance::PlacementStatus( (Instance::PlacementStatus::Code)status )
+                                           , false ) );
+    }
+
+    uint64_t     netCount = reader.getVarint();
+    vector<Net*> nets;
+    nets.reserve( netCount );
+    cell->reserveNets( netCount );
+    for ( uint64_t i=0 ; i<netCount ; ++i ) {
+      Name     name      = _getName( reader.getVarint() );
+      uint8_t  bits      = reader.getU8();
+      uint64_t type      = reader.getVarint();
+      uint64_t direction = reader.getVarint();
+      Net*     net       = NULL;
+      if (bits & NetDeep) {
+        HyperNet hyperNet ( _readOccurrence(reader,cell,NULL) );
+        net = DeepNet::create( hyperNet );
+        if (not net)
+          throw Error( "Snapshot::load(): Cannot re-create DeepNet \"%s\" in %s."
+                     , getString(name).c_str(), getString(cell).c_str() );
+      } else
+        net = Net::create( cell, name );
+      net->setExternal ( bits & NetExternal  );
+      net->setGlobal   ( bits & NetGlobal    );
+      net->setAutomatic( bits & NetAutomatic );
+      net->setType     ( Net::Type     ( (Net::Type::Code     )type      ) );
+      net->setDirection( Net::Direction( (Net::Direction::Code)direction ) );
+      nets.push_back( net );
+    }
+
+    for ( Instance* instance : instances ) {
+      uint64_t plugCount = reader.getVarint();
+      for ( uint64_t i=0 ; i<plugCount ; ++i ) {
+        Name     netName   = _getName( reader.getVarint() );
+        uint64_t inet      = reader.getVarint();
+        Net*     masterNet = instance->getMasterCell()->getNet( netName );
+        if (not masterNet or (inet >= nets.size()))
+          throw Error( "Snapshot::load(): Bad connexion of \"%s.%s\" in %s."
+                     , getString(instance->getName()).c_str(), getString(netName).c_str()
+                     , getString(cell).c_str() );
+        instance->getPlug( masterNet )->setNet( nets[inet] );
+      }
+    }
+
+    cell->closeBulkBuild();
+  }
+
+
+  void  Snapshot::Loader::materialize ( uint32_t icell )
+  {
+    CellEntry&                    entry  = _cells[icell];
+    Cell*                         cell   = entry._cell;
+    SnapshotReader                reader ( entry._components, entry._componentsSize );
+    unordered_map<uint32_t,Net*>  nets;
+    vector<Component*>            components;
+
+    uint64_t componentCount = reader.getVarint();
+    components.reserve( componentCount );
+    cell->openBulkBuild();
+
+    DbU::Unit lastX = 0;
+    DbU::Unit lastY = 0;
+    for ( uint64_t i=0 ; i<componentCount ; ++i ) {
+      uint8_t    kind      = reader.getU8();
+      Net*       net       = _getNet( cell, reader.getVarint(), nets );
+      bool       external  = reader.getU8();
+      Component* component = NULL;
+
+      switch ( kind ) {
+        case PinKind: {
+          Name         name      = _getName( reader.getVarint() );
+          uint8_t      access    = reader.getU8();
+          uint8_t      status    = reader.getU8();
+          const Layer* layer     = _getLayer( reader.getVarint() );
+          DbU::Unit    x         = reader.getDelta( lastX );
+          DbU::Unit    y         = reader.getDelta( lastY );
+          DbU::Unit    width     = reader.getSigned();
+          DbU::Unit    height    = reader.getSigned();
+          component = Pin::create( net
+                                 , name
+                                 , Pin::AccessDirection( (Pin::AccessDirection::Code)access )
+                                 , Pin::PlacementStatus( (Pin::PlacementStatus::Code)status )
+                                 , layer, x, y, width, height );
+          break;
+        }
+        case ContactKind: {
+          const Layer* layer  = _getLayer( reader.getVarint() );
+          Component*   anchor = _readRef( reader, cell, components );
+          DbU::Unit    dx     = (anchor) ? reader.getSigned() : reader.getDelta( lastX );
+          DbU::Unit    dy     = (anchor) ? reader.getSigned() : reader.getDelta( lastY );
+          DbU::Unit    width  = reader.getSigned();
+          DbU::Unit    height = reader.getSigned();
+          if (anchor) component = Contact::create( anchor, layer, dx, dy, width, height );
+          else        component = Contact::create( net   , layer, dx, dy, width, height );
+          break;
+        }
+        case HorizontalKind: {
+          const Layer* layer    = _getLayer( reader.getVarint() );
+          Component*   source   = _readRef( reader, cell, components );
+          Component*   target   = _readRef( reader, cell, components );
+          DbU::Unit    y        = reader.getDelta( lastY );
+          DbU::Unit    width    = reader.getSigned();
+          DbU::Unit    dxSource = reader.getDelta( lastX );
+          DbU::Unit    dxTarget = dxSource + reader.getSigned();
+          Horizontal*  segment  = Horizontal::create( net, layer, y, width, dxSource, dxTarget );
+          if (source) segment->getSourceHook()->attach( source->getBodyHook() );
+          if (target) segment->getTargetHook()->attach( target->getBodyHook() );
+          component = segment;
+          break;
+        }
+        case VerticalKind: {
+          const Layer* layer    = _getLayer( reader.getVarint() );
+          Component*   source   = _readRef( reader, cell, components );
+          Component*   target   = _readRef( reader, cell, components );
+          DbU::Unit    x        = reader.getDelta( lastX );
+          DbU::Unit    width    = reader.getSigned();
+          DbU::Unit    dySource = reader.getDelta( lastY );
+          DbU::Unit    dyTarget = dySource + reader.getSigned();
+          Vertical*    segment  = Vertical::create( net, layer, x, width, dySource, dyTarget );
+          if (source) segment->getSourceHook()->attach( source->getBodyHook() );
+          if (target) segment->getTargetHook()->attach( target->getBodyHook() );
+          component = segment;
+          break;
+        }
+        case PadKind: {
+          const Layer* layer  = _getLayer( reader.getVarint() );
+          DbU::Unit    xMin   = reader.getDelta( lastX );
+          DbU::Unit    yMin   = reader.getDelta( lastY );
+          DbU::Unit    width  = reader.getSigned();
+          DbU::Unit    height = reader.getSigned();
+          component = Pad::create( net, layer, Box(xMin,yMin,xMin+width,yMin+height) );
+          break;
+        }
+        case RoutingPadKind: {
+          Occurrence  occurrence = _readOccurrence( reader, cell, &components );
+          uint32_t    flags      = reader.getVarint();
+          RoutingPad* routingPad = RoutingPad::create( net, occurrence, 0 );
+          routingPad->setFlags( flags & ~RoutingPad::UserCenter );
+          if (flags & RoutingPad::UserCenter) {
+            DbU::Unit x = reader.getSigned();
+            DbU::Unit y = reader.getSigned();
+            routingPad->setUserCenter( Point(x,y) );
+          }
+          component = routingPad;
+          break;
+        }
+        default:
+          throw Error( "Snapshot::load(): Unknown component kind %u in %s."
+                     , (unsigned)kind, getString(cell).c_str() );
+      }
+
+      if (external) NetExternalComponents::setExternal( component );
+      components.push_back( component );
+    }
+
+    cell->closeBulkBuild();
+  }
+
+
+  Cell* Snapshot::Loader::load ( uint32_t flags )
+  {
+    _readSections();
+    for ( CellEntry& entry : _cells ) _readNetlist( entry );
+
+    for ( uint32_t icell=0 ; icell<_cells.size() ; ++icell ) {
+      if (flags & Snapshot::LazyComponents)
+        _cells[icell]._cell->put( Snapshot::Pending::create( shared_from_this(), icell ) );
+      else
+        materialize( icell );
+    }
+    return _cells.back()._cell;
+  }
+
+
+// -------------------------------------------------------------------
+// Class  :  "Snapshot::Pending".
+
+
+  Snapshot::Pending::Pending ( std::shared_ptr<Loader> loader, uint32_t icell )
+    : PrivateProperty()
+    , _loader        (loader)
+    , _index         (icell)
+  { }
+
+
+  Snapshot::Pending* Snapshot::Pending::create ( std::shared_ptr<Loader> loader, uint32_t icell )
+  {
+    Pending* property = new Pending( loader, icell );
+    property->_postCreate();
+    return property;
+  }
+
+
+  Name  Snapshot::Pending::getPropertyName ()
+  {
+    static Name name = "Snapshot::Pending";
+    return name;
+  }
+
+
+  Name    Snapshot::Pending::getName      () const { return getPropertyName(); }
+  string  Snapshot::Pending::_getTypeName () const { return "Snapshot::Pending"; }
+
+
+  string  Snapshot::Pending::_getString () const
+  {
+    string s = PrivateProperty::_getString();
+    s.insert( s.length() - 1 , " " + getString(_index) );
+    return s;
+  }
+
+
+  Record* Snapshot::Pending::_getRecord () const
+  {
+    Record* record = PrivateProperty::_getRecord();
+    if (record) record->add( getSlot( "_index", _index ) );
+    return record;
+  }
+
+
+// -------------------------------------------------------------------
+// Class  :  "Snapshot".
+
+
+  void  Snapshot::save ( Cell* cell, const string& path )
+  {
+    if (not cell)
+      throw Error( "Snapshot::save(): NULL cell." );
+
+    SnapshotWriter writer ( cell );
+    writer.write( path );
+  }
+
+
+  Cell* Snapshot::load ( const string& path, uint32_t flags )
+  {
+    std::shared_ptr<Loader> loader = std::make_shared<Loader>( path );
+
+    UpdateSession::open();
+    Cell* cell = NULL;
+    try {
+      cell = loader->load( flags );
+    }
+    catch ( ... ) {
+      UpdateSession::close();
+      throw;
+    }
+    UpdateSession::close();
+    return cell;
+  }
+
+
+  bool  Snapshot::isPending ( const Cell* cell )
+  { return (cell->getProperty(Pending::getPropertyName()) != NULL); }
+
+
+  void  Snapshot::materialize ( Cell* cell )
+  {
+    Pending* pending = static_cast<Pending*>( cell->getProperty(Pending::getPropertyName()) );
+    if (not pending) return;
+
+  // Keep the Loader alive while the property is removed.
+    std::shared_ptr<Loader> loader = pending->getLoader()->shared_from_this();
+    uint32_t                icell  = pending->getIndex();
+    cell->remove( pending );
+
+    UpdateSession::open();
+    try {
+      loader->materialize( icell );
+    }
+    catch ( ... ) {
+      UpdateSession::close();
+      throw;
+    }
+    UpdateSession::close();
+  }
+
+
+}  // Hurricane namespace.
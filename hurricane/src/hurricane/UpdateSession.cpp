@@ -17,7 +17,9 @@
 // not, see <http://www.gnu.org/licenses/>.
 // ****************************************************************************************************
 
+#include <algorithm>
 #include "hurricane/UpdateSession.h"
+#include "hurricane/QuadTree.h"
 #include "hurricane/Go.h"
 #include "hurricane/Cell.h"
 #include "hurricane/Instance.h"
@@ -33,9 +35,41 @@ namespace Hurricane {
 
 stack<UpdateSession*>* UPDATOR_STACK = NULL;
 
+size_t UpdateSession::_sessionCount = 0;
+size_t UpdateSession::_totalInvalidations = 0;
+size_t UpdateSession::_lastInvalidations = 0;
+size_t UpdateSession::_maxInvalidations = 0;
+
+namespace {
+
+    // Interleave the bits of the two 16 bits coordinates (Morton/Z-order key).
+    uint32_t _getMortonKey(uint32_t x, uint32_t y)
+    // *******************************************
+    {
+        uint32_t key = 0;
+        for (unsigned bit = 0; bit < 16; bit++) {
+            key |= ((x >> bit) & 1) << (2*bit);
+            key |= ((y >> bit) & 1) << (2*bit+1);
+        }
+        return key;
+    }
+
+    struct GoToMaterialize {
+        uint32_t _key;
+        Go* _go;
+        bool operator<(const GoToMaterialize& other) const
+        {
+            if (_key != other._key) return _key < other._key;
+            return _go->getId() < other._go->getId();
+        }
+    };
+
+} // Anonymous namespace.
+
 UpdateSession::UpdateSession()
 // ***************************
-:    Inherit()
+:    Inherit(),
+    _invalidations(0)
 { }
 
 void UpdateSession::destroy()
@@ -69,6 +103,7 @@ void UpdateSession::_postCreate()
     if (!UPDATOR_STACK) UPDATOR_STACK = new stack<UpdateSession*>();
 
     UPDATOR_STACK->push(this);
+    QuadTree::openBatch();
 }
 
 void UpdateSession::_destroy()
@@ -88,7 +123,9 @@ void UpdateSession::_destroy()
 
     UPDATOR_STACK->pop();
 
-    vector<Cell*> changedCells;
+    vector<Cell*>           changedCells;
+    vector<GoToMaterialize> gos;
+    Box                     area;
     for ( DBo* owner : getOwners() ) {
       Cell* cell = dynamic_cast<Cell*>(owner);
       if (cell) {
@@ -96,9 +133,35 @@ void UpdateSession::_destroy()
         changedCells.push_back( cell );
       } else {
         Go* go = dynamic_cast<Go*>(owner);
-        if (go) go->materialize();
+        if (go) {
+          gos.push_back( GoToMaterialize{ 0, go } );
+          area.merge( go->getBoundingBox().getCenter() );
+        }
+      }
+    }
+
+  // The Gos are materialized in Z-order of their centers, so consecutive
+  // insertions go down the same QuadTree branches. The QuadTrees are only
+  // rebalanced once, when the batch is closed (see QuadTree::openBatch()).
+    if (not area.isEmpty()) {
+      double width  = std::max( (double)area.getWidth (), 1.0 );
+      double height = std::max( (double)area.getHeight(), 1.0 );
+      for ( GoToMaterialize& entry : gos ) {
+        Point center = entry._go->getBoundingBox().getCenter();
+        entry._key = _getMortonKey( (uint32_t)(65535.0 * (center.getX() - area.getXMin()) / width )
+                                  , (uint32_t)(65535.0 * (center.getY() - area.getYMin()) / height) );
       }
+      sort( gos.begin(), gos.end() );
     }
+    for ( GoToMaterialize& entry : gos ) entry._go->materialize();
+    QuadTree::closeBatch();
+
+    _sessionCount++;
+    _totalInvalidations += _invalidations;
+    _lastInvalidations   = _invalidations;
+    _maxInvalidations    = std::max( _maxInvalidations, _invalidations );
+    cdebug_log(18,0) << "UpdateSession: " << _invalidations << " invalidated Gos, "
+                     << gos.size() << " materialized." << endl;
 
   // Changed cells must be notified *after* all the Gos are materialized.
   // They also should be sorted according to their hierarchical depth and
@@ -121,6 +184,9 @@ Record* UpdateSession::_getRecord() const
 {
     Record* record = Inherit::_getRecord();
     if (record) {
+        record->add(getSlot("_invalidations", _invalidations));
+        record->add(getSlot("_sessionCount", _sessionCount));
+        record->add(getSlot("_totalInvalidations", _totalInvalidations));
     }
     return record;
 }
@@ -169,6 +235,7 @@ void Go::invalidate(bool propagateFlag)
     if (isMaterialized() or not Go::autoMaterializationIsDisabled()) {
       unmaterialize();
       put( UPDATOR_STACK->top() );
+      UPDATOR_STACK->top()->_addInvalidation();
     }
 
     Property* cellUpdateSession = getCell()->getProperty( UpdateSession::getPropertyName() );
@@ -224,6 +291,15 @@ size_t  UpdateSession::getStackSize ()
 { return (UPDATOR_STACK) ? UPDATOR_STACK->size() : 0; }
 
 
+void  UpdateSession::resetCounters ()
+{
+  _sessionCount       = 0;
+  _totalInvalidations = 0;
+  _lastInvalidations  = 0;
+  _maxInvalidations   = 0;
+}
+
+
 } // End of Hurricane namespace.
 
 
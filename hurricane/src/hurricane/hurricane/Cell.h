@@ -42,6 +42,7 @@
 #include "hurricane/Layer.h"
 #include "hurricane/QuadTree.h"
 //#include "hurricane/IntrusiveMap.h"
+#include "hurricane/IntrusiveHashMap.h"
 #include "hurricane/IntrusiveSet.h"
 #include "hurricane/MapCollection.h"
 #include "hurricane/NetAlias.h"
@@ -79,12 +80,14 @@ class Cell : public Entity {
                   , NoClockFlatten          = (1 <<  4)
                   , WarnOnUnplacedInstances = (1 <<  5)
                   , StayOnPlugs             = (1 <<  6)
+                  , ParallelFlatten         = (1 <<  7)
                   , MaskRings               = BuildRings|BuildClockRings|BuildSupplyRings
                   // Flags set for Observers.
                   , CellAboutToChange       = (1 << 10)
                   , CellChanged             = (1 << 11)
                   , CellDestroyed           = (1 << 12)
                   // Cell states
+                  , BulkBuild               = (1 << 19)
                   , TerminalNetlist         = (1 << 20)
                   , Pad                     = (1 << 21)
                   , Feed                    = (1 << 22)
@@ -106,6 +109,20 @@ class Cell : public Entity {
         virtual std::string  _getString   () const;
     };
 
+    // Scoped bulk build session. If it has not been closed explicitly
+    // (error path), the destructor closes it.
+    class BulkBuildGuard {
+      public:
+                          BulkBuildGuard  ( Cell*, size_t nets=0, size_t instances=0 );
+                         ~BulkBuildGuard  ();
+                void      close           ();
+      private:
+        Cell*  _cell;
+      private:
+                          BulkBuildGuard  ( const BulkBuildGuard& ) = delete;
+        BulkBuildGuard&   operator=       ( const BulkBuildGuard& ) = delete;
+    };
+
     class UniquifyRelation : public Relation {
       public:
         static  UniquifyRelation*  create           ( Cell* );
@@ -238,17 +255,15 @@ class Cell : public Entity {
         const Cell* _cell;
     };
 
-    class InstanceMap : public IntrusiveMap<Name, Instance> {
-    // ****************************************************
+    class InstanceMap : public IntrusiveHashMap<Name, Instance> {
+    // ********************************************************
 
-        public: typedef IntrusiveMap<Name, Instance> Inherit;
+        public: typedef IntrusiveHashMap<Name, Instance> Inherit;
 
         public: InstanceMap();
 
-        public: virtual Name _getKey(Instance* instance) const;
-        public: virtual unsigned _getHashValue(Name name) const;
-        public: virtual Instance* _getNextElement(Instance* instance) const;
-        public: virtual void _setNextElement(Instance* instance, Instance* nextInstance) const;
+        public: virtual const Name& _getKey(Instance* instance) const;
+        public: virtual unsigned _getHashValue(const Name& name) const;
 
     };
 
@@ -265,31 +280,27 @@ class Cell : public Entity {
 
     };
 
-    public: class NetMap : public IntrusiveMapConst<Name, Net> {
-    // *********************************************************
+    public: class NetMap : public IntrusiveHashMap<Name, Net> {
+    // ********************************************************
 
-        public: typedef IntrusiveMapConst<Name, Net> Inherit;
+        public: typedef IntrusiveHashMap<Name, Net> Inherit;
     
         public: NetMap();
 
         public: virtual const Name& _getKey(Net* net) const;
         public: virtual unsigned _getHashValue(const Name& name) const;
-        public: virtual Net* _getNextElement(Net* net) const;
-        public: virtual void _setNextElement(Net* net, Net* nextNet) const;
 
     };
 
-    class PinMap : public IntrusiveMap<Name, Pin> {
-    // *******************************************
+    class PinMap : public IntrusiveHashMap<Name, Pin> {
+    // ***********************************************
 
-        public: typedef IntrusiveMap<Name, Pin> Inherit;
+        public: typedef IntrusiveHashMap<Name, Pin> Inherit;
 
         public: PinMap();
 
-        public: virtual Name _getKey(Pin* pin) const;
-        public: virtual unsigned _getHashValue(Name name) const;
-        public: virtual Pin* _getNextElement(Pin* pin) const;
-        public: virtual void _setNextElement(Pin* pin, Pin* nextPin) const;
+        public: virtual const Name& _getKey(Pin* pin) const;
+        public: virtual unsigned _getHashValue(const Name& name) const;
 
     };
 
@@ -456,6 +467,8 @@ class Cell : public Entity {
     public: Markers getMarkers() const {return _markerSet.getElements();};
     public: Markers getMarkersUnder(const Box& area) const;
     public: References getReferences() const;
+    public: size_t getSharedPathCount() const;
+    public: size_t getSharedPathMemorySize() const;
   public: Components getComponents(const Layer::Mask& mask = Layer::Mask::FFFF ) const; public: Components getComponentsUnder(const Box& area, const Layer::Mask& mask = Layer::Mask::FFFF) const;
     public: Occurrences getOccurrences(unsigned searchDepth = std::numeric_limits<unsigned int>::max()) const;
     public: Occurrences getOccurrencesUnder(const Box& area, unsigned searchDepth = std::numeric_limits<unsigned int>::max(), DbU::Unit threshold=0) const;
@@ -483,6 +496,7 @@ class Cell : public Entity {
 
     public: bool isCalledBy(Cell* cell) const;
     public: bool isTerminal() const {return _instanceMap.isEmpty();};
+    public: bool isInBulkBuild() const {return _flags.isset(Flags::BulkBuild);};
     public: bool isTerminalNetlist() const {return _flags.isset(Flags::TerminalNetlist);};
     public: bool isUnique() const;
     public: bool isUniquified() const;
@@ -513,15 +527,22 @@ class Cell : public Entity {
     public: void setRouted(bool state) {_flags.set(Flags::Routed,state);};
     public: void setAbstractedSupply(bool state) { _flags.set(Flags::AbstractedSupply,state); };
     public: void setNoExtractConsistent(bool state) { _flags.set(Flags::NoExtractConsistent,state); };
+    public: void reserveNets(size_t size) { _netMap.reserve(size); };
+    public: void reserveInstances(size_t size) { _instanceMap.reserve(size); };
+    public: void reservePins(size_t size) { _pinMap.reserve(size); };
+    public: void openBulkBuild(size_t nets=0, size_t instances=0);
+    public: void closeBulkBuild();
     public: void flattenNets(uint64_t flags=Flags::BuildRings);
     public: void flattenNets(const Instance* instance, uint64_t flags=Flags::BuildRings);
-    public: void flattenNets(const Instance* instance, const std::set<std::string>& excludeds, uint64_t flags=Flags::BuildRings);
+    public: void flattenNets(const Instance* instance, const std::set<std::string>& excludeds, uint64_t flags=Flags::BuildRings, unsigned int threads=1);
     public: void createRoutingPadRings(uint64_t flags=Flags::BuildRings);
     public: void setFlags(uint64_t flags) { _flags |= flags; }
     public: void resetFlags(uint64_t flags) { _flags &= ~flags; }
     public: bool updatePlacedFlag();
     public: void materialize();
     public: void unmaterialize();
+    public: void packQuadTrees();
+    public: void unpackQuadTrees();
     public: Cell* getClone();
     public: void uniquify(unsigned int depth=std::numeric_limits<unsigned int>::max());
     public: void addObserver(BaseObserver*);
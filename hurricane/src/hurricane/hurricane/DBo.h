@@ -41,6 +41,14 @@ namespace Hurricane {
 
 // -------------------------------------------------------------------
 // Class  :  "Hurricane::DBo".
+//
+// The Properties are kept in a small vector, in insertion order. The
+// Name of each one is read once, when it is put, and stored alongside
+// in a parallel vector. As the Names are interned, getProperty() is a
+// linear scan of pointer comparisons over a contiguous array, without
+// any call to the virtual Property::getName(). It is still linear in
+// the number of Properties of the object, only cheaper per Property.
+// A Property must not change it's name while it is owned.
 
   class DBo {
     public:
@@ -60,10 +68,13 @@ namespace Hurricane {
       static  void               useIdCounter2       ();
     public:
       virtual void               destroy             ();
-      inline  set<Property*>&    _getPropertySet     ();
+      inline  const vector<Property*>&
+                                 _getProperties      () const;
               void               _onDestroyed        ( Property* property );
       inline  unsigned int       getId               () const;
               Property*          getProperty         ( const Name& ) const;
+      template<typename DerivedProperty>
+      inline  DerivedProperty*   getProperty         () const;
               Properties         getProperties       () const;
       inline  bool               hasProperty         () const;
               void               setId               ( unsigned int );
@@ -84,6 +95,9 @@ namespace Hurricane {
       virtual                   ~DBo                 () noexcept(false);
       virtual void               _postCreate         ();
       virtual void               _preDestroy         ();
+    private:
+              size_t             _findProperty       ( const Property* ) const;
+              void               _eraseProperty      ( size_t );
     private:                                         
                                  DBo                 ( const DBo& ) = delete;
               DBo&               operator=           ( const DBo& ) = delete;
@@ -95,7 +109,8 @@ namespace Hurricane {
       static  unsigned int       _idCounter;
       static  unsigned int       _idCounterLimit;
               unsigned int       _id;
-      mutable set<Property*>     _propertySet;
+      mutable vector<Property*>  _properties;
+      mutable vector<Name>       _propertyNames;
     public:
       struct CompareById {
           template<typename Key>
@@ -105,9 +120,17 @@ namespace Hurricane {
 
 
 // Inline Functions.
-  inline set<Property*>& DBo::_getPropertySet () { return _propertySet; }
-  inline bool            DBo::hasProperty     () const { return !_propertySet.empty(); }
-  inline unsigned int    DBo::getId           () const { return _id; }
+  inline const vector<Property*>& DBo::_getProperties () const { return _properties; }
+  inline bool                     DBo::hasProperty    () const { return !_properties.empty(); }
+  inline unsigned int             DBo::getId          () const { return _id; }
+
+
+// Typed lookup (same scan), the Property is identified by the static
+// name of it's class, which must be unique to that class (no
+// dynamic_cast).
+  template<typename DerivedProperty>
+  inline DerivedProperty* DBo::getProperty () const
+  { return static_cast<DerivedProperty*>( getProperty(DerivedProperty::staticGetName()) ); }
 
   template<typename Key>
   inline bool  DBo::CompareById::operator() ( const Key* lhs, const Key* rhs ) const
@@ -65,7 +65,9 @@ namespace Hurricane {
       static  DeepNet*    create               ( HyperNet& hyperNet );
       inline  Occurrence  getRootNetOccurrence () const;
       virtual bool        isDeepNet            () const { return true; };
+      static  bool        _needRoutingPads     ( HyperNet&, const Cell* );
               size_t      _createRoutingPads   ( unsigned int flags=0 );
+              size_t      _createRoutingPads   ( const std::vector<Occurrence>& plugOccurrences, unsigned int flags=0 );
       virtual Record*     _getRecord           () const;
       virtual string      _getTypeName         () const { return "DeepNet"; };
       virtual void        _toJson              ( JsonWriter* ) const;
@@ -77,20 +77,6 @@ class Instance : public Go {
 
     };
 
-    public: class SharedPathMap : public IntrusiveMap<const SharedPath*, SharedPath> {
-    // *****************************************************************************
-
-        public: typedef IntrusiveMap<const SharedPath*, SharedPath> Inherit;
-    
-        public: SharedPathMap();
-
-        public: virtual const SharedPath* _getKey(SharedPath* sharedPath) const;
-        public: virtual unsigned _getHashValue(const SharedPath* tailSharedPath) const;
-        public: virtual SharedPath* _getNextElement(SharedPath* sharedPath) const;
-        public: virtual void _setNextElement(SharedPath* sharedPath, SharedPath* nextSharedPath) const;
-
-    };
-
 // Attributes
 // **********
 
@@ -100,8 +86,7 @@ class Instance : public Go {
     private: Transformation _transformation;
     private: PlacementStatus _placementStatus;
     private: PlugMap _plugMap;
-    private: SharedPathMap _sharedPathMap;
-    private: Instance* _nextOfCellInstanceMap;
+    private: vector<SharedPath*> _sharedPathes;
     private: Instance* _nextOfCellSlaveInstanceSet;
 
 // Constructors
@@ -181,13 +166,12 @@ class Instance : public Go {
     public: virtual void _toJson(JsonWriter*) const;
     public: virtual void _toJsonCollections(JsonWriter*) const;
     public: PlugMap& _getPlugMap() {return _plugMap;};
-    public: SharedPath* _getSharedPath(const SharedPath* tailSharedPath) const {return _sharedPathMap.getElement(tailSharedPath);}
-    public: SharedPathes _getSharedPathes() const {return _sharedPathMap.getElements();};
-    public: SharedPathMap& _getSharedPathMap() {return _sharedPathMap;};
-    public: Instance* _getNextOfCellInstanceMap() const {return _nextOfCellInstanceMap;};
+    public: SharedPath* _getSharedPath(const SharedPath* tailSharedPath) const {return SharedPath::find(this, tailSharedPath);}
+    public: const vector<SharedPath*>& _getSharedPathes() const {return _sharedPathes;};
+    public: void _insertSharedPath(SharedPath* sharedPath);
+    public: void _removeSharedPath(SharedPath* sharedPath);
     public: Instance* _getNextOfCellSlaveInstanceSet() const {return _nextOfCellSlaveInstanceSet;};
 
-    public: void _setNextOfCellInstanceMap(Instance* instance) {_nextOfCellInstanceMap = instance;};
     public: void _setNextOfCellSlaveInstanceSet(Instance* instance) {_nextOfCellSlaveInstanceSet = instance;};
 
 };
@@ -255,7 +239,6 @@ inline Hurricane::Record* getRecord<const Hurricane::Instance::PlacementStatus::
 INSPECTOR_P_SUPPORT(Hurricane::Instance);
 INSPECTOR_P_SUPPORT(Hurricane::Instance::PlacementStatus);
 INSPECTOR_P_SUPPORT(Hurricane::Instance::PlugMap);
-INSPECTOR_P_SUPPORT(Hurricane::Instance::SharedPathMap);
 
 inline void  jsonWrite ( JsonWriter* w, const std::string& key, const Hurricane::Instance::PlacementStatus& status )
 {
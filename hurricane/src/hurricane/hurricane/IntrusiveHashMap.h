@@ -0,0 +1,579 @@
+// -*- C++ -*-
+//
+// Copyright (c) BULL S.A. 2000-2026, All Rights Reserved
+//
+// This file is part of Hurricane.
+//
+// Hurricane is free software: you can redistribute it  and/or  modify
+// it under the terms of the GNU  Lesser  General  Public  License  as
+// published by the Free Software Foundation, either version 3 of  the
+// License, or (at your option) any later version.
+//
+// Hurricane is distributed in the hope that it will  be  useful,  but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHAN-
+// TABILITY or FITNESS FOR A PARTICULAR PURPOSE. See  the  Lesser  GNU
+// General Public License for more details.
+//
+// You should have received a copy of the Lesser  GNU  General  Public
+// License along with Hurricane. If not, see
+//                                     <http://www.gnu.org/licenses/>.
+//
+// +-----------------------------------------------------------------+
+// |                  H U R R I C A N E                              |
+// |     V L S I   B a c k e n d   D a t a - B a s e                 |
+// |                                                                 |
+// |  Author      :                    Jean-Paul CHAPUT              |
+// |  E-mail      :            Jean-Paul.Chaput@lip6.fr              |
+// | =============================================================== |
+// |  C++ Header  :  "./hurricane/IntrusiveHashMap.h"                |
+// +-----------------------------------------------------------------+
+
+
+#pragma  once
+#include <cstdint>
+#include <limits>
+#include <algorithm>
+#include <functional>
+#include "hurricane/Collection.h"
+#include "hurricane/Error.h"
+
+
+namespace Hurricane {
+
+
+// -------------------------------------------------------------------
+// Class  :  "Hurricane::IntrusiveHashMap".
+//
+// Open addressing (Robin Hood, linear probing) counterpart of the
+// chained IntrusiveMap, for the maps that may grow to millions of
+// elements (the Nets, Instances & Pins of a Cell). The same kind of
+// element is stored (a pointer to an object holding it's own key),
+// but no link is needed in the element.
+//
+// * The table is a power of two array of slots, each slot keeping
+//   the element and the hash of it's key. Keys are only compared
+//   (through the virtual _getKey()) when the hashes are equal.
+// * The home slot is given by a Fibonacci hashing of the hash value,
+//   so a hash with poor low bits still spreads over the table.
+// * The load factor is kept under 7/8, the table grows by doubling.
+//   reserve() allows to size it once when the final count is known
+//   (parsers), so no rehash happens during the load.
+// * Removal is done by backward shifting, without tombstones.
+// * Elements of the same home slot are kept sorted by hash then
+//   address, so the whole table is sorted on the (Fibonacci hashed)
+//   key, the slots wrapped at the beginning of the table coming last.
+//
+// The iteration follows that order, which depends only on the keys
+// (and addresses on a full hash collision), not on the table size.
+// The locator keeps the element it points to with it's hash and, if
+// it is no longer in it's slot (moved by a removal, an insertion or a
+// rehash, or removed itself), finds it again or it's successor from
+// the hash and address alone. So, as with the chained map, the current
+// element can be destroyed or renamed from inside a for_each loop, and
+// so can any other element. An element inserted while iterating is
+// visited only if it sorts after the current one.
+
+  template< typename Key, typename Element >
+  class IntrusiveHashMap {
+    public:
+      struct Slot {
+        Element*  _element;
+        uint32_t  _hash;
+      };
+
+    public:
+      class Elements : public Collection<Element*> {
+        public:
+          typedef Collection<Element*>  Inherit;
+        public:
+          class Locator : public Hurricane::Locator<Element*> {
+            public:
+              typedef Hurricane::Locator<Element*>  Inherit;
+            public:
+              inline                                Locator    ( const IntrusiveHashMap* map=NULL );
+              inline                                Locator    ( const Locator& );
+              virtual Element*                      getElement () const;
+              virtual Hurricane::Locator<Element*>* getClone   () const;
+              virtual bool                          isValid    () const;
+              virtual void                          progress   ();
+              virtual string                        _getString () const;
+            private:
+              inline  void                          _load      ( uint32_t index ) const;
+              inline  void                          _resync    () const;
+            private:
+                      const IntrusiveHashMap* _map;
+              mutable Element*                _element;
+              mutable uint32_t                _hash;
+              mutable uint32_t                _index;
+          };
+        public:
+          inline                                Elements   ( const IntrusiveHashMap* map=NULL );
+          inline                                Elements   ( const Elements& );
+          virtual Collection<Element*>*         getClone   () const;
+          virtual Hurricane::Locator<Element*>* getLocator () const;
+          virtual string                        _getString () const;
+        private:
+          const IntrusiveHashMap* _map;
+      };
+
+    public:
+      inline                    IntrusiveHashMap ();
+      virtual                  ~IntrusiveHashMap ();
+      inline  bool              isEmpty          () const;
+              Element*          getElement       ( const Key& ) const;
+      inline  Elements          getElements      () const;
+              void              reserve          ( size_t );
+      virtual const Key&        _getKey          ( Element* ) const = 0;
+      virtual unsigned          _getHashValue    ( const Key& ) const = 0;
+      inline  unsigned          _getSize         () const;
+      inline  unsigned          _getLength       () const;
+      inline  const Slot*       _getSlots        () const;
+              bool              _contains        ( Element* ) const;
+              void              _insert          ( Element* );
+              void              _remove          ( Element* );
+              string            _getTypeName     () const;
+              string            _getString       () const;
+              Record*           _getRecord       () const;
+    private:
+      static inline uint32_t    _getOrder        ( uint32_t hash );
+      static inline bool        _isAfter         ( const Slot&, uint32_t order, const Element* );
+      inline  uint32_t          _getHome         ( uint32_t hash ) const;
+      inline  uint32_t          _getDistance     ( uint32_t islot ) const;
+      inline  bool              _isWrapped       ( uint32_t islot ) const;
+              uint32_t          _find            ( const Element*, uint32_t hash ) const;
+              uint32_t          _getFirst        () const;
+              uint32_t          _getNext         ( const Element*, uint32_t hash, uint32_t islot ) const;
+              void              _place           ( Slot );
+              void              _rehash          ( unsigned length );
+    private:
+      unsigned  _size;
+      unsigned  _length;
+      unsigned  _shift;
+      Slot*     _slots;
+    private:
+                         IntrusiveHashMap ( const IntrusiveHashMap& );
+      IntrusiveHashMap&  operator=        ( const IntrusiveHashMap& );
+  };
+
+
+// -------------------------------------------------------------------
+// Class  :  "Hurricane::IntrusiveHashMap::Elements::Locator".
+
+  template< typename Key, typename Element >
+  inline IntrusiveHashMap<Key,Element>::Elements::Locator::Locator ( const IntrusiveHashMap* map )
+    : Inherit()
+    , _map    (map)
+    , _element(NULL)
+    , _hash   (0)
+    , _index  (0)
+  {
+    if (_map) _load( _map->_getFirst() );
+  }
+
+
+  template< typename Key, typename Element >
+  inline IntrusiveHashMap<Key,Element>::Elements::Locator::Locator ( const Locator& other )
+    : Inherit()
+    , _map    (other._map)
+    , _element(other._element)
+    , _hash   (other._hash)
+    , _index  (other._index)
+  { }
+
+
+  template< typename Key, typename Element >
+  inline void  IntrusiveHashMap<Key,Element>::Elements::Locator::_load ( uint32_t index ) const
+  {
+    _index   = index;
+    _element = NULL;
+    _hash    = 0;
+    if (_index < _map->_getLength()) {
+      _element = _map->_getSlots()[_index]._element;
+      _hash    = _map->_getSlots()[_index]._hash;
+    }
+  }
+
+
+// The table has been modified since the element was loaded: look for it
+// again, and if it has been removed, go to it's successor. The element
+// itself is never dereferenced (it may have been destroyed).
+  template< typename Key, typename Element >
+  inline void  IntrusiveHashMap<Key,Element>::Elements::Locator::_resync () const
+  {
+    if (not _element) return;
+    if (   (_index < _map->_getLength())
+       and (_map->_getSlots()[_index]._element == _element)
+       and (_map->_getSlots()[_index]._hash    == _hash   )) return;
+
+    uint32_t index = _map->_find( _element, _hash );
+    if (index < _map->_getLength()) _index = index;
+    else                            _load( _map->_getNext(_element,_hash,_map->_getLength()) );
+  }
+
+
+  template< typename Key, typename Element >
+  Element* IntrusiveHashMap<Key,Element>::Elements::Locator::getElement () const
+  {
+    _resync();
+    return _element;
+  }
+
+
+  template< typename Key, typename Element >
+  Hurricane::Locator<Element*>* IntrusiveHashMap<Key,Element>::Elements::Locator::getClone () const
+  { return new Locator( *this ); }
+
+
+  template< typename Key, typename Element >
+  bool  IntrusiveHashMap<Key,Element>::Elements::Locator::isValid () const
+  {
+    _resync();
+    return (_element != NULL);
+  }
+
+
+  template< typename Key, typename Element >
+  void  IntrusiveHashMap<Key,Element>::Elements::Locator::progress ()
+  {
+    if (not _element) return;
+    _load( _map->_getNext(_element,_hash,_index) );
+  }
+
+
+  template< typename Key, typename Element >
+  string  IntrusiveHashMap<Key,Element>::Elements::Locator::_getString () const
+  {
+    string s = "<" + _TName("IntrusiveHashMap::Elements::Locator");
+    if (_map) s += " " + _map->_getString();
+    s += ">";
+    return s;
+  }
+
+
+// -------------------------------------------------------------------
+// Class  :  "Hurricane::IntrusiveHashMap::Elements".
+
+  template< typename Key, typename Element >
+  inline IntrusiveHashMap<Key,Element>::Elements::Elements ( const IntrusiveHashMap* map )
+    : Inherit()
+    , _map   (map)
+  { }
+
+
+  template< typename Key, typename Element >
+  inline IntrusiveHashMap<Key,Element>::Elements::Elements ( const Elements& other )
+    : Inherit()
+    , _map   (other._map)
+  { }
+
+
+  template< typename Key, typename Element >
+  Collection<Element*>* IntrusiveHashMap<Key,Element>::Elements::getClone () const
+  { return new Elements( *this ); }
+
+
+  template< typename Key, typename Element >
+  Hurricane::Locator<Element*>* IntrusiveHashMap<Key,Element>::Elements::getLocator () const
+  { return new Locator( _map ); }
+
+
+  template< typename Key, typename Element >
+  string  IntrusiveHashMap<Key,Element>::Elements::_getString () const
+  {
+    string s = "<" + _TName("IntrusiveHashMap::Elements");
+    if (_map) s += " " + _map->_getString();
+    s += ">";
+    return s;
+  }
+
+
+// -------------------------------------------------------------------
+// Class  :  "Hurricane::IntrusiveHashMap".
+
+  template< typename Key, typename Element >
+  inline IntrusiveHashMap<Key,Element>::IntrusiveHashMap ()
+    : _size  (0)
+    , _length(0)
+    , _shift (32)
+    , _slots (NULL)
+  { }
+
+
+  template< typename Key, typename Element >
+  IntrusiveHashMap<Key,Element>::~IntrusiveHashMap ()
+  { delete [] _slots; }
+
+
+  template< typename Key, typename Element >
+  inline bool  IntrusiveHashMap<Key,Element>::isEmpty () const { return (_size == 0); }
+
+  template< typename Key, typename Element >
+  inline typename IntrusiveHashMap<Key,Element>::Elements  IntrusiveHashMap<Key,Element>::getElements () const { return Elements(this); }
+
+  template< typename Key, typename Element >
+  inline unsigned  IntrusiveHashMap<Key,Element>::_getSize () const { return _size; }
+
+  template< typename Key, typename Element >
+  inline unsigned  IntrusiveHashMap<Key,Element>::_getLength () const { return _length; }
+
+  template< typename Key, typename Element >
+  inline const typename IntrusiveHashMap<Key,Element>::Slot* IntrusiveHashMap<Key,Element>::_getSlots () const { return _slots; }
+
+  template< typename Key, typename Element >
+  inline uint32_t  IntrusiveHashMap<Key,Element>::_getOrder ( uint32_t hash )
+  { return (uint32_t)(hash * 2654435769U); }
+
+  template< typename Key, typename Element >
+  inline bool  IntrusiveHashMap<Key,Element>::_isAfter ( const Slot& slot, uint32_t order, const Element* element )
+  {
+    uint32_t slotOrder = _getOrder( slot._hash );
+    if (slotOrder != order) return (slotOrder > order);
+    return std::less<const Element*>()( element, slot._element );
+  }
+
+  template< typename Key, typename Element >
+  inline uint32_t  IntrusiveHashMap<Key,Element>::_getHome ( uint32_t hash ) const
+  { return _getOrder(hash) >> _shift; }
+
+  template< typename Key, typename Element >
+  inline uint32_t  IntrusiveHashMap<Key,Element>::_getDistance ( uint32_t islot ) const
+  { return (islot - _getHome(_slots[islot]._hash)) & (_length-1); }
+
+// The slot holds an element whose home is at the end of the table.
+  template< typename Key, typename Element >
+  inline bool  IntrusiveHashMap<Key,Element>::_isWrapped ( uint32_t islot ) const
+  { return (_getHome(_slots[islot]._hash) > islot); }
+
+
+  template< typename Key, typename Element >
+  Element* IntrusiveHashMap<Key,Element>::getElement ( const Key& key ) const
+  {
+    if (not _size) return NULL;
+
+    uint32_t hash  = _getHashValue( key );
+    uint32_t mask  = _length - 1;
+    uint32_t islot = _getHome( hash );
+    for ( uint32_t distance=0 ; true ; ++distance, islot=(islot+1) & mask ) {
+      const Slot& slot = _slots[islot];
+      if (not slot._element or (_getDistance(islot) < distance)) return NULL;
+      if ((slot._hash == hash) and (_getKey(slot._element) == key)) return slot._element;
+    }
+    return NULL;
+  }
+
+
+  template< typename Key, typename Element >
+  uint32_t  IntrusiveHashMap<Key,Element>::_find ( const Element* element, uint32_t hash ) const
+  {
+    if (not _size) return _length;
+
+    uint32_t mask  = _length - 1;
+    uint32_t islot = _getHome( hash );
+    for ( uint32_t distance=0 ; true ; ++distance, islot=(islot+1) & mask ) {
+      const Slot& slot = _slots[islot];
+      if (not slot._element or (_getDistance(islot) < distance)) return _length;
+      if (slot._element == element) return islot;
+    }
+    return _length;
+  }
+
+
+  template< typename Key, typename Element >
+  bool  IntrusiveHashMap<Key,Element>::_contains ( Element* element ) const
+  { return _find( element, _getHashValue(_getKey(element)) ) < _length; }
+
+
+// First element in order: the first slot not wrapped from the end.
+  template< typename Key, typename Element >
+  uint32_t  IntrusiveHashMap<Key,Element>::_getFirst () const
+  {
+    for ( uint32_t islot=0 ; islot<_length ; ++islot ) {
+      if (_slots[islot]._element and not _isWrapped(islot)) return islot;
+    }
+    return _length;
+  }
+
+
+// Next element in order after (element,hash). If it is still in the
+// given slot, it is the next occupied one. Otherwise the search starts
+// from it's home, skipping the elements which sort before it. The
+// slots wrapped from the end are only considered after the end of the
+// table has been reached.
+  template< typename Key, typename Element >
+  uint32_t  IntrusiveHashMap<Key,Element>::_getNext ( const Element* element, uint32_t hash, uint32_t islot ) const
+  {
+    if (not _size) return _length;
+
+    if ((islot < _length) and (_slots[islot]._element == element) and (_slots[islot]._hash == hash)) {
+      bool wrapped = _isWrapped( islot );
+      if (not wrapped) {
+        for ( ++islot ; islot<_length ; ++islot ) {
+          if (_slots[islot]._element) return islot;
+        }
+        islot = 0;
+      } else
+        ++islot;
+      if ((islot < _length) and _slots[islot]._element and _isWrapped(islot)) return islot;
+      return _length;
+    }
+
+    uint32_t order   = _getOrder( hash );
+    bool     wrapped = false;
+    islot = _getHome( hash );
+    for ( uint32_t count=0 ; count<=_length ; ++count ) {
+      const Slot& slot = _slots[islot];
+      if (slot._element) {
+        if (_isWrapped(islot) == wrapped) {
+          if (_isAfter(slot,order,element)) return islot;
+        } else if (wrapped)
+          return _length;
+      }
+      if (++islot == _length) {
+        if (wrapped) break;
+        islot   = 0;
+        wrapped = true;
+      }
+    }
+    return _length;
+  }
+
+
+// The incoming slot takes the place of any slot closer to it's home
+// ("rich") than itself, or of the same home but sorting after it, which
+// is then moved further.
+  template< typename Key, typename Element >
+  void  IntrusiveHashMap<Key,Element>::_place ( Slot incoming )
+  {
+    uint32_t mask     = _length - 1;
+    uint32_t islot    = _getHome( incoming._hash );
+    uint32_t distance = 0;
+    while ( true ) {
+      Slot& slot = _slots[islot];
+      if (not slot._element) { slot = incoming; return; }
+
+      uint32_t slotDistance = _getDistance( islot );
+      if (   (slotDistance < distance)
+         or ((slotDistance == distance) and _isAfter(slot,_getOrder(incoming._hash),incoming._element))) {
+        std::swap( slot, incoming );
+        distance = slotDistance;
+      }
+      islot = (islot+1) & mask;
+      ++distance;
+    }
+  }
+
+
+  template< typename Key, typename Element >
+  void  IntrusiveHashMap<Key,Element>::_rehash ( unsigned length )
+  {
+    cdebug_log(0,0) << "IntrusiveHashMap::_rehash() " << _length << " -> " << length << endl;
+
+    unsigned  oldLength = _length;
+    Slot*     oldSlots  = _slots;
+
+    _length = length;
+    _shift  = 32;
+    for ( unsigned i=length ; i>1 ; i >>= 1 ) --_shift;
+    _slots  = new Slot [ _length ];
+    std::fill( _slots, _slots+_length, Slot{ NULL, 0 } );
+
+    for ( unsigned islot=0 ; islot<oldLength ; ++islot ) {
+      if (oldSlots[islot]._element) _place( oldSlots[islot] );
+    }
+    delete [] oldSlots;
+  }
+
+
+  template< typename Key, typename Element >
+  void  IntrusiveHashMap<Key,Element>::reserve ( size_t size )
+  {
+    size_t length = 8;
+    while ( length*7 < size*8 ) length *= 2;
+    if (length > (size_t)std::numeric_limits<uint32_t>::max())
+      throw Error( "IntrusiveHashMap::reserve(): Too many elements (%s).", getString(size).c_str() );
+    if (length > _length) _rehash( length );
+  }
+
+
+  template< typename Key, typename Element >
+  void  IntrusiveHashMap<Key,Element>::_insert ( Element* element )
+  {
+    uint32_t hash = _getHashValue( _getKey(element) );
+    if (_find(element,hash) < _length) return;
+
+    if ((_size+1)*8 > _length*7) reserve( std::max(_size+1,_length) );
+    _place( Slot{ element, hash } );
+    ++_size;
+  }
+
+
+// Backward shift: the following slots which are not at their home
+// are moved back by one, so no tombstone is needed.
+  template< typename Key, typename Element >
+  void  IntrusiveHashMap<Key,Element>::_remove ( Element* element )
+  {
+    uint32_t islot = _find( element, _getHashValue(_getKey(element)) );
+    if (islot >= _length) return;
+
+    uint32_t mask = _length - 1;
+    uint32_t next = (islot+1) & mask;
+    while ( _slots[next]._element and _getDistance(next) ) {
+      _slots[islot] = _slots[next];
+      islot = next;
+      next  = (next+1) & mask;
+    }
+    _slots[islot] = Slot{ NULL, 0 };
+    --_size;
+  }
+
+
+  template< typename Key, typename Element >
+  string  IntrusiveHashMap<Key,Element>::_getTypeName () const
+  { return _TName("IntrusiveHashMap"); }
+
+
+  template< typename Key, typename Element >
+  string  IntrusiveHashMap<Key,Element>::_getString () const
+  {
+    if (isEmpty()) return "<" + _getTypeName() + " empty>";
+    return "<" + _getTypeName() + " " + getString(_size) + "/" + getString(_length) + ">";
+  }
+
+
+  template< typename Key, typename Element >
+  Record* IntrusiveHashMap<Key,Element>::_getRecord () const
+  {
+    if (isEmpty()) return NULL;
+
+    Record* record = new Record( getString(this) );
+    for ( unsigned islot=0 ; islot<_length ; ++islot ) {
+      if (_slots[islot]._element)
+        record->add( getSlot<Element*>( getString(islot), _slots[islot]._element ) );
+    }
+    return record;
+  }
+
+
+  template< typename Key, typename Element >
+  inline GenericCollection<Element*> getCollection ( const IntrusiveHashMap<Key,Element>& map )
+  { return map.getElements(); }
+
+
+} // Hurricane namespace.
+
+
+template< typename Key, typename Element >
+inline std::string  getString ( Hurricane::IntrusiveHashMap<Key,Element>* map )
+{ return map->_getString(); }
+
+template< typename Key, typename Element >
+inline std::string  getString ( const Hurricane::IntrusiveHashMap<Key,Element>* map )
+{ return map->_getString(); }
+
+template< typename Key, typename Element >
+inline Hurricane::Record* getRecord ( Hurricane::IntrusiveHashMap<Key,Element>* map )
+{ return map->_getRecord(); }
+
+template< typename Key, typename Element >
+inline Hurricane::Record* getRecord ( const Hurricane::IntrusiveHashMap<Key,Element>* map )
+{ return map->_getRecord(); }
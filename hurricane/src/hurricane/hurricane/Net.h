@@ -154,7 +154,6 @@ class Net : public Entity {
     private: Point _position;
     private: ComponentSet _componentSet;
     private: RubberSet _rubberSet;
-    private: Net* _nextOfCellNetMap;
     private: NetMainName _mainName;
 
 // Constructors
@@ -257,9 +256,6 @@ class Net : public Entity {
     public: NetMainName& _getMainName() { return _mainName; }
     public: ComponentSet& _getComponentSet() {return _componentSet;};
     public: RubberSet& _getRubberSet() {return _rubberSet;};
-    public: Net* _getNextOfCellNetMap() const {return _nextOfCellNetMap;};
-
-    public: void _setNextOfCellNetMap(Net* net) {_nextOfCellNetMap = net;};
 
     public: struct CompareByName {
         inline bool operator() ( const Net* lhs, const Net* rhs ) const { return lhs->getName() < rhs->getName(); }
@@ -0,0 +1,202 @@
+// -*- C++ -*-
+//
+// Copyright (c) BULL S.A. 2000-2026, All Rights Reserved
+//
+// This file is part of Hurricane.
+//
+// Hurricane is free software: you can redistribute it  and/or  modify
+// it under the terms of the GNU  Lesser  General  Public  License  as
+// published by the Free Software Foundation, either version 3 of  the
+// License, or (at your option) any later version.
+//
+// Hurricane is distributed in the hope that it will  be  useful,  but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHAN-
+// TABILITY or FITNESS FOR A PARTICULAR PURPOSE. See  the  Lesser  GNU
+// General Public License for more details.
+//
+// You should have received a copy of the Lesser  GNU  General  Public
+// License along with Hurricane. If not, see
+//                                     <http://www.gnu.org/licenses/>.
+//
+// +-----------------------------------------------------------------+
+// |                  H U R R I C A N E                              |
+// |     V L S I   B a c k e n d   D a t a - B a s e                 |
+// |                                                                 |
+// |  Author      :                    Jean-Paul CHAPUT              |
+// |  E-mail      :            Jean-Paul.Chaput@lip6.fr              |
+// | =============================================================== |
+// |  C++ Header  :  "./hurricane/PackedRTree.h"                     |
+// +-----------------------------------------------------------------+
+//
+// References:
+//    1. S. Leutenegger, M. Lopez, J. Edgington, "STR: A Simple and
+//       Efficient Algorithm for R-Tree Packing", ICDE 1997.
+
+
+#pragma  once
+#include <cstdint>
+#include <atomic>
+#include <vector>
+#include "hurricane/Box.h"
+#include "hurricane/Gos.h"
+
+
+namespace Hurricane {
+
+
+// -------------------------------------------------------------------
+// Class  :  "Hurricane::PackedRTree".
+//
+// Static, bulk loaded (Sort-Tile-Recursive) R-Tree. All the nodes
+// are stored level by level in one contiguous array, leaves first
+// and root last, and the Gos with their bounding boxes in two other
+// arrays, in leaf order. It cannot be modified once built, it is
+// only a read accelerator for a QuadTree that is no longer edited.
+//
+// The Gos collections and locators keep a reference on the tree. When
+// the owning QuadTree is modified it only detaches the tree, which is
+// deleted when the last reference goes away. So a Go can be inserted
+// or removed while iterating, the iteration continues over the stale
+// contents the tree had when it was detached.
+
+  class PackedRTree {
+    public:
+      static const uint32_t  NodeCapacity = 16;
+    public:
+      class Node {
+        public:
+          inline            Node       ();
+          inline bool       intersect  ( const Box& ) const;
+          inline bool       isPruned   ( DbU::Unit threshold ) const;
+          inline void       merge      ( DbU::Unit xMin, DbU::Unit yMin, DbU::Unit xMax, DbU::Unit yMax );
+        public:
+          DbU::Unit  _xMin;
+          DbU::Unit  _yMin;
+          DbU::Unit  _xMax;
+          DbU::Unit  _yMax;
+          uint32_t   _first;
+          uint32_t   _count;
+      };
+    public:
+                                     PackedRTree    ( Gos );
+      inline  bool                   isEmpty        () const;
+      inline  size_t                 getSize        () const;
+      inline  size_t                 getNodesSize   () const;
+      inline  uint32_t               getLeafsSize   () const;
+      inline  uint32_t               getRoot        () const;
+      inline  bool                   isLeaf         ( uint32_t ) const;
+      inline  const Node&            getNode        ( uint32_t ) const;
+      inline  Go*                    getGo          ( uint32_t ) const;
+      inline  const Box&             getGoBox       ( uint32_t ) const;
+              Box                    getBoundingBox () const;
+              Gos                    getGos         () const;
+              Gos                    getGosUnder    ( const Box& area, DbU::Unit threshold=0 ) const;
+      template< typename Visitor >
+      inline  void                   visitGosUnder  ( const Box& area, DbU::Unit threshold, Visitor ) const;
+              size_t                 getMemorySize  () const;
+      inline  bool                   _isDetached    () const;
+      inline  void                   _ref           () const;
+              void                   _unref         () const;
+              void                   _detach        ();
+              string                 _getTypeName   () const;
+              string                 _getString     () const;
+              Record*                _getRecord     () const;
+    private:
+      std::vector<Node>  _nodes;
+      std::vector<Box>   _boxes;
+      std::vector<Go*>   _gos;
+      uint32_t           _leafs;
+      mutable std::atomic<uint32_t>  _refs;
+      bool                           _detached;
+
+    private:
+                   ~PackedRTree ();
+                    PackedRTree ( const PackedRTree& );
+      PackedRTree&  operator=   ( const PackedRTree& );
+  };
+
+
+  inline  PackedRTree::Node::Node ()
+    : _xMin (0)
+    , _yMin (0)
+    , _xMax (0)
+    , _yMax (0)
+    , _first(0)
+    , _count(0)
+  { }
+
+
+  inline bool  PackedRTree::Node::intersect ( const Box& area ) const
+  {
+    return (_xMin <= area.getXMax()) and (area.getXMin() <= _xMax)
+       and (_yMin <= area.getYMax()) and (area.getYMin() <= _yMax);
+  }
+
+
+// The threshold pruning must stay the exact mirror of the one done by
+// QuadTree_GosUnder: a Go is skipped when *both* it's sides are below
+// the threshold, so a node can be skipped as a whole on the same rule.
+  inline bool  PackedRTree::Node::isPruned ( DbU::Unit threshold ) const
+  {
+    if (threshold <= 0) return false;
+    return (_xMax - _xMin < threshold) and (_yMax - _yMin < threshold);
+  }
+
+
+  inline void  PackedRTree::Node::merge ( DbU::Unit xMin, DbU::Unit yMin, DbU::Unit xMax, DbU::Unit yMax )
+  {
+    if (xMin < _xMin) _xMin = xMin;
+    if (yMin < _yMin) _yMin = yMin;
+    if (xMax > _xMax) _xMax = xMax;
+    if (yMax > _yMax) _yMax = yMax;
+  }
+
+
+  inline  bool               PackedRTree::isEmpty      () const { return _gos.empty(); }
+  inline  size_t             PackedRTree::getSize      () const { return _gos.size(); }
+  inline  size_t             PackedRTree::getNodesSize () const { return _nodes.size(); }
+  inline  uint32_t           PackedRTree::getLeafsSize () const { return _leafs; }
+  inline  uint32_t           PackedRTree::getRoot      () const { return _nodes.size()-1; }
+  inline  bool               PackedRTree::isLeaf       ( uint32_t inode ) const { return inode < _leafs; }
+  inline  const PackedRTree::Node&
+                             PackedRTree::getNode      ( uint32_t inode ) const { return _nodes[inode]; }
+  inline  Go*                PackedRTree::getGo        ( uint32_t igo ) const { return _gos[igo]; }
+  inline  const Box&         PackedRTree::getGoBox     ( uint32_t igo ) const { return _boxes[igo]; }
+  inline  bool               PackedRTree::_isDetached  () const { return _detached; }
+  inline  void               PackedRTree::_ref         () const { ++_refs; }
+
+
+// Same walk as PackedRTree_GosUnder but without the Locator overhead,
+// the visitor is called with the Go and it's cached bounding box.
+  template< typename Visitor >
+  inline void  PackedRTree::visitGosUnder ( const Box& area, DbU::Unit threshold, Visitor visitor ) const
+  {
+    if (_nodes.empty() or area.isEmpty()) return;
+
+  // At most (NodeCapacity-1) pending siblings per level.
+    uint32_t  stack[ 256 ];
+    size_t    top = 0;
+    stack[ top++ ] = getRoot();
+    while ( top ) {
+      uint32_t    inode = stack[ --top ];
+      const Node& node  = _nodes[ inode ];
+      if (not node.intersect(area) or node.isPruned(threshold)) continue;
+      if (isLeaf(inode)) {
+        for ( uint32_t igo=node._first ; igo<node._first+node._count ; ++igo ) {
+          const Box& bb = _boxes[igo];
+          if (not bb.intersect(area)) continue;
+          if ((threshold > 0) and (bb.getWidth() < threshold) and (bb.getHeight() < threshold)) continue;
+          visitor( _gos[igo], bb );
+        }
+        continue;
+      }
+      for ( uint32_t ichild=node._first+node._count ; ichild > node._first ; --ichild )
+        stack[ top++ ] = ichild-1;
+    }
+  }
+
+
+} // Hurricane namespace.
+
+
+INSPECTOR_P_SUPPORT(Hurricane::PackedRTree);
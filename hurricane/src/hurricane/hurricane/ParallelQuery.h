@@ -0,0 +1,150 @@
+// -*- C++ -*-
+//
+// Copyright (c) BULL S.A. 2000-2026, All Rights Reserved
+//
+// This file is part of Hurricane.
+//
+// Hurricane is free software: you can redistribute it  and/or  modify
+// it under the terms of the GNU  Lesser  General  Public  License  as
+// published by the Free Software Foundation, either version 3 of  the
+// License, or (at your option) any later version.
+//
+// Hurricane is distributed in the hope that it will  be  useful,  but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHAN-
+// TABILITY or FITNESS FOR A PARTICULAR PURPOSE. See  the  Lesser  GNU
+// General Public License for more details.
+//
+// You should have received a copy of the Lesser  GNU  General  Public
+// License along with Hurricane. If not, see
+//                                     <http://www.gnu.org/licenses/>.
+//
+// +-----------------------------------------------------------------+
+// |                  H U R R I C A N E                              |
+// |     V L S I   B a c k e n d   D a t a - B a s e                 |
+// |                                                                 |
+// |  Author      :                    Jean-Paul CHAPUT              |
+// |  E-mail      :            Jean-Paul.Chaput@lip6.fr              |
+// | =============================================================== |
+// |  C++ Header  :  "./hurricane/ParallelQuery.h"                   |
+// +-----------------------------------------------------------------+
+
+
+#pragma  once
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include "hurricane/Query.h"
+
+
+namespace Hurricane {
+
+
+// -------------------------------------------------------------------
+// Class  :  "ParallelQuery".
+//
+// Multi-threaded flavor of Query. The top area is cut into a grid of
+// tiles, each worker thread pulls tiles from a shared counter and
+// walks the hierarchy with it's own QueryStack. The callbacks receive
+// that stack and the worker index, so they can store their results in
+// per-worker containers and must be thread-safe otherwise.
+//
+// An object overlapping several tiles is reported only once, by the
+// tile that owns the lower left corner of it's bounding box (clipped
+// to the top area), in top cell coordinates.
+//
+// The QuadTrees of all the Cells of the hierarchy are packed before
+// the workers are started (see Cell::packQuadTrees()) as the lazily
+// computed bounding boxes of a plain QuadTree cannot be shared, and
+// the ones that were not already packed are unpacked afterwards. Tools
+// that run their own threads over a hierarchy can call freeze() and
+// unfreeze() for the same purpose.
+
+  class ParallelQuery {
+    public:
+      typedef Query::Mask                                    Mask;
+      typedef std::vector< std::pair<Cell*,const Layer*> >  Frozens;
+    public:
+      static  void                  freeze                 ( Cell*, Frozens* packeds=NULL );
+      static  void                  unfreeze               ( const Frozens& packeds );
+    public:
+    // Constructors & Destructors.
+                                    ParallelQuery          ();
+      virtual                      ~ParallelQuery          ();
+    // Accessors.
+      inline  Cell*                 getCell                () const;
+      inline  const Box&            getArea                () const;
+      inline  const BasicLayer*     getBasicLayer          () const;
+      inline  unsigned int          getThreads             () const;
+      inline  unsigned int          getTilesPerSide        () const;
+      inline  size_t                getInstanceCount       () const;
+      virtual bool                  hasGoCallback          () const;
+      virtual bool                  hasMasterCellCallback  () const;
+      virtual void                  goCallback             ( Go*, QueryStack&, unsigned int worker ) = 0;
+      virtual void                  masterCellCallback     ( QueryStack&, unsigned int worker );
+    // Modifiers.
+              void                  setQuery               ( Cell*                 cell
+                                                           , const Box&            area
+                                                           , const Transformation& transformation
+                                                           , const BasicLayer*     basicLayer
+                                                           , Mask                  filter
+                                                           , DbU::Unit             threshold=0
+                                                           );
+      inline  void                  setCell                ( Cell* );
+      inline  void                  setArea                ( const Box& );
+      inline  void                  setTransformation      ( const Transformation& );
+      inline  void                  setBasicLayer          ( const BasicLayer* );
+      inline  void                  setFilter              ( Mask );
+      inline  void                  setThreshold           ( DbU::Unit );
+      inline  void                  setStartLevel          ( unsigned int );
+      inline  void                  setStopLevel           ( unsigned int );
+      inline  void                  setStopCellFlags       ( Cell::Flags );
+              void                  setThreads             ( unsigned int );
+              void                  setTilesPerSide        ( unsigned int );
+      virtual void                  doQuery                ();
+    protected:
+              void                  _runWorker             ( unsigned int worker );
+              void                  _doTile                ( QueryStack&, size_t itile, unsigned int worker );
+              size_t                _getOwnerTile          ( const Box& ) const;
+              Box                   _getTile               ( size_t itile ) const;
+    protected:
+    // Internal: Attributes.
+              Cell*                 _cell;
+              Box                   _area;
+              Transformation        _transformation;
+              Transformation        _inverse;
+              const BasicLayer*     _basicLayer;
+              Mask                  _filter;
+              DbU::Unit             _threshold;
+              unsigned int          _startLevel;
+              unsigned int          _stopLevel;
+              Cell::Flags           _stopCellFlags;
+              unsigned int          _threads;
+              unsigned int          _tilesPerSide;
+              std::atomic<size_t>   _nextTile;
+              std::atomic<size_t>   _instanceCount;
+              std::mutex            _errorLock;
+              std::string           _error;
+    private:
+                                    ParallelQuery          ( const ParallelQuery& );
+              ParallelQuery&        operator=              ( const ParallelQuery& );
+  };
+
+
+  inline  Cell*              ParallelQuery::getCell            () const { return _cell; }
+  inline  const Box&         ParallelQuery::getArea            () const { return _area; }
+  inline  const BasicLayer*  ParallelQuery::getBasicLayer      () const { return _basicLayer; }
+  inline  unsigned int       ParallelQuery::getThreads         () const { return _threads; }
+  inline  unsigned int       ParallelQuery::getTilesPerSide    () const { return _tilesPerSide; }
+  inline  size_t             ParallelQuery::getInstanceCount   () const { return _instanceCount; }
+  inline  void               ParallelQuery::setCell            ( Cell* cell ) { _cell = cell; }
+  inline  void               ParallelQuery::setArea            ( const Box& area ) { _area = area; }
+  inline  void               ParallelQuery::setTransformation  ( const Transformation& transformation ) { _transformation = transformation; }
+  inline  void               ParallelQuery::setBasicLayer      ( const BasicLayer* basicLayer ) { _basicLayer = basicLayer; }
+  inline  void               ParallelQuery::setFilter          ( Mask filter ) { _filter = filter; }
+  inline  void               ParallelQuery::setThreshold       ( DbU::Unit threshold ) { _threshold = threshold; }
+  inline  void               ParallelQuery::setStartLevel      ( unsigned int level ) { _startLevel = level; }
+  inline  void               ParallelQuery::setStopLevel       ( unsigned int level ) { _stopLevel = level; }
+  inline  void               ParallelQuery::setStopCellFlags   ( Cell::Flags flags ) { _stopCellFlags = flags; }
+
+
+} // Hurricane namespace.
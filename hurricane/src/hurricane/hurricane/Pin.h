@@ -115,13 +115,10 @@ namespace Hurricane {
       virtual std::string      _getTypeName         () const {return _TName("Pin");};
       virtual std::string      _getString           () const;
       virtual Record*          _getRecord           () const;
-              Pin*             _getNextOfCellPinMap () const { return _nextOfCellPinMap; };
-              void             _setNextOfCellPinMap ( Pin* pin ) { _nextOfCellPinMap = pin; };
     private:
       Name             _name;
       AccessDirection  _accessDirection;
       PlacementStatus  _placementStatus;
-      Pin*             _nextOfCellPinMap;
   };
 
 
@@ -24,6 +24,8 @@
 
 namespace Hurricane {
 
+class PackedRTree;
+
 
 
 // ****************************************************************************************************
@@ -60,6 +62,7 @@ class QuadTree {
     private: QuadTree* _urChild; // Upper Right Child
     private: QuadTree* _llChild; // Lower Left Child
     private: QuadTree* _lrChild; // Lower Right Child
+    private: PackedRTree* _packedRTree; // Read-only accelerator, root only
 
 // Constructors
 // ************
@@ -92,12 +95,18 @@ class QuadTree {
 // **********
 
     public: bool isEmpty() const {return (_size == 0);};
+    public: bool isPacked() const {return (_packedRTree != NULL);};
 
 // Updators
 // ********
 
     public: void insert(Go* go);
     public: void remove(Go* go);
+    public: void pack();
+    public: void unpack();
+    public: static void openBatch();
+    public: static void closeBatch();
+    public: static bool isInBatch();
 
 // Others
 // ******
@@ -107,6 +116,7 @@ class QuadTree {
     public: Record* _getRecord() const;
 
     public: GoSet& _getGoSet() {return _goSet;};
+    public: PackedRTree* _getPackedRTree() const {return _packedRTree;};
     public: QuadTree* _getDeepestChild(const Box& box);
     public: QuadTree* _getFirstQuadTree() const;
     public: QuadTree* _getFirstQuadTree(const Box& area) const;
@@ -117,6 +127,7 @@ class QuadTree {
 
     public: void _explode();
     public: void _implode();
+    public: void _rebalance();
 
 };
 
@@ -25,16 +25,19 @@
 // |  Authors     :                       Remy Escassut              |
 // |  E-mail      :            Jean-Paul.Chaput@lip6.fr              |
 // | =============================================================== |
-// |  C++ Header  :  "./hurricane/RoutingPad.h"                      |
+// |  C++ Header  :  "./hurricane/SharedPath.h"                      |
 // +-----------------------------------------------------------------+
 
 
 #pragma  once
+#include <cstdint>
+#include <shared_mutex>
 #include "hurricane/Instances.h"
 #include "hurricane/SharedPathes.h"
 #include "hurricane/Quark.h"
 #include "hurricane/Transformation.h"
 #include "hurricane/IntrusiveMap.h"
+#include "hurricane/IntrusiveHashMap.h"
 
 namespace Hurricane {
 
@@ -44,7 +47,30 @@ namespace Hurricane {
 
 // -------------------------------------------------------------------
 // Class  :  "SharedPath".
-
+//
+// SharedPathes are hash-consed: there is only one SharedPath for a
+// given (head Instance, tail SharedPath) pair, found or created
+// through SharedPath::get() in a global Table. Flattening a deep
+// hierarchy creates one SharedPath per instance occurrence, so they
+// are kept as small as possible:
+//
+// * They are allocated in an Arena, by chunks, and identified by a
+//   compact 32 bits id (their index in the Arena). An id is reused
+//   once it's SharedPath is destroyed.
+// * The hash is computed from the head Instance id and the tail hash
+//   (a 64 bits mix), so it does not depend on the creation order and
+//   stays deterministic from one run to another.
+// * The QuarkMap is only allocated when the first Quark is put on the
+//   path (most of them never get one).
+// * The head Instance lists it's SharedPathes in a vector, the
+//   position in it is stored in the SharedPath.
+//
+// The Table owns a readers/writer lock, taken by every access to the
+// Table and the Arena (shared by find(), exclusive by the creation and
+// the destruction). So Pathes can be built from any thread without an
+// external lock, only the creation of a new SharedPath is exclusive.
+// Destroying SharedPathes while other threads use them is still not
+// supported.
 
   class SharedPath {
     public:
@@ -60,16 +86,49 @@ namespace Hurricane {
     };
 
     public:
-                   SharedPath ( Instance* headInstance, SharedPath* tailSharedPath = NULL );
-                  ~SharedPath ();
+      struct Key {
+        inline bool  operator== ( const Key& ) const;
+        const Instance*    _headInstance;
+        const SharedPath*  _tailSharedPath;
+      };
+
+    public:
+      class Table : public IntrusiveHashMap<Key,SharedPath> {
+        public:
+          typedef IntrusiveHashMap<Key,SharedPath> Inherit;
+        public:
+                                Table         ();
+          inline  std::shared_mutex&
+                                getLock       () const;
+          virtual const Key&    _getKey       ( SharedPath* ) const;
+          virtual unsigned      _getHashValue ( const Key& ) const;
+        private:
+          mutable std::shared_mutex  _lock;
+      };
+
+    public:
+      static const uint32_t  npos = (uint32_t)-1;
+      class Arena;
+
+    public:
+      static SharedPath*    get               ( Instance* headInstance, SharedPath* tailSharedPath=NULL );
+      static SharedPath*    find              ( const Instance* headInstance, const SharedPath* tailSharedPath=NULL );
+      static SharedPath*    getFromId         ( uint32_t id );
+      static size_t         getCount          ();
+      static size_t         getAllocatedSize  ();
+      static unsigned long  computeHash       ( const Instance* headInstance, const SharedPath* tailSharedPath );
+             void           destroy           ();
     private:
+                   SharedPath ( uint32_t id, Instance* headInstance, SharedPath* tailSharedPath );
+                  ~SharedPath ();
                    SharedPath ( const SharedPath& ) = delete;
        SharedPath& operator=  ( const SharedPath& ) = delete;
     public:
       static char getNameSeparator ();
       static void setNameSeparator ( char nameSeparator );
     public:
-             unsigned long  getHash           () const;
+      inline uint32_t       getId             () const;
+      inline unsigned long  getHash           () const;
       inline Instance*      getHeadInstance   () const;
       inline SharedPath*    getTailSharedPath () const;
              SharedPath*    getHeadSharedPath () const;
@@ -81,31 +140,39 @@ namespace Hurricane {
              Instances      getInstances      () const;
              Transformation getTransformation ( const Transformation& transformation=Transformation() ) const;
     public:
-             std::string    _getTypeName                    () const;
-             std::string    _getString                      () const;
-             Record*        _getRecord                      () const;
-      inline Quark*         _getQuark                       (const Entity* entity ) const;
-      inline Quarks         _getQuarks                      () const;
-      inline QuarkMap&      _getQuarkMap                    ();
-      inline SharedPath*    _getNextOfInstanceSharedPathMap () const;
-      inline void           _setNextOfInstanceSharedPathMap ( SharedPath* sharedPath );
+             std::string    _getTypeName      () const;
+             std::string    _getString        () const;
+             Record*        _getRecord        () const;
+             size_t         _getMemorySize    () const;
+      inline Quark*         _getQuark         ( const Entity* entity ) const;
+      inline Quarks         _getQuarks        () const;
+             void           _insertQuark      ( Quark* );
+             void           _removeQuark      ( Quark* );
+      inline uint32_t       _getInstanceIndex () const;
+      inline void           _setInstanceIndex ( uint32_t );
     private:
     // Attributes.
+      uint32_t       _id;
+      uint32_t       _instanceIndex;
       unsigned long  _hash;
-      Instance*      _headInstance;
-      SharedPath*    _tailSharedPath;
-      QuarkMap       _quarkMap;
-      SharedPath*    _nextOfInstanceSharedPathMap;
+      Key            _key;
+      QuarkMap*      _quarkMap;
   };
 
-  
-  inline Instance*             SharedPath::getHeadInstance                 () const { return _headInstance; }
-  inline SharedPath*           SharedPath::getTailSharedPath               () const { return _tailSharedPath; }
-  inline Quark*                SharedPath::_getQuark                       (const Entity* entity ) const { return _quarkMap.getElement(entity); }
-  inline Quarks                SharedPath::_getQuarks                      () const { return _quarkMap.getElements(); }
-  inline SharedPath::QuarkMap& SharedPath::_getQuarkMap                    () { return _quarkMap; }
-  inline SharedPath*           SharedPath::_getNextOfInstanceSharedPathMap () const { return _nextOfInstanceSharedPathMap; }
-  inline void                  SharedPath::_setNextOfInstanceSharedPathMap ( SharedPath* sharedPath ) { _nextOfInstanceSharedPathMap = sharedPath; }
+
+  inline bool  SharedPath::Key::operator== ( const Key& other ) const
+  { return (_headInstance == other._headInstance) and (_tailSharedPath == other._tailSharedPath); }
+
+  inline std::shared_mutex& SharedPath::Table::getLock () const { return _lock; }
+
+  inline uint32_t       SharedPath::getId             () const { return _id; }
+  inline unsigned long  SharedPath::getHash           () const { return _hash; }
+  inline Instance*      SharedPath::getHeadInstance   () const { return const_cast<Instance*>( _key._headInstance ); }
+  inline SharedPath*    SharedPath::getTailSharedPath () const { return const_cast<SharedPath*>( _key._tailSharedPath ); }
+  inline Quark*         SharedPath::_getQuark         ( const Entity* entity ) const { return (_quarkMap) ? _quarkMap->getElement(entity) : NULL; }
+  inline Quarks         SharedPath::_getQuarks        () const { return (_quarkMap) ? Quarks(_quarkMap->getElements()) : Quarks(); }
+  inline uint32_t       SharedPath::_getInstanceIndex () const { return _instanceIndex; }
+  inline void           SharedPath::_setInstanceIndex ( uint32_t index ) { _instanceIndex = index; }
 
 
 } // Hurricane namespace.
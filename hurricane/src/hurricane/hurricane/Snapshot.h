@@ -0,0 +1,115 @@
+// -*- C++ -*-
+//
+// Copyright (c) BULL S.A. 2000-2026, All Rights Reserved
+//
+// This file is part of Hurricane.
+//
+// Hurricane is free software: you can redistribute it  and/or  modify
+// it under the terms of the GNU  Lesser  General  Public  License  as
+// published by the Free Software Foundation, either version 3 of  the
+// License, or (at your option) any later version.
+//
+// Hurricane is distributed in the hope that it will  be  useful,  but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHAN-
+// TABILITY or FITNESS FOR A PARTICULAR PURPOSE. See  the  Lesser  GNU
+// General Public License for more details.
+//
+// You should have received a copy of the Lesser  GNU  General  Public
+// License along with Hurricane. If not, see
+//                                     <http://www.gnu.org/licenses/>.
+//
+// +-----------------------------------------------------------------+
+// |                  H U R R I C A N E                              |
+// |     V L S I   B a c k e n d   D a t a - B a s e                 |
+// |                                                                 |
+// |  Author      :                    Jean-Paul CHAPUT              |
+// |  E-mail      :            Jean-Paul.Chaput@lip6.fr              |
+// | =============================================================== |
+// |  C++ Header  :  "./hurricane/Snapshot.h"                        |
+// +-----------------------------------------------------------------+
+
+
+#pragma  once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "hurricane/Property.h"
+
+
+namespace Hurricane {
+
+  class Cell;
+
+
+// -------------------------------------------------------------------
+// Class  :  "Snapshot".
+//
+// Binary checkpoint of a Cell hierarchy, to save & restore the data
+// base between the steps of a flow (place, route, extract) without
+// going through JSON. The top Cell is saved along with all the non
+// terminal netlist Cells below it. The terminal netlist ones (standard
+// cells) are only referenced by their hierarchical names and must be
+// reachable through DataBase::getCell() when loading.
+//
+// The file is made of a header, a table of sections (kind, offset,
+// size) and the sections themselves:
+//
+// * Strings    : every Name & hierarchical name, stored once, every
+//                other section refers to them by index.
+// * Layers     : the names of the Layers used by the Components.
+// * Externals  : the terminal netlist master Cells.
+// * Cells      : one fixed size record per saved Cell, bottom-up (the
+//                top one last), with the location of it's netlist and
+//                components inside the two next sections.
+// * Netlists   : Instances, Nets (and DeepNets) and Plug connexions.
+// * Components : Contacts, Pins, Segments, Pads & RoutingPads, the
+//                anchors & hooked components before their slaves.
+//
+// Integers are stored as LEB128 varints, signed ones zigzag encoded,
+// the absolute coordinates are delta encoded from the previous one of
+// the same axis. Only the Components supported by the format are
+// saved, the others are counted and reported by a Warning.
+//
+// The file is memory mapped when loading. With the LazyComponents
+// flag, only the Cells & netlists are built, the Components of each
+// Cell are created by materialize(). Until then, a Pending property
+// keeps the file mapped and the netlist of the Cell must not be
+// modified.
+
+  class Snapshot {
+    public:
+      static const uint32_t  Version = 1;
+      enum Flags { NoFlags        = 0
+                 , LazyComponents = (1 << 0)
+                 };
+    public:
+      class Loader;
+      class Pending : public PrivateProperty {
+        public:
+          static  Pending*    create          ( std::shared_ptr<Loader>, uint32_t icell );
+          static  Name        getPropertyName ();
+          virtual Name        getName         () const;
+          inline  Loader*     getLoader       () const;
+          inline  uint32_t    getIndex        () const;
+          virtual std::string _getTypeName    () const;
+          virtual std::string _getString      () const;
+          virtual Record*     _getRecord      () const;
+        protected:
+                              Pending         ( std::shared_ptr<Loader>, uint32_t icell );
+        private:
+          std::shared_ptr<Loader>  _loader;
+          uint32_t                 _index;
+      };
+    public:
+      static void   save        ( Cell*, const std::string& path );
+      static Cell*  load        ( const std::string& path, uint32_t flags=NoFlags );
+      static bool   isPending   ( const Cell* );
+      static void   materialize ( Cell* );
+  };
+
+
+  inline Snapshot::Loader* Snapshot::Pending::getLoader () const { return _loader.get(); }
+  inline uint32_t          Snapshot::Pending::getIndex  () const { return _index; }
+
+
+}  // Hurricane namespace.
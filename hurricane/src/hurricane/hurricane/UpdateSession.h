@@ -52,6 +52,7 @@ class UpdateSession : public SharedProperty {
 
     public: static const Name& getPropertyName();
     public: virtual Name getName() const {return getPropertyName();};
+    public: size_t getInvalidations() const {return _invalidations;};
 
 // Managers
 // ********
@@ -77,6 +78,26 @@ class UpdateSession : public SharedProperty {
     public: static void reset();
     public: static size_t  getStackSize();
 
+// Invalidation counters, accumulated over the closed sessions
+// ***********************************************************
+
+    public: static size_t getSessionCount() {return _sessionCount;};
+    public: static size_t getTotalInvalidations() {return _totalInvalidations;};
+    public: static size_t getLastInvalidations() {return _lastInvalidations;};
+    public: static size_t getMaxInvalidations() {return _maxInvalidations;};
+    public: static void resetCounters();
+
+    public: void _addInvalidation() {_invalidations++;};
+
+// Attributes
+// **********
+
+    private: size_t _invalidations;
+    private: static size_t _sessionCount;
+    private: static size_t _totalInvalidations;
+    private: static size_t _lastInvalidations;
+    private: static size_t _maxInvalidations;
+
 
 };
 
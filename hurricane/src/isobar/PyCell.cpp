@@ -14,6 +14,7 @@
 // +-----------------------------------------------------------------+
 
 
+#include "hurricane/Snapshot.h"
 #include "hurricane/isobar/PyCell.h"
 #include "hurricane/isobar/PyBox.h"
 #include "hurricane/isobar/PyLibrary.h"
@@ -749,17 +750,19 @@ extern "C" {
     cdebug_log(20,0) << "PyCell_flattenNets()" << endl;
     
     uint64_t     flags    = 0;
+    unsigned int threads  = 1;
     set<string>  excludeds;
     Instance*    instance = NULL;
     PyObject*    arg0     = NULL;
     PyObject*    arg1     = NULL;
     PyObject*    arg2     = NULL;
+    PyObject*    arg3     = NULL;
 
     HTRY
       METHOD_HEAD ( "Cell.flattenNets()" )
       __cs.init( "Cell.flattenNets" );
-      if (not PyArg_ParseTuple(args,"OO|O:Cell.flattenNets", &arg0, &arg1, &arg2 )) {
-        PyErr_SetString( ConstructorError, "Cell.flattenNets(): Takes between two and three parameters." );
+      if (not PyArg_ParseTuple(args,"OO|OO:Cell.flattenNets", &arg0, &arg1, &arg2, &arg3 )) {
+        PyErr_SetString( ConstructorError, "Cell.flattenNets(): Takes between two and four parameters." );
         return NULL;
       }
   
@@ -773,11 +776,12 @@ extern "C" {
       if (arg2) {
         pyListToStringSet( arg1, excludeds );
         flags = PyInt_AsLong( arg2 );
+        if (arg3) threads = PyInt_AsLong( arg3 );
       } else {
         flags = PyInt_AsLong( arg1 );
       }
 
-      cell->flattenNets( instance, excludeds, flags );
+      cell->flattenNets( instance, excludeds, flags, threads );
     HCATCH
     Py_RETURN_NONE;
   }
@@ -797,6 +801,87 @@ extern "C" {
   }
 
 
+  // ---------------------------------------------------------------
+  // Attribute Method  :  "PyCell_packQuadTrees ()"
+
+  static PyObject* PyCell_packQuadTrees ( PyCell *self )
+  {
+    cdebug_log(20,0) << "PyCell_packQuadTrees ()" << endl;
+    HTRY
+      METHOD_HEAD( "Cell.packQuadTrees()" )
+      cell->packQuadTrees();
+    HCATCH
+    Py_RETURN_NONE;
+  }
+
+
+  // ---------------------------------------------------------------
+  // Attribute Method  :  "PyCell_unpackQuadTrees ()"
+
+  static PyObject* PyCell_unpackQuadTrees ( PyCell *self )
+  {
+    cdebug_log(20,0) << "PyCell_unpackQuadTrees ()" << endl;
+    HTRY
+      METHOD_HEAD( "Cell.unpackQuadTrees()" )
+      cell->unpackQuadTrees();
+    HCATCH
+    Py_RETURN_NONE;
+  }
+
+
+  // ---------------------------------------------------------------
+  // Attribute Method  :  "PyCell_saveSnapshot ()"
+
+  static PyObject* PyCell_saveSnapshot ( PyCell *self, PyObject* args )
+  {
+    cdebug_log(20,0) << "PyCell_saveSnapshot ()" << endl;
+    char* path = NULL;
+    HTRY
+      METHOD_HEAD( "Cell.saveSnapshot()" )
+      if (not PyArg_ParseTuple(args,"s:Cell.saveSnapshot", &path)) {
+        PyErr_SetString( ConstructorError, "Cell.saveSnapshot(): Takes exactly one path argument." );
+        return NULL;
+      }
+      Snapshot::save( cell, path );
+    HCATCH
+    Py_RETURN_NONE;
+  }
+
+
+  // ---------------------------------------------------------------
+  // Attribute Method  :  "PyCell_loadSnapshot ()"
+
+  static PyObject* PyCell_loadSnapshot ( PyObject*, PyObject* args )
+  {
+    cdebug_log(20,0) << "PyCell_loadSnapshot ()" << endl;
+    char*    path  = NULL;
+    uint32_t flags = Snapshot::NoFlags;
+    Cell*    cell  = NULL;
+    HTRY
+      if (not PyArg_ParseTuple(args,"s|I:Cell.loadSnapshot", &path, &flags)) {
+        PyErr_SetString( ConstructorError, "Cell.loadSnapshot(): Takes a path and optional flags." );
+        return NULL;
+      }
+      cell = Snapshot::load( path, flags );
+    HCATCH
+    return PyCell_Link( cell );
+  }
+
+
+  // ---------------------------------------------------------------
+  // Attribute Method  :  "PyCell_materializeSnapshot ()"
+
+  static PyObject* PyCell_materializeSnapshot ( PyCell *self )
+  {
+    cdebug_log(20,0) << "PyCell_materializeSnapshot ()" << endl;
+    HTRY
+      METHOD_HEAD( "Cell.materializeSnapshot()" )
+      Snapshot::materialize( cell );
+    HCATCH
+    Py_RETURN_NONE;
+  }
+
+
   // Standart Predicates (Attributes).
   DirectGetBoolAttribute(PyCell_isTerminal         , isTerminal         ,PyCell,Cell)
   DirectGetBoolAttribute(PyCell_isTerminalNetlist  , isTerminalNetlist  ,PyCell,Cell)
@@ -881,6 +966,12 @@ extern "C" {
     , { "getClone"            , (PyCFunction)PyCell_getClone            , METH_NOARGS , "Return a copy of the Cell (placement only)." }
     , { "flattenNets"         , (PyCFunction)PyCell_flattenNets         , METH_VARARGS, "Perform a virtual flatten, possibly limited to one instance." }
     , { "destroyPhysical"     , (PyCFunction)PyCell_destroyPhysical     , METH_NOARGS , "Destroy all physical components, including DeepNets (vflatten)." }
+    , { "packQuadTrees"       , (PyCFunction)PyCell_packQuadTrees       , METH_NOARGS , "Freeze the QuadTrees into packed R-Trees for faster area queries." }
+    , { "unpackQuadTrees"     , (PyCFunction)PyCell_unpackQuadTrees     , METH_NOARGS , "Release the packed R-Trees, revert to the plain QuadTrees." }
+    , { "saveSnapshot"        , (PyCFunction)PyCell_saveSnapshot        , METH_VARARGS, "Save the cell & it's non-terminal hierarchy in a binary snapshot." }
+    , { "loadSnapshot"        , (PyCFunction)PyCell_loadSnapshot        , METH_VARARGS|METH_STATIC
+                              , "Load a binary snapshot, returns the top cell." }
+    , { "materializeSnapshot" , (PyCFunction)PyCell_materializeSnapshot , METH_NOARGS , "Create the components of a lazily loaded snapshot cell." }
     , { "destroy"             , (PyCFunction)PyCell_destroy             , METH_NOARGS , "Destroy associated hurricane object The python object remains." }
     , {NULL, NULL, 0, NULL}   /* sentinel */
     };
@@ -915,6 +1006,8 @@ extern "C" {
     LoadObjectConstant(PyTypeCell.tp_dict,Cell::Flags::BuildClockRings    ,"Flags_BuildClockRings");
     LoadObjectConstant(PyTypeCell.tp_dict,Cell::Flags::BuildSupplyRings   ,"Flags_BuildSupplyRings");
     LoadObjectConstant(PyTypeCell.tp_dict,Cell::Flags::NoClockFlatten     ,"Flags_NoClockFlatten");
+    LoadObjectConstant(PyTypeCell.tp_dict,Cell::Flags::ParallelFlatten    ,"Flags_ParallelFlatten");
+    LoadObjectConstant(PyTypeCell.tp_dict,Snapshot::LazyComponents        ,"Snapshot_LazyComponents");
     LoadObjectConstant(PyTypeCell.tp_dict,Cell::Flags::TerminalNetlist    ,"Flags_TerminalNetlist");
     LoadObjectConstant(PyTypeCell.tp_dict,Cell::Flags::Pad                ,"Flags_Pad");
     LoadObjectConstant(PyTypeCell.tp_dict,Cell::Flags::Feed               ,"Flags_Feed");
@@ -42,6 +42,10 @@ namespace Katana {
     , _postEventCb         ()
     , _bloat               (Cfg::getParamString("etesian.bloat"               ,"disabled")->asString() )
     , _searchHalo          (Cfg::getParamInt   ("katana.searchHalo"           ,      1)->asInt())
+    , _globalThreads       (std::max(1,Cfg::getParamInt("katana.globalThreads",1)->asInt()))
+    , _globalLandmarks     (Cfg::getParamInt   ("katana.globalLandmarks"      ,      4)->asInt())
+    , _negociateRegions    (std::max(1,Cfg::getParamInt("katana.negociateRegions",1)->asInt()))
+    , _negociateHalo       (Cfg::getParamInt   ("katana.negociateHalo"        ,      2)->asInt())
     , _longWireUpThreshold1(Cfg::getParamInt   ("katana.longWireUpThreshold1" ,     60)->asInt())
     , _longWireUpReserve1  (Cfg::getParamDouble("katana.longWireUpReserve1"   ,    1.0)->asDouble())
     , _hTracksReservedLocal(Cfg::getParamInt   ("katana.hTracksReservedLocal" ,      3)->asInt())
@@ -69,6 +73,7 @@ namespace Katana {
 
     if (Cfg::getParamBool("katana.useGlobalEstimate"    ,false)->asBool()) _flags |= UseGlobalEstimate;
     if (Cfg::getParamBool("katana.useStaticBloatProfile",true )->asBool()) _flags |= UseStaticBloatProfile;
+    if (Cfg::getParamBool("katana.useGlobalAStar"       ,false)->asBool()) _flags |= UseGlobalAStar;
 
     // for ( size_t i=0 ; i<MaxMetalDepth ; ++i ) {
     //   ostringstream paramName;
@@ -96,6 +101,10 @@ namespace Katana {
     , _postEventCb         (other._postEventCb)
     , _bloat               (other._bloat)
     , _searchHalo          (other._searchHalo)
+    , _globalThreads       (other._globalThreads)
+    , _globalLandmarks     (other._globalLandmarks)
+    , _negociateRegions    (other._negociateRegions)
+    , _negociateHalo       (other._negociateHalo)
     , _longWireUpThreshold1(other._longWireUpThreshold1)
     , _longWireUpReserve1  (other._longWireUpReserve1)
     , _hTracksReservedLocal(other._hTracksReservedLocal)
@@ -189,6 +198,11 @@ namespace Katana {
     cout << Dots::asString("     - Net builder style"                  ,getNetBuilderStyle()) << endl;
     cout << Dots::asString("     - Routing style"                      ,getRoutingStyle().asString()) << endl;
     cout << Dots::asUInt  ("     - Dijkstra GR search halo"            ,getSearchHalo()) << endl;
+    cout << Dots::asUInt  ("     - Dijkstra GR threads"                ,getGlobalThreads()) << endl;
+    cout << Dots::asBool  ("     - Dijkstra GR uses A*"                ,useGlobalAStar()) << endl;
+    cout << Dots::asUInt  ("     - Dijkstra GR A* landmarks"           ,getGlobalLandmarks()) << endl;
+    cout << Dots::asUInt  ("     - Negociation regions (per side)"     ,getNegociateRegions()) << endl;
+    cout << Dots::asUInt  ("     - Negociation regions halo (GCells)"  ,getNegociateHalo()) << endl;
     cout << Dots::asBool  ("     - Use GR density estimate"            ,useGlobalEstimate()) << endl;
     cout << Dots::asBool  ("     - Use static bloat profile"           ,useStaticBloatProfile()) << endl;
     cout << Dots::asInt   ("     - GCell terminal(RP) saturate number" ,getSaturateRp()) << endl;
@@ -233,6 +247,10 @@ namespace Katana {
     if ( record ) {
       record->add ( getSlot("_bloat"                ,_bloat                ) );
       record->add ( getSlot("_searchHalo"           ,_searchHalo           ) );
+      record->add ( getSlot("_globalThreads"        ,_globalThreads        ) );
+      record->add ( getSlot("_globalLandmarks"      ,_globalLandmarks      ) );
+      record->add ( getSlot("_negociateRegions"     ,_negociateRegions     ) );
+      record->add ( getSlot("_negociateHalo"        ,_negociateHalo        ) );
       record->add ( getSlot("_longWireUpThreshold1" ,_longWireUpThreshold1 ) );
       record->add ( getSlot("_longWireUpReserved1"  ,_longWireUpReserve1   ) );
       record->add ( getSlot("_hTracksReservedLocal" ,_hTracksReservedLocal ) );
@@ -0,0 +1,189 @@
+// -*- C++ -*-
+//
+// This file is part of the Coriolis Software.
+// Copyright (c) Sorbonne Université 2026-2026, All Rights Reserved
+//
+// +-----------------------------------------------------------------+
+// |                   C O R I O L I S                               |
+// |      K i t e  -  D e t a i l e d   R o u t e r                  |
+// |                                                                 |
+// |  Author      :                    Jean-Paul CHAPUT              |
+// |  E-mail      :            Jean-Paul.Chaput@lip6.fr              |
+// | =============================================================== |
+// |  C++ Module  :       "./EventProfile.cpp"                       |
+// +-----------------------------------------------------------------+
+
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "katana/EventProfile.h"
+
+
+namespace {
+
+  using namespace std;
+
+
+  inline uint64_t  nowNs ()
+  {
+    return chrono::duration_cast<chrono::nanoseconds>
+      ( chrono::steady_clock::now().time_since_epoch() ).count();
+  }
+
+
+}  // Anonymous namespace.
+
+
+namespace Katana {
+
+  using std::string;
+  using std::vector;
+  using std::pair;
+  using std::ostream;
+  using std::endl;
+
+
+// -------------------------------------------------------------------
+// Class  :  "EventProfile".
+
+
+  bool                                  EventProfile::_enabled = false;
+  uint32_t                              EventProfile::_level   = 0;
+  uint32_t                              EventProfile::_depth   = 0;
+  size_t                                EventProfile::_top     = 0;
+  EventProfile::Frame                   EventProfile::_stack [MaxStack];
+  EventProfile::Entry                   EventProfile::_table [MaxLevel][MaxDepth][PhaseCount];
+  std::unordered_map<uint64_t,uint64_t>  EventProfile::_stacks;
+
+
+  const char* EventProfile::getPhaseName ( Phase phase )
+  {
+    switch ( phase ) {
+      case Process:    return "process";
+      case FsmBuild:   return "fsm";
+      case TrackCost:  return "trackCost";
+      case Ripup:      return "ripup";
+      case Relax:      return "relax";
+      case Slacken:    return "slacken";
+      case Actions:    return "actions";
+      case Revalidate: return "revalidate";
+      default: break;
+    }
+    return "unknown";
+  }
+
+
+  void  EventProfile::enable ( bool state )
+  {
+    if (state and not _enabled) _top = 0;
+    _enabled = state;
+  }
+
+
+  void  EventProfile::clear ()
+  {
+    memset( _table, 0, sizeof(_table) );
+    _stacks.clear();
+    _level = 0;
+    _depth = 0;
+    _top   = 0;
+  }
+
+
+  bool  EventProfile::isEmpty ()
+  {
+    for ( uint32_t level=0 ; level<MaxLevel ; ++level ) {
+      for ( uint32_t depth=0 ; depth<MaxDepth ; ++depth ) {
+        if (_table[level][depth][Process]._calls) return false;
+      }
+    }
+    return true;
+  }
+
+
+// The stack key encodes the phases from the bottom of the stack, one
+// digit (in base PhaseCount+1) per frame, zero meaning no frame.
+  void  EventProfile::push ( Phase phase )
+  {
+    if (_top < MaxStack) {
+      Frame& frame    = _stack[_top];
+      frame._phase    = phase;
+      frame._children = 0;
+      frame._stackKey = ((_top) ? _stack[_top-1]._stackKey * (PhaseCount+1) : 0) + phase + 1;
+      frame._start    = nowNs();
+    }
+    ++_top;
+  }
+
+
+  void  EventProfile::pop ()
+  {
+    if (not _top) return;
+    if (--_top >= MaxStack) return;
+
+    Frame&   frame   = _stack[_top];
+    uint64_t elapsed = nowNs() - frame._start;
+    uint64_t self    = (elapsed > frame._children) ? elapsed - frame._children : 0;
+    Entry&   entry   = _table[_level][_depth][frame._phase];
+
+    entry._calls += 1;
+    entry._total += elapsed;
+    entry._self  += self;
+    _stacks[ frame._stackKey ] += self;
+    if (_top) _stack[_top-1]._children += elapsed;
+  }
+
+
+  void  EventProfile::toCsv ( ostream& out )
+  {
+    Entry totals [PhaseCount];
+    memset( totals, 0, sizeof(totals) );
+
+    out << "level,depth,phase,calls,total_ns,self_ns" << endl;
+    for ( uint32_t level=0 ; level<MaxLevel ; ++level ) {
+      for ( uint32_t depth=0 ; depth<MaxDepth ; ++depth ) {
+        for ( size_t phase=0 ; phase<PhaseCount ; ++phase ) {
+          const Entry& entry = _table[level][depth][phase];
+          if (not entry._calls) continue;
+
+          out << level << "," << depth << "," << getPhaseName((Phase)phase)
+              << "," << entry._calls << "," << entry._total << "," << entry._self << endl;
+          totals[phase]._calls += entry._calls;
+          totals[phase]._total += entry._total;
+          totals[phase]._self  += entry._self;
+        }
+      }
+    }
+
+    for ( size_t phase=0 ; phase<PhaseCount ; ++phase ) {
+      if (not totals[phase]._calls) continue;
+      out << "all,all," << getPhaseName((Phase)phase)
+          << "," << totals[phase]._calls << "," << totals[phase]._total << "," << totals[phase]._self << endl;
+    }
+  }
+
+
+  void  EventProfile::toCollapsed ( ostream& out )
+  {
+    vector< pair<string,uint64_t> >  lines;
+    for ( auto item : _stacks ) {
+      string   path;
+      uint64_t key = item.first;
+      while ( key ) {
+        string name = getPhaseName( (Phase)(key % (PhaseCount+1) - 1) );
+        path = (path.empty()) ? name : name + ";" + path;
+        key /= PhaseCount+1;
+      }
+      lines.push_back( make_pair(path,item.second) );
+    }
+    sort( lines.begin(), lines.end() );
+
+    for ( auto& line : lines )
+      out << line.first << " " << line.second << endl;
+  }
+
+
+}  // Katana namespace.
@@ -14,6 +14,9 @@
 // +-----------------------------------------------------------------+
 
 
+#include <atomic>
+#include <mutex>
+#include <thread>
 #include "flute.h"
 #include "hurricane/utilities/Dots.h"
 #include "hurricane/Warning.h"
@@ -50,9 +53,16 @@ namespace {
   using Anabatic::Flags;
   using Anabatic::Edge;
   using Anabatic::GCell;
+  using Anabatic::GridView;
   using Anabatic::Vertex;
   using Anabatic::EdgeCapacity;
   using Anabatic::AnabaticEngine;
+  using Anabatic::Dijkstra;
+  using Anabatic::NetData;
+  using Anabatic::PriorityQueue;
+  using Hurricane::Box;
+  using Hurricane::Error;
+  using Hurricane::NetRoutingState;
   using Etesian::BloatExtension;
   using namespace Katana;
 
@@ -62,6 +72,8 @@ namespace {
       inline            DigitalDistance ( float h, float k, float gcellAspectRatio, float hScaling );
       inline void       setNet          ( Net* );
              DbU::Unit  operator()      ( const Vertex* source ,const Vertex* target,const Edge* edge ) const;
+      inline float      getScale        () const;
+             DbU::Unit  getLowerBound   ( const Edge* ) const;
     private:
     // For an explanation of h & k parameters, see:
     //     "KNIK, routeur global pour la plateforme Coriolis", p. 52.
@@ -86,6 +98,33 @@ namespace {
   inline void  DigitalDistance::setNet ( Net* net ) { _net = net; }
 
 
+// Lower bounds of the distance, for the A* search. The congestion cost
+// is at least 1.0, the historic & via costs are positives and the
+// channel factor is at least 1.0 so an Edge costs at least it's length
+// times the H/V scaling. A 2% margin absorbs the rounding of the float
+// computations in operator(). Only valid when there is no standard cell
+// row GCells (not channel style), which can be entered at zero cost.
+//
+// The Edge lower bound builds the landmarks tables, an Edge must only
+// be unreachable if operator() *always* rejects it. A blocked Edge
+// next to a standard cell row may be crossed for free, so it's bound
+// is zero.
+  inline float  DigitalDistance::getScale () const
+  { return 0.98 * std::min( 1.0f, _hScaling ); }
+
+
+  DbU::Unit  DigitalDistance::getLowerBound ( const Edge* edge ) const
+  {
+    bool sourceRow = edge->getSource()->isStdCellRow();
+    bool targetRow = edge->getTarget()->isStdCellRow();
+    if (sourceRow and targetRow) return Vertex::unreachable;
+    if (edge->getCapacity() <= 0)
+      return (sourceRow or targetRow) ? 0 : Vertex::unreachable;
+    float hvScaling = (edge->isHorizontal()) ? _hScaling : 1.0;
+    return (DbU::Unit)( 0.98 * (float)edge->getDistance() * hvScaling );
+  }
+
+
   DbU::Unit  DigitalDistance::operator() ( const Vertex* source, const Vertex* target, const Edge* edge ) const
   {
     if (source->getGCell()->isStdCellRow() and target->getGCell()->isStdCellRow())
@@ -99,7 +138,14 @@ namespace {
       return Vertex::unreachable;
     cdebug_log(112,0) << "Not a go straight" << endl;
 
-    if (edge->getCapacity() <= 0) {
+  // Capacity & occupancy are read from the GridView arrays, the Edge keeps
+  // them up to date (see Anabatic::Edge::_updateView()).
+    const GridView* grid      = source->getGridView();
+    uint32_t        iedge     = edge->getViewIndex();
+    int             capacity  = grid->getEdgeCapacity ( iedge );
+    uint32_t        occupancy = grid->getEdgeOccupancy( iedge );
+
+    if (capacity <= 0) {
       if (target->getGCell()->isStdCellRow()
          and target->hasValidStamp() and (target->getConnexId() >= 0) )
         return 0;
@@ -108,14 +154,14 @@ namespace {
          and source->hasValidStamp() and (source->getConnexId() >= 0) )
         return 0;
       
-      cdebug_log(112,0) << "Negative or null edge capacity: " << edge->getCapacity() << endl;
+      cdebug_log(112,0) << "Negative or null edge capacity: " << capacity << endl;
       return Vertex::unreachable;
     }
 
     cdebug_log(112,0) << "Computing distance" << endl;
     float congestionCost = 1.0;
-    float congestion     = ((float)edge->getRealOccupancy() + edge->getEstimateOccupancy())
-                         /  (float)edge->getCapacity();
+    float congestion     = ((float)occupancy + edge->getEstimateOccupancy())
+                         /  (float)capacity;
 
     if (not source->getGCell()->isChannelRow() or not target->getGCell()->isChannelRow())
       congestionCost += _h / (1.0 + std::exp(_k * (congestion - 1.0)));
@@ -127,7 +173,7 @@ namespace {
       viaCost += 2.5;
     }
     
-    float realCongestion = (float)edge->getRealOccupancy() /  (float)edge->getCapacity();
+    float realCongestion = (float)occupancy /  (float)capacity;
     float historicCost   = edge->getHistoricCost();
     if (realCongestion <= 1.0)
       historicCost += edge->getEstimateOccupancy() * realCongestion;
@@ -172,6 +218,267 @@ namespace {
   }
 
 
+// -------------------------------------------------------------------
+// Class  :  "GlobalBatch".
+//
+// Parallel routing of the first global routing pass. The nets are
+// gathered in batches whose footprints (search area inflated by the
+// largest GCell sides) are pairwise disjoints. A net is skipped if it
+// overlaps a net of the batch *or* a net skipped before it, so two
+// overlapping nets are always routed in the net ordering. As a search
+// only sees the Vertexes & Edges of it's footprint, the result is the
+// same as the sequential one, whatever the number of threads.
+//
+// A batch is routed in three steps:
+//   1. Sequential loading of the nets, in per-net worker Dijkstras.
+//      The GContacts are created at this point.
+//   2. Parallel search, the workers threads pull nets from a shared
+//      counter. Nothing but the Vertexes of the area is modified.
+//   3. Sequential materialization, in the net ordering, this is where
+//      the Edges occupancies are updated.
+//
+// Footprints conflicts are checked over a coarse grid of claims, one
+// cell per largest GCell. Symmetric nets (analog) have the whole area
+// as footprint, they are routed alone.
+
+  class GlobalBatch {
+    public:
+      enum Claim { Free=0, Taken=1, Skipped=2 };
+    public:
+                       GlobalBatch   ( KatanaEngine*, Dijkstra* master, DigitalDistance*, uint32_t threads );
+                      ~GlobalBatch   ();
+      inline size_t    getBatchCount () const;
+             size_t    route         ( const vector<NetData*>& );
+    private:
+             Box       _getFootprint ( NetData* ) const;
+             bool      _claim        ( const Box& );
+             void      _select       ( vector<NetData*>& pendings );
+             size_t    _flush        ();
+             void      _removeEstimate ( NetData* );
+             void      _runWorker    ();
+    private:
+      KatanaEngine*              _katana;
+      Dijkstra*                  _master;
+      DigitalDistance*           _distance;
+      uint32_t                   _threads;
+      size_t                     _capacity;
+      size_t                     _batchCount;
+      Box                        _area;
+      DbU::Unit                  _side;
+      DbU::Unit                  _margin;
+      size_t                     _columns;
+      size_t                     _rows;
+      vector<uint8_t>            _claims;
+      vector<NetData*>           _batch;
+      vector<Dijkstra*>          _workers;
+      vector<DigitalDistance*>   _distances;
+      vector<char>               _searcheds;
+      std::atomic<size_t>        _next;
+      std::mutex                 _errorLock;
+      std::string                _error;
+  };
+
+
+  GlobalBatch::GlobalBatch ( KatanaEngine* katana, Dijkstra* master, DigitalDistance* distance, uint32_t threads )
+    : _katana    (katana)
+    , _master    (master)
+    , _distance  (distance)
+    , _threads   (threads)
+    , _capacity  (16*threads)
+    , _batchCount(0)
+    , _area      (katana->getCell()->getAbutmentBox())
+    , _side      (1)
+    , _margin    (0)
+    , _columns   (1)
+    , _rows      (1)
+    , _claims    ()
+    , _batch     ()
+    , _workers   ()
+    , _distances ()
+    , _searcheds ()
+    , _next      (0)
+    , _errorLock ()
+    , _error     ()
+  {
+    for ( GCell* gcell : katana->getGCells() ) {
+      _area.merge( gcell->getBoundingBox() );
+      _side = std::max( _side, gcell->getWidth () );
+      _side = std::max( _side, gcell->getHeight() );
+    }
+    _margin  = master->getSearchAreaHalo() + 2*_side;
+    _columns = _area.getWidth () / _side + 1;
+    _rows    = _area.getHeight() / _side + 1;
+    _claims.resize( _columns*_rows, Free );
+  }
+
+
+  GlobalBatch::~GlobalBatch ()
+  {
+    for ( Dijkstra* worker : _workers ) delete worker;
+  }
+
+
+  inline size_t  GlobalBatch::getBatchCount () const { return _batchCount; }
+
+
+  Box  GlobalBatch::_getFootprint ( NetData* netData ) const
+  {
+    NetRoutingState* state = netData->getNetRoutingState();
+    if (state and state->isSymmetric()) return _area;
+    return Box( netData->getSearchArea() ).inflate( _margin );
+  }
+
+
+// Returns true if the footprint is free, and then take it. Otherwise
+// the free part of the footprint is marked as skipped.
+  bool  GlobalBatch::_claim ( const Box& footprint )
+  {
+    Box clipped = footprint.getIntersection( _area );
+    if (clipped.isEmpty()) clipped = Box( _area.getCenter() );
+
+    size_t colMin = (clipped.getXMin() - _area.getXMin()) / _side;
+    size_t colMax = (clipped.getXMax() - _area.getXMin()) / _side;
+    size_t rowMin = (clipped.getYMin() - _area.getYMin()) / _side;
+    size_t rowMax = (clipped.getYMax() - _area.getYMin()) / _side;
+
+    bool free = true;
+    for ( size_t row=rowMin ; free and (row<=rowMax) ; ++row ) {
+      for ( size_t col=colMin ; col<=colMax ; ++col ) {
+        if (_claims[ row*_columns + col ] != Free) { free = false; break; }
+      }
+    }
+
+    uint8_t claim = (free) ? Taken : Skipped;
+    for ( size_t row=rowMin ; row<=rowMax ; ++row ) {
+      for ( size_t col=colMin ; col<=colMax ; ++col ) {
+        uint8_t& cell = _claims[ row*_columns + col ];
+        if (cell == Free) cell = claim;
+      }
+    }
+    return free;
+  }
+
+
+  void  GlobalBatch::_select ( vector<NetData*>& pendings )
+  {
+    std::fill( _claims.begin(), _claims.end(), Free );
+
+    vector<NetData*>  remainings;
+    size_t            window     = std::min( pendings.size(), 4*_capacity );
+    size_t            ipending   = 0;
+    for ( ; ipending<window ; ++ipending ) {
+      if (_batch.size() >= _capacity) break;
+
+      NetData*         netData = pendings[ipending];
+      NetRoutingState* state   = netData->getNetRoutingState();
+      if (state and state->isSymmetric() and not _batch.empty()) break;
+
+      if (_claim(_getFootprint(netData))) {
+        _batch.push_back( netData );
+        if (state and state->isSymmetric()) { ++ipending; break; }
+      } else
+        remainings.push_back( netData );
+    }
+    remainings.insert( remainings.end(), pendings.begin()+ipending, pendings.end() );
+    pendings.swap( remainings );
+  }
+
+
+  void  GlobalBatch::_removeEstimate ( NetData* netData )
+  {
+    if (netData->isGlobalEstimated()) {
+      _katana->updateEstimateDensity( netData, -1.0 );
+      netData->setGlobalEstimated( false );
+    }
+  }
+
+
+  void  GlobalBatch::_runWorker ()
+  {
+    try {
+      while ( true ) {
+        size_t inet = _next++;
+        if (inet >= _batch.size()) break;
+        _searcheds[inet] = _workers[inet]->search();
+      }
+    }
+    catch ( std::exception& e ) {
+      std::lock_guard<std::mutex> guard ( _errorLock );
+      if (_error.empty()) _error = e.what();
+      _next = _batch.size();
+    }
+  }
+
+
+  size_t  GlobalBatch::_flush ()
+  {
+    size_t count = _batch.size();
+    if (not count) return 0;
+    ++_batchCount;
+
+    if (count == 1) {
+      NetData* netData = _batch[0];
+      _removeEstimate( netData );
+      _distance->setNet( netData->getNet() );
+      _master->load( netData->getNet() );
+      _master->run();
+      netData->setGlobalRouted( true );
+      _batch.clear();
+      return 1;
+    }
+
+    while ( _workers.size() < count ) {
+      Dijkstra* worker = new Dijkstra ( _master );
+      _distances.push_back( worker->setDistance( *_distance ) );
+      _workers  .push_back( worker );
+    }
+
+    _katana->openStampBatch();
+    for ( size_t inet=0 ; inet<count ; ++inet ) {
+      _removeEstimate( _batch[inet] );
+      _distances[inet]->setNet( _batch[inet]->getNet() );
+      _workers  [inet]->load  ( _batch[inet]->getNet() );
+    }
+
+    _searcheds.assign( count, false );
+    _next = 0;
+    _error.clear();
+    uint32_t threads = std::min( (size_t)_threads, count );
+    if (threads == 1)
+      _runWorker();
+    else {
+      vector<std::thread>  threadPool;
+      for ( uint32_t i=0 ; i<threads ; ++i )
+        threadPool.push_back( std::thread( &GlobalBatch::_runWorker, this ) );
+      for ( std::thread& thread : threadPool ) thread.join();
+    }
+    if (not _error.empty()) {
+      _katana->closeStampBatch();
+      throw Error( "KatanaEngine::runGlobalRouter(): A global routing worker failed.\n%s", _error.c_str() );
+    }
+
+    for ( size_t inet=0 ; inet<count ; ++inet ) {
+      if (_searcheds[inet]) _workers[inet]->materialize();
+      _batch[inet]->setGlobalRouted( true );
+    }
+    _katana->closeStampBatch();
+    _batch.clear();
+    return count;
+  }
+
+
+  size_t  GlobalBatch::route ( const vector<NetData*>& nets )
+  {
+    size_t            routeds = 0;
+    vector<NetData*>  pendings ( nets );
+    while ( not pendings.empty() ) {
+      _select( pendings );
+      routeds += _flush();
+    }
+    return routeds;
+  }
+
+
   void  computeNextHCost ( Edge* edge, float edgeHInc )
   {
     float congestion = (float)edge->getRealOccupancy() / (float)edge->getCapacity();
@@ -191,6 +498,18 @@ namespace {
     bool     straightLine = not (hoverlap.isEmpty() and voverlap.isEmpty());
     double   cost         = ((straightLine) ? 1.0 : 0.5) * weight;
 
+    const GridView* grid = anabatic->getGridView();
+    if (grid and grid->isValid()) {
+      uint32_t isource = grid->getIndex( source );
+      uint32_t itarget = grid->getIndex( target );
+      auto     update  = [cost]( Edge* edge ) { edge->incEstimateOccupancy( cost ); };
+
+      grid->visitEdgesUnderPath( isource, itarget, Flags::NorthPath, update );
+      if (not straightLine)
+        grid->visitEdgesUnderPath( isource, itarget, Flags::NoFlags, update );
+      return;
+    }
+
     for ( Edge* edge : anabatic->getEdgesUnderPath(source,target,Flags::NorthPath) ) {
       edge->incEstimateOccupancy( cost );
     }
@@ -401,7 +720,10 @@ namespace Katana {
   {
     Cell* cell = getCell();
 
-    cell->flattenNets( Cell::Flags::BuildRings|Cell::Flags::WarnOnUnplacedInstances );
+    cell->flattenNets( NULL
+                     , std::set<std::string>()
+                     , Cell::Flags::BuildRings|Cell::Flags::WarnOnUnplacedInstances|Cell::Flags::ParallelFlatten
+                     , getGlobalThreads() );
 
     if (!(flags & Flags::PlacementCallback)) {
       cell->createRoutingPadRings( Cell::Flags::BuildRings );
@@ -558,6 +880,10 @@ namespace Katana {
       dijkstra->setSearchAreaHalo( Session::getSliceHeight()*10 );
     else
       dijkstra->setSearchAreaHalo( Session::getSliceHeight()*getSearchHalo() );
+    if (useGlobalAStar() and not isChannelStyle())
+      dijkstra->setAStar( distance->getScale()
+                        , getGlobalLandmarks()
+                        , [distance]( const Edge* edge ) { return distance->getLowerBound(edge); } );
 
     bool     globalEstimated = false;
     size_t   iteration       = 0;
@@ -570,37 +896,65 @@ namespace Katana {
       long   viaCount   = 0;
 
       netCount = 0;
-      for ( NetData* netData : getNetOrdering() ) {
-        if (netData->isGlobalRouted() or netData->isExcluded()) continue;
-        if (netData->isGlobalEstimated()) {
-          updateEstimateDensity( netData, -1.0 );
-          netData->setGlobalEstimated( false );
+      if ((iteration == 0) and (getGlobalThreads() > 1)) {
+      // The nets are split at the one triggering the global estimate,
+      // so the estimates are set exactly at the same point than in the
+      // sequential loop below.
+        vector<NetData*>  prefix;
+        vector<NetData*>  suffix;
+        bool              trigger = false;
+        for ( NetData* netData : getNetOrdering() ) {
+          if (netData->isGlobalRouted() or netData->isExcluded()) continue;
+          if (trigger) { suffix.push_back( netData ); continue; }
+          prefix.push_back( netData );
+          if (useGlobalEstimate() and (netData->getRpCount() < 11) and not globalEstimated)
+            trigger = true;
+        }
+
+        GlobalBatch batch ( this, dijkstra, distance, getGlobalThreads() );
+        netCount += batch.route( prefix );
+        if (trigger) {
+          for ( NetData* netData2 : suffix ) {
+            updateEstimateDensity( netData2, 1.0 );
+            netData2->setGlobalEstimated( true );
+          }
+          globalEstimated = true;
         }
+        netCount += batch.route( suffix );
+        cdebug_log(159,0) << "Parallel global routing, " << batch.getBatchCount() << " batches." << endl;
+      } else {
+        for ( NetData* netData : getNetOrdering() ) {
+          if (netData->isGlobalRouted() or netData->isExcluded()) continue;
+          if (netData->isGlobalEstimated()) {
+            updateEstimateDensity( netData, -1.0 );
+            netData->setGlobalEstimated( false );
+          }
+
+          distance->setNet( netData->getNet() );
+          dijkstra->load( netData->getNet() );
+          dijkstra->run();
+          netData->setGlobalRouted( true );
+          ++netCount;
+
+          // if (netData->getNet()->getName() == Name("mips_r3000_1m_dp_shift32_rshift_se_msb")) {
+          //   Session::close();
+          //   Breakpoint::stop( 1, "After global routing of \"mips_r3000_1m_dp_shift32_rshift_se_msb\"." );
+          //   openSession();
+          // }
 
-        distance->setNet( netData->getNet() );
-        dijkstra->load( netData->getNet() );
-        dijkstra->run();
-        netData->setGlobalRouted( true );
-        ++netCount;
-
-        // if (netData->getNet()->getName() == Name("mips_r3000_1m_dp_shift32_rshift_se_msb")) {
-        //   Session::close();
-        //   Breakpoint::stop( 1, "After global routing of \"mips_r3000_1m_dp_shift32_rshift_se_msb\"." );
-        //   openSession();
-        // }
-
-        if (useGlobalEstimate()) {
-        // Triggers the global routing when we reach nets of less than 11 terminals.
-        // High degree nets are routed straight (without taking account the smalls).
-        // See the SparsityOrder comparison function.
-          if ( (netData->getRpCount() < 11) and not globalEstimated ) {
-            for ( NetData* netData2 : getNetOrdering() ) {
-              if (netData2->isGlobalRouted() or netData2->isExcluded()) continue;
-
-              updateEstimateDensity( netData2, 1.0 );
-              netData2->setGlobalEstimated( true );
+          if (useGlobalEstimate()) {
+          // Triggers the global routing when we reach nets of less than 11 terminals.
+          // High degree nets are routed straight (without taking account the smalls).
+          // See the SparsityOrder comparison function.
+            if ( (netData->getRpCount() < 11) and not globalEstimated ) {
+              for ( NetData* netData2 : getNetOrdering() ) {
+                if (netData2->isGlobalRouted() or netData2->isExcluded()) continue;
+
+                updateEstimateDensity( netData2, 1.0 );
+                netData2->setGlobalEstimated( true );
+              }
+              globalEstimated = true;
             }
-            globalEstimated = true;
           }
         }
       }
@@ -659,6 +1013,26 @@ namespace Katana {
     stopMeasures();
     printMeasures( "Dijkstra" );
 
+    uint64_t  expandeds    = 0;
+    size_t    routedNets   = 0;
+    NetData*  maxExpandeds = NULL;
+    for ( NetData* netData : getNetOrdering() ) {
+      if (not netData->getExpandeds()) continue;
+      cdebug_log(159,0) << "Expanded vertexes: " << setw(9) << netData->getExpandeds()
+                        << " " << netData->getNet() << endl;
+      expandeds += netData->getExpandeds();
+      ++routedNets;
+      if (not maxExpandeds or (netData->getExpandeds() > maxExpandeds->getExpandeds()))
+        maxExpandeds = netData;
+    }
+    if (routedNets) {
+      cmess2 << ::Dots::asULong ("     - Expanded vertexes"         ,expandeds) << endl;
+      cmess2 << ::Dots::asULong ("     - Expanded vertexes per net" ,expandeds/routedNets) << endl;
+      cmess2 << ::Dots::asString("     - Most expanded net"
+                                ,getString(maxExpandeds->getNet()->getName())
+                                 + " (" + getString(maxExpandeds->getExpandeds()) + ")") << endl;
+    }
+
     uint32_t hoverflow = 0;
     uint32_t voverflow = 0;
     if (not ovEdges.empty()) {
@@ -46,6 +46,7 @@
 #include "katana/Session.h"
 #include "katana/TrackSegment.h"
 #include "katana/NegociateWindow.h"
+#include "katana/EventProfile.h"
 #include "katana/KatanaEngine.h"
 #include "katana/PyKatanaEngine.h"
 
@@ -870,6 +871,12 @@ namespace Katana {
                      , getString(getCell()->getName()).c_str()
                      ) << endl;
     }
+
+    if (not EventProfile::isEmpty()) {
+      out << "#" << endl;
+      out << "# RoutingEvent::process() profile (katana.profileEventCosts)." << endl;
+      EventProfile::toCsv( out );
+    }
   }
 
 
@@ -883,6 +890,15 @@ namespace Katana {
     ofstream sfile ( path.str().c_str() );
     dumpMeasures( sfile );
     sfile.close();
+
+    if (not EventProfile::isEmpty()) {
+      ostringstream flamePath;
+      flamePath << getCell()->getName() << ".katana.flame";
+
+      ofstream ffile ( flamePath.str().c_str() );
+      EventProfile::toCollapsed( ffile );
+      ffile.close();
+    }
   }
 
 
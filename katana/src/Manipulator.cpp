@@ -24,6 +24,7 @@
 #include "katana/RoutingEvent.h"
 #include "katana/SegmentFsm.h"
 #include "katana/Manipulator.h"
+#include "katana/EventProfile.h"
 #include "katana/KatanaEngine.h"
 
 
@@ -147,6 +148,8 @@ namespace Katana {
 
   bool  Manipulator::ripup ( uint32_t type, DbU::Unit axisHint )
   {
+    EventProfile::Scope  profileScope ( EventProfile::Ripup );
+
     cdebug_log(159,1) << "Manipulator::ripup()" << endl;
 
     if (not canRipup())      { cdebug_tabw(159,-1); return false; }
@@ -169,6 +172,8 @@ namespace Katana {
 
   bool  Manipulator::ripupPerpandiculars ( uint32_t flags )
   {
+    EventProfile::Scope  profileScope ( EventProfile::Ripup );
+
     cdebug_log(159,1) << "Manipulator::ripupPerpandiculars() - " << flags << endl;
 
     bool      success                  = true;
@@ -303,6 +308,8 @@ namespace Katana {
 
   bool  Manipulator::relax ( Interval interval, uint32_t flags )
   {
+    EventProfile::Scope  profileScope ( EventProfile::Relax );
+
     Session::toAxisInterval( interval, Session::getLayerDepth(_segment->getLayer())+1 );
     cdebug_log(159,0) << "Manipulator::relax() of: " << _segment << " " << interval << endl; 
 
@@ -30,6 +30,7 @@
 #include "crlcore/AllianceFramework.h"
 #include "crlcore/Measures.h"
 #include "crlcore/Histogram.h"
+#include "crlcore/Progress.h"
 #include "anabatic/AutoContactTerminal.h"
 #include "katana/DataNegociate.h"
 #include "katana/TrackElement.h"
@@ -42,6 +43,7 @@
 #include "katana/RoutingEventHistory.h"
 #include "katana/RoutingEventLoop.h"
 #include "katana/NegociateWindow.h"
+#include "katana/EventProfile.h"
 #include "katana/KatanaEngine.h"
 
 
@@ -274,6 +276,7 @@ namespace Katana {
   using Hurricane::DebugSession;
   using Hurricane::UpdateSession;
   using CRL::Histogram;
+  using CRL::Progress;
   using CRL::addMeasure;
   using Anabatic::AutoContact;
   using Anabatic::AutoContactTerminal;
@@ -614,17 +617,17 @@ namespace Katana {
     }
     packQueue.commit();
 
+    Progress progress ( "pack.event" );
+    size_t   events   = progress.addCounter( "events"  );
+    size_t   remains  = progress.addCounter( "remains" );
+
     while ( not packQueue.empty() and not isInterrupted() ) {
       RoutingEvent* event = packQueue.pop();
 
-      if (tty::enabled()) {
-        cmess2 << "        <pack.event:" << tty::bold << setw(8) << setfill('0')
-               << RoutingEvent::getProcesseds() << tty::reset
-               << " remains:" << right << setw(8) << setfill('0')
-               << packQueue.size() << ">"
-               << setfill(' ') << tty::reset << tty::cr;
-        cmess2.flush();
-      } else {
+      progress.set( events , RoutingEvent::getProcesseds() );
+      progress.set( remains, packQueue.size() );
+      progress.tick();
+      if (not tty::enabled()) {
         cmess2 << "        <pack.event:" << setw(8) << setfill('0')
                << RoutingEvent::getProcesseds() << setfill(' ') << " "
                << event->getEventLevel() << ":" << event->getPriority() << "> "
@@ -637,10 +640,64 @@ namespace Katana {
 
       if (RoutingEvent::getProcesseds() >= limit) setInterrupt( true );
     }
+    progress.finish();
   // Count will be wrong!
   }
 
 
+  void  NegociateWindow::_partition ( vector< vector<TrackElement*> >& batches ) const
+  {
+    cdebug_log(159,1) << "NegociateWindow::_partition()" << endl;
+
+    batches.clear();
+
+    uint32_t regions = _katana->getNegociateRegions();
+    if ((regions < 2) or _gcells.empty()) {
+      batches.push_back( _segments );
+      cdebug_tabw(159,-1);
+      return;
+    }
+
+    Box area;
+    for ( GCell* gcell : _gcells ) area.merge( gcell->getBoundingBox() );
+
+    DbU::Unit halo       = _katana->getNegociateHalo() * _katana->getConfiguration()->getSliceHeight();
+    DbU::Unit tileWidth  = area.getWidth () / regions + 1;
+    DbU::Unit tileHeight = area.getHeight() / regions + 1;
+
+  // The tile index is clamped so the halo may go outside the area.
+    auto tileOf = [&] ( DbU::Unit u, DbU::Unit origin, DbU::Unit size ) -> uint32_t
+                  {
+                    if (u <= origin) return 0;
+                    return std::min( regions-1, (uint32_t)((u - origin) / size) );
+                  };
+
+  // The last batch holds the boundary segments: those whose box, bloated
+  // by the halo, is not fully inside one tile.
+    batches.resize( regions*regions + 1 );
+    for ( TrackElement* segment : _segments ) {
+      Interval  span = segment->getCanonicalInterval();
+      DbU::Unit axis = segment->getAxis();
+      Box       bb   = (segment->isHorizontal()) ? Box( span.getVMin(), axis, span.getVMax(), axis )
+                                                 : Box( axis, span.getVMin(), axis, span.getVMax() );
+      bb.inflate( halo );
+
+      uint32_t xmin = tileOf( bb.getXMin(), area.getXMin(), tileWidth  );
+      uint32_t xmax = tileOf( bb.getXMax(), area.getXMin(), tileWidth  );
+      uint32_t ymin = tileOf( bb.getYMin(), area.getYMin(), tileHeight );
+      uint32_t ymax = tileOf( bb.getYMax(), area.getYMin(), tileHeight );
+
+      if ((xmin == xmax) and (ymin == ymax))
+        batches[ ymin*regions + xmin ].push_back( segment );
+      else
+        batches.back().push_back( segment );
+    }
+
+    cdebug_log(159,0) << "Boundary segments: " << batches.back().size() << endl;
+    cdebug_tabw(159,-1);
+  }
+
+
   size_t  NegociateWindow::_negociate ()
   {
     cdebug_log(9000,0) << "Deter| NegociateWindow::_negociate()" << endl;
@@ -652,91 +709,109 @@ namespace Katana {
     bool          profiling = _katana->profileEventCosts();
     ofstream      ofprofile;
 
-    if (profiling) ofprofile.open( "katana.profile.txt" );
+    if (profiling) {
+      ofprofile.open( "katana.profile.txt" );
+      EventProfile::clear();
+      EventProfile::enable( true );
+    }
 
     _eventHistory.clear();
-    _eventQueue.load( _segments );
-    cmess2 << "        <queue:" <<  right << setw(8) << setfill('0') << _eventQueue.size() << ">" << endl;
-    if (cdebug.enabled(9000)) _eventQueue.dump();
-    _statistics.setLoadedEventsCount( _eventQueue.size() );
 
-    size_t count = 0;
+    vector< vector<TrackElement*> >  batches;
+    _partition( batches );
+    if (batches.size() > 1)
+      cmess2 << "        <regions:" << (batches.size()-1)
+             << " boundary:" << batches.back().size() << ">" << endl;
+
+    Progress progress ( "event" );
+    size_t   events   = progress.addCounter( "events"  );
+    size_t   remains  = progress.addCounter( "remains" );
+
+    size_t count  = 0;
+    size_t loaded = 0;
     _katana->setStage( StageNegociate );
-    while ( not _eventQueue.empty() and not isInterrupted() ) {
-      RoutingEvent* event = _eventQueue.pop();
+    for ( size_t ibatch=0 ; (ibatch<batches.size()) and not isInterrupted() ; ++ibatch ) {
+      if (batches[ibatch].empty()) continue;
 
-      size_t depth = _katana->getConfiguration()->getLayerDepth( event->getSegment()->getLayer() );
-      _statistics.incEventsCount( 1, depth );
+      _eventQueue.load( batches[ibatch] );
+      cmess2 << "        <queue:" <<  right << setw(8) << setfill('0') << _eventQueue.size() << ">" << endl;
+      if (cdebug.enabled(9000)) _eventQueue.dump();
+      loaded += _eventQueue.size();
 
-      if (ofprofile.is_open()) {
-        if (depth < 6) {
-          ofprofile << setw(10) << right << count << " ";
-          for ( size_t i=0 ; i<6 ; ++i ) {
-            if (i == depth)
-              ofprofile << setw(10) << right << setprecision(2) << event->getPriority() << " ";
-            else
-              ofprofile << setw(10) << right << setprecision(2) << 0.0 << " ";
+      while ( not _eventQueue.empty() and not isInterrupted() ) {
+        RoutingEvent* event = _eventQueue.pop();
+
+        size_t depth = _katana->getConfiguration()->getLayerDepth( event->getSegment()->getLayer() );
+        _statistics.incEventsCount( 1, depth );
+
+        if (ofprofile.is_open()) {
+          if (depth < 6) {
+            ofprofile << setw(10) << right << count << " ";
+            for ( size_t i=0 ; i<6 ; ++i ) {
+              if (i == depth)
+                ofprofile << setw(10) << right << setprecision(2) << event->getPriority() << " ";
+              else
+                ofprofile << setw(10) << right << setprecision(2) << 0.0 << " ";
+            }
+
+            ofprofile << setw( 2) << right << event->getEventLevel() << endl;
           }
+        }
 
-          ofprofile << setw( 2) << right << event->getEventLevel() << endl;
+        progress.set( events , RoutingEvent::getProcesseds() );
+        progress.set( remains, _eventQueue.size() );
+        progress.tick();
+        if (not tty::enabled()) {
+          cmess2 << "        <event:" << right << setw(8) << setfill('0')
+                 << RoutingEvent::getProcesseds() << setfill(' ') << " "
+                 << event->getEventLevel() << ":" << event->getPriority()
+                 << ":" << DbU::getValueString(event->getSegment()->getLength()) << "> "
+                 << event->getSegment()
+                 << endl;
+          cmess2.flush();
         }
-      }
 
-      if (tty::enabled()) {
-        cmess2 << "        <event:" << tty::bold << right << setw(8) << setfill('0')
-               << RoutingEvent::getProcesseds() << tty::reset
-               << " remains:" << right << setw(8) << setfill('0')
-               << _eventQueue.size()
-               << setfill(' ') << tty::reset << ">" << tty::cr;
-        cmess2.flush ();
-      } else {
-        cmess2 << "        <event:" << right << setw(8) << setfill('0')
-               << RoutingEvent::getProcesseds() << setfill(' ') << " "
-               << event->getEventLevel() << ":" << event->getPriority()
-               << ":" << DbU::getValueString(event->getSegment()->getLength()) << "> "
-               << event->getSegment()
-               << endl;
-        cmess2.flush();
-      }
+        event->process( _eventQueue, _eventHistory, _eventLoop );
+        count++;
 
-      event->process( _eventQueue, _eventHistory, _eventLoop );
-      count++;
+        // if (RoutingEvent::getProcesseds() == 446036) {
+        //   UpdateSession::close();
+        //   Breakpoint::stop( 0, "After processing RoutingEvent 446035." );
+        //   UpdateSession::open();
+        // }
+
+        // if (  (event->getSegment()->getId() == 88365)
+        //    or (event->getSegment()->getId() == 88368)) {
+        //   UpdateSession::close();
+        //   ostringstream message;
+        //   message << "After processing AutoSegment " << event->getSegment()->getId()
+        //           << " (@event:" << (count-1) << ")";
+        //   Breakpoint::stop( 0, message.str() );
+        //   UpdateSession::open();
+        // }
 
-      // if (RoutingEvent::getProcesseds() == 446036) {
-      //   UpdateSession::close();
-      //   Breakpoint::stop( 0, "After processing RoutingEvent 446035." );
-      //   UpdateSession::open();
-      // }
-
-      // if (  (event->getSegment()->getId() == 88365)
-      //    or (event->getSegment()->getId() == 88368)) {
-      //   UpdateSession::close();
-      //   ostringstream message;
-      //   message << "After processing AutoSegment " << event->getSegment()->getId()
-      //           << " (@event:" << (count-1) << ")";
-      //   Breakpoint::stop( 0, message.str() );
-      //   UpdateSession::open();
-      // }
-
-      // if (event->getSegment()->getNet()->getId() == 239546) {
-      //   UpdateSession::close();
-      //   ostringstream message;
-      //   message << "After processing an event from Net id:239546\n" << event;
-      //   Breakpoint::stop( 0, message.str() );
-      //   UpdateSession::open();
-      // }
+        // if (event->getSegment()->getNet()->getId() == 239546) {
+        //   UpdateSession::close();
+        //   ostringstream message;
+        //   message << "After processing an event from Net id:239546\n" << event;
+        //   Breakpoint::stop( 0, message.str() );
+        //   UpdateSession::open();
+        // }
          
-      // if (count and not (count % 500)) {
-      //   _pack( count, false );
-      // } 
+        // if (count and not (count % 500)) {
+        //   _pack( count, false );
+        // } 
          
-      // if (RoutingEvent::getProcesseds() == 65092) {
-      //   UpdateSession::close();
-      //   Breakpoint::stop( 0, "Overlap has happened" );
-      //   UpdateSession::open();
-      // }
-      if (RoutingEvent::getProcesseds() >= limit) setInterrupt( true );
+        // if (RoutingEvent::getProcesseds() == 65092) {
+        //   UpdateSession::close();
+        //   Breakpoint::stop( 0, "Overlap has happened" );
+        //   UpdateSession::open();
+        // }
+        if (RoutingEvent::getProcesseds() >= limit) setInterrupt( true );
+      }
     }
+    progress.finish();
+    _statistics.setLoadedEventsCount( loaded );
     _statistics.setProcessedEventsCount( RoutingEvent::getProcesseds() );
   //_pack( count, true );
     _negociateRepair();
@@ -754,17 +829,16 @@ namespace Katana {
       _eventQueue.commit();
       cmess2 << "        <realign.queue:" <<  right << setw(8) << setfill('0')
              << _eventQueue.size() << ">" << setfill(' ') << endl;
-      count = 0;
+      Progress realignProgress ( "realign.event" );
+      events  = realignProgress.addCounter( "events"  );
+      remains = realignProgress.addCounter( "remains" );
+      count   = 0;
       while ( not _eventQueue.empty() and not isInterrupted() ) {
         RoutingEvent* event = _eventQueue.pop();
-        if (tty::enabled()) {
-          cmess2 << "        <realign.event:" << tty::bold << setw(8) << setfill('0')
-                 << RoutingEvent::getProcesseds() << tty::reset
-                 << " remains:" << right << setw(8) << setfill('0')
-                 << _eventQueue.size() << ">"
-                 << setfill(' ') << tty::reset << tty::cr;
-          cmess2.flush();
-        } else {
+        realignProgress.set( events , RoutingEvent::getProcesseds() );
+        realignProgress.set( remains, _eventQueue.size() );
+        realignProgress.tick();
+        if (not tty::enabled()) {
           cmess2 << "        <realign.event:" << setw(8) << setfill('0')
                  << RoutingEvent::getProcesseds() << setfill(' ') << " "
                  << event->getEventLevel() << ":" << event->getPriority() << "> "
@@ -782,12 +856,11 @@ namespace Katana {
         //   UpdateSession::open();
         // }
       }
+      realignProgress.finish();
 
       _negociateRepair();
     }
 
-    if (count and cmess2.enabled() and tty::enabled()) cmess1 << endl;
-
     size_t eventsCount = _eventHistory.size();
 
     _eventHistory.clear();
@@ -798,7 +871,9 @@ namespace Katana {
     }
 
     if (ofprofile.is_open()) ofprofile.close();
+    EventProfile::enable( false );
     _statistics.setEventsCount( eventsCount );
+    _statistics.setQueueCounts( _eventQueue );
     cdebug_tabw(159,-1);
 
     return eventsCount;
@@ -828,17 +903,17 @@ namespace Katana {
     cmess2 << "        <repair.queue:" <<  right << setw(8) << setfill('0')
            << _eventQueue.size() << ">" << setfill(' ') << endl;
 
+    Progress progress ( "repair.event" );
+    size_t   events   = progress.addCounter( "events"  );
+    size_t   remains  = progress.addCounter( "remains" );
+
     while ( not _eventQueue.empty() and not isInterrupted() ) {
       RoutingEvent* event = _eventQueue.pop();
 
-      if (tty::enabled()) {
-        cmess2 << "        <repair.event:" << tty::bold << setw(8) << setfill('0')
-               << RoutingEvent::getProcesseds() << tty::reset
-               << " remains:" << right << setw(8) << setfill('0')
-               << _eventQueue.size() << ">"
-               << setfill(' ') << tty::reset << tty::cr;
-        cmess2.flush();
-      } else {
+      progress.set( events , RoutingEvent::getProcesseds() );
+      progress.set( remains, _eventQueue.size() );
+      progress.tick();
+      if (not tty::enabled()) {
         cmess2 << "        <repair.event:" << setw(8) << setfill('0')
                << RoutingEvent::getProcesseds() << setfill(' ') << " "
                << event->getEventLevel() << ":" << event->getPriority() << "> "
@@ -852,6 +927,7 @@ namespace Katana {
       count++;
       if (RoutingEvent::getProcesseds() >= limit) setInterrupt( true );
     }
+    progress.finish();
 
     cdebug_tabw(159,-1);
   }
@@ -927,6 +1003,10 @@ namespace Katana {
                             ,(totalEvents - RoutingEvent::getCloneds())) << endl;
     cmess1 << Dots::asSizet ( "     - Processeds Events Total",totalEvents) << endl;
     cmess1 << Dots::asString( "     - Event ripup ratio", os.str() ) << endl;
+    cmess1 << Dots::asSizet ( "     - Queue pushes"  , _statistics.getQueuePushesCount  ()) << endl;
+    cmess1 << Dots::asSizet ( "     - Queue pops"    , _statistics.getQueuePopsCount    ()) << endl;
+    cmess1 << Dots::asSizet ( "     - Queue repushes", _statistics.getQueueRepushesCount()) << endl;
+    cmess1 << Dots::asSizet ( "     - Queue compares", _statistics.getQueueComparesCount()) << endl;
     for ( auto keyValue : _statistics.getEventsMap() ) {
       ostringstream title;
       title << "     - Processeds Events in "
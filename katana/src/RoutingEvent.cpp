@@ -42,6 +42,7 @@
 #include "katana/KatanaEngine.h"
 #include "katana/Manipulator.h"
 #include "katana/SegmentFsm.h"
+#include "katana/EventProfile.h"
 
 
 namespace Katana {
@@ -205,6 +206,8 @@ namespace Katana {
     , _insertState         (0)
     , _rippleState         (0)
     , _eventLevel          (0)
+    , _queueLevel          (0)
+    , _queueIndex          (std::numeric_limits<uint32_t>::max())
     , _key                 (this)
   {
     if (_idCounter == std::numeric_limits<uint32_t>::max()) {
@@ -252,6 +255,7 @@ namespace Katana {
     clone->_cloned     = false;
     clone->_disabled   = false;
     clone->_eventLevel = 0;
+    clone->_queueIndex = std::numeric_limits<uint32_t>::max();
 
     cdebug_log(159,0) << "RoutingEvent::clone() " << clone
                 << " (from: " << ")" <<  endl;
@@ -424,6 +428,10 @@ namespace Katana {
       setProcessed();
     }
 
+    if (EventProfile::isEnabled())
+      EventProfile::setEvent( getEventLevel(), Session::getLayerDepth(_segment->getLayer()) );
+    EventProfile::Scope  processScope ( EventProfile::Process );
+
   //DebugSession::open( _segment->getNet(), 155, 160 );
     DebugSession::open( _segment->getNet(), 149, 160 );
 
@@ -475,7 +483,10 @@ namespace Katana {
     //   UpdateSession::open();
     // }
     
-    Session::revalidate();
+    {
+      EventProfile::Scope  revalidateScope ( EventProfile::Revalidate );
+      Session::revalidate();
+    }
     queue.commit();
 
   //_postCheck( _segment );
@@ -47,7 +47,14 @@ namespace Katana {
   RoutingEventQueue::RoutingEventQueue ()
     : _topEventLevel (0)
     , _pushRequests  ()
-    , _events        ()
+    , _buckets       ()
+    , _topBucket     (0)
+    , _size          (0)
+    , _order         (0)
+    , _pushCount     (0)
+    , _popCount      (0)
+    , _repushCount   (0)
+    , _compareCount  (0)
   { }
 
 
@@ -55,6 +62,101 @@ namespace Katana {
   { clear (); }
 
 
+// Same order as the multiset<RoutingEvent*,RoutingEvent::Compare>, the
+// top of the queue being it's *last* element. Between two equivalent
+// keys, the last inserted comes first (it was the last of it's range).
+  bool  RoutingEventQueue::_isBefore ( const Entry& lhs, const Entry& rhs ) const
+  {
+    ++_compareCount;
+    RoutingEvent::Compare  compare;
+    if (compare(rhs._event,lhs._event)) return true;
+    if (compare(lhs._event,rhs._event)) return false;
+    return lhs._order > rhs._order;
+  }
+
+
+  void  RoutingEventQueue::_siftUp ( uint32_t level, uint32_t index )
+  {
+    Bucket& bucket = _buckets[level];
+    Entry   entry  = bucket[index];
+    while ( index ) {
+      uint32_t parent = (index-1) / 2;
+      if (not _isBefore(entry,bucket[parent])) break;
+      _place( level, index, bucket[parent] );
+      index = parent;
+    }
+    _place( level, index, entry );
+  }
+
+
+  void  RoutingEventQueue::_siftDown ( uint32_t level, uint32_t index )
+  {
+    Bucket&  bucket = _buckets[level];
+    Entry    entry  = bucket[index];
+    uint32_t size   = bucket.size();
+    while ( true ) {
+      uint32_t child = 2*index + 1;
+      if (child >= size) break;
+      if ((child+1 < size) and _isBefore(bucket[child+1],bucket[child])) ++child;
+      if (not _isBefore(bucket[child],entry)) break;
+      _place( level, index, bucket[child] );
+      index = child;
+    }
+    _place( level, index, entry );
+  }
+
+
+// The key of the event must be up to date (RoutingEvent::updateKey())
+// and the event must not be already queued.
+  void  RoutingEventQueue::_insert ( RoutingEvent* event )
+  {
+    uint32_t level = event->getKey().getEventLevel();
+    if (level >= _buckets.size()) _buckets.resize( level+1 );
+    _buckets[level].push_back( Entry{ event, _order++ } );
+    _siftUp( level, _buckets[level].size()-1 );
+
+    _topBucket = max( _topBucket, level );
+    ++_size;
+    ++_pushCount;
+  }
+
+
+  bool  RoutingEventQueue::_erase ( RoutingEvent* event )
+  {
+    if (not contains(event)) return false;
+
+    uint32_t level = event->getQueueLevel();
+    uint32_t index = event->getQueueIndex();
+    Bucket&  bucket = _buckets[level];
+
+    event->setQueuePosition( 0, npos );
+    --_size;
+    if (index+1 == bucket.size()) {
+      bucket.pop_back();
+      return true;
+    }
+
+    Entry removed = bucket[index];
+    _place( level, index, bucket.back() );
+    bucket.pop_back();
+    if (_isBefore(bucket[index],removed)) _siftUp  ( level, index );
+    else                                  _siftDown( level, index );
+    return true;
+  }
+
+
+// The stored position may be a leftover of a previous queue (or of the
+// cloned event), so it is trusted only if the slot holds the event.
+  bool  RoutingEventQueue::contains ( const RoutingEvent* event ) const
+  {
+    uint32_t level = event->getQueueLevel();
+    uint32_t index = event->getQueueIndex();
+    return (level < _buckets.size())
+       and (index < _buckets[level].size())
+       and (_buckets[level][index]._event == event);
+  }
+
+
   void  RoutingEventQueue::load ( const vector<TrackElement*>& segments )
   {
     for ( size_t i=0 ; i<segments.size() ; i++ ) {
@@ -68,7 +170,7 @@ namespace Katana {
       }
       RoutingEvent* event = RoutingEvent::create( segments[i] );
       event->updateKey();
-      _events.insert( event );
+      _insert( event );
     }
   }
 
@@ -91,15 +193,13 @@ namespace Katana {
   {
     cdebug_log(159,1) << "RoutingEventQueue::commit()" << endl;
 
-    size_t addeds = _pushRequests.size();
-    size_t before = _events.size();
-
     RoutingEventSet::iterator ipushEvent = _pushRequests.begin();
     for ( ; ipushEvent != _pushRequests.end() ; ipushEvent++ ) {
+      if (_erase(*ipushEvent)) ++_repushCount;
       (*ipushEvent)->updateKey();
 
       _topEventLevel = max( _topEventLevel, (*ipushEvent)->getEventLevel() );
-      _events.insert( (*ipushEvent) );
+      _insert( *ipushEvent );
 
       cdebug_log(159,0) << "| " << (*ipushEvent) << endl;
     }
@@ -107,11 +207,6 @@ namespace Katana {
 #if defined(CHECK_ROUTINGEVENT_QUEUE)
     _keyCheck();
 #endif
-    size_t after = _events.size();
-    if (after-before != addeds) {
-      cerr << Bug( "RoutingEventQueue::commit(): less than %d events pusheds (%d)."
-                 , addeds,(after-before) ) << endl;
-    }
 
     cdebug_tabw(159,-1);
   }
@@ -119,28 +214,17 @@ namespace Katana {
 
   RoutingEvent* RoutingEventQueue::pop ()
   {
-    multiset<RoutingEvent*,RoutingEvent::Compare>::iterator ievent;
-    RoutingEvent* event = NULL;
-
 #if defined(CHECK_ROUTINGEVENT_QUEUE)
     _keyCheck ();
 #endif
 
-    if (not _events.empty()) {
-      size_t beforeSize = _events.size();
+    if (not _size) return NULL;
 
-      ievent = _events.end();
-      ievent--;
-      event  = (*ievent);
-      _events.erase( ievent );
+    while ( _buckets[_topBucket].empty() ) --_topBucket;
 
-      size_t afterSize = _events.size();
-
-      if (afterSize+1 != beforeSize) {
-        cerr << Bug( "RoutingEventQueue::pop(): more than one event popped: %d."
-                   , (beforeSize-afterSize) ) << endl;
-      }
-    }
+    RoutingEvent* event = _buckets[_topBucket].front()._event;
+    _erase( event );
+    ++_popCount;
 
     return event;
   }
@@ -152,18 +236,7 @@ namespace Katana {
     _keyCheck ();
 #endif
 
-    multiset<RoutingEvent*,RoutingEvent::Compare>::iterator ievent = _events.find(event);
-    size_t count = _events.count(event);
-    if (count > 1) {
-      cerr << Bug( "RoutingEventQueue::repush(): %d events matches key %p.", count, event ) << endl;
-#if defined(CHECK_ROUTINGEVENT_QUEUE)
-      _keyCheck ();
-#endif
-    }
-
-    if (ievent != _events.end()) {
-      _events.erase( ievent );
-    }
+    if (_erase(event)) ++_repushCount;
     push ( event );
   }
 
@@ -193,62 +266,98 @@ namespace Katana {
 
   void  RoutingEventQueue::prepareRepair ()
   {
-    multiset<RoutingEvent*,RoutingEvent::Compare>::const_iterator ievent = _events.begin ();
-    for ( ; ievent != _events.end(); ++ievent ) {
-      (*ievent)->getSegment()->base()->toOptimalAxis();
+    for ( const Bucket& bucket : _buckets ) {
+      for ( const Entry& entry : bucket )
+        entry._event->getSegment()->base()->toOptimalAxis();
     }
   }
 
 
   void  RoutingEventQueue::clear ()
   {
-    if (not _events.empty()) {
+    if (_size) {
       cerr << Bug("RoutingEvent queue is not empty, %d events remains."
-                 ,_events.size()) << endl;
+                 ,_size) << endl;
     }
-    _events.clear();
+    _buckets.clear();
+    _topBucket = 0;
+    _size      = 0;
+  }
+
+
+  void  RoutingEventQueue::resetCounters ()
+  {
+    _pushCount    = 0;
+    _popCount     = 0;
+    _repushCount  = 0;
+    _compareCount = 0;
+  }
+
+
+// Events in the multiset order, that is, the top of the queue last.
+  void  RoutingEventQueue::_getSorteds ( vector<RoutingEvent*>& events ) const
+  {
+    vector<Entry>  entries;
+    for ( const Bucket& bucket : _buckets )
+      entries.insert( entries.end(), bucket.begin(), bucket.end() );
+    std::sort( entries.begin(), entries.end()
+             , [this]( const Entry& lhs, const Entry& rhs ) { return _isBefore(rhs,lhs); } );
+
+    events.clear();
+    for ( const Entry& entry : entries ) events.push_back( entry._event );
   }
 
 
   void  RoutingEventQueue::dump () const
   {
-    multiset<RoutingEvent*,RoutingEvent::Compare>::const_iterator ievent = _events.begin ();
-    for ( ; ievent != _events.end(); ievent++ ) {
+    vector<RoutingEvent*>  events;
+    _getSorteds( events );
+    for ( RoutingEvent* event : events ) {
       cerr << "Deter| Queue:"
-           <<         (*ievent)->getEventLevel()
-           << ","  << setw(6) << (*ievent)->getPriority()
-           << " "  << setw(6) << DbU::getValueString((*ievent)->getSegment()->getLength())
-           << " "             << (*ievent)->getSegment()->isHorizontal()
-           << " "  << setw(6) << DbU::getValueString((*ievent)->getSegment()->getAxis())
-           << " "  << setw(6) << DbU::getValueString((*ievent)->getSegment()->getSourceU())
-           << ": " << (*ievent)->getSegment() << endl;
+           <<         event->getEventLevel()
+           << ","  << setw(6) << event->getPriority()
+           << " "  << setw(6) << DbU::getValueString(event->getSegment()->getLength())
+           << " "             << event->getSegment()->isHorizontal()
+           << " "  << setw(6) << DbU::getValueString(event->getSegment()->getAxis())
+           << " "  << setw(6) << DbU::getValueString(event->getSegment()->getSourceU())
+           << ": " << event->getSegment() << endl;
     }
   }
 
 
   void  RoutingEventQueue::_keyCheck () const
   {
-    multiset<RoutingEvent*,RoutingEvent::Compare>::const_iterator ievent = _events.begin ();
-    for ( ; ievent != _events.end(); ievent++ ) {
-      multiset<RoutingEvent*,RoutingEvent::Compare>::const_iterator ieventByKey
-        = _events.find ( *ievent );
-      
-      if ( ieventByKey != ievent ) {
-        if ( ieventByKey == _events.end() ) {
-          cerr << Bug("Key mismatch in RoutingEvent Queue:\n"
-                      "      %p:%s wasn't found by key."
-                     ,*ievent,getString(*ievent).c_str()
+    size_t size = 0;
+    for ( uint32_t level=0 ; level<_buckets.size() ; ++level ) {
+      const Bucket& bucket = _buckets[level];
+      size += bucket.size();
+      for ( uint32_t index=0 ; index<bucket.size() ; ++index ) {
+        RoutingEvent* event = bucket[index]._event;
+        if ((event->getQueueLevel() != level) or (event->getQueueIndex() != index)) {
+          cerr << Bug("Position mismatch in RoutingEvent Queue:\n"
+                      "      %p:%s is at [%u,%u] but records [%u,%u]."
+                     ,event,getString(event).c_str()
+                     ,level,index,event->getQueueLevel(),event->getQueueIndex()
                      ) << endl;
-        } else {
+        }
+        if (event->getKey().getEventLevel() != level) {
           cerr << Bug("Key mismatch in RoutingEvent Queue:\n"
-                      "      %p:%s has same key of\n"
+                      "      %p:%s is in bucket %u."
+                     ,event,getString(event).c_str(),level
+                     ) << endl;
+        }
+        if (index and _isBefore(bucket[index],bucket[(index-1)/2])) {
+          cerr << Bug("Heap order broken in RoutingEvent Queue:\n"
+                      "      %p:%s is before it's parent\n"
                       "      %p:%s"
-                     ,*ievent,getString(*ievent).c_str()
-                     ,*ieventByKey,getString(*ieventByKey).c_str()
+                     ,event,getString(event).c_str()
+                     ,bucket[(index-1)/2]._event,getString(bucket[(index-1)/2]._event).c_str()
                      ) << endl;
         }
       }
     }
+    if (size != _size)
+      cerr << Bug("RoutingEvent Queue holds %d events but size is %d.",size,_size) << endl;
   }
 
 
@@ -266,7 +375,11 @@ namespace Katana {
   Record* RoutingEventQueue::_getRecord () const
   {
     Record* record = new Record ( getString(this) );
-    record->add ( getSlot ( "_events", &_events ) );
+    record->add ( getSlot ( "_topEventLevel", &_topEventLevel ) );
+    record->add ( getSlot ( "_size"         , &_size          ) );
+    record->add ( getSlot ( "_pushCount"    , &_pushCount     ) );
+    record->add ( getSlot ( "_popCount"     , &_popCount      ) );
+    record->add ( getSlot ( "_repushCount"  , &_repushCount   ) );
                                      
     return record;
   }
@@ -26,6 +26,7 @@
 #include "katana/RoutingEventHistory.h"
 #include "katana/Manipulator.h"
 #include "katana/SegmentFsm.h"
+#include "katana/EventProfile.h"
 #include "katana/KatanaEngine.h"
 
 
@@ -457,6 +458,7 @@ namespace Katana {
     , _data2       (NULL)
     , _constraint  ()
     , _optimal     ()
+    , _costsStorage()
     , _costs       ()
     , _actions     ()
     , _fullBlocked (true)
@@ -464,6 +466,8 @@ namespace Katana {
     , _useEvent2   (false)
     , _minimizeDrag(false)
   {
+    EventProfile::Scope  profileScope ( EventProfile::FsmBuild );
+
     DataSymmetric* symData  = NULL;
     TrackElement*  segment1 = _event1->getSegment();
     TrackElement*  segment2 = segment1->getSymmetric();
@@ -554,6 +558,10 @@ namespace Katana {
 
     RoutingPlane* plane = Session::getKatanaEngine()->getRoutingPlaneByLayer(segment1->getLayer());
 
+  // The costs are built by value, _costs points to them once they are all
+  // created (_costsStorage may be reallocated until then).
+    _costsStorage.reserve( 16 );
+
     if (segment1->isNonPref()) {
       Track*        baseTrack = plane->getTrackByPosition( segment1->base()->getSourcePosition(), Constant::Superior );
       RoutingPlane* perpPlane = plane->getTop();
@@ -563,20 +571,20 @@ namespace Katana {
 
       for ( Track* ptrack : Tracks_Range::get(perpPlane,_constraint) ) {
         cdebug_log(155,0) << "Align on (top) preferred: " << ptrack << endl;
-        _costs.push_back( new TrackCost(segment1,NULL,baseTrack,NULL,ptrack->getAxis(),0) );
+        _costsStorage.emplace_back( segment1,nullptr,baseTrack,nullptr,ptrack->getAxis(),0 );
       
-        cdebug_log(155,0) << "AxisWeight:" << DbU::getValueString(_costs.back()->getRefCandidateAxis())
-                          << " sum:" << DbU::getValueString(_costs.back()->getAxisWeight())
+        cdebug_log(155,0) << "AxisWeight:" << DbU::getValueString(_costsStorage.back().getRefCandidateAxis())
+                          << " sum:" << DbU::getValueString(_costsStorage.back().getAxisWeight())
                           << endl;
         
-        if ( _fullBlocked and (not _costs.back()->isBlockage() and not _costs.back()->isFixed()) ) 
+        if ( _fullBlocked and (not _costsStorage.back().isBlockage() and not _costsStorage.back().isFixed()) ) 
           _fullBlocked = false;
 
-        cdebug_log(155,0) << "| " << _costs.back() << ((_fullBlocked)?" FB ": " -- ") << ptrack << endl;
+        cdebug_log(155,0) << "| " << &_costsStorage.back() << ((_fullBlocked)?" FB ": " -- ") << ptrack << endl;
       }
-      if (_costs.empty()) {
-        _costs.push_back( new TrackCost(segment1,NULL,baseTrack,NULL,segment1->getAxis(),0) );
-        if ( _fullBlocked and (not _costs.back()->isBlockage() and not _costs.back()->isFixed()) ) 
+      if (_costsStorage.empty()) {
+        _costsStorage.emplace_back( segment1,nullptr,baseTrack,nullptr,segment1->getAxis(),0 );
+        if ( _fullBlocked and (not _costsStorage.back().isBlockage() and not _costsStorage.back().isFixed()) ) 
           _fullBlocked = false;
       }
     } else {
@@ -596,23 +604,24 @@ namespace Katana {
           cdebug_log(155,0) << "plus segment2:" << DbU::getValueString( segment2->getSymmetricAxis(symData->getSymmetrical(track1->getAxis())) ) << endl;
         }
 
-        _costs.push_back( new TrackCost(segment1,segment2,track1,track2,track1->getAxis(),symAxis) );
+        _costsStorage.emplace_back( segment1,segment2,track1,track2,track1->getAxis(),symAxis );
         cdebug_log(155,0) << "Same Ripup:" << _data1->getSameRipup() << endl;
         if ((_data1->getSameRipup() > 10) and (track1->getAxis() == segment1->getAxis())) {
           cdebug_log(155,0) << "Track blacklisted" << endl;
-          _costs.back()->setBlacklisted();
+          _costsStorage.back().setBlacklisted();
         }
       
-        cdebug_log(155,0) << "AxisWeight:" << DbU::getValueString(_costs.back()->getRefCandidateAxis())
-                          << " sum:" << DbU::getValueString(_costs.back()->getAxisWeight())
+        cdebug_log(155,0) << "AxisWeight:" << DbU::getValueString(_costsStorage.back().getRefCandidateAxis())
+                          << " sum:" << DbU::getValueString(_costsStorage.back().getAxisWeight())
                           << endl;
         
-        if ( _fullBlocked and (not _costs.back()->isBlockage() and not _costs.back()->isFixed()) ) 
+        if ( _fullBlocked and (not _costsStorage.back().isBlockage() and not _costsStorage.back().isFixed()) ) 
           _fullBlocked = false;
 
-        cdebug_log(155,0) << "| " << _costs.back() << ((_fullBlocked)?" FB ": " -- ") << track1 << endl;
+        cdebug_log(155,0) << "| " << &_costsStorage.back() << ((_fullBlocked)?" FB ": " -- ") << track1 << endl;
       }
     }
+    for ( TrackCost& cost : _costsStorage ) _costs.push_back( &cost );
     cdebug_tabw(159,-1);
 
     if (_costs.empty()) {
@@ -648,6 +657,7 @@ namespace Katana {
 
   // FOR ANALOG ONLY.
   //flags |= TrackCost::IgnoreSharedLength;
+    for ( TrackCost* cost : _costs ) cost->updateSortKey( flags );
     sort( _costs.begin(), _costs.end(), TrackCost::Compare(flags) );
 
     size_t i=0;
@@ -669,9 +679,7 @@ namespace Katana {
 
 
   SegmentFsm::~SegmentFsm ()
-  {
-    for ( TrackCost* cost : _costs ) delete cost;
-  }
+  { }
 
 
   void  SegmentFsm::setDataState ( uint32_t state )
@@ -695,6 +703,8 @@ namespace Katana {
 
   void  SegmentFsm::doActions ()
   {
+    EventProfile::Scope  profileScope ( EventProfile::Actions );
+
     cdebug_log(159,1) << "SegmentFsm::doActions() - " << _actions.size() << endl;
 
     for ( AutoSegment* base : Session::getInvalidateds() ) {
@@ -1524,6 +1534,8 @@ namespace Katana {
 
   bool  SegmentFsm::slackenTopology ( uint32_t flags )
   {
+    EventProfile::Scope  profileScope ( EventProfile::Slacken );
+
     bool          success     = false;
     TrackElement* segment1    = getSegment1();
     uint32_t      actionFlags = SegmentAction::SelfInsert|SegmentAction::EventLevel5;
@@ -287,6 +287,7 @@ namespace Katana {
     , _markers      ()
     , _localAssigned(false)
     , _segmentsValid(false)
+    , _sortedCount  (0)
     , _markersValid (false)
     , _minInvalid   (routingPlane->getTrackMin())
     , _maxInvalid   (routingPlane->getTrackMax())
@@ -1035,12 +1036,18 @@ namespace Katana {
   {
     cdebug_log(155,1) << "Track::doRemoval() - " << this << endl;
 
-    size_t  size = _segments.size();
+    size_t  size        = _segments.size();
+    size_t  kept        = 0;
+    size_t  sortedCount = 0;
 
-    vector<TrackElement*>::iterator  beginRemove
-      = remove_if( _segments.begin(), _segments.end(), isDetachedSegment() );
-
-    _segments.erase( beginRemove, _segments.end() );
+  // Same as remove_if(), but keeps track of the sorted part.
+    for ( size_t i=0 ; i<size ; ++i ) {
+      if (isDetachedSegment()( _segments[i] )) continue;
+      if (i < _sortedCount) ++sortedCount;
+      _segments[kept++] = _segments[i];
+    }
+    _segments.resize( kept );
+    _sortedCount = sortedCount;
 
     cdebug_log(155,0) << "After doRemoval " << this << endl;
     cdebug_tabw(155,-1);
@@ -1053,8 +1060,32 @@ namespace Katana {
   {
     cdebug_log(155,0) << "Track::doReorder() " << this << endl;
 
-    if (not _segmentsValid) {
-      std::sort( _segments.begin(), _segments.end(), SegmentCompare() );
+    if (not _segmentsValid or (_sortedCount < _segments.size())) {
+      SegmentCompare         compare;
+      vector<TrackElement*>  displaceds ( _segments.begin()+_sortedCount, _segments.end() );
+      _segments.resize( _sortedCount );
+
+    // Some segments of the sorted part may have moved. Pull out both
+    // elements of each descent, what is left is still sorted and each
+    // moved segment costs at most two displaced ones.
+      if (not _segmentsValid) {
+        size_t kept = 0;
+        for ( size_t i=0 ; i<_segments.size() ; ++i ) {
+          if (kept and compare(_segments[i],_segments[kept-1])) {
+            displaceds.push_back( _segments[--kept] );
+            displaceds.push_back( _segments[i] );
+          } else
+            _segments[kept++] = _segments[i];
+        }
+        _segments.resize( kept );
+      }
+
+      std::sort( displaceds.begin(), displaceds.end(), compare );
+      size_t middle = _segments.size();
+      _segments.insert( _segments.end(), displaceds.begin(), displaceds.end() );
+      std::inplace_merge( _segments.begin(), _segments.begin()+middle, _segments.end(), compare );
+
+      _sortedCount   = _segments.size();
       _segmentsValid = true;
     }
     // Net*      blockageNet = Session::getBlockageNet();
@@ -19,6 +19,7 @@
 #include <iostream>
 #include "katana/Track.h"
 #include "katana/TrackCost.h"
+#include "katana/EventProfile.h"
 #include "katana/TrackElement.h"
 #include "katana/Session.h"
 
@@ -44,8 +45,9 @@ namespace Katana {
     , _span            (refSegment->getTrackSpan())
     , _refCandidateAxis(refCandidateAxis)
     , _symCandidateAxis(symCandidateAxis)
-    , _tracks          ( _span * ((symSegment) ? 2 : 1)
-                       , std::tuple<Track*,size_t,size_t>(NULL,Track::npos,Track::npos) )
+    , _sortKey         (0)
+    , _inlineTracks    ()
+    , _wideTracks      ()
     , _segment1        (refSegment)
     , _segment2        (symSegment)
     , _interval1       (refSegment->getCanonicalInterval())
@@ -63,6 +65,8 @@ namespace Katana {
     , _selectFlags     (NoFlags)
     , _selectIndex     (0)
   {
+    EventProfile::Scope  profileScope ( EventProfile::TrackCost );
+
     if (Session::getStage() == StageRealign) _flags |= IgnoreShort;
     
     if (refSegment->isNonPref()) {
@@ -78,17 +82,25 @@ namespace Katana {
         throw Error( "TrackCost::TrackCost(): Zero track span is not allowed.\n"
                      "        %s", getString(refSegment).c_str() );
     }
+
+    size_t entries = _span * ((symSegment) ? 2 : 1);
+    if (entries > MaxInlineTracks)
+      _wideTracks.resize( entries, TrackEntry(NULL,Track::npos,Track::npos) );
+    else {
+      for ( size_t i=0 ; i<MaxInlineTracks ; ++i )
+        _inlineTracks[i] = TrackEntry( NULL, Track::npos, Track::npos );
+    }
     
     cdebug_log(159,1) << "TrackCost::TrackCost() - " << refSegment << endl;
     cdebug_log(159,0) << "  interval1: " << _interval1 << endl;
     
-    std::get<0>( _tracks[0] ) = refTrack;
+    std::get<0>( _getEntry(0) ) = refTrack;
     _segment1->addOverlapCost( *this );
 
     if (symTrack) {
-      cdebug_log(159,0) << "  _tracks.size(): " << _tracks.size() << " _span:" << _span << endl;
+      cdebug_log(159,0) << "  entries: " << entries << " _span:" << _span << endl;
 
-      std::get<0>( _tracks[_span] ) = symTrack;
+      std::get<0>( _getEntry(_span) ) = symTrack;
       select( 0, Symmetric );
       _segment2->addOverlapCost( *this );
     }
@@ -108,8 +120,23 @@ namespace Katana {
   }
 
 
+// Pack, from the most significant bit, the boolean criterions which
+// are checked first by Compare, a set bit is a worse cost.
+  void  TrackCost::updateSortKey ( uint32_t compareFlags )
+  {
+    _sortKey = 0;
+    if (isInfinite    ()) _sortKey |= (1 << 4);
+    if (isAtRipupLimit()) _sortKey |= (1 << 3);
+    if (isBlacklisted ()) _sortKey |= (1 << 2);
+    if ((compareFlags & DiscardGlobals) and isOverlapGlobal()) _sortKey |= (1 << 1);
+    if (isHardOverlap ()) _sortKey |= (1 << 0);
+  }
+
+
   bool  TrackCost::Compare::operator() ( const TrackCost* lhs, const TrackCost* rhs )
   {
+    if (lhs->_sortKey != rhs->_sortKey) return lhs->_sortKey < rhs->_sortKey;
+
     if (lhs->isInfinite    () xor rhs->isInfinite    ()) return rhs->isInfinite();
     if (lhs->isAtRipupLimit() xor rhs->isAtRipupLimit()) return rhs->isAtRipupLimit();
     if (lhs->isBlacklisted()  xor rhs->isBlacklisted ()) return rhs->isBlacklisted();
@@ -194,14 +221,14 @@ namespace Katana {
   size_t  TrackCost::getBegin ( size_t i, uint32_t flags ) const
   {
     if (i >= _span) return Track::npos;
-    return std::get<1>( _tracks[i + ((flags & Symmetric) ? _span : 0)] );
+    return std::get<1>( _getEntry(i + ((flags & Symmetric) ? _span : 0)) );
   }
 
 
   size_t  TrackCost::getEnd ( size_t i, uint32_t flags ) const
   {
     if (i >= _span) return Track::npos;
-    return std::get<2>( _tracks[i + ((flags & Symmetric) ? _span : 0)] );
+    return std::get<2>( _getEntry(i + ((flags & Symmetric) ? _span : 0)) );
   }
 
 
@@ -295,7 +322,7 @@ namespace Katana {
   {
     Record* record = new Record ( _getString() );
     record->add( getSlot          ( "_flags"          ,  _flags           ) );
-    record->add( getSlot          ( "_tracks"         ,  _tracks          ) );
+    record->add( getSlot          ( "_wideTracks"     ,  _wideTracks      ) );
     record->add( getSlot          ( "_interval1"      , &_interval1       ) );
     record->add( getSlot          ( "_interval2"      , &_interval2       ) );
     record->add( getSlot          ( "_terminals"      ,  _terminals       ) );
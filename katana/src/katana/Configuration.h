@@ -55,6 +55,7 @@ namespace Katana {
       enum Flag        { UseClockTree          = (1 << 0)
                        , UseGlobalEstimate     = (1 << 1)
                        , UseStaticBloatProfile = (1 << 2)
+                       , UseGlobalAStar        = (1 << 3)
                        };
     public:
     // Constructor & Destructor.
@@ -65,6 +66,7 @@ namespace Katana {
       inline        bool                       useClockTree            () const;
       inline        bool                       useGlobalEstimate       () const;
       inline        bool                       useStaticBloatProfile   () const;
+      inline        bool                       useGlobalAStar          () const;
       inline        bool                       profileEventCosts       () const;
       inline        bool                       runRealignStage         () const;
       inline        bool                       disableStackedVias      () const;
@@ -77,6 +79,10 @@ namespace Katana {
       inline        uint32_t                   getRipupCost            () const;
                     uint32_t                   getRipupLimit           ( uint32_t type ) const;
       inline        uint32_t                   getSearchHalo           () const;
+      inline        uint32_t                   getGlobalThreads        () const;
+      inline        uint32_t                   getGlobalLandmarks      () const;
+      inline        uint32_t                   getNegociateRegions     () const;
+      inline        uint32_t                   getNegociateHalo        () const;
       inline        uint32_t                   getBloatOverloadAdd     () const;
       inline        uint32_t                   getLongWireUpThreshold1 () const;
       inline        double                     getLongWireUpReserve1   () const;
@@ -109,6 +115,10 @@ namespace Katana {
              PostEventCb_t  _postEventCb;
              std::string    _bloat;
              uint32_t       _searchHalo;
+             uint32_t       _globalThreads;
+             uint32_t       _globalLandmarks;
+             uint32_t       _negociateRegions;
+             uint32_t       _negociateHalo;
              uint32_t       _longWireUpThreshold1;
              double         _longWireUpReserve1;
              uint32_t       _hTracksReservedLocal;
@@ -139,6 +149,10 @@ namespace Katana {
   inline       std::string                   Configuration::getBloat                () const { return _bloat; }
   inline       uint64_t                      Configuration::getEventsLimit          () const { return _eventsLimit; }
   inline       uint32_t                      Configuration::getSearchHalo           () const { return _searchHalo; }
+  inline       uint32_t                      Configuration::getGlobalThreads        () const { return _globalThreads; }
+  inline       uint32_t                      Configuration::getGlobalLandmarks      () const { return _globalLandmarks; }
+  inline       uint32_t                      Configuration::getNegociateRegions     () const { return _negociateRegions; }
+  inline       uint32_t                      Configuration::getNegociateHalo        () const { return _negociateHalo; }
   inline       uint32_t                      Configuration::getRipupCost            () const { return _ripupCost; }
   inline       uint32_t                      Configuration::getBloatOverloadAdd     () const { return _bloatOverloadAdd; }
   inline       uint32_t                      Configuration::getLongWireUpThreshold1 () const { return _longWireUpThreshold1; }
@@ -157,6 +171,7 @@ namespace Katana {
   inline       bool                          Configuration::useClockTree            () const { return _flags & UseClockTree; }
   inline       bool                          Configuration::useGlobalEstimate       () const { return _flags & UseGlobalEstimate; }
   inline       bool                          Configuration::useStaticBloatProfile   () const { return _flags & UseStaticBloatProfile; }
+  inline       bool                          Configuration::useGlobalAStar          () const { return _flags & UseGlobalAStar; }
   inline       bool                          Configuration::profileEventCosts       () const { return _profileEventCosts; }
   inline       bool                          Configuration::runRealignStage         () const { return _runRealignStage; }
   inline       bool                          Configuration::disableStackedVias      () const { return _disableStackedVias; }
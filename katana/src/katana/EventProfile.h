@@ -0,0 +1,121 @@
+// -*- C++ -*-
+//
+// This file is part of the Coriolis Software.
+// Copyright (c) Sorbonne Université 2026-2026, All Rights Reserved
+//
+// +-----------------------------------------------------------------+
+// |                   C O R I O L I S                               |
+// |      K i t e  -  D e t a i l e d   R o u t e r                  |
+// |                                                                 |
+// |  Author      :                    Jean-Paul CHAPUT              |
+// |  E-mail      :            Jean-Paul.Chaput@lip6.fr              |
+// | =============================================================== |
+// |  C++ Header  :  "./katana/EventProfile.h"                       |
+// +-----------------------------------------------------------------+
+
+
+#pragma  once
+#include <cstdint>
+#include <algorithm>
+#include <iosfwd>
+#include <unordered_map>
+
+
+namespace Katana {
+
+
+// -------------------------------------------------------------------
+// Class  :  "EventProfile".
+//
+// Wall time profile of RoutingEvent::process(), active when the
+// "katana.profileEventCosts" parameter is set. The hot spots are
+// bracketed by an EventProfile::Scope, scopes may be nested. Times
+// are aggregated in two ways:
+//
+// * Per event level, layer depth (of the event's segment) and phase:
+//   number of calls, inclusive time and self time (children excluded).
+// * Per call stack of phases: self time. This is the "collapsed stacks"
+//   format of flame graph tools ("process;fsm;trackCost <ns>").
+//
+// The levels & depths above the table sizes are counted in the last
+// row. KatanaEngine::dumpMeasures() appends the first table (as CSV)
+// to "<cell>.katana.dat" and writes the stacks in "<cell>.katana.flame".
+// Like the RoutingEvent counters, the tables are static: there is only
+// one negociation running at a time.
+
+  class EventProfile {
+    public:
+      enum Phase { Process    = 0
+                 , FsmBuild
+                 , TrackCost
+                 , Ripup
+                 , Relax
+                 , Slacken
+                 , Actions
+                 , Revalidate
+                 , PhaseCount
+                 };
+      static const uint32_t  MaxLevel = 16;
+      static const uint32_t  MaxDepth = 16;
+      static const uint32_t  MaxStack = 16;
+    public:
+      class Scope {
+        public:
+          inline  Scope ( Phase );
+          inline ~Scope ();
+        private:
+          bool  _active;
+      };
+    public:
+      struct Entry {
+        uint64_t  _calls;
+        uint64_t  _total;
+        uint64_t  _self;
+      };
+    public:
+      static inline bool         isEnabled    ();
+      static        bool         isEmpty      ();
+      static        void         enable       ( bool );
+      static        void         clear        ();
+      static inline void         setEvent     ( uint32_t level, uint32_t depth );
+      static        void         push         ( Phase );
+      static        void         pop          ();
+      static        const char*  getPhaseName ( Phase );
+      static        void         toCsv        ( std::ostream& );
+      static        void         toCollapsed  ( std::ostream& );
+    private:
+      struct Frame {
+        Phase     _phase;
+        uint64_t  _start;
+        uint64_t  _children;
+        uint64_t  _stackKey;
+      };
+    private:
+      static bool                                  _enabled;
+      static uint32_t                              _level;
+      static uint32_t                              _depth;
+      static size_t                                _top;
+      static Frame                                 _stack [MaxStack];
+      static Entry                                 _table [MaxLevel][MaxDepth][PhaseCount];
+      static std::unordered_map<uint64_t,uint64_t>  _stacks;
+  };
+
+
+  inline bool  EventProfile::isEnabled () { return _enabled; }
+
+  inline void  EventProfile::setEvent ( uint32_t level, uint32_t depth )
+  {
+    _level = std::min( level, MaxLevel-1 );
+    _depth = std::min( depth, MaxDepth-1 );
+  }
+
+
+  inline  EventProfile::Scope::Scope ( Phase phase )
+    : _active(EventProfile::isEnabled())
+  { if (_active) EventProfile::push( phase ); }
+
+  inline  EventProfile::Scope::~Scope ()
+  { if (_active) EventProfile::pop(); }
+
+
+}  // Katana namespace.
@@ -69,6 +69,7 @@ namespace Katana {
       inline  bool                     useClockTree               () const;
       inline  bool                     useGlobalEstimate          () const;
       inline  bool                     useStaticBloatProfile      () const;
+      inline  bool                     useGlobalAStar             () const;
       inline  CellViewer*              getViewer                  () const;
       inline  AnabaticEngine*          base                       ();
               const Configuration*     getConfiguration           () const;
@@ -80,6 +81,10 @@ namespace Katana {
               uint32_t                 getRipupLimit              ( const TrackElement* ) const;
       inline  uint32_t                 getRipupCost               () const;
       inline  uint32_t                 getSearchHalo              () const;
+      inline  uint32_t                 getGlobalThreads           () const;
+      inline  uint32_t                 getGlobalLandmarks         () const;
+      inline  uint32_t                 getNegociateRegions        () const;
+      inline  uint32_t                 getNegociateHalo           () const;
       inline  uint32_t                 getBloatOverloadAdd        () const;
       inline  uint32_t                 getHTracksReservedLocal    () const;
       inline  uint32_t                 getVTracksReservedLocal    () const;
@@ -183,6 +188,7 @@ namespace Katana {
   inline  bool                          KatanaEngine::useClockTree            () const { return getConfiguration()->useClockTree(); }
   inline  bool                          KatanaEngine::useGlobalEstimate       () const { return getConfiguration()->useGlobalEstimate(); }
   inline  bool                          KatanaEngine::useStaticBloatProfile   () const { return getConfiguration()->useStaticBloatProfile(); }
+  inline  bool                          KatanaEngine::useGlobalAStar          () const { return getConfiguration()->useGlobalAStar(); }
   inline  CellViewer*                   KatanaEngine::getViewer               () const { return _viewer; }
   inline  AnabaticEngine*               KatanaEngine::base                    () { return static_cast<AnabaticEngine*>(this); }
   inline  uint32_t                      KatanaEngine::getStage                () const { return _stage; }
@@ -191,6 +197,10 @@ namespace Katana {
   inline  uint64_t                      KatanaEngine::getEventsLimit          () const { return getConfiguration()->getEventsLimit(); }
   inline  uint32_t                      KatanaEngine::getRipupCost            () const { return getConfiguration()->getRipupCost(); }
   inline  uint32_t                      KatanaEngine::getSearchHalo           () const { return getConfiguration()->getSearchHalo(); }
+  inline  uint32_t                      KatanaEngine::getGlobalThreads        () const { return getConfiguration()->getGlobalThreads(); }
+  inline  uint32_t                      KatanaEngine::getGlobalLandmarks      () const { return getConfiguration()->getGlobalLandmarks(); }
+  inline  uint32_t                      KatanaEngine::getNegociateRegions     () const { return getConfiguration()->getNegociateRegions(); }
+  inline  uint32_t                      KatanaEngine::getNegociateHalo        () const { return getConfiguration()->getNegociateHalo(); }
   inline  uint32_t                      KatanaEngine::getBloatOverloadAdd     () const { return getConfiguration()->getBloatOverloadAdd(); }
   inline  uint32_t                      KatanaEngine::getHTracksReservedLocal () const { return getConfiguration()->getHTracksReservedLocal(); }
   inline  uint32_t                      KatanaEngine::getVTracksReservedLocal () const { return getConfiguration()->getVTracksReservedLocal(); }
@@ -47,6 +47,10 @@ namespace Katana {
       inline size_t           getEventsCount          ( size_t depth ) const;
       inline size_t           getLoadedEventsCount    () const;
       inline size_t           getProcessedEventsCount () const;
+      inline size_t           getQueuePushesCount     () const;
+      inline size_t           getQueuePopsCount       () const;
+      inline size_t           getQueueRepushesCount   () const;
+      inline size_t           getQueueComparesCount   () const;
       inline float            getRipupRatio           () const;
       inline const EventsMap& getEventsMap            () const;
       inline void             setGCellsCount          ( size_t );
@@ -54,6 +58,7 @@ namespace Katana {
       inline void             setEventsCount          ( size_t );
       inline void             setLoadedEventsCount    ( size_t );
       inline void             setProcessedEventsCount ( size_t );
+      inline void             setQueueCounts          ( const RoutingEventQueue& );
       inline void             incGCellCount           ( size_t );
       inline void             incSegmentsCount        ( size_t );
       inline void             incEventsCount          ( size_t count, size_t depth );
@@ -64,6 +69,10 @@ namespace Katana {
       size_t     _eventsCount;
       size_t     _loadedEventsCount;
       size_t     _processedEventsCount;
+      size_t     _queuePushesCount;
+      size_t     _queuePopsCount;
+      size_t     _queueRepushesCount;
+      size_t     _queueComparesCount;
       EventsMap  _eventsCountByDepth;
   };
 
@@ -74,6 +83,10 @@ namespace Katana {
     , _eventsCount         (0)
     , _loadedEventsCount   (0)
     , _processedEventsCount(0)
+    , _queuePushesCount    (0)
+    , _queuePopsCount      (0)
+    , _queueRepushesCount  (0)
+    , _queueComparesCount  (0)
     , _eventsCountByDepth  ()
   { }
 
@@ -82,12 +95,25 @@ namespace Katana {
   inline size_t  Statistics::getEventsCount          ( size_t depth ) const { return (depth < _eventsCountByDepth.size()) ? _eventsCountByDepth.at(depth) : 0; }
   inline size_t  Statistics::getLoadedEventsCount    () const { return _loadedEventsCount; }
   inline size_t  Statistics::getProcessedEventsCount () const { return _processedEventsCount; }
+  inline size_t  Statistics::getQueuePushesCount     () const { return _queuePushesCount; }
+  inline size_t  Statistics::getQueuePopsCount       () const { return _queuePopsCount; }
+  inline size_t  Statistics::getQueueRepushesCount   () const { return _queueRepushesCount; }
+  inline size_t  Statistics::getQueueComparesCount   () const { return _queueComparesCount; }
   inline float   Statistics::getRipupRatio           () const { return (_loadedEventsCount) ? ((float)(_processedEventsCount - _loadedEventsCount) / (float)_loadedEventsCount) : 0.0; }
   inline void    Statistics::setGCellsCount          ( size_t count ) { _gcellsCount = count; }
   inline void    Statistics::setSegmentsCount        ( size_t count ) { _segmentsCount = count; }
   inline void    Statistics::setLoadedEventsCount    ( size_t count ) { _loadedEventsCount = count; }
   inline void    Statistics::setProcessedEventsCount ( size_t count ) { _processedEventsCount = count; }
   inline void    Statistics::setEventsCount          ( size_t count ) { _eventsCount = count; }
+
+  inline void  Statistics::setQueueCounts ( const RoutingEventQueue& queue )
+  {
+    _queuePushesCount   = queue.getPushCount   ();
+    _queuePopsCount     = queue.getPopCount    ();
+    _queueRepushesCount = queue.getRepushCount ();
+    _queueComparesCount = queue.getCompareCount();
+  }
+
   inline void    Statistics::incGCellCount           ( size_t count ) { _gcellsCount += count; }
   inline void    Statistics::incSegmentsCount        ( size_t count ) { _segmentsCount += count; }
   inline void    Statistics::incEventsCount          ( size_t count, size_t depth ) { _eventsCountByDepth[depth] += count; }
@@ -100,6 +126,10 @@ namespace Katana {
     _gcellsCount   += other._gcellsCount;
     _segmentsCount += other._segmentsCount;
     _eventsCount   += other._eventsCount;
+    _queuePushesCount   += other._queuePushesCount;
+    _queuePopsCount     += other._queuePopsCount;
+    _queueRepushesCount += other._queueRepushesCount;
+    _queueComparesCount += other._queueComparesCount;
     return *this;
   }
 
@@ -130,6 +160,7 @@ namespace Katana {
              void                          _computePriorities   ();
              void                          _associateSymmetrics ();
              void                          _pack                ( size_t& count, bool last );
+             void                          _partition           ( vector< vector<TrackElement*> >& ) const;
              size_t                        _negociate           ();
              void                          _negociateRepair     ();
              Hurricane::Record*            _getRecord           () const;
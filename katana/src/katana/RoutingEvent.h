@@ -60,8 +60,9 @@ namespace Katana {
           };
 
         public:
-                Key    ( const RoutingEvent* );
-          void  update ( const RoutingEvent* );
+                           Key           ( const RoutingEvent* );
+          inline uint32_t  getEventLevel () const;
+                 void      update        ( const RoutingEvent* );
         private:
           unsigned int  _tracksNb  :16;
           unsigned int  _rpDistance: 4;
@@ -128,6 +129,8 @@ namespace Katana {
       inline  uint32_t                     getTracksFree         () const;
       inline  uint32_t                     getInsertState        () const;
       inline  uint32_t                     getEventLevel         () const;
+      inline  uint32_t                     getQueueLevel         () const;
+      inline  uint32_t                     getQueueIndex         () const;
               void                         revalidate            ();
               void                         _revalidateNonPref    ();
       inline  void                         updateKey             ();
@@ -152,6 +155,7 @@ namespace Katana {
       inline  void                         incInsertState        ();
       inline  void                         resetInsertState      ();
       inline  void                         setEventLevel         ( uint32_t );
+      inline  void                         setQueuePosition      ( uint32_t level, uint32_t index );
               bool                         _rescheduleAsPref     ();
               void                         _processNegociate     ( RoutingEventQueue&, RoutingEventHistory& );
               void                         _processPack          ( RoutingEventQueue&, RoutingEventHistory& );
@@ -192,6 +196,8 @@ namespace Katana {
       unsigned int          _insertState     : 6;
       unsigned int          _rippleState     : 4;
       uint32_t              _eventLevel;
+      uint32_t              _queueLevel;
+      uint32_t              _queueIndex;
     //vector<TrackElement*> _perpandiculars;
       Key                   _key;
   };
@@ -220,6 +226,8 @@ namespace Katana {
 //inline const Interval&               RoutingEvent::getPerpandicular        () const { return _perpandicular; }
   inline float                         RoutingEvent::getPriority             () const { return _segment->getPriority(); }
   inline uint32_t                      RoutingEvent::getEventLevel           () const { return _eventLevel; }
+  inline uint32_t                      RoutingEvent::getQueueLevel           () const { return _queueLevel; }
+  inline uint32_t                      RoutingEvent::getQueueIndex           () const { return _queueIndex; }
   inline uint32_t                      RoutingEvent::getTracksNb             () const { return _tracksNb; }
   inline uint32_t                      RoutingEvent::getTracksFree           () const { return _tracksFree; }
   inline uint32_t                      RoutingEvent::getInsertState          () const { return _insertState; }
@@ -235,8 +243,11 @@ namespace Katana {
   inline void                          RoutingEvent::incInsertState          () { _insertState++; }
   inline void                          RoutingEvent::resetInsertState        () { _insertState = 0; }
   inline void                          RoutingEvent::setEventLevel           ( uint32_t level ) { _eventLevel = level; }
+  inline void                          RoutingEvent::setQueuePosition        ( uint32_t level, uint32_t index ) { _queueLevel = level; _queueIndex = index; }
   inline void                          RoutingEvent::updateKey               () { revalidate(); _key.update(this); }
 
+  inline uint32_t  RoutingEvent::Key::getEventLevel () const { return _eventLevel; }
+
   inline bool  RoutingEvent::CompareById::operator() ( const RoutingEvent* lhs, const RoutingEvent* rhs ) const
   { return lhs->getId() < rhs->getId(); }
 
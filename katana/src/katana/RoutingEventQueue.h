@@ -17,6 +17,7 @@
 #ifndef  KATANA_ROUTING_EVENT_QUEUE_H
 #define  KATANA_ROUTING_EVENT_QUEUE_H
 
+#include <cstdint>
 #include <set>
 #include <vector>
 #include "katana/RoutingEvent.h"
@@ -31,15 +32,29 @@ namespace Katana {
 
 // -------------------------------------------------------------------
 // Class  :  "RoutingEventQueue".
+//
+// The events are sorted in buckets, one per event level (the first
+// criterion of RoutingEvent::Compare), each bucket being an indexed
+// binary heap. The position of an event (bucket & index) is kept in
+// the event itself so a repush is done in O(log n) without searching
+// by key. Events with equivalent keys are popped in reverse order of
+// insertion, as in the multiset formerly used.
 
   class RoutingEventQueue {
 
+    public:
+      static const uint32_t  npos = (uint32_t)-1;
     public:
                             RoutingEventQueue  ();
                            ~RoutingEventQueue  ();
       inline  bool          empty              () const;
       inline  size_t        size               () const;
       inline  uint32_t      getTopEventLevel   () const;
+      inline  size_t        getPushCount       () const;
+      inline  size_t        getPopCount        () const;
+      inline  size_t        getRepushCount     () const;
+      inline  size_t        getCompareCount    () const;
+              bool          contains           ( const RoutingEvent* ) const;
               RoutingEvent* pop                ();
               void          load               ( const vector<TrackElement*>& );
               void          add                ( TrackElement*, uint32_t level );
@@ -49,17 +64,40 @@ namespace Katana {
               void          commit             ();
               void          prepareRepair      ();
               void          clear              ();
+              void          resetCounters      ();
               void          dump               () const;
               void          _keyCheck          () const;
               Record*       _getRecord         () const;
               string        _getString         () const;
       inline  string        _getTypeName       () const;
 
+    protected:
+      struct Entry {
+        RoutingEvent* _event;
+        uint64_t      _order;
+      };
+      typedef  vector<Entry>  Bucket;
+    protected:
+              bool          _isBefore          ( const Entry&, const Entry& ) const;
+              void          _insert            ( RoutingEvent* );
+              bool          _erase             ( RoutingEvent* );
+      inline  void          _place             ( uint32_t level, uint32_t index, const Entry& );
+              void          _siftUp            ( uint32_t level, uint32_t index );
+              void          _siftDown          ( uint32_t level, uint32_t index );
+              void          _getSorteds        ( vector<RoutingEvent*>& ) const;
+
     protected:
     // Attributes.
-      uint32_t                                       _topEventLevel;
-      RoutingEventSet                                _pushRequests;
-      multiset<RoutingEvent*,RoutingEvent::Compare>  _events;
+      uint32_t          _topEventLevel;
+      RoutingEventSet   _pushRequests;
+      vector<Bucket>    _buckets;
+      uint32_t          _topBucket;
+      size_t            _size;
+      uint64_t          _order;
+      size_t            _pushCount;
+      size_t            _popCount;
+      size_t            _repushCount;
+      mutable size_t    _compareCount;
 
     private:
               RoutingEventQueue& operator=         ( const RoutingEventQueue& );
@@ -69,12 +107,22 @@ namespace Katana {
 
 
 // Inline Functions.
-  inline bool      RoutingEventQueue::empty            () const { return _events.empty(); }
-  inline size_t    RoutingEventQueue::size             () const { return _events.size(); }
+  inline bool      RoutingEventQueue::empty            () const { return not _size; }
+  inline size_t    RoutingEventQueue::size             () const { return _size; }
   inline uint32_t  RoutingEventQueue::getTopEventLevel () const { return _topEventLevel; }
+  inline size_t    RoutingEventQueue::getPushCount     () const { return _pushCount; }
+  inline size_t    RoutingEventQueue::getPopCount      () const { return _popCount; }
+  inline size_t    RoutingEventQueue::getRepushCount   () const { return _repushCount; }
+  inline size_t    RoutingEventQueue::getCompareCount  () const { return _compareCount; }
   inline string    RoutingEventQueue::_getTypeName     () const { return "EventQueue"; }
   inline void      RoutingEventQueue::push             ( RoutingEvent* event ) { _pushRequests.insert( event ); }
 
+  inline void  RoutingEventQueue::_place ( uint32_t level, uint32_t index, const Entry& entry )
+  {
+    _buckets[level][index] = entry;
+    entry._event->setQueuePosition( level, index );
+  }
+
 
 }  // Katana namespace.
 
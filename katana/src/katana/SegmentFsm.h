@@ -186,6 +186,7 @@ namespace Katana {
       DataNegociate*                _data2;
       Interval                      _constraint;
       Interval                      _optimal;
+      vector<TrackCost>             _costsStorage;
       vector<TrackCost*>            _costs;
       vector<SegmentAction>         _actions;
       bool                          _fullBlocked;
@@ -37,6 +37,12 @@ namespace Katana {
 
 // -------------------------------------------------------------------
 // Class  :  "Track".
+//
+// The segments are kept in a vector sorted by SegmentCompare, in two
+// parts: the first _sortedCount ones are sorted, the newly inserted
+// ones are appended after them. doReorder() only sorts the appended
+// segments (and the ones that have moved, after an invalidate()) then
+// merges them in, instead of sorting the whole Track again.
 
   class Track {
 
@@ -130,6 +136,7 @@ namespace Katana {
       std::vector<TrackMarker*>   _markers;
       bool                        _localAssigned;
       bool                        _segmentsValid;
+      size_t                      _sortedCount;
       bool                        _markersValid;
       DbU::Unit                   _minInvalid;
       DbU::Unit                   _maxInvalid;
@@ -36,8 +36,21 @@ namespace Katana {
 
 // -------------------------------------------------------------------
 // Class  :  "TrackCost".
+//
+// The costs of the candidate Tracks are stored by value in the
+// SegmentFsm (one allocation per event instead of one per candidate).
+// The Tracks are kept in place when they fit in MaxInlineTracks (non
+// wide, possibly symmetric segments), in _wideTracks otherwise.
+//
+// The boolean criterions of Compare, which come first, are packed in
+// a sort key by updateSortKey(), so most comparisons are resolved by
+// a single integer comparison. The keys must be updated, with the same
+// flags, before sorting with Compare.
  
   class TrackCost {
+    public:
+      typedef std::tuple<Track*,size_t,size_t>  TrackEntry;
+      static const size_t  MaxInlineTracks = 2;
     public:
       enum Flags { NoFlags            =  0
                  , IgnoreAxisWeight   = (1 <<  0)
@@ -89,6 +102,7 @@ namespace Katana {
                                                      , DbU::Unit     refCandidateAxis
                                                      , DbU::Unit     symCandidateAxis
                                                      );
+                                 TrackCost           ( TrackCost&& ) = default;
                                 ~TrackCost           ();
       inline       bool          isForGlobal         () const;
       inline       bool          isBlockage          () const;
@@ -163,10 +177,14 @@ namespace Katana {
       inline       bool          selectNextTrack     ();
       inline       bool          select              ( size_t index, uint32_t flags );
                    void          consolidate         ();
+                   void          updateSortKey       ( uint32_t compareFlags );
                    void          setDistanceToFixed  ();
                    Record*       _getRecord          () const;
                    string        _getString          () const;
       inline       string        _getTypeName        () const;
+    private:
+      inline       TrackEntry&   _getEntry           ( size_t i );
+      inline const TrackEntry&   _getEntry           ( size_t i ) const;
     private:                                         
                                  TrackCost           ( const TrackCost& ) = delete;
                    TrackCost&    operator=           ( const TrackCost& ) = delete;
@@ -176,8 +194,10 @@ namespace Katana {
       size_t        _span;
       DbU::Unit     _refCandidateAxis;
       DbU::Unit     _symCandidateAxis;
-      std::vector< std::tuple<Track*,size_t,size_t> >
-                    _tracks;
+      uint32_t      _sortKey;
+      TrackEntry    _inlineTracks[MaxInlineTracks];
+      std::vector<TrackEntry>
+                    _wideTracks;
       TrackElement* _segment1;
       TrackElement* _segment2;
       Interval      _interval1;
@@ -265,6 +285,13 @@ namespace Katana {
   inline  TrackCost::Compare::Compare ( uint32_t flags ) : _flags(flags) { }
 
 
+  inline TrackCost::TrackEntry& TrackCost::_getEntry ( size_t i )
+  { return (_wideTracks.empty()) ? _inlineTracks[i] : _wideTracks[i]; }
+
+  inline const TrackCost::TrackEntry& TrackCost::_getEntry ( size_t i ) const
+  { return (_wideTracks.empty()) ? _inlineTracks[i] : _wideTracks[i]; }
+
+
   inline  Track* TrackCost::getTrack () const
   {
     // cdebug_log( 55,0) << "TrackCost::getTrack() _index:" << _selectIndex
@@ -311,7 +338,7 @@ namespace Katana {
     //                   << " flags:" << flags
     //                   << " index:" << (i + ((flags & Symmetric) ? _span : 0)) << std::endl;
 
-    return std::get<0>( _tracks[i + ((flags & Symmetric) ? _span : 0)] );
+    return std::get<0>( _getEntry(i + ((flags & Symmetric) ? _span : 0)) );
   }
 
 
@@ -322,7 +349,7 @@ namespace Katana {
                       << " index:" << (_selectIndex + ((_selectFlags & Symmetric) ? _span : 0))
                       << " " << track << std::endl;
 
-    auto& entry = _tracks[_selectIndex + ((_selectFlags & Symmetric) ? _span : 0)];
+    auto& entry = _getEntry( _selectIndex + ((_selectFlags & Symmetric) ? _span : 0) );
     std::get<0>( entry ) = track;
     std::get<1>( entry ) = begin;
     std::get<2>( entry ) = end;
@@ -196,6 +196,7 @@ Construct the parameters
                      &GlobalPlacerParameters::distanceTolerance)
       .def_readwrite("export_blending", &GlobalPlacerParameters::exportBlending)
       .def_readwrite("noise", &GlobalPlacerParameters::noise)
+      .def_readwrite("nb_threads", &GlobalPlacerParameters::nbThreads)
       .def("check", &GlobalPlacerParameters::check)
       .def("__str__", &GlobalPlacerParameters::toString)
       .def("__repr__", &GlobalPlacerParameters::toString);
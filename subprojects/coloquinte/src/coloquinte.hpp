@@ -462,6 +462,12 @@ struct GlobalPlacerParameters {
    */
   double noise;
 
+  /**
+   * @brief Number of threads for the continuous model and the rough
+   * legalization; 1 runs them sequentially
+   */
+  int nbThreads;
+
   /**
    * @brief Initialize the parameters with sensible defaults
    */
@@ -240,6 +240,7 @@ GlobalPlacerParameters::GlobalPlacerParameters(int effort)
   // TODO: find best parameter
   exportBlending = 0.99;
   noise = 1.0e-4;
+  nbThreads = 1;
   // Parameters that vary with effort here
   double gapToleranceArray[9] = {0.13,  0.13,  0.058, 0.038, 0.026,
                                  0.026, 0.026, 0.026, 0.026};
@@ -260,7 +261,8 @@ std::string GlobalPlacerParameters::toString() const {
      << "\n\tInitial placement steps: " << nbInitialSteps
      << "\n\tPlacement steps per legalization: "
      << nbStepsBeforeRoughLegalization
-     << "\n\tExport blending: " << exportBlending;
+     << "\n\tExport blending: " << exportBlending
+     << "\n\tThreads: " << nbThreads;
   ss << std::endl;
   return ss.str();
 }
@@ -423,6 +425,9 @@ void GlobalPlacerParameters::check() const {
     throw std::runtime_error(
         "Noise should be a very small non-negative number");
   }
+  if (nbThreads < 1) {
+    throw std::runtime_error("Number of threads should be positive");
+  }
 }
 
 void LegalizationParameters::check() const {
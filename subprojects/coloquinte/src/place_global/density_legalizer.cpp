@@ -11,6 +11,7 @@
 #include "place_global/transportation.hpp"
 #include "place_global/transportation_1d.hpp"
 #include "utils/norm.hpp"
+#include "utils/parallel.hpp"
 
 namespace coloquinte {
 DensityLegalizer::Parameters::Parameters() {
@@ -25,6 +26,7 @@ DensityLegalizer::Parameters::Parameters() {
   quadraticPenaltyFactor = 0.0;
   coarseningLimit = 1.0;
   unidimensionalTransport = false;
+  nbThreads = 1;
 }
 
 DensityLegalizer::DensityLegalizer(DensityGrid grid,
@@ -308,6 +310,34 @@ void DensityLegalizer::reoptimize(
   }
 }
 
+void DensityLegalizer::reoptimize(
+    const std::vector<std::vector<std::pair<int, int> > > &binGroups) {
+  // Groups that share no bin touch disjoint cells and may run concurrently
+  bool disjoint = params_.nbThreads > 1;
+  if (disjoint) {
+    std::vector<char> used(nbBinsX() * nbBinsY(), 0);
+    for (const auto &bins : binGroups) {
+      for (auto [x, y] : bins) {
+        char &u = used[x * nbBinsY() + y];
+        disjoint &= u == 0;
+        u = 1;
+      }
+      if (!disjoint) break;
+    }
+  }
+  if (!disjoint) {
+    for (const auto &bins : binGroups) {
+      reoptimize(bins);
+    }
+    return;
+  }
+  parallelChunks(params_.nbThreads, binGroups.size(), [&](int, int b, int e) {
+    for (int i = b; i < e; ++i) {
+      reoptimize(binGroups[i]);
+    }
+  });
+}
+
 void DensityLegalizer::refine() {
   // Refine both if they are at the same level, otherwise refine only the
   // coarsest level
@@ -343,25 +373,31 @@ void DensityLegalizer::improve() {
 }
 
 void DensityLegalizer::improveXNeighbours(bool sameParent) {
-  for (int i = 0; i + 1 < nbBinsX(); ++i) {
-    if ((parentX(i) == parentX(i + 1)) != sameParent) {
-      continue;
-    }
-    for (int j = 0; j < nbBinsY(); ++j) {
-      rebisect(i, j, i + 1, j);
+  // Rows are independent: split them between threads
+  parallelChunks(params_.nbThreads, nbBinsY(), [&](int, int b, int e) {
+    for (int i = 0; i + 1 < nbBinsX(); ++i) {
+      if ((parentX(i) == parentX(i + 1)) != sameParent) {
+        continue;
+      }
+      for (int j = b; j < e; ++j) {
+        rebisect(i, j, i + 1, j);
+      }
     }
-  }
+  });
 }
 
 void DensityLegalizer::improveYNeighbours(bool sameParent) {
-  for (int j = 0; j + 1 < nbBinsY(); ++j) {
-    if ((parentY(j) == parentY(j + 1)) != sameParent) {
-      continue;
-    }
-    for (int i = 0; i < nbBinsX(); ++i) {
-      rebisect(i, j, i, j + 1);
+  // Columns are independent: split them between threads
+  parallelChunks(params_.nbThreads, nbBinsX(), [&](int, int b, int e) {
+    for (int j = 0; j + 1 < nbBinsY(); ++j) {
+      if ((parentY(j) == parentY(j + 1)) != sameParent) {
+        continue;
+      }
+      for (int i = b; i < e; ++i) {
+        rebisect(i, j, i, j + 1);
+      }
     }
-  }
+  });
 }
 
 void DensityLegalizer::improveSquareNeighbours(bool sameParentX,
@@ -406,69 +442,73 @@ void DensityLegalizer::improveUnidimensionalTransport() {
 
 void DensityLegalizer::improveXTransport() {
   float factor = 1.0e8 / placementArea().width();
-  for (int j = 0; j < nbBinsY(); ++j) {
-    std::vector<int> cells;
-    std::vector<long long> u;
-    std::vector<long long> v;
-    std::vector<long long> s;
-    std::vector<long long> d;
-    for (int i = 0; i < nbBinsX(); ++i) {
-      v.push_back(std::round(factor * binX(i, j)));
-      // Recursive bisection tends to have slightly higher usage than capacity
-      // Keep the previous usage in order not to break the quality
-      long long capa = std::max(binCapacity(i, j), binUsage(i, j));
-      d.push_back(capa);
-      for (int c : binCells(i, j)) {
-        cells.push_back(c);
-        u.push_back(std::round(factor * cellTargetX(c)));
-        s.push_back(cellDemand(c));
+  parallelChunks(params_.nbThreads, nbBinsY(), [&](int, int b, int e) {
+    for (int j = b; j < e; ++j) {
+      std::vector<int> cells;
+      std::vector<long long> u;
+      std::vector<long long> v;
+      std::vector<long long> s;
+      std::vector<long long> d;
+      for (int i = 0; i < nbBinsX(); ++i) {
+        v.push_back(std::round(factor * binX(i, j)));
+        // Recursive bisection tends to have slightly higher usage than capacity
+        // Keep the previous usage in order not to break the quality
+        long long capa = std::max(binCapacity(i, j), binUsage(i, j));
+        d.push_back(capa);
+        for (int c : binCells(i, j)) {
+          cells.push_back(c);
+          u.push_back(std::round(factor * cellTargetX(c)));
+          s.push_back(cellDemand(c));
+        }
+      }
+      Transportation1d pb(u, v, s, d);
+      pb.balanceDemand();
+      std::vector<int> assignment = pb.assign();
+      std::vector<std::vector<int> > binCells(nbBinsX());
+      for (size_t i = 0; i < cells.size(); ++i) {
+        binCells[assignment[i]].push_back(cells[i]);
+      }
+      for (int i = 0; i < nbBinsX(); ++i) {
+        setBinCells(i, j, binCells[i]);
       }
     }
-    Transportation1d pb(u, v, s, d);
-    pb.balanceDemand();
-    std::vector<int> assignment = pb.assign();
-    std::vector<std::vector<int> > binCells(nbBinsX());
-    for (size_t i = 0; i < cells.size(); ++i) {
-      binCells[assignment[i]].push_back(cells[i]);
-    }
-    for (int i = 0; i < nbBinsX(); ++i) {
-      setBinCells(i, j, binCells[i]);
-    }
-  }
+  });
   check();
 }
 
 void DensityLegalizer::improveYTransport() {
   float factor = 1.0e8 / placementArea().height();
-  for (int i = 0; i < nbBinsX(); ++i) {
-    std::vector<int> cells;
-    std::vector<long long> u;
-    std::vector<long long> v;
-    std::vector<long long> s;
-    std::vector<long long> d;
-    for (int j = 0; j < nbBinsY(); ++j) {
-      v.push_back(std::round(factor * binY(i, j)));
-      // Recursive bisection tends to have slightly higher usage than capacity
-      // Keep the previous usage in order not to break the quality
-      long long capa = std::max(binCapacity(i, j), binUsage(i, j));
-      d.push_back(capa);
-      for (int c : binCells(i, j)) {
-        cells.push_back(c);
-        u.push_back(std::round(factor * cellTargetY(c)));
-        s.push_back(cellDemand(c));
+  parallelChunks(params_.nbThreads, nbBinsX(), [&](int, int b, int e) {
+    for (int i = b; i < e; ++i) {
+      std::vector<int> cells;
+      std::vector<long long> u;
+      std::vector<long long> v;
+      std::vector<long long> s;
+      std::vector<long long> d;
+      for (int j = 0; j < nbBinsY(); ++j) {
+        v.push_back(std::round(factor * binY(i, j)));
+        // Recursive bisection tends to have slightly higher usage than capacity
+        // Keep the previous usage in order not to break the quality
+        long long capa = std::max(binCapacity(i, j), binUsage(i, j));
+        d.push_back(capa);
+        for (int c : binCells(i, j)) {
+          cells.push_back(c);
+          u.push_back(std::round(factor * cellTargetY(c)));
+          s.push_back(cellDemand(c));
+        }
+      }
+      Transportation1d pb(u, v, s, d);
+      pb.balanceDemand();
+      std::vector<int> assignment = pb.assign();
+      std::vector<std::vector<int> > binCells(nbBinsY());
+      for (size_t i = 0; i < cells.size(); ++i) {
+        binCells[assignment[i]].push_back(cells[i]);
+      }
+      for (int j = 0; j < nbBinsY(); ++j) {
+        setBinCells(i, j, binCells[j]);
       }
     }
-    Transportation1d pb(u, v, s, d);
-    pb.balanceDemand();
-    std::vector<int> assignment = pb.assign();
-    std::vector<std::vector<int> > binCells(nbBinsY());
-    for (size_t i = 0; i < cells.size(); ++i) {
-      binCells[assignment[i]].push_back(cells[i]);
-    }
-    for (int j = 0; j < nbBinsY(); ++j) {
-      setBinCells(i, j, binCells[j]);
-    }
-  }
+  });
   check();
 }
 
@@ -507,14 +547,21 @@ void DensityLegalizer::improveRectangles(int width, int height, int strideX,
                                          int strideY, int startX, int startY) {
   assert(width >= 1 && height >= 1 && strideX >= 1 && strideY >= 1);
   if (width * height == 1) return;
+  std::vector<std::vector<std::pair<int, int> > > binGroups;
   for (int i = startX; i < nbBinsX(); i += strideX) {
     for (int j = startY; j < nbBinsY(); j += strideY) {
-      improveRectangle(i, j, width, height);
+      binGroups.push_back(rectangleBins(i, j, width, height));
     }
   }
+  reoptimize(binGroups);
 }
 
 void DensityLegalizer::improveRectangle(int i, int j, int width, int height) {
+  reoptimize(rectangleBins(i, j, width, height));
+}
+
+std::vector<std::pair<int, int> > DensityLegalizer::rectangleBins(
+    int i, int j, int width, int height) const {
   assert(width >= 1 && height >= 1);
   std::vector<std::pair<int, int> > bins;
   for (int k = i; k < nbBinsX() && k < i + width; ++k) {
@@ -522,7 +569,7 @@ void DensityLegalizer::improveRectangle(int i, int j, int width, int height) {
       bins.emplace_back(k, l);
     }
   }
-  reoptimize(bins);
+  return bins;
 }
 
 void DensityLegalizer::improveDiagonalRectangles(int xmySize, int xpySize,
@@ -530,6 +577,7 @@ void DensityLegalizer::improveDiagonalRectangles(int xmySize, int xpySize,
                                                  int startX, int startY) {
   assert(xmySize >= 1 && xpySize >= 1 && strideX >= 1 && strideY >= 1);
   if (xmySize * xpySize == 1) return;
+  std::vector<std::vector<std::pair<int, int> > > binGroups;
   for (int i = startX; i < nbBinsX(); i += strideX) {
     for (int j = startY; j < nbBinsY(); j += strideY) {
       std::vector<std::pair<int, int> > bins;
@@ -546,9 +594,10 @@ void DensityLegalizer::improveDiagonalRectangles(int xmySize, int xpySize,
           bins.emplace_back(x, y);
         }
       }
-      reoptimize(bins);
+      binGroups.push_back(std::move(bins));
     }
   }
+  reoptimize(binGroups);
 }
 
 void DensityLegalizer::run() {
@@ -26,6 +26,8 @@ class DensityLegalizer : public HierarchicalDensityPlacement {
     double quadraticPenaltyFactor;
     double coarseningLimit;
     bool unidimensionalTransport;
+    // Number of threads to process independent groups of bins
+    int nbThreads;
 
     Parameters();
   };
@@ -203,11 +205,24 @@ class DensityLegalizer : public HierarchicalDensityPlacement {
    */
   void improveRectangle(int i, int j, int width, int height);
 
+  /**
+   * @brief Return the bins of a rectangle of the grid
+   */
+  std::vector<std::pair<int, int> > rectangleBins(int i, int j, int width,
+                                                  int height) const;
+
   /**
    * @brief Redo the distribution using a transportation algorithm
    */
   void reoptimize(const std::vector<std::pair<int, int> > &bins);
 
+  /**
+   * @brief Redo the distribution for several groups of bins, in order; they
+   * are processed concurrently if no bin is shared between groups
+   */
+  void reoptimize(
+      const std::vector<std::vector<std::pair<int, int> > > &binGroups);
+
   // Bisection algorithm helpers
   std::vector<std::pair<float, int> > computeCellCosts(
       float cx1, float cy1, float cx2, float cy2,
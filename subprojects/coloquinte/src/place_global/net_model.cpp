@@ -4,6 +4,9 @@
 #include <eigen3/Eigen/IterativeLinearSolvers>
 #include <eigen3/Eigen/Sparse>
 #include <limits>
+#include <numeric>
+
+#include "utils/parallel.hpp"
 
 namespace coloquinte {
 NetModel::Parameters::Parameters() {
@@ -12,6 +15,7 @@ NetModel::Parameters::Parameters() {
   penaltyCutoffDistance = 100.0;
   tolerance = 1.0e-4;
   maxNbIterations = 100;
+  nbThreads = 1;
 }
 
 NetModel NetModel::xTopology(const Circuit &circuit) {
@@ -241,19 +245,160 @@ std::tuple<int, int, float, float> NetModel::maxPin(
   return std::make_tuple(bestI, bestC, bestO, bestPos);
 }
 
+namespace {
+// Below these sizes, the work is not split between threads
+const int minNetsPerChunk = 1024;
+const int minRowsPerChunk = 4096;
+
+/**
+ * Conjugate gradient with a diagonal preconditioner, where the matrix-vector
+ * products and the reductions are split between threads by chunks of rows.
+ * It follows the same steps and stopping criterion as Eigen's
+ * ConjugateGradient with its default preconditioner. The per-chunk reductions
+ * are summed in order, so the result only depends on the number of threads.
+ */
+std::vector<float> solveParallelCG(
+    const Eigen::SparseMatrix<float, Eigen::RowMajor> &mat,
+    const std::vector<float> &rhs, const std::vector<float> &initial,
+    float tolerance, int maxIterations, int nbThreads) {
+  int n = mat.rows();
+  const int *outer = mat.outerIndexPtr();
+  const int *inner = mat.innerIndexPtr();
+  const float *values = mat.valuePtr();
+  int nbChunks = nbParallelChunks(nbThreads, n, minRowsPerChunk);
+  std::vector<double> partial1(nbChunks);
+  std::vector<double> partial2(nbChunks);
+  auto sum = [](const std::vector<double> &partial) {
+    return std::accumulate(partial.begin(), partial.end(), 0.0);
+  };
+
+  std::vector<float> x = initial;
+  std::vector<float> r(n);
+  std::vector<float> z(n);
+  std::vector<float> p(n);
+  std::vector<float> q(n);
+  std::vector<float> invDiag(n);
+
+  // Initial residual and preconditioner
+  parallelChunks(
+      nbThreads, n,
+      [&](int chunk, int b, int e) {
+        double rhsNorm2 = 0.0;
+        double resNorm2 = 0.0;
+        for (int i = b; i < e; ++i) {
+          float diag = 0.0f;
+          float ax = 0.0f;
+          for (int k = outer[i]; k < outer[i + 1]; ++k) {
+            if (inner[k] == i) {
+              diag += values[k];
+            }
+            ax += values[k] * x[inner[k]];
+          }
+          invDiag[i] = diag != 0.0f ? 1.0f / diag : 1.0f;
+          r[i] = rhs[i] - ax;
+          p[i] = invDiag[i] * r[i];
+          rhsNorm2 += rhs[i] * rhs[i];
+          resNorm2 += r[i] * r[i];
+        }
+        partial1[chunk] = rhsNorm2;
+        partial2[chunk] = resNorm2;
+      },
+      minRowsPerChunk);
+  double rhsNorm2 = sum(partial1);
+  if (rhsNorm2 == 0.0) {
+    return std::vector<float>(n, 0.0f);
+  }
+  double threshold =
+      std::max((double)tolerance * tolerance * rhsNorm2,
+               (double)std::numeric_limits<float>::min());
+  if (sum(partial2) < threshold) {
+    return x;
+  }
+
+  parallelChunks(
+      nbThreads, n,
+      [&](int chunk, int b, int e) {
+        double rz = 0.0;
+        for (int i = b; i < e; ++i) {
+          rz += r[i] * p[i];
+        }
+        partial1[chunk] = rz;
+      },
+      minRowsPerChunk);
+  double absNew = sum(partial1);
+
+  for (int it = 0; it < maxIterations; ++it) {
+    // q = A p
+    parallelChunks(
+        nbThreads, n,
+        [&](int chunk, int b, int e) {
+          double pq = 0.0;
+          for (int i = b; i < e; ++i) {
+            float s = 0.0f;
+            for (int k = outer[i]; k < outer[i + 1]; ++k) {
+              s += values[k] * p[inner[k]];
+            }
+            q[i] = s;
+            pq += p[i] * s;
+          }
+          partial1[chunk] = pq;
+        },
+        minRowsPerChunk);
+    float alpha = absNew / sum(partial1);
+
+    // Update the solution and the residual
+    parallelChunks(
+        nbThreads, n,
+        [&](int chunk, int b, int e) {
+          double resNorm2 = 0.0;
+          double rz = 0.0;
+          for (int i = b; i < e; ++i) {
+            x[i] += alpha * p[i];
+            r[i] -= alpha * q[i];
+            z[i] = invDiag[i] * r[i];
+            resNorm2 += r[i] * r[i];
+            rz += r[i] * z[i];
+          }
+          partial1[chunk] = resNorm2;
+          partial2[chunk] = rz;
+        },
+        minRowsPerChunk);
+    if (sum(partial1) < threshold) {
+      break;
+    }
+    double absOld = absNew;
+    absNew = sum(partial2);
+    float beta = absNew / absOld;
+
+    parallelChunks(
+        nbThreads, n,
+        [&](int, int b, int e) {
+          for (int i = b; i < e; ++i) {
+            p[i] = z[i] + beta * p[i];
+          }
+        },
+        minRowsPerChunk);
+  }
+  return x;
+}
+}  // namespace
+
 /**
  * Matrix creation for quadratic approximations
  */
 class MatrixCreator {
  public:
   explicit MatrixCreator(const NetModel &topo)
+      : MatrixCreator(topo, topo.nbPins()) {}
+
+  MatrixCreator(const NetModel &topo, int nbReservedPins)
       : topo_(topo),
         nbCells_(topo.nbCells()),
         nbSupps_(0),
         rhs_(topo.nbCells()),
         initial_(topo.nbCells()),
         hasNonZero_(topo.nbCells()) {
-    mat_.reserve(2 * topo_.nbPins());
+    mat_.reserve(2 * nbReservedPins);
   }
 
   int nbCells() const { return nbCells_; }
@@ -265,22 +410,29 @@ class MatrixCreator {
 
   int addCell(float initialPos);
 
-  std::vector<float> solve(float tolerance, int maxIterations);
+  std::vector<float> solve(float tolerance, int maxIterations,
+                           int nbThreads = 1);
 
-  static MatrixCreator createStar(const NetModel &topo);
+  static MatrixCreator createStar(const NetModel &topo, int nbThreads = 1);
   static MatrixCreator create(const NetModel &topo,
                               const std::vector<float> &pl, float epsilon,
-                              NetModelOption netModel);
+                              NetModelOption netModel, int nbThreads = 1);
   static MatrixCreator createB2B(const NetModel &topo,
-                                 const std::vector<float> &pl, float epsilon);
+                                 const std::vector<float> &pl, float epsilon,
+                                 int nbThreads = 1);
   static MatrixCreator createStar(const NetModel &topo,
-                                  const std::vector<float> &pl, float epsilon);
+                                  const std::vector<float> &pl, float epsilon,
+                                  int nbThreads = 1);
   static MatrixCreator createClique(const NetModel &topo,
-                                    const std::vector<float> &pl,
-                                    float epsilon);
+                                    const std::vector<float> &pl, float epsilon,
+                                    int nbThreads = 1);
   static MatrixCreator createLightStar(const NetModel &topo,
                                        const std::vector<float> &pl,
-                                       float epsilon);
+                                       float epsilon, int nbThreads = 1);
+
+  template <typename F>
+  static MatrixCreator createParallel(const NetModel &topo, int nbThreads,
+                                      const F &addNet);
 
   void addPenalty(const std::vector<float> &netPlacement,
                   const std::vector<float> &placementTarget,
@@ -306,6 +458,8 @@ class MatrixCreator {
 
   void finalize();
 
+  void append(const MatrixCreator &other);
+
  private:
   const NetModel &topo_;
   int nbCells_;
@@ -389,66 +543,114 @@ int MatrixCreator::addCell(float initialPos) {
 
 MatrixCreator MatrixCreator::create(const NetModel &topo,
                                     const std::vector<float> &pl, float epsilon,
-                                    NetModelOption netModel) {
+                                    NetModelOption netModel, int nbThreads) {
   if (netModel == NetModelOption::BoundToBound) {
-    return MatrixCreator::createB2B(topo, pl, epsilon);
+    return MatrixCreator::createB2B(topo, pl, epsilon, nbThreads);
   }
   if (netModel == NetModelOption::Star) {
-    return MatrixCreator::createStar(topo, pl, epsilon);
+    return MatrixCreator::createStar(topo, pl, epsilon, nbThreads);
   }
   if (netModel == NetModelOption::Clique) {
-    return MatrixCreator::createClique(topo, pl, epsilon);
+    return MatrixCreator::createClique(topo, pl, epsilon, nbThreads);
   }
 
-  return MatrixCreator::createLightStar(topo, pl, epsilon);
+  return MatrixCreator::createLightStar(topo, pl, epsilon, nbThreads);
 }
 
-MatrixCreator MatrixCreator::createStar(const NetModel &topo) {
-  MatrixCreator ret(topo);
-  for (int i = 0; i < topo.nbNets(); ++i) {
-    ret.addStar(i);
+template <typename F>
+MatrixCreator MatrixCreator::createParallel(const NetModel &topo,
+                                            int nbThreads, const F &addNet) {
+  int nbChunks = nbParallelChunks(nbThreads, topo.nbNets(), minNetsPerChunk);
+  if (nbChunks == 1) {
+    MatrixCreator ret(topo);
+    for (int i = 0; i < topo.nbNets(); ++i) {
+      addNet(ret, i);
+    }
+    return ret;
+  }
+  // Each thread builds the matrix of a contiguous range of nets. They are
+  // appended in net order, yielding the same triplets and additional cells as
+  // a sequential construction
+  std::vector<MatrixCreator> chunks;
+  chunks.reserve(nbChunks);
+  for (int c = 0; c < nbChunks; ++c) {
+    chunks.emplace_back(topo, 0);
+  }
+  parallelChunks(
+      nbThreads, topo.nbNets(),
+      [&](int c, int b, int e) {
+        MatrixCreator &chunk = chunks[c];
+        chunk.mat_.reserve(2 * (topo.netLimits_[e] - topo.netLimits_[b]));
+        for (int i = b; i < e; ++i) {
+          addNet(chunk, i);
+        }
+      },
+      minNetsPerChunk);
+  MatrixCreator ret(topo, topo.nbPins());
+  for (const MatrixCreator &chunk : chunks) {
+    ret.append(chunk);
   }
   return ret;
 }
 
+void MatrixCreator::append(const MatrixCreator &other) {
+  assert(nbCells_ == other.nbCells_);
+  // Renumber the additional cells after the existing ones
+  int offset = nbSupps_;
+  auto renumber = [this, offset](int c) {
+    return c < nbCells_ ? c : c + offset;
+  };
+  for (const Eigen::Triplet<float> &t : other.mat_) {
+    mat_.emplace_back(renumber(t.row()), renumber(t.col()), t.value());
+  }
+  for (int i = 0; i < nbCells_; ++i) {
+    rhs_[i] += other.rhs_[i];
+    initial_[i] += other.initial_[i];
+    hasNonZero_[i] |= other.hasNonZero_[i];
+  }
+  rhs_.insert(rhs_.end(), other.rhs_.begin() + nbCells_, other.rhs_.end());
+  initial_.insert(initial_.end(), other.initial_.begin() + nbCells_,
+                  other.initial_.end());
+  hasNonZero_.insert(hasNonZero_.end(), other.hasNonZero_.begin() + nbCells_,
+                     other.hasNonZero_.end());
+  nbSupps_ += other.nbSupps_;
+}
+
+MatrixCreator MatrixCreator::createStar(const NetModel &topo, int nbThreads) {
+  return createParallel(topo, nbThreads,
+                        [](MatrixCreator &m, int i) { m.addStar(i); });
+}
+
 MatrixCreator MatrixCreator::createStar(const NetModel &topo,
                                         const std::vector<float> &pl,
-                                        float epsilon) {
-  MatrixCreator ret(topo);
-  for (int i = 0; i < topo.nbNets(); ++i) {
-    ret.addStar(i, pl, epsilon);
-  }
-  return ret;
+                                        float epsilon, int nbThreads) {
+  return createParallel(topo, nbThreads, [&](MatrixCreator &m, int i) {
+    m.addStar(i, pl, epsilon);
+  });
 }
 
 MatrixCreator MatrixCreator::createB2B(const NetModel &topo,
                                        const std::vector<float> &pl,
-                                       float epsilon) {
-  MatrixCreator ret(topo);
-  for (int i = 0; i < topo.nbNets(); ++i) {
-    ret.addB2B(i, pl, epsilon);
-  }
-  return ret;
+                                       float epsilon, int nbThreads) {
+  return createParallel(topo, nbThreads, [&](MatrixCreator &m, int i) {
+    m.addB2B(i, pl, epsilon);
+  });
 }
 
 MatrixCreator MatrixCreator::createClique(const NetModel &topo,
                                           const std::vector<float> &pl,
-                                          float epsilon) {
-  MatrixCreator ret(topo);
-  for (int i = 0; i < topo.nbNets(); ++i) {
-    ret.addClique(i, pl, epsilon);
-  }
-  return ret;
+                                          float epsilon, int nbThreads) {
+  return createParallel(topo, nbThreads, [&](MatrixCreator &m, int i) {
+    m.addClique(i, pl, epsilon);
+  });
 }
 
 MatrixCreator MatrixCreator::createLightStar(const NetModel &topo,
                                              const std::vector<float> &pl,
-                                             float epsilon) {
-  MatrixCreator ret(topo);
-  for (int i = 0; i < topo.nbNets(); ++i) {
-    ret.addLightStar(i, pl, epsilon);
-  }
-  return ret;
+                                             float epsilon, int nbThreads) {
+  return createParallel(topo, nbThreads, [&](MatrixCreator &m, int i) {
+    m.addLightStar(i, pl, epsilon);
+  });
 }
 
 void MatrixCreator::addBipoint(int net) {
@@ -593,9 +795,18 @@ void MatrixCreator::finalize() {
   }
 }
 
-std::vector<float> MatrixCreator::solve(float tolerance, int maxIterations) {
+std::vector<float> MatrixCreator::solve(float tolerance, int maxIterations,
+                                        int nbThreads) {
   check();
   finalize();
+  if (nbParallelChunks(nbThreads, matSize(), minRowsPerChunk) > 1) {
+    Eigen::SparseMatrix<float, Eigen::RowMajor> mat(matSize(), matSize());
+    mat.setFromTriplets(mat_.begin(), mat_.end());
+    std::vector<float> ret = solveParallelCG(mat, rhs_, initial_, tolerance,
+                                             maxIterations, nbThreads);
+    ret.resize(nbCells_);
+    return ret;
+  }
   Eigen::SparseMatrix<float> mat(matSize(), matSize());
   mat.setFromTriplets(mat_.begin(), mat_.end());
   Eigen::Map<Eigen::Matrix<float, -1, 1> > rhs(rhs_.data(), rhs_.size());
@@ -622,22 +833,26 @@ void MatrixCreator::check() const {
 }
 
 std::vector<float> NetModel::solveStar(const Parameters &params) const {
-  MatrixCreator builder = MatrixCreator::createStar(*this);
-  return builder.solve(params.tolerance, params.maxNbIterations);
+  MatrixCreator builder = MatrixCreator::createStar(*this, params.nbThreads);
+  return builder.solve(params.tolerance, params.maxNbIterations,
+                       params.nbThreads);
 }
 
 std::vector<float> NetModel::solveStar(const std::vector<float> &placement,
                                        const Parameters &params) const {
-  MatrixCreator builder =
-      MatrixCreator::createStar(*this, placement, params.approximationDistance);
-  return builder.solve(params.tolerance, params.maxNbIterations);
+  MatrixCreator builder = MatrixCreator::createStar(
+      *this, placement, params.approximationDistance, params.nbThreads);
+  return builder.solve(params.tolerance, params.maxNbIterations,
+                       params.nbThreads);
 }
 
 std::vector<float> NetModel::solve(const std::vector<float> &netPlacement,
                                    const Parameters &params) const {
   MatrixCreator builder = MatrixCreator::create(
-      *this, netPlacement, params.approximationDistance, params.netModel);
-  return builder.solve(params.tolerance, params.maxNbIterations);
+      *this, netPlacement, params.approximationDistance, params.netModel,
+      params.nbThreads);
+  return builder.solve(params.tolerance, params.maxNbIterations,
+                       params.nbThreads);
 }
 
 std::vector<float> NetModel::solveWithPenalty(
@@ -645,10 +860,12 @@ std::vector<float> NetModel::solveWithPenalty(
     const std::vector<float> &placementTarget,
     const std::vector<float> &penaltyStrength, const Parameters &params) const {
   MatrixCreator builder = MatrixCreator::create(
-      *this, netPlacement, params.approximationDistance, params.netModel);
+      *this, netPlacement, params.approximationDistance, params.netModel,
+      params.nbThreads);
   builder.addPenalty(netPlacement, placementTarget, penaltyStrength,
                      params.penaltyCutoffDistance);
-  return builder.solve(params.tolerance, params.maxNbIterations);
+  return builder.solve(params.tolerance, params.maxNbIterations,
+                       params.nbThreads);
 }
 
 std::vector<float> NetModel::solveStar(
@@ -656,17 +873,19 @@ std::vector<float> NetModel::solveStar(
     const std::vector<float> &placementTarget,
     const std::vector<float> &penaltyStrength, const Parameters &params) const {
   MatrixCreator builder = MatrixCreator::createStar(
-      *this, netPlacement, params.approximationDistance);
+      *this, netPlacement, params.approximationDistance, params.nbThreads);
   builder.addPenalty(netPlacement, placementTarget, penaltyStrength,
                      params.penaltyCutoffDistance);
-  return builder.solve(params.tolerance, params.maxNbIterations);
+  return builder.solve(params.tolerance, params.maxNbIterations,
+                       params.nbThreads);
 }
 
 std::vector<float> NetModel::solveB2B(const std::vector<float> &placement,
                                       const Parameters &params) const {
-  MatrixCreator builder =
-      MatrixCreator::createB2B(*this, placement, params.approximationDistance);
-  return builder.solve(params.tolerance, params.maxNbIterations);
+  MatrixCreator builder = MatrixCreator::createB2B(
+      *this, placement, params.approximationDistance, params.nbThreads);
+  return builder.solve(params.tolerance, params.maxNbIterations,
+                       params.nbThreads);
 }
 
 std::vector<float> NetModel::solveB2B(const std::vector<float> &netPlacement,
@@ -674,9 +893,10 @@ std::vector<float> NetModel::solveB2B(const std::vector<float> &netPlacement,
                                       const std::vector<float> &penaltyStrength,
                                       const Parameters &params) const {
   MatrixCreator builder = MatrixCreator::createB2B(
-      *this, netPlacement, params.approximationDistance);
+      *this, netPlacement, params.approximationDistance, params.nbThreads);
   builder.addPenalty(netPlacement, placementTarget, penaltyStrength,
                      params.penaltyCutoffDistance);
-  return builder.solve(params.tolerance, params.maxNbIterations);
+  return builder.solve(params.tolerance, params.maxNbIterations,
+                       params.nbThreads);
 }
 }  // namespace coloquinte
\ No newline at end of file
@@ -20,6 +20,8 @@ class NetModel {
     float penaltyCutoffDistance;
     float tolerance;
     int maxNbIterations;
+    // Number of threads for matrix assembly and the conjugate gradient
+    int nbThreads;
 
     Parameters();
   };
@@ -80,6 +80,7 @@ GlobalPlacer::GlobalPlacer(Circuit &circuit, const ColoquinteParameters &params)
   legParams.unidimensionalTransport =
       rlp.unidimensionalTransport && m == LegalizationModel::L1;
   legParams.coarseningLimit = rlp.coarseningLimit;
+  legParams.nbThreads = params.global.nbThreads;
   if (m == LegalizationModel::L1 || m == LegalizationModel::L2 ||
       m == LegalizationModel::LInf) {
     float dist = leg_.placementArea().width() + leg_.placementArea().height();
@@ -204,8 +205,13 @@ void GlobalPlacer::runInitialLB() {
       params_.global.continuousModel.conjugateGradientErrorTolerance;
   params.maxNbIterations =
       params_.global.continuousModel.maxNbConjugateGradientSteps;
-  xPlacementLB_ = xtopo_.solveStar(params);
+  params.nbThreads = nbThreadsPerDirection();
+  // Solve x and y independently
+  std::future<std::vector<float> > x =
+      std::async(std::launch::async,
+                 [this, &params]() { return xtopo_.solveStar(params); });
   yPlacementLB_ = ytopo_.solveStar(params);
+  xPlacementLB_ = x.get();
   std::cout << std::defaultfloat << std::setprecision(4) << "#0:\tLB "
             << valueLB() << std::endl;
   callback(PlacementStep::LowerBound, xPlacementLB_, yPlacementLB_);
@@ -231,6 +237,7 @@ void GlobalPlacer::runLB() {
       params_.global.continuousModel.conjugateGradientErrorTolerance;
   params.maxNbIterations =
       params_.global.continuousModel.maxNbConjugateGradientSteps;
+  params.nbThreads = nbThreadsPerDirection();
 
   // Compute the per-cell penalty with randomization
   std::vector<float> penalty = computeIterationPerCellPenalty();
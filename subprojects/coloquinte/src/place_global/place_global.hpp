@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <random>
 #include <vector>
 
@@ -108,6 +109,14 @@ class GlobalPlacer {
     return params_.global.distanceTolerance * averageCellLength_;
   }
 
+  /**
+   * @brief Number of threads for each continuous model solve, as the x and y
+   * directions are solved concurrently
+   */
+  int nbThreadsPerDirection() const {
+    return std::max(1, params_.global.nbThreads / 2);
+  }
+
   /**
    * @brief Compute the penalty forces for this iteration
    */
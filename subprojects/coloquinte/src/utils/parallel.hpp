@@ -0,0 +1,48 @@
+#pragma once
+
+#include <algorithm>
+#include <future>
+#include <vector>
+
+#include "utils/helpers.hpp"
+
+namespace coloquinte {
+/**
+ * @brief Number of chunks used to split n elements between threads, so that
+ * each chunk has at least minChunkSize elements
+ */
+inline int nbParallelChunks(int nbThreads, int n, int minChunkSize = 1) {
+  int maxChunks = std::max(1, n / std::max(1, minChunkSize));
+  return std::max(1, std::min(nbThreads, maxChunks));
+}
+
+/**
+ * @brief Split [0, n) in contiguous chunks and call f(chunk, begin, end) on
+ * each of them from a separate thread
+ *
+ * The chunks only depend on the number of threads, so that per-chunk results
+ * can be combined in a deterministic order. The first chunk is handled by the
+ * calling thread. Exceptions are propagated to the caller.
+ */
+template <typename F>
+inline void parallelChunks(int nbThreads, int n, const F &f,
+                           int minChunkSize = 1) {
+  int nbChunks = nbParallelChunks(nbThreads, n, minChunkSize);
+  if (nbChunks == 1) {
+    f(0, 0, n);
+    return;
+  }
+  std::vector<int> limits = computeSubdivisions(0, n, nbChunks);
+  std::vector<std::future<void> > futures;
+  futures.reserve(nbChunks - 1);
+  for (int i = 1; i < nbChunks; ++i) {
+    futures.push_back(std::async(std::launch::async, [&f, &limits, i]() {
+      f(i, limits[i], limits[i + 1]);
+    }));
+  }
+  f(0, limits[0], limits[1]);
+  for (std::future<void> &fut : futures) {
+    fut.get();
+  }
+}
+}  // namespace coloquinte
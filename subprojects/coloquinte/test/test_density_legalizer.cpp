@@ -100,3 +100,37 @@ BOOST_AUTO_TEST_CASE(UnitArea) {
   pl.coarsenFully();
   pl.check();
 }
+
+BOOST_AUTO_TEST_CASE(Multithreaded) {
+  // Groups of bins are disjoint with the default parameters: the result must
+  // not depend on the number of threads
+  Rectangle area(0, 100, 0, 100);
+  int nbCells = 2000;
+  std::mt19937 rgen(1);
+  std::uniform_real_distribution<float> posDist(0.0f, 100.0f);
+  std::vector<int> cellDemand(nbCells, 4);
+  std::vector<float> cellTargetX;
+  std::vector<float> cellTargetY;
+  for (int i = 0; i < nbCells; ++i) {
+    cellTargetX.push_back(posDist(rgen));
+    cellTargetY.push_back(0.5f * posDist(rgen));
+  }
+  std::vector<DensityLegalizer> legs;
+  for (int nbThreads : {1, 4}) {
+    DensityLegalizer::Parameters params;
+    params.squareReoptSize = 2;
+    params.unidimensionalTransport = true;
+    params.nbThreads = nbThreads;
+    DensityGrid grid(5, area);
+    DensityLegalizer leg(grid, cellDemand, params);
+    leg.updateCellTargetX(cellTargetX);
+    leg.updateCellTargetY(cellTargetY);
+    leg.run();
+    leg.check();
+    legs.push_back(leg);
+  }
+  for (int i = 0; i < nbCells; ++i) {
+    BOOST_CHECK_EQUAL(legs[0].cellBinX(i), legs[1].cellBinX(i));
+    BOOST_CHECK_EQUAL(legs[0].cellBinY(i), legs[1].cellBinY(i));
+  }
+}
@@ -4,6 +4,7 @@
 #include <cmath>
 #include <iostream>
 #include <limits>
+#include <random>
 #include <stdexcept>
 #include <vector>
 
@@ -78,3 +79,34 @@ BOOST_AUTO_TEST_CASE(star_mid) {
   BOOST_CHECK_CLOSE(res[0], 2.0, 0.001);
   BOOST_CHECK_CLOSE(res[1], 3.0, 0.001);
 }
+
+BOOST_AUTO_TEST_CASE(multithreaded) {
+  // Large enough to be split between threads
+  int nbCells = 20000;
+  std::mt19937 rgen(1);
+  std::uniform_int_distribution<int> cellDist(0, nbCells - 1);
+  std::uniform_real_distribution<float> posDist(0.0f, 1000.0f);
+  NetModel model(nbCells);
+  for (int i = 0; i < nbCells; ++i) {
+    std::vector<int> cells = {cellDist(rgen), cellDist(rgen), cellDist(rgen)};
+    float pos = posDist(rgen);
+    model.addNet(cells, {0.0f, 0.0f, 0.0f}, pos, pos + 10.0f);
+  }
+  std::vector<float> place;
+  for (int i = 0; i < nbCells; ++i) {
+    place.push_back(posDist(rgen));
+  }
+  for (NetModelOption option :
+       {NetModelOption::BoundToBound, NetModelOption::Star,
+        NetModelOption::Clique, NetModelOption::LightStar}) {
+    NetModel::Parameters params;
+    params.netModel = option;
+    params.tolerance = 1.0e-6;
+    params.maxNbIterations = 1000;
+    auto seq = model.solve(place, params);
+    params.nbThreads = 4;
+    auto par = model.solve(place, params);
+    BOOST_CHECK_EQUAL(seq.size(), par.size());
+    BOOST_CHECK_CLOSE(model.value(seq), model.value(par), 0.1);
+  }
+}
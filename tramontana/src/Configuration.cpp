@@ -50,11 +50,14 @@ namespace Tramontana {
   Configuration::Configuration ()
     : _mergeSupplies      ( Cfg::getParamBool("tramontana.mergeSupplies"      , false)->asBool() )
     , _instancesPerWindows( Cfg::getParamInt ("tramontana.instancesPerWindows", 10000)->asInt () )
+    , _threads            ( std::max( 1, Cfg::getParamInt("tramontana.threads", 1)->asInt() ))
   { }
 
 
   Configuration::Configuration ( const Configuration& other )
-    : _mergeSupplies( other._mergeSupplies )
+    : _mergeSupplies      ( other._mergeSupplies )
+    , _instancesPerWindows( other._instancesPerWindows )
+    , _threads            ( other._threads )
   { }
 
 
@@ -69,6 +72,7 @@ namespace Tramontana {
   {
     cmess1 << "  o  Configuration of ToolEngine<Tramontana> for Cell <" << cell->getName() << ">" << endl;
     cmess1 << Dots::asBool( "     - Merge supplies" ,_mergeSupplies ) << endl;
+    cmess1 << Dots::asUInt( "     - Threads"        ,_threads       ) << endl;
   }
 
 
@@ -91,6 +95,7 @@ namespace Tramontana {
     Record* record = new Record ( _getString() );
     record->add( getSlot( "_mergeSupplies"      , _mergeSupplies       ) );
     record->add( getSlot( "_instancesPerWindows", _instancesPerWindows ) );
+    record->add( getSlot( "_threads"            , _threads             ) );
     return record;
   }
 
@@ -17,6 +17,10 @@
 
 
 #include <iomanip>
+#include <atomic>
+#include <limits>
+#include <mutex>
+#include <thread>
 #include "hurricane/utilities/Path.h"
 #include "hurricane/DebugSession.h"
 #include "hurricane/UpdateSession.h"
@@ -37,8 +41,10 @@
 #include "hurricane/Vertical.h"
 #include "hurricane/Horizontal.h"
 #include "hurricane/RoutingPad.h"
+#include "hurricane/ParallelQuery.h"
 #include "crlcore/Utilities.h"
 #include "crlcore/ToolBox.h"
+#include "crlcore/Progress.h"
 #include "tramontana/SweepLine.h"
 #include "tramontana/QueryTiles.h"
 
@@ -68,6 +74,7 @@ namespace Tramontana {
   using Hurricane::Error;
   using Hurricane::Warning;
   using Hurricane::Breakpoint;
+  using Hurricane::Timer;
   using Hurricane::Interval;
   using Hurricane::Box;
   using Hurricane::DataBase;
@@ -80,6 +87,8 @@ namespace Tramontana {
   using Hurricane::RoutingPad;
   using Hurricane::Cell;
   using Hurricane::Instance;
+  using Hurricane::ParallelQuery;
+  using CRL::Progress;
 
 
 // -------------------------------------------------------------------
@@ -88,12 +97,16 @@ namespace Tramontana {
 
   SweepLine::SweepLine ( TramontanaEngine* tramontana  )
     : _tramontana   (tramontana) 
+    , _pool         ()
     , _tiles        ()
     , _intervalTrees()
     , _slidingWindow()
     , _lastLeftEdge (nullptr)
     , _splitCount   (0)
     , _flags        (0)
+    , _slabs        ()
+    , _merges       ()
+    , _stitches     ()
   {
     for ( const BasicLayer* layer : getExtracteds() ) {
       _intervalTrees.insert( make_pair( layer->getMask(), TileIntvTree() ));
@@ -103,12 +116,39 @@ namespace Tramontana {
   }
 
 
+  SweepLine::SweepLine ( TramontanaEngine* tramontana, uint32_t idBase )
+    : _tramontana   (tramontana) 
+    , _pool         ()
+    , _tiles        ()
+    , _intervalTrees()
+    , _slidingWindow()
+    , _lastLeftEdge (nullptr)
+    , _splitCount   (0)
+    , _flags        (IsSlab)
+    , _slabs        ()
+    , _merges       ()
+    , _stitches     ()
+  {
+    for ( const BasicLayer* layer : getExtracteds() ) {
+      _intervalTrees.insert( make_pair( layer->getMask(), TileIntvTree() ));
+    }
+    _pool.rebase( idBase );
+  }
+
+
   SweepLine::~SweepLine ()
-  { }
+  {
+    for ( SweepLine* slab : _slabs ) delete slab;
+  }
   
 
   void  SweepLine::run ( bool isTopLevel )
   {
+    if (_splitCount and (_tramontana->getThreads() > 1)) {
+      _runParallel( isTopLevel );
+      return;
+    }
+
     UpdateSession::open();
     // if (getCell()->getName() == "a2_x2")
     //   DebugSession::open( 160, 169 );
@@ -117,6 +157,9 @@ namespace Tramontana {
     Interval  sweepSpan  = Interval( ab.getXMin(), ab.getXMax() );
     size_t    processeds = 0;
     DbU::Unit xSweepLine = sweepSpan.getVMin();
+    Progress  progress   ( "SweepLine" );
+    size_t    tiles      = progress.addCounter( "tiles" );
+    size_t    percent    = progress.addCounter( "%" );
     
     loadNextWindow();
     do {
@@ -133,17 +176,11 @@ namespace Tramontana {
           
           if (tile->getLeftEdge() != xSweepLine) {
             xSweepLine = tile->getLeftEdge();
-            if (tty::enabled()) {
-              DbU::Unit progress = ((xSweepLine - sweepSpan.getVMin()) * 100) / sweepSpan.getSize();
-              cmess2 << "        <SweepLine @" << tty::bold
-                     << right << setw(12) << DbU::getValueString(xSweepLine,DbU::Physical) << " | "
-                     << right << setw( 3) << progress << "%"
-                     << tty::reset
-                     << setfill(' ') << tty::reset << ">" << tty::cr;
-              cmess2.flush ();
-            }
+            progress.set( percent, ((xSweepLine - sweepSpan.getVMin()) * 100) / sweepSpan.getSize() );
           }
         }
+        progress.inc( tiles );
+        progress.tick();
         
         cdebug_log(160,1) << "X@ + " << DbU::getValueString(_tiles[processeds].getX()) << " " << tile << endl;
         auto  intvTree = _intervalTrees.find( _tiles[processeds].getMask() );
@@ -193,17 +230,17 @@ namespace Tramontana {
         tile->getRoot( Tile::Compress|Tile::MergeEqui );
       }
       _tiles.erase( _tiles.begin(), _tiles.begin() + processeds );
-      Tile::destroyQueued();
-      cdebug_log(160,0) << "  -> Freeds " << Tile::getFreedIds().size() << endl;
+      _pool.destroyQueued();
+      cdebug_log(160,0) << "  -> Freeds " << _pool.getFreedsCount() << endl;
       processeds = 0;
       loadNextWindow();
     } while ( processeds < _tiles.size() );
     
-    if (tty::enabled()) cmess2 << endl;
+    progress.finish();
     cdebug_tabw(160,-1);
     mergeEquipotentials( Tile::MakeLeafEqui );
     if (isTopLevel) printSummary();
-    Tile::deleteAllTiles();
+    _pool.deleteAllTiles();
     // if (getCell()->getName() == "a2_x2")
     //   DebugSession::close();
     UpdateSession::close();
@@ -214,7 +251,7 @@ namespace Tramontana {
   {
     cdebug_log(160,1) << "SweepLine::loadNextWindow()" << endl;
 
-    size_t    tilesCount = Tile::activeTilesCount();
+    size_t    tilesCount = _pool.activeTilesCount();
     Box       bb         = getCell()->getBoundingBox();
     DbU::Unit sliceWidth = bb.getWidth() / (_splitCount + 1);
     _lastLeftEdge = nullptr;
@@ -249,6 +286,239 @@ namespace Tramontana {
   }
 
 
+// The pool of each thread gets it's own range of tile ids, so the ids
+// stay unique across the pools without rebasing the live tiles.
+  void  SweepLine::_runParallel ( bool isTopLevel )
+  {
+    UpdateSession::open();
+    cdebug_log(160,1) << "SweepLine::_runParallel()" << endl;
+    ParallelQuery::Frozens packeds;
+    ParallelQuery::freeze( getCell(), &packeds );
+
+    Box                bb        = getCell()->getBoundingBox();
+    uint32_t           threads   = _tramontana->getThreads();
+    uint32_t           slabCount = std::max( _splitCount+1, threads );
+    uint32_t           idRange   = std::numeric_limits<uint32_t>::max() / threads;
+    vector<DbU::Unit>  xs;
+    for ( uint32_t i=0 ; i<=slabCount ; ++i )
+      xs.push_back( bb.getXMin() + (bb.getWidth() * (DbU::Unit)i) / slabCount );
+    for ( uint32_t i=0 ; i<threads ; ++i )
+      _slabs.push_back( new SweepLine( _tramontana, i*idRange ));
+
+    vector<Tile*>  boundaries;
+    for ( uint32_t first=0 ; first<slabCount ; first+=threads ) {
+      uint32_t count = std::min( threads, slabCount-first );
+      for ( uint32_t i=0 ; i<count ; ++i ) {
+        SweepLine* slab = _slabs[i];
+        slab->_slidingWindow = Box( xs[first+i], bb.getYMin(), xs[first+i+1], bb.getYMax() );
+        slab->_flags         = IsSlab;
+        if (first+i   == 0        ) slab->_flags |= IsLeftMostWindow;
+        if (first+i+1 == slabCount) slab->_flags |= IsRightMostWindow;
+      }
+      _runSlabs( &SweepLine::_loadSlab, count );
+      for ( uint32_t i=0 ; i<count ; ++i ) {
+        if (_slabs[i]->_pool.getSize() >= idRange)
+          throw Error( "SweepLine::_runParallel(): Tile ids overflow in slab %u.", first+i );
+      }
+
+    // Give to each slab the tiles of the others reaching it's span, that
+    // is, the boundary tiles of the previous waves and the tiles of this
+    // one going out of their slab. Spans are closed intervals, as abutting
+    // tiles are connected, the outer ones are unbounded.
+      vector<Tile*>  crossings = boundaries;
+      for ( uint32_t i=0 ; i<count ; ++i ) {
+        bool leftMost  = (first+i   == 0        );
+        bool rightMost = (first+i+1 == slabCount);
+        for ( const Element& element : _slabs[i]->_tiles ) {
+          if (not element.isLeftEdge() or element.isForeign()) continue;
+          Tile* tile = element.getTile();
+          if (    (leftMost  or (tile->getLeftEdge () > xs[first+i  ]))
+              and (rightMost or (tile->getRightEdge() < xs[first+i+1])) ) continue;
+          crossings.push_back( tile );
+        }
+      }
+      for ( Tile* tile : crossings ) {
+        for ( uint32_t j=0 ; j<count ; ++j ) {
+          if ((tile->getPool() == &_slabs[j]->_pool) and not tile->isBoundary()) continue;
+          if ((first+j   > 0        ) and (tile->getRightEdge() < xs[first+j  ])) continue;
+          if ((first+j+1 < slabCount) and (tile->getLeftEdge () > xs[first+j+1])) continue;
+          _slabs[j]->_addForeign( tile );
+        }
+      }
+      _runSlabs( &SweepLine::_sweepSlab, count );
+
+      cdebug_log(160,0) << "Replaying slabs merges & stitches." << endl;
+      Tile::timeTick();
+      for ( uint32_t i=0 ; i<count ; ++i ) {
+        for ( auto& merge : _slabs[i]->_merges ) merge.first->merge( merge.second );
+      }
+      for ( uint32_t i=0 ; i<count ; ++i ) {
+        for ( auto& stitch : _slabs[i]->_stitches ) stitch.first->merge( stitch.second );
+      }
+
+    // Release all the tiles that cannot reach the next waves.
+      DbU::Unit      nextEdge  = (first+count < slabCount) ? xs[first+count] : DbU::Max;
+      vector<Tile*>  releaseds;
+      vector<Tile*>  keeps;
+      for ( Tile* tile : boundaries ) {
+        if (tile->getRightEdge() >= nextEdge) keeps    .push_back( tile );
+        else                                  releaseds.push_back( tile );
+      }
+      for ( uint32_t i=0 ; i<count ; ++i ) {
+        SweepLine* slab = _slabs[i];
+        for ( const Element& element : slab->_tiles ) {
+          if (not element.isLeftEdge() or element.isForeign()) continue;
+          Tile* tile = element.getTile();
+          if (tile->getRightEdge() >= nextEdge) {
+            tile->setBoundary( true );
+            keeps.push_back( tile );
+          } else
+            releaseds.push_back( tile );
+        }
+        slab->_tiles   .clear();
+        slab->_merges  .clear();
+        slab->_stitches.clear();
+      }
+      boundaries.swap( keeps );
+
+      Tile::timeTick();
+      for ( Tile* tile : releaseds ) {
+        tile->setBoundary( false );
+        tile->decRefCount();
+        tile->decRefCount();
+      }
+      for ( Tile* tile : releaseds ) {
+        if (tile->isFreed()) continue;
+        tile->getRoot( Tile::Compress|Tile::MergeEqui );
+      }
+      _destroyQueued();
+    }
+
+    cdebug_tabw(160,-1);
+    mergeEquipotentials( Tile::MakeLeafEqui );
+    if (isTopLevel) printSummary();
+    for ( SweepLine* slab : _slabs ) {
+      slab->_pool.deleteAllTiles();
+      delete slab;
+    }
+    _slabs.clear();
+    ParallelQuery::unfreeze( packeds );
+    UpdateSession::close();
+  }
+
+
+  void  SweepLine::_runSlabs ( void (SweepLine::* method)(), size_t count )
+  {
+    std::atomic<size_t>  next      ( 0 );
+    std::mutex           errorLock;
+    string               error;
+
+    auto worker = [&] () {
+      try {
+        while ( true ) {
+          size_t islab = next++;
+          if (islab >= count) break;
+          (_slabs[islab]->*method)();
+        }
+      }
+      catch ( std::exception& e ) {
+        std::lock_guard<std::mutex> guard ( errorLock );
+        if (error.empty()) error = e.what();
+        next = count;
+      }
+    };
+
+    vector<std::thread>  threads;
+    for ( size_t i=0 ; i<count ; ++i )
+      threads.push_back( std::thread( worker ) );
+    for ( std::thread& thread : threads ) thread.join();
+
+    if (not error.empty())
+      throw Error( "SweepLine::_runParallel(): A slab worker failed.\n%s", error.c_str() );
+  }
+
+
+  void  SweepLine::_loadSlab ()
+  {
+    QueryTiles::doAreaQuery( this, _slidingWindow );
+  }
+
+
+// Runs concurrently with the other slabs, so only the tiles of the
+// own pool are touched. Their connexity is computed in a local
+// union-find (over ids shifted to the pool base), and only the merges
+// between distinct sets are recorded. Pairs involving a foreign tile
+// (including the boundary tiles of the previous waves still living
+// in the pool) are all recorded as stitches.
+  void  SweepLine::_sweepSlab ()
+  {
+    sort( _tiles.begin(), _tiles.end() );
+
+    uint32_t          base    = _pool.getIdBase();
+    vector<uint32_t>  parents ( _pool.getSize() );
+    for ( uint32_t i=0 ; i<parents.size() ; ++i ) {
+      Tile* tile   = _pool.getTileAt(i);
+      Tile* parent = (tile and not tile->isBoundary()) ? tile->getParent() : nullptr;
+      parents[i] = (parent and (parent->getPool() == &_pool)) ? parent->getId() - base : i;
+    }
+    auto findRoot = [&] ( uint32_t i ) {
+      while ( parents[i] != i ) {
+        parents[i] = parents[ parents[i] ];
+        i = parents[i];
+      }
+      return i;
+    };
+
+    for ( const Element& element : _tiles ) {
+      Tile*     tile     = element.getTile();
+      TileIntv  tileIntv ( tile, tile->getYMin(), tile->getYMax() );
+      auto      intvTree = _intervalTrees.find( element.getMask() );
+      if (intvTree == _intervalTrees.end()) {
+        cerr << Error( "SweepLine::_sweepSlab(): Missing interval tree for layer(mask) %s."
+                       "        (for tile: %s)"
+                     , getString(element.getMask()).c_str()
+                     , getString(tile).c_str()
+                     ) << endl;
+        continue;
+      }
+      if (not element.isLeftEdge()) {
+        intvTree->second.remove( tileIntv );
+        continue;
+      }
+
+      for ( const TileIntv& overlap : intvTree->second.getOverlaps(
+                                         Interval(tile->getYMin(), tile->getYMax() ))) {
+        Tile* other = overlap.getData();
+        if (element.isForeign() or (other->getPool() != &_pool) or other->isBoundary()) {
+          _stitches.push_back( make_pair( tile, other ));
+          continue;
+        }
+        uint32_t root1 = findRoot( tile ->getId() - base );
+        uint32_t root2 = findRoot( other->getId() - base );
+        if (root1 == root2) continue;
+        parents[ root2 ] = root1;
+        _merges.push_back( make_pair( tile, other ));
+      }
+      intvTree->second.insert( tileIntv );
+    }
+  }
+
+
+  vector<TilePool*>  SweepLine::_getPools ()
+  {
+    vector<TilePool*>  pools;
+    if (_slabs.empty()) pools.push_back( &_pool );
+    for ( SweepLine* slab : _slabs ) pools.push_back( &slab->_pool );
+    return pools;
+  }
+
+
+  void  SweepLine::_destroyQueued ()
+  {
+    for ( TilePool* pool : _getPools() ) pool->destroyQueued();
+  }
+
+
   void  SweepLine::mergeEquipotentials ( uint32_t flags )
   {
     cout.flush();
@@ -256,23 +526,41 @@ namespace Tramontana {
   //DebugSession::open( 160, 169 );
     cdebug_log(160,1) << "SweepLine::mergeEquipotentials()" << endl;
     Tile::timeTick();
-    const vector<Tile*>& tiles = Tile::getAllTiles();
-    for ( size_t i=0 ; i<tiles.size() ; ++i ) {
-      if (not tiles[i]) continue;
-      tiles[i]->getRoot( Tile::Compress|Tile::MergeEqui|flags );
-      Tile::destroyQueued();
+  // A freed tile has no child left, and is already merged, so it can
+  // be skipped and the queue only destroyed once per pool.
+    for ( TilePool* pool : _getPools() ) {
+      for ( uint32_t i=0 ; i<pool->getSize() ; ++i ) {
+        Tile* tile = pool->getTileAt( i );
+        if (not tile or tile->isFreed()) continue;
+        tile->getRoot( Tile::Compress|Tile::MergeEqui|flags );
+      }
+      _destroyQueued();
     }
     cdebug_tabw(160,-1);
-  //Tile::showStats();
+  //_pool.showStats();
   //DebugSession::close();
   }
 
 
   void  SweepLine::printSummary () const
   {
-    cmess2 << Dots::asUInt("        - Windows"    , _splitCount+1          ) << endl;
-    cmess2 << Dots::asUInt("        - Peak tiles" , Tile::peakTilesCount ()) << endl;
-    cmess2 << Dots::asUInt("        - Total tiles", Tile::totalTilesCount()) << endl;
+    size_t peakTiles  = _pool.peakTilesCount ();
+    size_t totalTiles = _pool.totalTilesCount();
+    size_t memory     = _pool.getMemorySize  ();
+    for ( const SweepLine* slab : _slabs ) {
+      peakTiles  += slab->_pool.peakTilesCount ();
+      totalTiles += slab->_pool.totalTilesCount();
+      memory     += slab->_pool.getMemorySize  ();
+    }
+    if (_slabs.empty())
+      cmess2 << Dots::asUInt("        - Windows"    , _splitCount+1 ) << endl;
+    else {
+      cmess2 << Dots::asUInt("        - Slabs"      , _slabs.size() ) << endl;
+      cmess2 << Dots::asUInt("        - Threads"    , _tramontana->getThreads()) << endl;
+    }
+    cmess2 << Dots::asUInt("        - Peak tiles" , peakTiles       ) << endl;
+    cmess2 << Dots::asUInt("        - Total tiles", totalTiles      ) << endl;
+    cmess2 << Dots::asString("        - Tiles memory", Timer::getStringMemory(memory)) << endl;
   }
 
 
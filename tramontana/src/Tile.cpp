@@ -97,20 +97,18 @@ namespace Tramontana {
 // Class  :  "Tramontana::Tile".
 
 
-  uint32_t        Tile::_time      = 0;
-  vector<Tile*>   Tile::_allocateds;
-  vector<Tile*>   Tile::_destroyQueue;
-  vector<size_t>  Tile::_freeds;
-  size_t          Tile::_peakTiles  = 0;
-  size_t          Tile::_totalTiles = 0;
+  uint32_t  Tile::_time = 0;
 
 
   Tile::Tile (       Occurrence  occurrence
              ,       Occurrence  deepOccurrence
              , const BasicLayer* layer
              , const Box&        boundingBox
-             ,       Tile*       parent )
-    : _id            (0)
+             ,       Tile*       parent
+             ,       TilePool*   pool
+             ,       uint32_t    id )
+    : _pool          (pool)
+    , _id            (id)
     , _refCount      (0)
     , _occurrence    (occurrence) 
     , _deepOccurrence(deepOccurrence) 
@@ -122,16 +120,6 @@ namespace Tramontana {
     , _rank          (0)
     , _timeStamp     (0)
   {
-    _totalTiles++;
-    if (not _freeds.empty()) {
-      _id = _freeds.back();
-      _freeds.pop_back();
-      _allocateds[ _id ] = this;
-    } else {
-      _id = _allocateds.size();
-      _allocateds.push_back( this );
-      _peakTiles++;
-    }
     if (_parent) _parent->incRefCount();
 
     if (occurrence.getPath().isEmpty()) {
@@ -209,7 +197,7 @@ namespace Tramontana {
                        "        On: %s"
                      , getString(occurrence).c_str() );
         }
-        Tile* tile = new Tile ( childEqui, occurrence, layer, bb, rootTile );
+        Tile* tile = sweepLine->getTilePool()->_create( childEqui, occurrence, layer, bb, rootTile );
         sweepLine->add( tile );
         cdebug_log(165,0) << "| " << tile << endl;
         if (not rootTile) rootTile = tile;
@@ -227,7 +215,7 @@ namespace Tramontana {
                  "        On: %s"
                  , getString(occurrence).c_str() );
     }
-    Tile* tile = new Tile ( childEqui, occurrence, layer, bb, rootTile );
+    Tile* tile = sweepLine->getTilePool()->_create( childEqui, occurrence, layer, bb, rootTile );
     sweepLine->add( tile );
 
   //cerr << "Tile::create() " << (void*)tile << ":" << tile << endl;
@@ -242,20 +230,7 @@ namespace Tramontana {
     if (_parent) _parent->decRefCount();
     _flags |= Freed;
     cdebug_log(165,0) << "Tile::destroy() " << this << endl;
-    _destroyQueue.push_back( this );
-  }
-
-
-  void  Tile::destroyQueued ()
-  {
-
-    for ( Tile* tile : _destroyQueue ) {
-      _allocateds[ tile->getId() ] = nullptr;
-      _freeds.push_back( tile->getId() );
-    //cerr << "Tile::destroyQueued() " << (void*)tile << ":" << tile << endl;
-      delete tile;
-    }
-    _destroyQueue.clear();
+    _pool->_queue( this );
   }
 
 
@@ -263,65 +238,6 @@ namespace Tramontana {
   { }
 
 
-  void  Tile::deleteAllTiles ()
-  {
-    int64_t delCount = 0;
-    for ( Tile* tile : _allocateds) {
-      if (tile) delCount++;
-      delete tile;
-    }
-    int64_t delta = (int64_t)_allocateds.size() - (int64_t)_freeds.size() - delCount;
-    if (delta < 0) {
-      cerr << Error( "Tile::deleteAllTiles(): Delete more tiles than allocated, brace for a crash.\n"
-                     "        Has allocateds %lu, freed %lu in excess of %ld."
-                   , _allocateds.size(), _freeds.size(), delCount-_freeds.size()
-                   ) << endl;
-    }
-    if (delta > 0) {
-      cerr << Error( "Tile::deleteAllTiles(): Delete less tiles than allocated, memory leak.\n"
-                     "        Has allocateds %lu, freed %lu short of %ld."
-                   , _allocateds.size(), _freeds.size(), _freeds.size()-delCount
-                   ) << endl;
-    }
-    _allocateds.clear();
-    _freeds.clear();
-    _peakTiles  = 0;
-    _totalTiles = 0;
-  }
-
-
-  void  Tile::showStats ()
-  {
-    size_t roots        = 0;
-    size_t childs       = 0;
-    size_t mergedChilds = 0;
-    size_t nullRefCount = 0;
-    size_t nonFreeds    = 0;
-    for ( Tile* tile : _allocateds ) {
-      if (not tile) continue;
-      if (tile->getParent()) {
-        childs++;
-        if (tile->isOccMerged())
-          mergedChilds++;
-      } else
-        roots++;
-      if (tile->getRefCount() == 0) {
-        nullRefCount++;
-        if (not tile->isFreed() and tile->isOccMerged())
-          nonFreeds++;
-      }
-    }
-    cerr << "\n        o  Tile statistics:" << endl;
-    cerr << Dots::asUInt("           - Roots"           , roots             ) << endl;
-    cerr << Dots::asUInt("           - Childs"          , childs            ) << endl;
-    cerr << Dots::asUInt("           - Merged childs"   , mergedChilds      ) << endl;
-    cerr << Dots::asUInt("           - Null refcount"   , nullRefCount      ) << endl;
-    cerr << Dots::asUInt("           - Non freeds"      , nonFreeds         ) << endl;
-    cerr << Dots::asUInt("           - Total allocateds", _allocateds.size()) << endl;
-    cerr << Dots::asUInt("           - Freed"           , _freeds.size()    ) << endl;
-  }
-
-
   Tile* Tile::getRoot ( uint32_t flags )
   {
     cdebug_log(165,1) << "Tile::getRoot() " << this << endl;
@@ -488,7 +404,8 @@ namespace Tramontana {
     cerr << tag << endl;
     cerr << "  Tile::check() " << this << endl;
     size_t childCount = 0;
-    for ( const Tile* tile : _allocateds ) {
+    for ( uint32_t i=0 ; i<_pool->getSize() ; ++i ) {
+      const Tile* tile = _pool->getTileAt( i );
       if (not tile) continue;
       if (tile->getParent() and (tile->getParent() == this)) {
         cerr << "    | child " << tile << endl;
@@ -534,4 +451,139 @@ namespace Tramontana {
   }
 
 
+// -------------------------------------------------------------------
+// Class  :  "Tramontana::TilePool".
+
+
+  TilePool::TilePool ()
+    : _idBase      (0)
+    , _chunks      ()
+    , _lives       ()
+    , _destroyQueue()
+    , _freeds      ()
+    , _totalTiles  (0)
+  { }
+
+
+  TilePool::~TilePool ()
+  {
+    deleteAllTiles();
+  }
+
+
+  Tile* TilePool::_create (       Occurrence  occurrence
+                          ,       Occurrence  deepOccurrence
+                          , const BasicLayer* layer
+                          , const Box&        boundingBox
+                          ,       Tile*       parent )
+  {
+    uint32_t index = 0;
+    if (not _freeds.empty()) {
+      index = _freeds.back();
+      _freeds.pop_back();
+    } else {
+      index = _lives.size();
+      if ((index & (ChunkSize-1)) == 0)
+        _chunks.push_back( static_cast<Tile*>( ::operator new ( ChunkSize*sizeof(Tile) )));
+      _lives.push_back( 0 );
+    }
+    Tile* tile = new ( _getSlot(index) ) Tile ( occurrence, deepOccurrence, layer, boundingBox
+                                              , parent, this, _idBase+index );
+    _lives[ index ] = 1;
+    _totalTiles++;
+    return tile;
+  }
+
+
+  void  TilePool::rebase ( uint32_t base )
+  {
+    for ( uint32_t i=0 ; i<getSize() ; ++i ) {
+      Tile* tile = getTileAt( i );
+      if (tile) tile->_id = base + i;
+    }
+    _idBase = base;
+  }
+
+
+  void  TilePool::destroyQueued ()
+  {
+    for ( Tile* tile : _destroyQueue ) {
+      uint32_t index = tile->getId() - _idBase;
+    //cerr << "TilePool::destroyQueued() " << (void*)tile << ":" << tile << endl;
+      tile->~Tile();
+      _lives [ index ] = 0;
+      _freeds.push_back( index );
+    }
+    _destroyQueue.clear();
+  }
+
+
+  void  TilePool::deleteAllTiles ()
+  {
+    size_t delCount = 0;
+    for ( uint32_t i=0 ; i<getSize() ; ++i ) {
+      Tile* tile = getTileAt( i );
+      if (not tile) continue;
+      tile->~Tile();
+      delCount++;
+    }
+    if (delCount + _freeds.size() != _lives.size()) {
+      cerr << Error( "TilePool::deleteAllTiles(): Tile slots accounting mismatch.\n"
+                     "        Has slots %lu, freed %lu, deleted %lu."
+                   , _lives.size(), _freeds.size(), delCount
+                   ) << endl;
+    }
+    for ( Tile* chunk : _chunks ) ::operator delete ( chunk );
+    _chunks      .clear();
+    _lives       .clear();
+    _destroyQueue.clear();
+    _freeds      .clear();
+    _idBase     = 0;
+    _totalTiles = 0;
+  }
+
+
+  size_t  TilePool::getMemorySize () const
+  {
+    return _chunks      .size    () * ChunkSize * sizeof(Tile)
+         + _chunks      .capacity() * sizeof(Tile*)
+         + _lives       .capacity() * sizeof(uint8_t)
+         + _destroyQueue.capacity() * sizeof(Tile*)
+         + _freeds      .capacity() * sizeof(uint32_t);
+  }
+
+
+  void  TilePool::showStats () const
+  {
+    size_t roots        = 0;
+    size_t childs       = 0;
+    size_t mergedChilds = 0;
+    size_t nullRefCount = 0;
+    size_t nonFreeds    = 0;
+    for ( uint32_t i=0 ; i<getSize() ; ++i ) {
+      const Tile* tile = getTileAt( i );
+      if (not tile) continue;
+      if (tile->getParent()) {
+        childs++;
+        if (tile->isOccMerged())
+          mergedChilds++;
+      } else
+        roots++;
+      if (tile->getRefCount() == 0) {
+        nullRefCount++;
+        if (not tile->isFreed() and tile->isOccMerged())
+          nonFreeds++;
+      }
+    }
+    cerr << "\n        o  Tile statistics:" << endl;
+    cerr << Dots::asUInt("           - Roots"           , roots             ) << endl;
+    cerr << Dots::asUInt("           - Childs"          , childs            ) << endl;
+    cerr << Dots::asUInt("           - Merged childs"   , mergedChilds      ) << endl;
+    cerr << Dots::asUInt("           - Null refcount"   , nullRefCount      ) << endl;
+    cerr << Dots::asUInt("           - Non freeds"      , nonFreeds         ) << endl;
+    cerr << Dots::asUInt("           - Total allocateds", _lives.size()      ) << endl;
+    cerr << Dots::asUInt("           - Freed"           , _freeds.size()    ) << endl;
+  }
+
+
 } // Tramontana namespace.
@@ -42,13 +42,30 @@ namespace Tramontana {
 
 // -------------------------------------------------------------------
 // Class  :  "Tramontana::SweepLine".
+//
+// When more than one thread is configured, and the cell is big enough
+// to be cut in more than one window, the windows becomes independant
+// vertical slabs. They are processed by waves of one slab per thread,
+// each thread reusing the same SweepLine (TilePool and interval trees)
+// from one wave to the next. The slabs of a wave are loaded then swept
+// concurrently, the sweep of a slab only computing the connexity of
+// it's tiles in a local union-find and recording the pairs of tiles
+// actually merged. The tiles of other slabs overlapping it are swept
+// alongside so the pairs crossing the slab boundaries are recorded too
+// (stitches). Then the recorded merges are replayed sequentially with
+// Tile::merge(), which builds the Equipotentials and is not thread-safe.
+// Only the tiles reaching the next waves (boundary tiles) are kept, to
+// be swept again as foreign tiles, the others are released. So the
+// peak number of tiles is the one of a wave, not the whole cell's.
 
   class SweepLine {
     private:
-      typedef  std::map<Layer::Mask, TileIntvTree>  IntervalTrees;
+      typedef  std::map<Layer::Mask, TileIntvTree>   IntervalTrees;
+      typedef  std::vector< std::pair<Tile*,Tile*> >  TilePairs;
     private:
       const uint32_t IsLeftMostWindow    = (1 << 0);
       const uint32_t IsRightMostWindow   = (1 << 1);
+      const uint32_t IsSlab              = (1 << 2);
     private:
       class Element {
         public:
@@ -56,6 +73,7 @@ namespace Tramontana {
           inline bool         operator<  ( const Element& ) const;
           inline bool         operator== ( const Element& ) const;
           inline bool         isLeftEdge () const;
+          inline bool         isForeign  () const;
           inline Tile*        getTile    () const;
           inline DbU::Unit    getX       () const;
           inline DbU::Unit    getY       () const;
@@ -70,7 +88,9 @@ namespace Tramontana {
                                ~SweepLine           ();
       inline  bool              isLeftMostWindow    () const;
       inline  bool              isRightMostWindow   () const;
+      inline  bool              isSlab              () const;
       inline  Cell*             getCell             ();
+      inline  TilePool*         getTilePool         ();
       inline  const std::vector<const BasicLayer*>&
                                 getExtracteds       () const;
       inline  Layer::Mask       getExtractedMask    () const;
@@ -85,16 +105,29 @@ namespace Tramontana {
               std::string       _getString          () const;
               std::string       _getTypeName        () const;
     private:                                        
+                                SweepLine           ( TramontanaEngine*, uint32_t idBase );
+              void              _runParallel        ( bool isTopLevel );
+              void              _runSlabs           ( void (SweepLine::*)(), size_t count );
+              void              _loadSlab           ();
+              void              _sweepSlab          ();
+      inline  void              _addForeign         ( Tile* );
+              std::vector<TilePool*>
+                                _getPools           ();
+              void              _destroyQueued      ();
                                 SweepLine           ( const SweepLine& ) = delete;
               SweepLine&        operator=           ( const SweepLine& ) = delete;
     private:
       TramontanaEngine*               _tramontana;
+      TilePool                        _pool;
       std::vector<Element>            _tiles;
       IntervalTrees                   _intervalTrees;
       Box                             _slidingWindow;
       Tile*                           _lastLeftEdge;
       uint32_t                        _splitCount;
       uint32_t                        _flags;
+      std::vector<SweepLine*>         _slabs;
+      TilePairs                       _merges;
+      TilePairs                       _stitches;
   };
 
 
@@ -102,6 +135,7 @@ namespace Tramontana {
   inline              SweepLine::Element::Element    ( Tile* tile, uint32_t flags ) : _tile(tile), _flags(flags) { }
   inline bool         SweepLine::Element::isLeftEdge () const { return _flags & Tile::LeftEdge; }
   inline Tile*        SweepLine::Element::getTile    () const { return _tile; }
+  inline bool         SweepLine::Element::isForeign  () const { return _flags & Tile::Foreign; }
   inline DbU::Unit    SweepLine::Element::getX       () const { return isLeftEdge() ? _tile->getLeftEdge() : _tile->getRightEdge(); } 
   inline DbU::Unit    SweepLine::Element::getY       () const { return _tile->getBoundingBox().getYMin(); }
   inline DbU::Unit    SweepLine::Element::getId      () const { return _tile->getId(); }
@@ -124,7 +158,9 @@ namespace Tramontana {
 // SweepLine.  
   inline        bool                            SweepLine::isLeftMostWindow    () const { return _flags & IsLeftMostWindow; }
   inline        bool                            SweepLine::isRightMostWindow   () const { return _flags & IsRightMostWindow; }
+  inline        bool                            SweepLine::isSlab              () const { return _flags & IsSlab; }
   inline        Cell*                           SweepLine::getCell             () { return _tramontana->getCell(); }
+  inline        TilePool*                       SweepLine::getTilePool         () { return &_pool; }
   inline        Layer::Mask                     SweepLine::getExtractedMask    () const { return _tramontana->getExtractedMask(); }
   inline  const std::vector<const BasicLayer*>& SweepLine::getExtracteds       () const { return _tramontana->getExtracteds(); }
 
@@ -138,6 +174,12 @@ namespace Tramontana {
     _tiles.push_back( Element( tile, Tile::RightEdge ) );
   }
 
+  inline  void  SweepLine::_addForeign ( Tile* tile )
+  {
+    _tiles.push_back( Element( tile, Tile::LeftEdge |Tile::Foreign ) );
+    _tiles.push_back( Element( tile, Tile::RightEdge|Tile::Foreign ) );
+  }
+
 
   
 }  // Tramontana namespace.
@@ -45,6 +45,7 @@ namespace Tramontana {
   using Hurricane::IntervalTree;
   class Equipotential;
   class SweepLine;
+  class TilePool;
 
 
 // -------------------------------------------------------------------
@@ -71,17 +72,11 @@ namespace Tramontana {
       static const uint32_t  OccMerged    = (1<<6);
       static const uint32_t  TopLevel     = (1<<7);
       static const uint32_t  Freed        = (1<<8);
+      static const uint32_t  Foreign      = (1<<9);
+      static const uint32_t  Boundary     = (1<<10);
     public:
       typedef std::set<Tile*,TileCompare>  TileSet;
     public:
-      static inline const std::vector<Tile*>&  getAllTiles          ();
-      static inline const std::vector<size_t>& getFreedIds          ();
-      static inline       size_t               activeTilesCount     ();
-      static inline       size_t               peakTilesCount       ();
-      static inline       size_t               totalTilesCount      ();
-      static              void                 showStats            ();
-      static              void                 deleteAllTiles       ();
-      static              void                 destroyQueued        ();
       static inline       void                 timeTick             ();
       static              Tile*                create               ( Occurrence
                                                                     , const BasicLayer*
@@ -97,7 +92,9 @@ namespace Tramontana {
              inline       bool                 isOccMerged          () const;
              inline       bool                 isTopLevel           () const;
              inline       bool                 isFreed              () const;
+             inline       bool                 isBoundary           () const;
              inline       uint32_t             getId                () const;
+             inline       TilePool*            getPool              () const;
              inline       uint32_t             getRefCount          () const;
              inline       uint32_t             getRank              () const;
              inline       Tile*                getParent            () const;
@@ -121,6 +118,7 @@ namespace Tramontana {
                           Tile*                merge                ( Tile* );
                           bool                 _mergeEqui           ( Tile* );
              inline       void                 setOccMerged         ( bool state );
+             inline       void                 setBoundary          ( bool state );
              inline       void                 setEquipotential     ( Equipotential* );
                           Equipotential*       newEquipotential     ();
                           void                 destroyEquipotential ();
@@ -128,19 +126,15 @@ namespace Tramontana {
                           std::string          _getString           () const;
                           std::string          _getTypeName         () const;
     private:
-                      Tile      ( Occurrence occ, Occurrence deepOcc, const BasicLayer*, const Box&, Tile* parent );
+                      Tile      ( Occurrence occ, Occurrence deepOcc, const BasicLayer*, const Box&, Tile* parent, TilePool*, uint32_t id );
                      ~Tile      ();
     private:
                       Tile      ( const Tile& ) = delete;
               Tile&   operator= ( const Tile& ) = delete;
+    friend class TilePool;
     private:
-      static       uint32_t             _idCounter;
       static       uint32_t             _time;
-      static       std::vector<Tile*>   _allocateds;
-      static       std::vector<Tile*>   _destroyQueue;
-      static       std::vector<size_t>  _freeds;
-      static       size_t               _peakTiles;
-      static       size_t               _totalTiles;
+                   TilePool*            _pool;
                    uint32_t             _id;
                    uint32_t             _refCount;
                    Occurrence           _occurrence;
@@ -154,18 +148,15 @@ namespace Tramontana {
                    uint32_t             _timeStamp;
   };
 
-  inline const std::vector<Tile*>&  Tile::getAllTiles       () { return _allocateds; }
-  inline const std::vector<size_t>& Tile::getFreedIds       () { return _freeds; }
-  inline       size_t               Tile::activeTilesCount  () { return _allocateds.size() - _freeds.size(); }
-  inline       size_t               Tile::peakTilesCount    () { return _peakTiles; }
-  inline       size_t               Tile::totalTilesCount   () { return _totalTiles; }
   inline       void                 Tile::timeTick          () { _time++; }
   inline       bool                 Tile::isUpToDate        () const { return _timeStamp >= _time; }
   inline       bool                 Tile::isOccMerged       () const { return _flags & OccMerged; }
   inline       bool                 Tile::isTopLevel        () const { return _flags & TopLevel; }
   inline       bool                 Tile::isFreed           () const { return _flags & Freed; }
+  inline       bool                 Tile::isBoundary        () const { return _flags & Boundary; }
   inline       bool                 Tile::isRoot            () const { return not _parent; }
   inline       uint32_t             Tile::getId             () const { return _id; }
+  inline       TilePool*            Tile::getPool           () const { return _pool; }
   inline       uint32_t             Tile::getRefCount       () const { return _refCount; }
   inline       Occurrence           Tile::getOccurrence     () const { return _occurrence; }
   inline       Occurrence           Tile::getDeepOccurrence () const { return _deepOccurrence; }
@@ -214,6 +205,13 @@ namespace Tramontana {
   }
 
 
+  inline void  Tile::setBoundary ( bool state )
+  {
+    if (state) _flags |=  Boundary;
+    else       _flags &= ~Boundary;
+  }
+
+
   inline bool  TileCompare::operator() ( const Tile* lhs, const Tile* rhs ) const
   {
     cdebug_log(0,0) << "TileCompare::operator()" << std::endl;
@@ -221,6 +219,72 @@ namespace Tramontana {
   }
 
 
+// -------------------------------------------------------------------
+// Class  :  "Tramontana::TilePool".
+//
+// Arena owning the Tiles created by one SweepLine. Tiles are built in
+// place into fixed size chunks, and the slots of the destroyed ones
+// are recycled, so there is no allocation per Tile. The id of a Tile
+// is the index of it's slot shifted by the pool base, when several
+// pools are used concurrently (one per slab) they are rebased
+// afterwards so the ids stay unique.
+
+  class TilePool {
+    public:
+      static const uint32_t  ChunkShift = 12;
+      static const uint32_t  ChunkSize  = (1 << ChunkShift);
+    public:
+                                         TilePool         ();
+                                        ~TilePool         ();
+      inline       uint32_t              getIdBase        () const;
+      inline       uint32_t              getSize          () const;
+      inline       Tile*                 getTile          ( uint32_t id ) const;
+      inline       Tile*                 getTileAt        ( uint32_t index ) const;
+      inline       size_t                getFreedsCount   () const;
+      inline       size_t                activeTilesCount () const;
+      inline       size_t                peakTilesCount   () const;
+      inline       size_t                totalTilesCount  () const;
+                   size_t                getMemorySize    () const;
+                   void                  rebase           ( uint32_t base );
+                   void                  destroyQueued    ();
+                   void                  deleteAllTiles   ();
+                   void                  showStats        () const;
+    private:
+                   Tile*                 _create          ( Occurrence occ
+                                                          , Occurrence deepOcc
+                                                          , const BasicLayer*
+                                                          , const Box&
+                                                          , Tile* parent );
+      inline       Tile*                 _getSlot         ( uint32_t index ) const;
+      inline       void                  _queue           ( Tile* );
+    private:
+                                         TilePool         ( const TilePool& ) = delete;
+                   TilePool&             operator=        ( const TilePool& ) = delete;
+    private:
+      uint32_t               _idBase;
+      std::vector<Tile*>     _chunks;
+      std::vector<uint8_t>   _lives;
+      std::vector<Tile*>     _destroyQueue;
+      std::vector<uint32_t>  _freeds;
+      size_t                 _totalTiles;
+    friend class Tile;
+  };
+
+
+  inline uint32_t  TilePool::getIdBase        () const { return _idBase; }
+  inline uint32_t  TilePool::getSize          () const { return _lives.size(); }
+  inline size_t    TilePool::getFreedsCount   () const { return _freeds.size(); }
+  inline size_t    TilePool::activeTilesCount () const { return _lives.size() - _freeds.size(); }
+  inline size_t    TilePool::peakTilesCount   () const { return _lives.size(); }
+  inline size_t    TilePool::totalTilesCount  () const { return _totalTiles; }
+  inline Tile*     TilePool::getTile          ( uint32_t id ) const { return getTileAt( id - _idBase ); }
+  inline Tile*     TilePool::getTileAt        ( uint32_t index ) const { return (_lives[index]) ? _getSlot(index) : nullptr; }
+  inline void      TilePool::_queue           ( Tile* tile ) { _destroyQueue.push_back( tile ); }
+
+  inline Tile* TilePool::_getSlot ( uint32_t index ) const
+  { return _chunks[ index >> ChunkShift ] + (index & (ChunkSize-1)); }
+
+
 // -------------------------------------------------------------------
 // Class  :  "Tramontana::TileIntvTree".
 
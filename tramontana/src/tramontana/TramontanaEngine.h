@@ -62,6 +62,7 @@ namespace Tramontana {
       inline        bool               inDestroyStage         () const;
       inline        bool               doMergeSupplies        () const;
       inline        uint32_t           getInstancesPerWindows () const;
+      inline        uint32_t           getThreads             () const;
       inline        Configuration*     getConfiguration       () const;
               const Name&              getName                () const;
       inline        uint32_t           getDepth               () const;
@@ -121,6 +122,7 @@ namespace Tramontana {
   inline bool           TramontanaEngine::inDestroyStage         () const { return (_flags & DestroyStage); }
   inline bool           TramontanaEngine::doMergeSupplies        () const { return _configuration->doMergeSupplies(); }
   inline uint32_t       TramontanaEngine::getInstancesPerWindows () const { return _configuration->getInstancesPerWindows(); }
+  inline uint32_t       TramontanaEngine::getThreads             () const { return _configuration->getThreads(); }
   inline Configuration* TramontanaEngine::getConfiguration       () const { return _configuration; }
   inline void           TramontanaEngine::setViewer              ( CellViewer* viewer ) { _viewer=viewer; }
   inline CellViewer*    TramontanaEngine::getViewer              () { return _viewer; }
@@ -1,13 +1,64 @@
 
 
+#include  <chrono>
+#include  <thread>
+#include  <iomanip>
+#include  <cstdlib>
+#include  <cstdio>
+#include  <cmath>
+#include  <fstream>
+#include  <random>
+#include  <sstream>
+#include  <algorithm>
+#include  <set>
+#include  <map>
+#include  <array>
+#include  <unistd.h>
+#include  <sys/wait.h>
 #include  <boost/program_options.hpp>
 namespace boptions = boost::program_options;
 
 #include "hurricane/DebugSession.h"
+#include "hurricane/DataBase.h"
+#include "hurricane/Technology.h"
+#include "hurricane/BasicLayer.h"
+#include "hurricane/ViaLayer.h"
+#include "hurricane/RegularLayer.h"
+#include "hurricane/Library.h"
+#include "hurricane/Cell.h"
+#include "hurricane/Slice.h"
+#include "hurricane/QuadTree.h"
+#include "hurricane/Net.h"
+#include "hurricane/Horizontal.h"
+#include "hurricane/Vertical.h"
+#include "hurricane/Contact.h"
+#include "hurricane/Instance.h"
+#include "hurricane/Plug.h"
+#include "hurricane/RoutingPad.h"
+#include "hurricane/SharedPath.h"
+#include "hurricane/Snapshot.h"
+#include "hurricane/NetExternalComponents.h"
+#include "hurricane/UpdateSession.h"
+#include "hurricane/ParallelQuery.h"
 #include "hurricane/Interval.h"
 #include "hurricane/RbTree.h"
 #include "hurricane/IntervalTree.h"
+#include "hurricane/configuration/Configuration.h"
 #include "crlcore/Utilities.h"
+#include "crlcore/Gds.h"
+#include "crlcore/AllianceFramework.h"
+#include "crlcore/RoutingGauge.h"
+#include "crlcore/CellGauge.h"
+#include "tramontana/TramontanaEngine.h"
+#include "anabatic/Dijkstra.h"
+#include "anabatic/Session.h"
+#include "katana/KatanaEngine.h"
+#include "katana/Session.h"
+#include "katana/DataNegociate.h"
+#include "katana/TrackElement.h"
+#include "katana/RoutingEvent.h"
+#include "katana/RoutingEventQueue.h"
+#include "katana/NegociateWindow.h"
 
 namespace Hurricane {
 
@@ -137,6 +188,1876 @@ namespace {
     return 0;
   }
 
+
+
+// -------------------------------------------------------------------
+// Test  :  "testPackedRTree".
+//
+// Check that the packed R-Tree returns the same Gos than the QuadTree
+// and that Gos can be created or destroyed while iterating over it
+// (the tree is then detached and kept alive until the end of the
+// iteration).
+
+
+  size_t  countGosUnder ( Slice* slice, const Box& area )
+  {
+    size_t count = 0;
+    for ( Go* go : slice->_getQuadTree()->getGosUnder(area) ) { (void)go; ++count; }
+    return count;
+  }
+
+
+  int  testPackedRTree ()
+  {
+    DataBase*   db      = DataBase::getDB();
+    if (not db) db = DataBase::create();
+    Technology* tech    = db->getTechnology();
+    if (not tech) tech = Technology::create( db, "test" );
+    BasicLayer* metal1  = BasicLayer::create( tech, "testPackedRTree.METAL1", BasicLayer::Material::metal );
+    Library*    rootLib = db->getRootLibrary();
+    if (not rootLib) rootLib = Library::create( db, "RootLibrary" );
+    Library*    library = Library::create( rootLib, "testPackedRTree" );
+
+    int        errors = 0;
+    DbU::Unit  pitch  = l( 5 );
+    UpdateSession::open();
+    Cell*      cell   = Cell::create( library, "packed" );
+    Net*       net    = Net::create( cell, "q" );
+    for ( unsigned int iy=0 ; iy<64 ; ++iy ) {
+      for ( unsigned int ix=0 ; ix<64 ; ++ix )
+        Horizontal::create( net, metal1, pitch*iy, l(1), pitch*ix, pitch*ix + l(3) );
+    }
+    UpdateSession::close();
+    Slice* slice = cell->getSlice( metal1 );
+
+    vector<Box>  areas = { Box( 0, 0, pitch*64, pitch*64 )
+                         , Box( pitch*10, pitch*10, pitch*20, pitch*12 )
+                         , Box( pitch*63, pitch*63, pitch*80, pitch*80 )
+                         , Box( -pitch*10, -pitch*10, -pitch, -pitch ) };
+    vector<size_t>  counts;
+    for ( const Box& area : areas ) counts.push_back( countGosUnder(slice,area) );
+
+    cell->packQuadTrees();
+    if (not slice->_getQuadTree()->isPacked()) {
+      cerr << "  [ERROR] QuadTree not packed." << endl;
+      ++errors;
+    }
+    for ( size_t i=0 ; i<areas.size() ; ++i ) {
+      size_t count = countGosUnder( slice, areas[i] );
+      if (count != counts[i]) {
+        cerr << "  [ERROR] Packed R-Tree under " << areas[i] << " returns " << count
+             << " Gos instead of " << counts[i] << "." << endl;
+        ++errors;
+      }
+    }
+
+  // Destroy one segment out of two, and create one, while iterating.
+    size_t visiteds = 0;
+    UpdateSession::open();
+    for ( Go* go : slice->_getQuadTree()->getGosUnder(areas[1]) ) {
+      if (visiteds++ % 2) continue;
+      static_cast<Component*>( go )->destroy();
+      Horizontal::create( net, metal1, pitch*100, l(1), pitch*visiteds, pitch*visiteds + l(3) );
+    }
+    UpdateSession::close();
+    if (visiteds != counts[1]) {
+      cerr << "  [ERROR] Iteration over a detached tree visited " << visiteds
+           << " Gos instead of " << counts[1] << "." << endl;
+      ++errors;
+    }
+    if (slice->_getQuadTree()->isPacked()) {
+      cerr << "  [ERROR] QuadTree still packed after being modified." << endl;
+      ++errors;
+    }
+    size_t remaining = countGosUnder( slice, areas[1] );
+    if (remaining != counts[1]/2) {
+      cerr << "  [ERROR] " << remaining << " Gos remaining under " << areas[1]
+           << " instead of " << counts[1]/2 << "." << endl;
+      ++errors;
+    }
+
+  // Pack again, then unpack: back to plain QuadTree queries.
+    cell->packQuadTrees();
+    size_t packed = countGosUnder( slice, areas[0] );
+    cell->unpackQuadTrees();
+    if (slice->_getQuadTree()->isPacked() or (countGosUnder(slice,areas[0]) != packed)) {
+      cerr << "  [ERROR] Unpacked QuadTree differs from the packed one." << endl;
+      ++errors;
+    }
+
+    UpdateSession::open();
+    cell->destroy();
+    UpdateSession::close();
+    cerr << "testPackedRTree: " << ((errors) ? "FAILED" : "passed") << "." << endl;
+    return errors;
+  }
+
+// -------------------------------------------------------------------
+// Benchmark  :  "benchQuery".
+//
+// Build the same layout twice, once as a three levels hierarchy
+// (top / block / leaf) and once flattened in a single Cell, then
+// time the sequential Query against the ParallelQuery for an
+// increasing number of threads.
+
+
+  class BenchQuery : public Query {
+    public:
+                            BenchQuery          () : Query(), _count(0) { }
+      virtual bool          hasGoCallback       () const { return true; }
+      virtual void          goCallback          ( Go* ) { ++_count; }
+      virtual void          extensionGoCallback ( Go* ) { }
+      virtual void          masterCellCallback  () { }
+              size_t        getCount            () const { return _count; }
+    private:
+      size_t  _count;
+  };
+
+
+  class BenchParallelQuery : public ParallelQuery {
+    public:
+                            BenchParallelQuery ( unsigned int threads )
+                              : ParallelQuery(), _counts(threads*8,0) { setThreads(threads); }
+      virtual bool          hasGoCallback      () const { return true; }
+      virtual void          goCallback         ( Go*, QueryStack&, unsigned int worker ) { ++_counts[worker*8]; }
+              size_t        getCount           () const
+                            {
+                              size_t count = 0;
+                              for ( size_t i=0 ; i<_counts.size() ; i+=8 ) count += _counts[i];
+                              return count;
+                            }
+    private:
+      vector<size_t>  _counts;  // Padded to one cache line per worker.
+  };
+
+
+  double  timeQuery ( Cell* cell, const BasicLayer* layer, size_t& count )
+  {
+    BenchQuery  query;
+    query.setQuery( cell, cell->getAbutmentBox(), Transformation(), layer, 0
+                  , Query::DoComponents|Query::DoTerminalCells );
+    auto start = std::chrono::steady_clock::now();
+    query.doQuery();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    count = query.getCount();
+    return elapsed.count();
+  }
+
+
+  bool  isFrozen ( Cell* cell )
+  {
+    if (cell->_getQuadTree()->isPacked()) return true;
+    for ( Instance* instance : cell->getInstances() ) {
+      if (isFrozen(instance->getMasterCell())) return true;
+    }
+    return false;
+  }
+
+
+// The ParallelQuery is run over the unpacked hierarchy, so it's timing
+// includes the packing of the whole hierarchy (and it's unpacking).
+  void  timeQueries ( Cell* cell, const BasicLayer* layer )
+  {
+    size_t count  = 0;
+    double serial = timeQuery( cell, layer, count );
+    cerr << "  Query (QuadTree)  " << setw(10) << count
+         << " gos in " << setw(8) << fixed << setprecision(3) << serial << "s" << endl;
+
+    ParallelQuery::Frozens packeds;
+    auto start = std::chrono::steady_clock::now();
+    ParallelQuery::freeze( cell, &packeds );
+    std::chrono::duration<double> freezing = std::chrono::steady_clock::now() - start;
+    double packed = timeQuery( cell, layer, count );
+    ParallelQuery::unfreeze( packeds );
+    cerr << "  Query (packed)    " << setw(10) << count
+         << " gos in " << setw(8) << fixed << setprecision(3) << packed << "s"
+         << " (+" << freezing.count() << "s packing " << packeds.size() << " QuadTrees)" << endl;
+
+    unsigned int maxThreads = std::max( 1U, std::thread::hardware_concurrency() );
+    for ( unsigned int threads=1 ; threads<=maxThreads ; threads*=2 ) {
+      BenchParallelQuery  pquery ( threads );
+      pquery.setQuery( cell, cell->getAbutmentBox(), Transformation(), layer
+                     , Query::DoComponents|Query::DoTerminalCells );
+      start = std::chrono::steady_clock::now();
+      pquery.doQuery();
+      std::chrono::duration<double> parallel = std::chrono::steady_clock::now() - start;
+      cerr << "  ParallelQuery " << setw(3) << threads
+           << " " << setw(10) << pquery.getCount()
+           << " gos in " << setw(8) << fixed << setprecision(3) << parallel.count() << "s"
+           << " (x" << setprecision(2) << (serial / parallel.count()) << ")" << endl;
+      if (pquery.getCount() != count)
+        cerr << "  [ERROR] Sequential & parallel queries differs." << endl;
+      if (isFrozen(cell))
+        cerr << "  [ERROR] ParallelQuery left packed QuadTrees behind." << endl;
+    }
+  }
+
+
+  int  benchQuery ( unsigned int size )
+  {
+    DataBase*   db      = DataBase::getDB();
+    if (not db) db = DataBase::create();
+    Technology* tech    = db->getTechnology();
+    if (not tech) tech = Technology::create( db, "bench" );
+    BasicLayer* metal1  = BasicLayer::create( tech, "bench.METAL1", BasicLayer::Material::metal );
+    Library*    rootLib = db->getRootLibrary();
+    if (not rootLib) rootLib = Library::create( db, "RootLibrary" );
+    Library*    library = Library::create( rootLib, "benchQuery" );
+
+    const unsigned int segments = 32;
+    DbU::Unit          pitch    = l(  5 );
+    DbU::Unit          width    = l(100 );
+    DbU::Unit          height   = pitch * segments;
+
+    UpdateSession::open();
+
+    Cell* leaf = Cell::create( library, "leaf" );
+    leaf->setAbutmentBox( Box( 0, 0, width, height ) );
+    Net*  net  = Net::create( leaf, "q" );
+    for ( unsigned int i=0 ; i<segments ; ++i )
+      Horizontal::create( net, metal1, pitch*i + pitch/2, l(2), l(2), width-l(2) );
+
+    Cell* block = Cell::create( library, "block" );
+    block->setAbutmentBox( Box( 0, 0, width*8, height*8 ) );
+    for ( unsigned int ix=0 ; ix<8 ; ++ix ) {
+      for ( unsigned int iy=0 ; iy<8 ; ++iy )
+        Instance::create( block, "leaf_"+getString(ix)+"_"+getString(iy), leaf
+                        , Transformation(width*ix,height*iy), Instance::PlacementStatus::FIXED );
+    }
+
+    Cell* hier = Cell::create( library, "hierarchical" );
+    Cell* flat = Cell::create( library, "flat" );
+    hier->setAbutmentBox( Box( 0, 0, width*8*size, height*8*size ) );
+    flat->setAbutmentBox( hier->getAbutmentBox() );
+    Net*  flatNet = Net::create( flat, "q" );
+    for ( unsigned int ix=0 ; ix<size ; ++ix ) {
+      for ( unsigned int iy=0 ; iy<size ; ++iy ) {
+        Instance::create( hier, "block_"+getString(ix)+"_"+getString(iy), block
+                        , Transformation(width*8*ix,height*8*iy), Instance::PlacementStatus::FIXED );
+        for ( unsigned int jx=0 ; jx<8 ; ++jx ) {
+          for ( unsigned int jy=0 ; jy<8 ; ++jy ) {
+            DbU::Unit x0 = width *(8*ix+jx);
+            DbU::Unit y0 = height*(8*iy+jy);
+            for ( unsigned int i=0 ; i<segments ; ++i )
+              Horizontal::create( flatNet, metal1, y0 + pitch*i + pitch/2, l(2), x0+l(2), x0+width-l(2) );
+          }
+        }
+      }
+    }
+
+    UpdateSession::close();
+
+    cerr << "Hierarchical design (" << size*size*64 << " leaf instances):" << endl;
+    timeQueries( hier, metal1 );
+    cerr << "Flattened design (" << size*size*64*segments << " segments):" << endl;
+    timeQueries( flat, metal1 );
+    return 0;
+  }
+
+
+// -------------------------------------------------------------------
+// Benchmark  :  "benchExtract".
+//
+// Extract a (size*8)^2 array of abutted leaf cells, with rows linked
+// by metal2 straps, for an increasing number of threads. The tiles
+// counts and the memory of the TilePools are displayed by the
+// SweepLine summary.
+
+
+  BasicLayer* getBenchLayer ( Technology* tech, string name, BasicLayer::Material material )
+  {
+    BasicLayer* layer = tech->getBasicLayer( name );
+    if (not layer) layer = BasicLayer::create( tech, name, material );
+    return layer;
+  }
+
+
+  int  benchExtract ( unsigned int size )
+  {
+    DataBase*   db      = DataBase::getDB();
+    if (not db) db = DataBase::create();
+    Technology* tech    = db->getTechnology();
+    if (not tech) tech = Technology::create( db, "bench" );
+    BasicLayer* metal1  = getBenchLayer( tech, "bench.METAL1", BasicLayer::Material::metal );
+    BasicLayer* cut1    = getBenchLayer( tech, "bench.CUT1"  , BasicLayer::Material::cut   );
+    BasicLayer* metal2  = getBenchLayer( tech, "bench.METAL2", BasicLayer::Material::metal );
+    ViaLayer*   via12   = ViaLayer::create( tech, "bench.VIA12", metal1, cut1, metal2 );
+    Library*    rootLib = db->getRootLibrary();
+    if (not rootLib) rootLib = Library::create( db, "RootLibrary" );
+    Library*    library = Library::create( rootLib, "benchExtract" );
+
+    unsigned int side  = size * 8;
+    DbU::Unit    pitch = l( 20 );
+
+    UpdateSession::open();
+
+    Cell* leaf = Cell::create( library, "leaf" );
+    leaf->setAbutmentBox( Box( 0, 0, pitch, pitch ) );
+    leaf->setTerminalNetlist( true );
+    Net*  a    = Net::create( leaf, "a" );
+    Net*  b    = Net::create( leaf, "b" );
+    a->setExternal( true );
+    b->setExternal( true );
+    Horizontal::create( a, metal1, pitch/4  , l(2), 0   , pitch      );
+    Horizontal::create( b, metal1, pitch*3/4, l(2), l(2), pitch-l(2) );
+
+    Cell* top = Cell::create( library, "top" );
+    top->setAbutmentBox( Box( 0, 0, pitch*side, pitch*side ) );
+    for ( unsigned int ix=0 ; ix<side ; ++ix ) {
+      for ( unsigned int iy=0 ; iy<side ; ++iy )
+        Instance::create( top, "leaf_"+getString(ix)+"_"+getString(iy), leaf
+                        , Transformation(pitch*ix,pitch*iy), Instance::PlacementStatus::FIXED );
+    }
+    for ( unsigned int iy=0 ; iy+1<side ; iy+=2 ) {
+      Net* strap = Net::create( top, "strap_"+getString(iy) );
+      for ( unsigned int ix=(iy*7)%side ; ix<side ; ix+=side/3+1 ) {
+        DbU::Unit x     = pitch*ix + pitch/2;
+        DbU::Unit y1    = pitch*iy + pitch/4;
+        DbU::Unit y2    = y1 + pitch;
+        Contact ::create( strap, via12 , x, y1, l(2), l(2) );
+        Contact ::create( strap, via12 , x, y2, l(2), l(2) );
+        Vertical::create( strap, metal2, x, l(2), y1, y2 );
+      }
+    }
+
+    UpdateSession::close();
+
+    cerr << "Extraction of " << side*side << " instances:" << endl;
+    mstream::enable( mstream::Verbose2 );
+    unsigned int maxThreads = std::max( 1U, std::thread::hardware_concurrency() );
+    double       serial     = 0.0;
+    for ( unsigned int threads=1 ; threads<=maxThreads ; threads*=2 ) {
+      Cfg::getParamInt( "tramontana.threads", 1 )->setInt( threads );
+      auto start = std::chrono::steady_clock::now();
+      Tramontana::TramontanaEngine* tramontana = Tramontana::TramontanaEngine::create( top );
+      tramontana->extract();
+      std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+      if (threads == 1) serial = elapsed.count();
+      cerr << "  Extract " << setw(3) << threads
+           << " " << setw(10) << tramontana->getEquipotentials().size()
+           << " equis in " << setw(8) << fixed << setprecision(3) << elapsed.count() << "s"
+           << " (x" << setprecision(2) << (serial / elapsed.count()) << ")" << endl;
+      tramontana->destroy();
+    }
+    mstream::disable( mstream::Verbose2 );
+    return 0;
+  }
+
+
+// -------------------------------------------------------------------
+// Fixture  :  "RouteDesign".
+//
+// A placed design for the global routing tests & benchmarks: rows of
+// three inputs gates, the output of each gate driving one to three
+// inputs of nearby gates (the remaining inputs are driven by the left
+// neighbour). The technology is a symbolic one, METAL1
+// (terminals only) to METAL5, whose gauges ("bench.route") are the
+// ones of "sxlib". A new top Cell must be built for each routing, as
+// the global wiring is left in it. The routings are run without the
+// trace opened by main(), as it slows down Katana by orders of
+// magnitude.
+//
+// The order of the Hurricane collections depends on the DBo ids, so
+// two routings of the same design are only identical if they start
+// with the same id counter. routeApart() builds and routes the design
+// in a forked process, so all the routings start from the very same
+// database state.
+
+
+  class NoTrace {
+    public:
+      inline  NoTrace  ();
+      inline ~NoTrace  ();
+    private:
+      int  _minLevel;
+      int  _maxLevel;
+  };
+
+
+  inline  NoTrace::NoTrace ()
+    : _minLevel( cdebug.setMinLevel(100000) )
+    , _maxLevel( cdebug.setMaxLevel(0) )
+  { }
+
+
+  inline  NoTrace::~NoTrace ()
+  {
+    cdebug.setMinLevel( _minLevel );
+    cdebug.setMaxLevel( _maxLevel );
+  }
+
+
+  void  setupRouteTechnology ()
+  {
+    DataBase*   db   = DataBase::getDB();
+    Technology* tech = db->getTechnology();
+    if (not tech) tech = Technology::create( db, "bench" );
+    if (tech->getLayer("METAL1")) return;
+
+    BasicLayer* metals[5];
+    BasicLayer* cuts  [4];
+    for ( size_t i=0 ; i<5 ; ++i ) {
+      metals[i] = getBenchLayer( tech, "metal"+getString(i+1), BasicLayer::Material::metal );
+      if (i < 4) cuts[i] = getBenchLayer( tech, "cut"+getString(i+1), BasicLayer::Material::cut );
+    }
+    BasicLayer* gmetalh = getBenchLayer( tech, "gmetalh", BasicLayer::Material::metal );
+    BasicLayer* gcut    = getBenchLayer( tech, "gcut"   , BasicLayer::Material::cut   );
+    BasicLayer* gmetalv = getBenchLayer( tech, "gmetalv", BasicLayer::Material::metal );
+
+    for ( size_t i=0 ; i<5 ; ++i ) {
+      tech->setSymbolicLayer( RegularLayer::create( tech, "METAL"+getString(i+1), metals[i] ));
+      if (i < 4)
+        tech->setSymbolicLayer( ViaLayer::create( tech, "VIA"+getString(i+1)+getString(i+2)
+                                                , metals[i], cuts[i], metals[i+1] ));
+    }
+    tech->setSymbolicLayer( gmetalh );
+    tech->setSymbolicLayer( gcut    );
+    tech->setSymbolicLayer( gmetalv );
+    tech->setSymbolicLayer( ViaLayer::create( tech, "gcontact", gmetalh, gcut, gmetalv ));
+
+    AllianceFramework* af = AllianceFramework::get();
+    RoutingGauge*      rg = RoutingGauge::create( "bench.route" );
+    for ( size_t depth=0 ; depth<5 ; ++depth ) {
+      rg->addLayerGauge( RoutingLayerGauge::create( tech->getLayer("METAL"+getString(depth+1))
+                                                  , (depth%2) ? Constant::Horizontal : Constant::Vertical
+                                                  , (depth)   ? Constant::Default    : Constant::PinOnly
+                                                  , depth, 0.0, 0, l(5), l(2), 0, l(1), l(4) ));
+    }
+    af->addRoutingGauge( rg );
+    af->addCellGauge( CellGauge::create( "bench.route", "metal2", l(5), l(50), l(5) ));
+    Cfg::getParamString( "anabatic.routingGauge"   , "sxlib" )->setString( "bench.route" );
+    Cfg::getParamString( "anabatic.topRoutingLayer", "METAL5")->setString( "METAL5" );
+  }
+
+
+  Cell* getRouteGate ( Library* library )
+  {
+    Cell* gate = library->getCell( "bench_gate" );
+    if (gate) return gate;
+
+    Layer* metal1 = DataBase::getDB()->getTechnology()->getLayer( "METAL1" );
+    gate = Cell::create( library, "bench_gate" );
+    gate->setAbutmentBox( Box( 0, 0, l(20), l(50) ));
+    const char* names[] = { "i0", "i1", "i2", "q" };
+    for ( size_t i=0 ; i<4 ; ++i ) {
+      Net* net = Net::create( gate, names[i] );
+      net->setExternal ( true );
+      net->setDirection( (i < 3) ? Net::Direction::IN : Net::Direction::OUT );
+      NetExternalComponents::setExternal( Vertical::create( net, metal1, l(5*(i%3)+5), l(2)
+                                                          , l((i < 3) ? 10 : 30), l((i < 3) ? 25 : 40) ));
+    }
+    gate->setTerminalNetlist( true );
+    return gate;
+  }
+
+
+  Cell* getRouteTerminal ( Library* library, bool driver )
+  {
+    Cell* terminal = library->getCell( (driver) ? "bench_src" : "bench_snk" );
+    if (terminal) return terminal;
+
+    Layer* metal1 = DataBase::getDB()->getTechnology()->getLayer( "METAL1" );
+    terminal = Cell::create( library, (driver) ? "bench_src" : "bench_snk" );
+    terminal->setAbutmentBox( Box( 0, 0, l(10), l(50) ));
+    Net* net = Net::create( terminal, (driver) ? "q" : "i" );
+    net->setExternal ( true );
+    net->setDirection( (driver) ? Net::Direction::OUT : Net::Direction::IN );
+    NetExternalComponents::setExternal( Vertical::create( net, metal1, l(5), l(2), l(10), l(40) ));
+    terminal->setTerminalNetlist( true );
+    return terminal;
+  }
+
+
+  Library* getRouteLibrary ()
+  {
+    DataBase*   db      = DataBase::getDB();
+    if (not db) db = DataBase::create();
+    Library*    rootLib = db->getRootLibrary();
+    if (not rootLib) rootLib = Library::create( db, "RootLibrary" );
+    Library*    library = rootLib->getLibrary( "benchRoute" );
+    if (not library) library = Library::create( rootLib, "benchRoute" );
+
+    setupRouteTechnology();
+    return library;
+  }
+
+
+  Cell* buildRouteDesign ( const string& name, unsigned int size, uint32_t seed=1 )
+  {
+    Library*      library = getRouteLibrary();
+    unsigned int  rows    = size*2;
+    unsigned int  columns = size*5;
+    std::mt19937  rng     ( seed );
+
+    UpdateSession::open();
+    Cell* gate = getRouteGate( library );
+    Cell* top  = Cell::create( library, name );
+    top->setAbutmentBox( Box( 0, 0, columns*l(20), rows*l(50) ));
+
+    vector<Instance*>  gates;
+    vector<uint8_t>    freeInputs ( rows*columns, 3 );
+    for ( unsigned int row=0 ; row<rows ; ++row ) {
+      for ( unsigned int column=0 ; column<columns ; ++column )
+        gates.push_back( Instance::create( top, "g_"+getString(row)+"_"+getString(column), gate
+                                         , Transformation( column*l(20), row*l(50) )
+                                         , Instance::PlacementStatus::PLACED ));
+    }
+    for ( size_t igate=0 ; igate<gates.size() ; ++igate ) {
+      Net* net = Net::create( top, "n_"+getString(igate) );
+      gates[igate]->getPlug( gate->getNet("q") )->setNet( net );
+
+      size_t sinks = 1 + rng()%3;
+      for ( size_t tries=0 ; sinks and (tries<8) ; ++tries ) {
+        int row    = (int)(igate / columns) + (int)(rng()%9) - 4;
+        int column = (int)(igate % columns) + (int)(rng()%17) - 8;
+        if ((row < 0) or (row >= (int)rows) or (column < 0) or (column >= (int)columns)) continue;
+        size_t isink = row*columns + column;
+        if ((isink == igate) or not freeInputs[isink]) continue;
+        --freeInputs[isink];
+        gates[isink]->getPlug( gate->getNet("i"+getString((int)freeInputs[isink])) )->setNet( net );
+        --sinks;
+      }
+    }
+  // The inputs left unconnected are driven by the left neighbour.
+    for ( size_t igate=0 ; igate<gates.size() ; ++igate ) {
+      Net* net = gates[ (igate%columns) ? igate-1 : igate+1 ]->getPlug( gate->getNet("q") )->getNet();
+      while ( freeInputs[igate] ) {
+        --freeInputs[igate];
+        gates[igate]->getPlug( gate->getNet("i"+getString((int)freeInputs[igate])) )->setNet( net );
+      }
+    }
+    UpdateSession::close();
+    return top;
+  }
+
+
+// Variant of the RouteDesign: size*size blocks of 500x500 lambdas, each
+// holding only one bipoint net between a driver and a sink, placed at
+// random in the lower left 300x300 lambdas. The search areas of the
+// nets are disjoints, so the routing of a net do not depend on the
+// others.
+  Cell* buildBipointDesign ( const string& name, unsigned int size, uint32_t seed=1 )
+  {
+    Library*      library = getRouteLibrary();
+    std::mt19937  rng     ( seed );
+
+    UpdateSession::open();
+    Cell* source = getRouteTerminal( library, true  );
+    Cell* sink   = getRouteTerminal( library, false );
+    Cell* top    = Cell::create( library, name );
+    top->setAbutmentBox( Box( 0, 0, size*l(500), size*l(500) ));
+
+    for ( unsigned int row=0 ; row<size ; ++row ) {
+      for ( unsigned int column=0 ; column<size ; ++column ) {
+        string    suffix  = getString(row)+"_"+getString(column);
+        DbU::Unit sourceX = 10*(rng()%30);
+        DbU::Unit sinkX   = (sourceX + 50 + 10*(rng()%20)) % 300;
+        Instance* driver  = Instance::create( top, "s_"+suffix, source
+                                            , Transformation( column*l(500) + l(sourceX)
+                                                            , row   *l(500) + l(50*(rng()%6)) )
+                                            , Instance::PlacementStatus::PLACED );
+        Instance* load    = Instance::create( top, "l_"+suffix, sink
+                                            , Transformation( column*l(500) + l(sinkX)
+                                                            , row   *l(500) + l(50*(rng()%6)) )
+                                            , Instance::PlacementStatus::PLACED );
+        Net* net = Net::create( top, "n_"+suffix );
+        driver->getPlug( source->getNet("q") )->setNet( net );
+        load  ->getPlug( sink  ->getNet("i") )->setNet( net );
+      }
+    }
+    UpdateSession::close();
+    return top;
+  }
+
+
+  typedef  Cell* (*DesignBuilder) ( const string&, unsigned int, uint32_t );
+
+
+  class RouteStats {
+    public:
+      inline       RouteStats ();
+      inline bool  isSame     ( const RouteStats& ) const;
+    public:
+      bool      _valid;
+      double    _time;
+      long      _wireLength;
+      long      _viaCount;
+      uint64_t  _expandeds;
+      DbU::Unit _searchCost;
+      size_t    _overflow;
+      uint64_t  _signature;
+  };
+
+
+  inline  RouteStats::RouteStats ()
+    : _valid(false), _time(0.0), _wireLength(0), _viaCount(0), _expandeds(0), _searchCost(0), _overflow(0), _signature(0)
+  { }
+
+
+  inline bool  RouteStats::isSame ( const RouteStats& other ) const
+  {
+    return _valid and other._valid
+       and (_wireLength == other._wireLength)
+       and (_viaCount   == other._viaCount  )
+       and (_overflow   == other._overflow  )
+       and (_signature  == other._signature );
+  }
+
+
+  ostream& operator<< ( ostream& o, const RouteStats& stats )
+  {
+    o << setw(8) << fixed << setprecision(3) << stats._time << "s"
+      << " WL:"        << setw(9) << stats._wireLength
+      << " VIAs:"      << setw(7) << stats._viaCount
+      << " ovE:"       << setw(4) << stats._overflow
+      << " expanded:"  << setw(10) << stats._expandeds;
+    return o;
+  }
+
+
+// The signature is independant of the Nets & Components ordering, it
+// only depends on the Nets names and their global wires.
+  uint64_t  getRoutingSignature ( Cell* top, const Layer* hLayer, const Layer* vLayer )
+  {
+    uint64_t signature = 0;
+    for ( Net* net : top->getNets() ) {
+      vector< std::array<DbU::Unit,4> >  wires;
+      for ( Component* component : net->getComponents() ) {
+        if ((component->getLayer() != hLayer) and (component->getLayer() != vLayer)) continue;
+        Box bb = component->getBoundingBox();
+        wires.push_back( { bb.getXMin(), bb.getYMin(), bb.getXMax(), bb.getYMax() } );
+      }
+      std::sort( wires.begin(), wires.end() );
+
+      uint64_t hash = std::hash<string>()( getString(net->getName()) );
+      for ( const auto& wire : wires ) {
+        for ( DbU::Unit coordinate : wire ) hash = (hash * 1099511628211ULL) ^ (uint64_t)coordinate;
+      }
+      signature += hash;
+    }
+    return signature;
+  }
+
+
+  RouteStats  globalRoute ( Cell* top )
+  {
+    RouteStats            stats;
+    Katana::KatanaEngine* katana = Katana::KatanaEngine::create( top );
+    katana->digitalInit();
+
+    auto start = std::chrono::steady_clock::now();
+    katana->runGlobalRouter();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    stats._time     = elapsed.count();
+    stats._overflow = katana->getOvEdges().size();
+    katana->computeGlobalWireLength( stats._wireLength, stats._viaCount );
+    for ( Anabatic::NetData* netData : katana->getNetOrdering() ) {
+      stats._expandeds  += netData->getExpandeds();
+      stats._searchCost += netData->getSearchCost();
+    }
+    stats._signature = getRoutingSignature( top
+                                          , katana->getConfiguration()->getGHorizontalLayer()
+                                          , katana->getConfiguration()->getGVerticalLayer() );
+    katana->destroy();
+    return stats;
+  }
+
+
+  RouteStats  routeApart ( DesignBuilder build, const string& name, unsigned int size )
+  {
+    RouteStats stats;
+    int        fds[2];
+    if (pipe(fds) != 0) return stats;
+
+    pid_t pid = fork();
+    if (pid == 0) {
+      close( fds[0] );
+      stats = globalRoute( build( name, size, 1 ));
+      stats._valid = true;
+      ssize_t written = write( fds[1], &stats, sizeof(RouteStats) );
+      _exit( (written == sizeof(RouteStats)) ? 0 : 1 );
+    }
+
+    close( fds[1] );
+    if (pid > 0) {
+      if (read(fds[0],&stats,sizeof(RouteStats)) != sizeof(RouteStats)) stats = RouteStats();
+      waitpid( pid, NULL, 0 );
+    }
+    close( fds[0] );
+    return stats;
+  }
+
+
+// Runs a check in a child process (the routing engines state is not
+// cleaned between the tests), the exit code being the errors count.
+  int  checkApart ( int (*check)() )
+  {
+    pid_t pid = fork();
+    if (pid == 0) _exit( std::min( check(), 100 ));
+    if (pid < 0) return 1;
+
+    int status = 0;
+    waitpid( pid, &status, 0 );
+    return (WIFEXITED(status)) ? WEXITSTATUS(status) : 1;
+  }
+
+
+// -------------------------------------------------------------------
+// Benchmark  :  "benchGlobalRoute".
+//
+// Katana global routing of the RouteDesign fixture, once with the
+// std::multiset queue of the Dijkstra (erase by linear search) and
+// once with the indexed d-ary heap. Both pop the Vertexes in the same
+// order, so the global wiring must be identical.
+
+
+  int  benchGlobalRoute ( unsigned int size )
+  {
+    cerr << "Global routing of " << (size*size*10) << " gates:" << endl;
+    NoTrace  noTrace;
+
+    Cfg::getParamString( "anabatic.dijkstraQueue", "heap" )->setString( "multiset" );
+    RouteStats multiset = routeApart( buildRouteDesign, "bench_route", size );
+    Cfg::getParamString( "anabatic.dijkstraQueue", "heap" )->setString( "heap" );
+    RouteStats heap     = routeApart( buildRouteDesign, "bench_route", size );
+
+    cerr << "  multiset " << multiset << endl;
+    cerr << "  heap     " << heap     << " (x" << setprecision(2)
+         << (multiset._time / heap._time) << ")" << endl;
+    if (not multiset.isSame(heap)) {
+      cerr << "  [ERROR] Multiset & heap global routings differs." << endl;
+      return 1;
+    }
+    return 0;
+  }
+
+
+// -------------------------------------------------------------------
+// Test  :  "testGlobalBatch".
+//
+// The first pass of the global router, when run on parallel batches of
+// disjoint nets (katana.globalThreads > 1), must give the same global
+// wiring than the sequential one. Checked with both Dijkstra queues,
+// as the workers uses the queue kind of their master.
+
+
+  int  testGlobalBatch ()
+  {
+    cerr << "testGlobalBatch:" << endl;
+    NoTrace  noTrace;
+
+    int errors = 0;
+    for ( const char* queue : { "multiset", "heap" } ) {
+      Cfg::getParamString( "anabatic.dijkstraQueue", "heap" )->setString( queue );
+      Cfg::getParamInt   ( "katana.globalThreads"  , 1      )->setInt( 1 );
+      RouteStats sequential = routeApart( buildRouteDesign, "test_batch", 8 );
+      Cfg::getParamInt   ( "katana.globalThreads"  , 1      )->setInt( 4 );
+      RouteStats batch      = routeApart( buildRouteDesign, "test_batch", 8 );
+
+      cerr << "  " << setw(8) << left << queue << right << " sequential " << sequential << endl;
+      cerr << "  " << setw(8) << ""             << " 4 threads  " << batch      << endl;
+      if (not sequential.isSame(batch)) {
+        cerr << "  [ERROR] Batch & sequential global routings differs (" << queue << ")." << endl;
+        ++errors;
+      }
+    }
+    Cfg::getParamString( "anabatic.dijkstraQueue", "heap" )->setString( "heap" );
+    Cfg::getParamInt   ( "katana.globalThreads"  , 1      )->setInt( 1 );
+
+    cerr << "testGlobalBatch: " << ((errors) ? "FAILED" : "passed") << "." << endl;
+    return errors;
+  }
+
+
+// -------------------------------------------------------------------
+// Test  :  "testGlobalAStar".
+//
+// The A* search of the global router (katana.useGlobalAStar) must find
+// paths of the same cost than the plain Dijkstra, while expanding less
+// Vertexes. The costs are compared over bipoint nets, for which the
+// Dijkstra returns the shortest path, and whose search areas are kept
+// disjoints (see buildBipointDesign()) so a net routed on another,
+// equally short, path do not change the costs of the following ones.
+
+
+  int  testGlobalAStar ()
+  {
+    cerr << "testGlobalAStar:" << endl;
+    NoTrace  noTrace;
+
+    Cfg::getParamBool( "katana.useGlobalAStar", false )->setBool( false );
+    RouteStats dijkstra = routeApart( buildBipointDesign, "test_astar", 12 );
+    Cfg::getParamBool( "katana.useGlobalAStar", false )->setBool( true );
+    RouteStats astar    = routeApart( buildBipointDesign, "test_astar", 12 );
+    Cfg::getParamBool( "katana.useGlobalAStar", false )->setBool( false );
+
+    cerr << "  Dijkstra " << dijkstra << " cost:" << DbU::getValueString(dijkstra._searchCost) << endl;
+    cerr << "  A*       " << astar    << " cost:" << DbU::getValueString(astar   ._searchCost) << endl;
+
+    int errors = 0;
+    if (not dijkstra._valid or not astar._valid) {
+      cerr << "  [ERROR] A global routing has failed." << endl;
+      ++errors;
+    } else {
+      if (astar._searchCost != dijkstra._searchCost) {
+        cerr << "  [ERROR] A* & Dijkstra paths costs differs." << endl;
+        ++errors;
+      }
+      if (astar._expandeds >= dijkstra._expandeds) {
+        cerr << "  [ERROR] A* did not expand less Vertexes than Dijkstra." << endl;
+        ++errors;
+      }
+    }
+
+    cerr << "testGlobalAStar: " << ((errors) ? "FAILED" : "passed") << "." << endl;
+    return errors;
+  }
+
+
+// -------------------------------------------------------------------
+// Test  :  "testGridView".
+//
+// A GCell is cut after the creation of the Dijkstra. The next load()
+// must rebuild the GridView and the Vertexes instead of failing, then
+// the copies of the Edges capacities & occupancies in the view must
+// follow the routing (write through from the Edges).
+
+
+  int  checkGridView ()
+  {
+    int                   errors = 0;
+    Cell*                 top    = buildBipointDesign( "test_gridview", 4, 1 );
+    Katana::KatanaEngine* katana = Katana::KatanaEngine::create( top );
+    katana->digitalInit();
+    katana->openSession();
+
+    Anabatic::Dijkstra* dijkstra = new Anabatic::Dijkstra ( katana );
+    Anabatic::GCell*    gcell    = katana->getGCellUnder( l(1010), l(1010) );
+    gcell->vcut( (gcell->getXMin() + gcell->getXMax()) / 2 );
+    if (katana->getGridView()->isValid()) {
+      cerr << "  [ERROR] GridView still valid after a GCell cut." << endl;
+      ++errors;
+    }
+
+    size_t routeds = 0;
+    for ( Anabatic::NetData* netData : katana->getNetOrdering() ) {
+      if (netData->isGlobalRouted() or netData->isExcluded()) continue;
+      dijkstra->load( netData->getNet() );
+      dijkstra->run();
+      netData->setGlobalRouted( true );
+      ++routeds;
+    }
+
+    const Anabatic::GridView* grid = katana->getGridView();
+    if (not grid->isValid() or (grid->getGCellCount() != katana->getGCells().size())) {
+      cerr << "  [ERROR] GridView not rebuilt ("
+           << grid->getGCellCount() << " GCells, expected " << katana->getGCells().size() << ")." << endl;
+      ++errors;
+    }
+    size_t occupieds = 0;
+    for ( uint32_t iedge=0 ; iedge<grid->getEdgeCount() ; ++iedge ) {
+      Anabatic::Edge* edge = grid->getEdge( iedge );
+      if (edge->getRealOccupancy()) ++occupieds;
+      if (  (grid->getEdgeCapacity (iedge) != (int)edge->getCapacity())
+         or (grid->getEdgeOccupancy(iedge) != edge->getRealOccupancy()) ) {
+        cerr << "  [ERROR] GridView copy differs from " << edge << endl;
+        ++errors;
+        break;
+      }
+    }
+    cerr << "  " << routeds << " nets routed over " << grid->getGCellCount() << " GCells, "
+         << occupieds << " occupied Edges." << endl;
+    if (not occupieds) {
+      cerr << "  [ERROR] No Edge occupied, the routing did not happen." << endl;
+      ++errors;
+    }
+
+    Anabatic::Session::close();
+    delete dijkstra;
+    katana->destroy();
+    return errors;
+  }
+
+
+  int  testGridView ()
+  {
+    cerr << "testGridView:" << endl;
+    NoTrace  noTrace;
+
+    int errors = checkApart( checkGridView );
+    cerr << "testGridView: " << ((errors) ? "FAILED" : "passed") << "." << endl;
+    return errors;
+  }
+
+
+// -------------------------------------------------------------------
+// Test  :  "testEventRequeue".
+//
+// RoutingEventQueue::commit() on events already in the queue (a push
+// request of a queued event, with or without a change of level) must
+// move them, not insert them a second time. All the TrackSegments of
+// a small design are loaded, then all of them are re-queued, half
+// with a raised event level.
+
+
+  int  checkEventRequeue ()
+  {
+    int                   errors = 0;
+    Cell*                 top    = buildRouteDesign( "test_requeue", 2 );
+    Katana::KatanaEngine* katana = Katana::KatanaEngine::create( top );
+    katana->digitalInit();
+    katana->runGlobalRouter();
+    katana->loadGlobalRouting( Anabatic::EngineLoadGrByNet );
+    katana->layerAssign( Anabatic::EngineNoNetLayerAssign );
+    katana->openSession();
+
+    Katana::NegociateWindow* window = Katana::NegociateWindow::create( katana );
+    window->setGCells( katana->getGCells() );
+
+    for ( Anabatic::GCell* gcell : katana->getGCells() ) window->_createRouting( gcell );
+
+    set<Katana::TrackElement*>  elements;
+    for ( auto item : katana->_getAutoSegmentLut() ) {
+      Katana::TrackElement* element = Katana::Session::lookup( item.second );
+      if (    element and not element->getTrack()
+         and  element->getDataNegociate()
+         and  not element->getDataNegociate()->getRoutingEvent())
+        elements.insert( element );
+    }
+
+    Katana::RoutingEventQueue  queue;
+    queue.load( vector<Katana::TrackElement*>( elements.begin(), elements.end() ));
+    size_t loaded = queue.size();
+
+    set<Katana::RoutingEvent*>  events;
+    for ( Katana::TrackElement* element : elements ) {
+      Katana::RoutingEvent* event = element->getDataNegociate()->getRoutingEvent();
+      if (events.size() % 2) event->setEventLevel( event->getEventLevel()+1 );
+      events.insert( event );
+      queue.push( event );
+    }
+    queue.commit();
+
+    cerr << "  " << loaded << " events loaded, " << queue.size() << " after the re-queue ("
+         << queue.getRepushCount() << " moved)." << endl;
+    if (not loaded) {
+      cerr << "  [ERROR] No TrackSegment to load." << endl;
+      ++errors;
+    }
+    if ((queue.size() != loaded) or (queue.getRepushCount() != loaded)) {
+      cerr << "  [ERROR] Re-queued events have been inserted twice." << endl;
+      ++errors;
+    }
+
+    Katana::RoutingEvent::Compare  compare;
+    Katana::RoutingEvent*          previous = NULL;
+    set<Katana::RoutingEvent*>     poppeds;
+    while ( not queue.empty() ) {
+      Katana::RoutingEvent* event = queue.pop();
+      if (not poppeds.insert(event).second) {
+        cerr << "  [ERROR] Event popped twice " << event << endl;
+        ++errors;
+        break;
+      }
+      if (previous and compare(previous,event)) {
+        cerr << "  [ERROR] Events popped out of order " << event << endl;
+        ++errors;
+        break;
+      }
+      previous = event;
+    }
+    if (poppeds != events) {
+      cerr << "  [ERROR] Popped events differs from the loaded ones." << endl;
+      ++errors;
+    }
+    return errors;
+  }
+
+
+  int  testEventRequeue ()
+  {
+    cerr << "testEventRequeue:" << endl;
+    NoTrace  noTrace;
+
+    int errors = checkApart( checkEventRequeue );
+    cerr << "testEventRequeue: " << ((errors) ? "FAILED" : "passed") << "." << endl;
+    return errors;
+  }
+
+
+// -------------------------------------------------------------------
+// Benchmark  :  "benchGds".
+//
+// Write a synthetic GDSII library, (size*8)^2 leaf structures of 256
+// boundaries each plus a top structure referencing them, then time
+// it's loading through Gds::load(). The raw read time of the file is
+// given as the I/O floor.
+
+
+  class BenchGdsWriter {
+    public:
+      inline       BenchGdsWriter ( const string& path );
+      inline void  record         ( uint16_t type, const void* data=NULL, size_t size=0 );
+      inline void  int16s         ( uint16_t type, std::initializer_list<int16_t> );
+      inline void  int32s         ( uint16_t type, const vector<int32_t>& );
+      inline void  text           ( uint16_t type, const string& );
+      inline void  reals          ( uint16_t type, std::initializer_list<double> );
+    private:
+      std::ofstream  _stream;
+  };
+
+
+  inline BenchGdsWriter::BenchGdsWriter ( const string& path )
+    : _stream(path,std::ios::binary)
+  { }
+
+
+  inline void  BenchGdsWriter::record ( uint16_t type, const void* data, size_t size )
+  {
+    uint8_t header[4] = { (uint8_t)((size+4) >> 8), (uint8_t)(size+4), (uint8_t)(type >> 8), (uint8_t)type };
+    _stream.write( (const char*)header, 4 );
+    if (size) _stream.write( (const char*)data, size );
+  }
+
+
+  inline void  BenchGdsWriter::int16s ( uint16_t type, std::initializer_list<int16_t> values )
+  {
+    vector<uint8_t> data;
+    for ( int16_t value : values ) { data.push_back( (uint16_t)value >> 8 ); data.push_back( value ); }
+    record( type, data.data(), data.size() );
+  }
+
+
+  inline void  BenchGdsWriter::int32s ( uint16_t type, const vector<int32_t>& values )
+  {
+    vector<uint8_t> data;
+    for ( int32_t value : values ) {
+      for ( int shift=24 ; shift>=0 ; shift-=8 ) data.push_back( (uint32_t)value >> shift );
+    }
+    record( type, data.data(), data.size() );
+  }
+
+
+  inline void  BenchGdsWriter::text ( uint16_t type, const string& s )
+  {
+    string padded = s;
+    if (padded.size() % 2) padded.push_back( (char)0 );
+    record( type, padded.data(), padded.size() );
+  }
+
+
+// GDSII excess-64, base 16 real.
+  inline void  BenchGdsWriter::reals ( uint16_t type, std::initializer_list<double> values )
+  {
+    vector<uint8_t> data;
+    for ( double value : values ) {
+      uint64_t encoded = 0;
+      if (value != 0.0) {
+        uint64_t sign     = (value < 0.0) ? 1 : 0;
+        int      exponent = 64;
+        value = std::fabs( value );
+        while ( value >= 1.0      ) { value /= 16.0; ++exponent; }
+        while ( value <  1.0/16.0 ) { value *= 16.0; --exponent; }
+        uint64_t mantissa = (uint64_t)std::ldexp( value, 56 );
+        encoded = (sign << 63) | ((uint64_t)exponent << 56) | (mantissa & 0x00ffffffffffffffULL);
+      }
+      for ( int shift=56 ; shift>=0 ; shift-=8 ) data.push_back( encoded >> shift );
+    }
+    record( type, data.data(), data.size() );
+  }
+
+
+  int  benchGds ( unsigned int size )
+  {
+    const uint16_t  HEADER   = 0x0002;
+    const uint16_t  BGNLIB   = 0x0102;
+    const uint16_t  LIBNAME  = 0x0206;
+    const uint16_t  UNITS    = 0x0305;
+    const uint16_t  ENDLIB   = 0x0400;
+    const uint16_t  BGNSTR   = 0x0502;
+    const uint16_t  STRNAME  = 0x0606;
+    const uint16_t  ENDSTR   = 0x0700;
+    const uint16_t  BOUNDARY = 0x0800;
+    const uint16_t  SREF     = 0x0a00;
+    const uint16_t  LAYER    = 0x0d02;
+    const uint16_t  DATATYPE = 0x0e02;
+    const uint16_t  XY       = 0x1003;
+    const uint16_t  ENDEL    = 0x1100;
+    const uint16_t  SNAME    = 0x1206;
+
+    DataBase*   db      = DataBase::getDB();
+    if (not db) db = DataBase::create();
+    Technology* tech    = db->getTechnology();
+    if (not tech) tech = Technology::create( db, "bench" );
+    BasicLayer* metal1  = getBenchLayer( tech, "bench.METAL1", BasicLayer::Material::metal );
+    metal1->setGds2Layer   ( 1 );
+    metal1->setGds2Datatype( 0 );
+    Library*    rootLib = db->getRootLibrary();
+    if (not rootLib) rootLib = Library::create( db, "RootLibrary" );
+    Library*    library = Library::create( rootLib, "benchGds" );
+
+    NoTrace            noTrace;
+    const string       path       = "benchGds.gds";
+    const unsigned int leafs      = size*size*64;
+    const unsigned int boundaries = 256;
+    const int32_t      pitch      = 400;
+    {
+      BenchGdsWriter gds ( path );
+      gds.int16s( HEADER , { 600 } );
+      gds.int16s( BGNLIB , { 1,1,1,1,1,1, 1,1,1,1,1,1 } );
+      gds.text  ( LIBNAME, "benchGds" );
+      gds.reals ( UNITS  , { 0.001, 1e-9 } );
+      for ( unsigned int ileaf=0 ; ileaf<leafs ; ++ileaf ) {
+        gds.int16s( BGNSTR , { 1,1,1,1,1,1, 1,1,1,1,1,1 } );
+        gds.text  ( STRNAME, "leaf_"+getString(ileaf) );
+        for ( unsigned int i=0 ; i<boundaries ; ++i ) {
+          int32_t x = (i % 16) * pitch;
+          int32_t y = (i / 16) * pitch;
+          gds.record( BOUNDARY );
+          gds.int16s( LAYER   , { 1 } );
+          gds.int16s( DATATYPE, { 0 } );
+          gds.int32s( XY, { x,y, x+pitch/2,y, x+pitch/2,y+pitch/2, x,y+pitch/2, x,y } );
+          gds.record( ENDEL );
+        }
+        gds.record( ENDSTR );
+      }
+      gds.int16s( BGNSTR , { 1,1,1,1,1,1, 1,1,1,1,1,1 } );
+      gds.text  ( STRNAME, "top" );
+      for ( unsigned int ileaf=0 ; ileaf<leafs ; ++ileaf ) {
+        gds.record( SREF );
+        gds.text  ( SNAME, "leaf_"+getString(ileaf) );
+        gds.int32s( XY, { (int32_t)(ileaf % (size*8)) * 16*pitch, (int32_t)(ileaf / (size*8)) * 16*pitch } );
+        gds.record( ENDEL );
+      }
+      gds.record( ENDSTR );
+      gds.record( ENDLIB );
+    }
+
+    auto   start  = std::chrono::high_resolution_clock::now();
+    size_t length = 0;
+    {
+      std::ifstream  stream ( path, std::ios::binary );
+      vector<char>   chunk  ( 1<<16 );
+      while ( stream.read(chunk.data(),chunk.size()) or stream.gcount() ) length += stream.gcount();
+    }
+    std::chrono::duration<double> raw = std::chrono::high_resolution_clock::now() - start;
+
+    start = std::chrono::high_resolution_clock::now();
+    Gds::load( library, path );
+    std::chrono::duration<double> load = std::chrono::high_resolution_clock::now() - start;
+
+    double megabytes = (double)length / (1024.0*1024.0);
+    cerr << "GDSII load of " << (leafs+1) << " structures, "
+         << (size_t)leafs*boundaries << " boundaries (" << fixed << setprecision(1) << megabytes << " Mb):" << endl;
+    cerr << "  raw read:"  << setw(9) << setprecision(3) << raw .count() << "s"
+         << " (" << setprecision(1) << (megabytes / raw .count()) << " Mb/s)" << endl;
+    cerr << "  Gds::load:" << setw(8) << setprecision(3) << load.count() << "s"
+         << " (" << setprecision(1) << (megabytes / load.count()) << " Mb/s)" << endl;
+
+    std::remove( path.c_str() );
+
+    size_t cells = library->getCells().getSize();
+    if (cells != leafs+1) {
+      cerr << "  [ERROR] Loaded " << cells << " structures instead of " << (leafs+1) << "." << endl;
+      return 1;
+    }
+    return 0;
+  }
+
+
+// -------------------------------------------------------------------
+// Test  :  "testGdsShortRecords".
+//
+// Records whose length is too short for their fixed size fields (UNITS
+// with one real, LAYER without data) must be rejected by Gds::load()
+// instead of having their fields read from the next record.
+
+
+  int  testGdsShortRecords ()
+  {
+    const uint16_t  HEADER   = 0x0002;
+    const uint16_t  BGNLIB   = 0x0102;
+    const uint16_t  LIBNAME  = 0x0206;
+    const uint16_t  UNITS    = 0x0305;
+    const uint16_t  ENDLIB   = 0x0400;
+    const uint16_t  BGNSTR   = 0x0502;
+    const uint16_t  STRNAME  = 0x0606;
+    const uint16_t  ENDSTR   = 0x0700;
+    const uint16_t  BOUNDARY = 0x0800;
+    const uint16_t  LAYER    = 0x0d02;
+    const uint16_t  DATATYPE = 0x0e02;
+    const uint16_t  XY       = 0x1003;
+    const uint16_t  ENDEL    = 0x1100;
+
+    DataBase*   db      = DataBase::getDB();
+    if (not db) db = DataBase::create();
+    Technology* tech    = db->getTechnology();
+    if (not tech) tech = Technology::create( db, "bench" );
+    BasicLayer* metal1  = getBenchLayer( tech, "bench.METAL1", BasicLayer::Material::metal );
+    metal1->setGds2Layer   ( 1 );
+    metal1->setGds2Datatype( 0 );
+    Library*    rootLib = db->getRootLibrary();
+    if (not rootLib) rootLib = Library::create( db, "RootLibrary" );
+
+    NoTrace      noTrace;
+    const string path   = "testGdsShort.gds";
+    int          errors = 0;
+    for ( size_t icase=0 ; icase<3 ; ++icase ) {
+      {
+        BenchGdsWriter gds ( path );
+        gds.int16s( HEADER , { 600 } );
+        gds.int16s( BGNLIB , { 1,1,1,1,1,1, 1,1,1,1,1,1 } );
+        gds.text  ( LIBNAME, "testGdsShort" );
+        if (icase == 1) gds.reals ( UNITS, { 0.001 } );
+        else            gds.reals ( UNITS, { 0.001, 1e-9 } );
+        gds.int16s( BGNSTR , { 1,1,1,1,1,1, 1,1,1,1,1,1 } );
+        gds.text  ( STRNAME, "short_"+getString(icase) );
+        gds.record( BOUNDARY );
+        if (icase == 2) gds.record( LAYER );
+        else            gds.int16s( LAYER, { 1 } );
+        gds.int16s( DATATYPE, { 0 } );
+        gds.int32s( XY, { 0,0, 200,0, 200,200, 0,200, 0,0 } );
+        gds.record( ENDEL );
+        gds.record( ENDSTR );
+        gds.record( ENDLIB );
+      }
+
+      Library* library = Library::create( rootLib, "testGdsShort_"+getString(icase) );
+      bool     loaded  = Gds::load( library, path );
+      if (loaded != (icase == 0)) {
+        cerr << "  [ERROR] Case " << icase << ": Gds::load() returned " << loaded << "." << endl;
+        ++errors;
+      }
+    }
+    std::remove( path.c_str() );
+
+    cerr << "GDSII short records: " << ((errors) ? "failed." : "passed.") << endl;
+    return errors;
+  }
+
+
+// -------------------------------------------------------------------
+// Benchmark  :  "benchNetMap".
+//
+// Create (size*32)^2 Nets in a Cell, with names shaped like the ones
+// of a flattened synthesized netlist, then time the lookups through
+// Cell::getNet(), hits in random order and misses. The creation is
+// timed with and without a Cell::reserveNets() beforehand. The Names
+// are interned before the timings, so only the map is measured.
+
+
+  double  benchNetMapPass ( Library* library, const string& cellName, const vector<Name>& names, bool reserve )
+  {
+    Cell* cell  = Cell::create( library, cellName );
+    auto  start = std::chrono::steady_clock::now();
+    if (reserve) cell->reserveNets( names.size() );
+    for ( const Name& name : names ) Net::create( cell, name );
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+  }
+
+
+  int  benchNetMap ( unsigned int size )
+  {
+    DataBase*   db      = DataBase::getDB();
+    if (not db) db = DataBase::create();
+    Library*    rootLib = db->getRootLibrary();
+    if (not rootLib) rootLib = Library::create( db, "RootLibrary" );
+    Library*    library = Library::create( rootLib, "benchNetMap" );
+
+    const size_t  count = (size_t)size*size*1024;
+    std::mt19937  rng   ( 42 );
+    vector<Name>  names;
+    vector<Name>  misses;
+    names .reserve( count );
+    misses.reserve( count );
+    for ( size_t i=0 ; i<count ; ++i ) {
+      ostringstream name;
+      switch ( i % 4 ) {
+        case 0: name << "core.alu_" << (i/4)%64 << ".adder_" << (i/256)%128 << ".sum(" << i/32768 << ")"; break;
+        case 1: name << "core.regfile.r" << (i/4)%32 << "_q(" << (i/128) << ")"; break;
+        case 2: name << "mbk_sig" << i; break;
+        case 3: name << "abc_" << (i/4) << "_new_n" << rng()%100000 << "_"; break;
+      }
+      names .push_back( Name(name.str()) );
+      misses.push_back( Name(name.str()+"_x") );
+    }
+
+    double create  = benchNetMapPass( library, "benchNetMap"       , names, false );
+    double reserve = benchNetMapPass( library, "benchNetMapReserve", names, true  );
+    Cell*  cell    = library->getCell( "benchNetMap" );
+
+    vector<size_t> order ( count );
+    for ( size_t i=0 ; i<count ; ++i ) order[i] = i;
+    std::shuffle( order.begin(), order.end(), rng );
+
+    size_t found = 0;
+    auto   start = std::chrono::steady_clock::now();
+    for ( size_t i : order ) {
+      Net* net = cell->getNet( names[i] );
+      if (net and (net->getName() == names[i])) ++found;
+    }
+    std::chrono::duration<double> hits = std::chrono::steady_clock::now() - start;
+
+    size_t wrongs = 0;
+    start = std::chrono::steady_clock::now();
+    for ( size_t i : order ) {
+      if (cell->getNet(misses[i])) ++wrongs;
+    }
+    std::chrono::duration<double> fails = std::chrono::steady_clock::now() - start;
+
+    double ns = 1e9 / (double)count;
+    cerr << "Cell::NetMap with " << count << " nets:" << endl;
+    cerr << "  Net::create()        " << setw(8) << fixed << setprecision(3) << create << "s"
+         << " (" << setprecision(1) << create*ns << " ns/net)" << endl;
+    cerr << "  reserve + create()   " << setw(8) << setprecision(3) << reserve << "s"
+         << " (" << setprecision(1) << reserve*ns << " ns/net)" << endl;
+    cerr << "  getNet() hits        " << setw(8) << setprecision(3) << hits.count() << "s"
+         << " (" << setprecision(1) << hits.count()*ns << " ns/lookup)" << endl;
+    cerr << "  getNet() misses      " << setw(8) << setprecision(3) << fails.count() << "s"
+         << " (" << setprecision(1) << fails.count()*ns << " ns/lookup)" << endl;
+
+    if ((found != count) or wrongs) {
+      cerr << "  [ERROR] " << (count-found) << " nets not found, " << wrongs << " false hits." << endl;
+      return 1;
+    }
+    return 0;
+  }
+
+
+
+// -------------------------------------------------------------------
+// Test  :  "testNetMapIterate".
+//
+// Modify the Cell NetMap while iterating over it with for_each_net:
+// destroy or rename the current Net, destroy Nets not visited yet and
+// create new ones (which makes the table grow). Every original Net must
+// be visited exactly once unless it has been destroyed before (a renamed
+// one may be visited again under it's new name).
+
+
+  int  testNetMapIterate ()
+  {
+    NoTrace     noTrace;
+    DataBase*   db      = DataBase::getDB();
+    if (not db) db = DataBase::create();
+    Library*    rootLib = db->getRootLibrary();
+    if (not rootLib) rootLib = Library::create( db, "RootLibrary" );
+    Library*    library = Library::create( rootLib, "testNetMapIterate" );
+    Cell*       cell    = Cell::create( library, "testNetMapIterate" );
+
+    const size_t     count = 5000;
+    std::mt19937     rng   ( 42 );
+    vector<unsigned int>       ids;
+    map<unsigned int,Net*>     pending;
+    for ( size_t i=0 ; i<count ; ++i ) {
+      Net* net = Net::create( cell, "n"+getString(i) );
+      ids.push_back( net->getId() );
+      pending[ net->getId() ] = net;
+    }
+
+  // Nets are identified by their ids, as the memory of a destroyed one
+  // is reused by the created ones.
+    set<unsigned int>          renameds;
+    map<unsigned int,size_t>   visits;
+    size_t           created = 0;
+    size_t           iter    = 0;
+    for_each_net( net, cell->getNets() ) {
+      visits[ net->getId() ]++;
+      pending.erase( net->getId() );
+      if (renameds.count(net->getId())) continue;
+
+      switch ( iter++ % 4 ) {
+        case 0: net->destroy(); break;
+        case 1:
+          net->setName( getString(net->getName()) + "_r" );
+          renameds.insert( net->getId() );
+          break;
+        case 2:
+          if (not pending.empty()) {
+            auto inet = pending.begin();
+            std::advance( inet, rng() % pending.size() );
+            visits[inet->first] = 0;
+            inet->second->destroy();
+            pending.erase( inet );
+          }
+          break;
+        case 3:
+          Net::create( cell, "new"+getString(created++) );
+          Net::create( cell, "new"+getString(created++) );
+          break;
+      }
+      end_for;
+    }
+
+    size_t errors = 0;
+    for ( unsigned int id : ids ) {
+      auto ivisit = visits.find( id );
+      if (ivisit == visits.end()) {
+        if (++errors < 10) cerr << "  [ERROR] Net never visited." << endl;
+        continue;
+      }
+      size_t maxVisits = (renameds.count(id)) ? 2 : 1;
+      if (ivisit->second > maxVisits) {
+        if (++errors < 10) cerr << "  [ERROR] Net visited " << ivisit->second << " times." << endl;
+      }
+    }
+    cerr << "testNetMapIterate: " << count << " nets, " << renameds.size() << " renamed, "
+         << created << " created, " << cell->getNets().getSize() << " remaining." << endl;
+    cerr << "testNetMapIterate: " << ((errors) ? "failed." : "passed.") << endl;
+    return (errors) ? 1 : 0;
+  }
+
+
+// -------------------------------------------------------------------
+// Test  :  "testBulkBuild".
+//
+// Cell::BulkBuildGuard, nested sessions (a master bulk built while
+// it's owner is) and error path (exception thrown inside the session).
+// Each Cell must be materialized when it's own session is closed, and
+// the auto-materialization restored when the last one is.
+
+
+  int  testBulkBuild ()
+  {
+    NoTrace     noTrace;
+    DataBase*   db      = DataBase::getDB();
+    if (not db) db = DataBase::create();
+    Technology* tech    = db->getTechnology();
+    if (not tech) tech = Technology::create( db, "bench" );
+    BasicLayer* metal1  = getBenchLayer( tech, "bench.METAL1", BasicLayer::Material::metal );
+    Library*    rootLib = db->getRootLibrary();
+    if (not rootLib) rootLib = Library::create( db, "RootLibrary" );
+    Library*    library = Library::create( rootLib, "testBulkBuild" );
+    DbU::Unit   l       = DbU::fromLambda( 1.0 );
+
+    size_t errors = 0;
+    auto   check  = [&] ( bool condition, const char* message ) {
+                      if (not condition) { cerr << "  [ERROR] " << message << endl; ++errors; }
+                    };
+
+    Go::enableAutoMaterialization();
+    Cell*      owner       = Cell::create( library, "owner" );
+    Cell*      master      = Cell::create( library, "master" );
+    Component* ownerWire   = NULL;
+    Component* masterWire  = NULL;
+    {
+      Cell::BulkBuildGuard ownerBulk ( owner );
+      ownerWire = Horizontal::create( Net::create(owner,"a"), metal1, 5*l, 2*l, 0, 20*l );
+      {
+        Cell::BulkBuildGuard masterBulk ( master );
+        masterWire = Horizontal::create( Net::create(master,"b"), metal1, 5*l, 2*l, 0, 20*l );
+        check( not masterWire->isMaterialized(), "Component materialized inside the session." );
+        masterBulk.close();
+      }
+      check( not master->isInBulkBuild()     , "Nested Cell still in bulk build." );
+      check( masterWire->isMaterialized()     , "Nested Cell not materialized on close." );
+      check( not ownerWire->isMaterialized()  , "Owner materialized by the nested close." );
+      check( Go::autoMaterializationIsDisabled(), "Auto-materialization restored by the nested close." );
+      ownerBulk.close();
+    }
+    check( ownerWire->isMaterialized()           , "Owner Cell not materialized on close." );
+    check( not Go::autoMaterializationIsDisabled(), "Auto-materialization not restored." );
+
+    Cell*      failed     = Cell::create( library, "failed" );
+    Component* failedWire = NULL;
+    try {
+      Cell::BulkBuildGuard failedBulk ( failed );
+      failedWire = Horizontal::create( Net::create(failed,"c"), metal1, 5*l, 2*l, 0, 20*l );
+      throw Error( "testBulkBuild(): Parser error." );
+    } catch ( const Error& ) {
+    }
+    check( not failed->isInBulkBuild()            , "Cell still in bulk build after an error." );
+    check( failedWire->isMaterialized()            , "Cell not materialized after an error." );
+    check( not Go::autoMaterializationIsDisabled(), "Auto-materialization not restored after an error." );
+
+    cerr << "testBulkBuild: " << ((errors) ? "failed." : "passed.") << endl;
+    return (errors) ? 1 : 0;
+  }
+
+
+// -------------------------------------------------------------------
+// Benchmark  :  "benchPaths".
+//
+// Build a hierarchy of four levels of 8 instances under a top Cell of
+// size*size blocks, then walk all the terminal instance Occurrences.
+// The first walk creates the SharedPathes, the second one must only
+// find them back in the hash-consing table. The count and memory of
+// the SharedPathes are reported globally and per Cell.
+
+
+  double  benchPathsPass ( Cell* top, size_t& occurrences, set<SharedPath*>& sharedPathes )
+  {
+    auto start = std::chrono::steady_clock::now();
+    occurrences = 0;
+    for ( Occurrence occurrence : top->getTerminalInstanceOccurrences() ) {
+      sharedPathes.insert( occurrence.getPath()._getSharedPath() );
+      ++occurrences;
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+  }
+
+
+  int  benchPaths ( unsigned int size )
+  {
+    DataBase*   db      = DataBase::getDB();
+    if (not db) db = DataBase::create();
+    Library*    rootLib = db->getRootLibrary();
+    if (not rootLib) rootLib = Library::create( db, "RootLibrary" );
+    Library*    library = Library::create( rootLib, "benchPaths" );
+
+    const unsigned int levels = 4;
+    vector<Cell*>      cells;
+
+    UpdateSession::open();
+    cells.push_back( Cell::create( library, "level_0" ) );
+    for ( unsigned int level=1 ; level<=levels ; ++level ) {
+      Cell* cell = Cell::create( library, "level_"+getString(level) );
+      for ( unsigned int i=0 ; i<8 ; ++i )
+        Instance::create( cell, "i"+getString(i), cells.back() );
+      cells.push_back( cell );
+    }
+    Cell* top = Cell::create( library, "top" );
+    for ( unsigned int i=0 ; i<size*size ; ++i )
+      Instance::create( top, "block_"+getString(i), cells.back() );
+    cells.push_back( top );
+    UpdateSession::close();
+
+    size_t           occurrences = 0;
+    size_t           baseCount   = SharedPath::getCount();
+    set<SharedPath*> sharedPathes;
+    double create  = benchPathsPass( top, occurrences, sharedPathes );
+    size_t created = SharedPath::getCount() - baseCount;
+    double lookup  = benchPathsPass( top, occurrences, sharedPathes );
+
+    size_t wrongs = 0;
+    for ( SharedPath* sharedPath : sharedPathes ) {
+      if (SharedPath::getFromId(sharedPath->getId()) != sharedPath) ++wrongs;
+    }
+
+    cerr << "SharedPathes of " << occurrences << " terminal instance occurrences:" << endl;
+    cerr << "  first walk (create)  " << setw(8) << fixed << setprecision(3) << create << "s" << endl;
+    cerr << "  second walk (lookup) " << setw(8) << setprecision(3) << lookup << "s" << endl;
+    cerr << "  " << created << " SharedPathes, " << SharedPath::getAllocatedSize()/1024 << " Kb allocated"
+         << " (" << setprecision(1) << (double)SharedPath::getAllocatedSize()/(double)SharedPath::getCount()
+         << " bytes/path)" << endl;
+    for ( Cell* cell : cells ) {
+      if (not cell->getSharedPathCount()) continue;
+      cerr << "    " << left << setw(10) << getString(cell->getName()) << right
+           << setw(10) << cell->getSharedPathCount() << " pathes "
+           << setw(10) << cell->getSharedPathMemorySize() << " bytes" << endl;
+    }
+
+    if ((SharedPath::getCount() != baseCount + created) or wrongs) {
+      cerr << "  [ERROR] SharedPathes created on the second walk or bad ids (" << wrongs << ")." << endl;
+      return 1;
+    }
+    return 0;
+  }
+
+
+
+// -------------------------------------------------------------------
+// Benchmark  :  "benchFlatten".
+//
+// A top Cell of size*size blocks of 8 chained leaf cells (terminal
+// netlist), the blocks being chained too. Each block has also 8
+// internal nets, so both DeepNets and top nets are flattened. Two
+// identical top Cells are flattened, serially and in parallel, and
+// the created DeepNets & RoutingPads must be the same.
+
+
+  Cell* buildFlattenTop ( Library* library, const string& name, Cell* block, unsigned int blocks )
+  {
+    Cell* top      = Cell::create( library, name );
+    Net*  previous = NULL;
+    for ( unsigned int i=0 ; i<blocks ; ++i ) {
+      Instance* instance = Instance::create( top, "block_"+getString(i), block );
+      if (previous) instance->getPlug( block->getNet("i") )->setNet( previous );
+      previous = Net::create( top, "n_"+getString(i) );
+      instance->getPlug( block->getNet("q") )->setNet( previous );
+    }
+    return top;
+  }
+
+
+  double  benchFlattenPass ( Cell* top, uint64_t flags, size_t& deepNets, size_t& routingPads, unsigned int threads=1 )
+  {
+    auto start = std::chrono::steady_clock::now();
+    top->flattenNets( NULL, std::set<std::string>(), flags, threads );
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    deepNets    = 0;
+    routingPads = 0;
+    for ( Net* net : top->getNets() ) {
+      if (net->isDeepNet()) ++deepNets;
+      routingPads += net->getRoutingPads().getSize();
+    }
+    return elapsed.count();
+  }
+
+
+  int  benchFlatten ( unsigned int size )
+  {
+    DataBase*   db      = DataBase::getDB();
+    if (not db) db = DataBase::create();
+    Library*    rootLib = db->getRootLibrary();
+    if (not rootLib) rootLib = Library::create( db, "RootLibrary" );
+    Library*    library = Library::create( rootLib, "benchFlatten" );
+
+    UpdateSession::open();
+    Cell* leaf = Cell::create( library, "leaf" );
+    Net::create( leaf, "i" )->setExternal( true );
+    Net::create( leaf, "q" )->setExternal( true );
+    leaf->setTerminalNetlist( true );
+
+    Cell* block = Cell::create( library, "block" );
+    Net*  input = Net::create( block, "i" );
+    input->setExternal( true );
+    Net*  previous = input;
+    for ( unsigned int i=0 ; i<8 ; ++i ) {
+      Instance* instance = Instance::create( block, "leaf_"+getString(i), leaf );
+      instance->getPlug( leaf->getNet("i") )->setNet( previous );
+      previous = Net::create( block, (i<7) ? "n_"+getString(i) : string("q") );
+      instance->getPlug( leaf->getNet("q") )->setNet( previous );
+    }
+    previous->setExternal( true );
+
+    Cell* serialTop   = buildFlattenTop( library, "serial"  , block, size*size*64 );
+    Cell* parallelTop = buildFlattenTop( library, "parallel", block, size*size*64 );
+    UpdateSession::close();
+
+    size_t serialDeeps   = 0;
+    size_t serialRps     = 0;
+    size_t parallelDeeps = 0;
+    size_t parallelRps   = 0;
+    double serial   = benchFlattenPass( serialTop  , Cell::Flags::NoFlags        , serialDeeps  , serialRps   );
+    double parallel = benchFlattenPass( parallelTop, Cell::Flags::ParallelFlatten, parallelDeeps, parallelRps
+                                      , std::thread::hardware_concurrency() );
+
+    cerr << "Cell::flattenNets() on " << size*size*64*8 << " leaf instances:" << endl;
+    cerr << "  serial               " << setw(8) << fixed << setprecision(3) << serial << "s"
+         << " (" << serialDeeps << " DeepNets, " << serialRps << " RoutingPads)" << endl;
+    cerr << "  parallel             " << setw(8) << setprecision(3) << parallel << "s"
+         << " (" << std::thread::hardware_concurrency() << " threads)" << endl;
+
+    if ((serialDeeps != parallelDeeps) or (serialRps != parallelRps)) {
+      cerr << "  [ERROR] Parallel flatten differs: " << parallelDeeps << " DeepNets, "
+           << parallelRps << " RoutingPads." << endl;
+      return 1;
+    }
+    return 0;
+  }
+
+
+
+// -------------------------------------------------------------------
+// Benchmark  :  "benchUpdate".
+//
+// All the instances of a flat Cell of size*size*64 leaf cells are
+// moved, first in one UpdateSession per instance (each move rebalance
+// the QuadTree, as before the batching), then all at once in a single
+// UpdateSession. The QuadTree must still find every instance.
+
+
+  double  benchUpdatePass ( Cell* top, const vector<Instance*>& instances, std::mt19937& generator, bool batched )
+  {
+    DbU::Unit  side = top->getAbutmentBox().getWidth() - DbU::fromLambda(10.0);
+    std::uniform_int_distribution<DbU::Unit>  position ( 0, side );
+
+    auto start = std::chrono::steady_clock::now();
+    if (batched) UpdateSession::open();
+    for ( Instance* instance : instances ) {
+      if (not batched) UpdateSession::open();
+      instance->setTransformation( Transformation( position(generator), position(generator) ) );
+      if (not batched) UpdateSession::close();
+    }
+    if (batched) UpdateSession::close();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+  }
+
+
+  int  benchUpdate ( unsigned int size )
+  {
+    DataBase*   db      = DataBase::getDB();
+    if (not db) db = DataBase::create();
+    Library*    rootLib = db->getRootLibrary();
+    if (not rootLib) rootLib = Library::create( db, "RootLibrary" );
+    Library*    library = Library::create( rootLib, "benchUpdate" );
+
+    size_t     count = size*size*64;
+    DbU::Unit  side  = DbU::fromLambda( 10.0 * std::sqrt((double)count) * 2.0 );
+
+    UpdateSession::open();
+    Cell* leaf = Cell::create( library, "leaf" );
+    leaf->setAbutmentBox( Box( 0, 0, DbU::fromLambda(10.0), DbU::fromLambda(10.0) ) );
+    leaf->setTerminalNetlist( true );
+
+    Cell* top = Cell::create( library, "top" );
+    top->setAbutmentBox( Box( 0, 0, side, side ) );
+    vector<Instance*>  instances;
+    for ( size_t i=0 ; i<count ; ++i )
+      instances.push_back( Instance::create( top, "leaf_"+getString(i), leaf ) );
+    UpdateSession::close();
+
+    std::mt19937  generator ( 1 );
+    double incremental = benchUpdatePass( top, instances, generator, false );
+    double batched     = benchUpdatePass( top, instances, generator, true  );
+
+    cerr << "UpdateSession, moving " << count << " instances:" << endl;
+    cerr << "  one session per move " << setw(8) << fixed << setprecision(3) << incremental << "s" << endl;
+    cerr << "  single session       " << setw(8) << setprecision(3) << batched << "s"
+         << " (" << UpdateSession::getLastInvalidations() << " invalidations)" << endl;
+
+    size_t found = top->getInstancesUnder( top->getAbutmentBox() ).getSize();
+    if (found != count) {
+      cerr << "  [ERROR] QuadTree lookup found " << found << " instances instead of " << count << "." << endl;
+      return 1;
+    }
+    return 0;
+  }
+
+
+
+// -------------------------------------------------------------------
+// Benchmark  :  "benchSnapshot".
+//
+// A top Cell of size*size*64 blocks of 8 terminal leaf cells, with
+// flattened nets and a small routing (contacts anchored on the
+// RoutingPads, one horizontal & one vertical) on each top net. It is
+// saved as a Snapshot, destroyed, then re-loaded (eagerly & lazily),
+// the counts of Nets, Instances & Components must be the same.
+
+
+  string  snapshotSignature ( Cell* cell )
+  {
+    size_t nets       = 0;
+    size_t instances  = cell->getInstances().getSize();
+    size_t components = 0;
+    size_t plugs      = 0;
+    for ( Net* net : cell->getNets() ) {
+      ++nets;
+      for ( Component* component : net->getComponents() ) {
+        if (dynamic_cast<Plug*>(component)) ++plugs;
+        else                                ++components;
+      }
+    }
+    return getString(nets)+" nets, "+getString(instances)+" instances, "
+          +getString(components)+" components, "+getString(plugs)+" connected plugs";
+  }
+
+
+  int  benchSnapshot ( unsigned int size )
+  {
+    DataBase*   db      = DataBase::getDB();
+    if (not db) db = DataBase::create();
+    Library*    rootLib = db->getRootLibrary();
+    if (not rootLib) rootLib = Library::create( db, "RootLibrary" );
+    Library*    library = Library::create( rootLib, "benchSnapshot" );
+    Technology* tech    = db->getTechnology();
+    if (not tech) tech = Technology::create( db, "bench" );
+    BasicLayer* metal1  = getBenchLayer( tech, "bench.METAL1", BasicLayer::Material::metal );
+    BasicLayer* metal2  = getBenchLayer( tech, "bench.METAL2", BasicLayer::Material::metal );
+    auto        l       = []( double value ) { return DbU::fromLambda(value); };
+    string      path    = "benchSnapshot.snap";
+
+    UpdateSession::open();
+    Cell* leaf = Cell::create( library, "leaf" );
+    leaf->setAbutmentBox( Box( 0, 0, l(10), l(50) ) );
+    Net*  leafI = Net::create( leaf, "i" );
+    Net*  leafQ = Net::create( leaf, "q" );
+    leafI->setExternal( true );
+    leafQ->setExternal( true );
+    NetExternalComponents::setExternal( Vertical::create( leafI, metal1, l(3), l(2), l(5), l(45) ) );
+    NetExternalComponents::setExternal( Vertical::create( leafQ, metal1, l(7), l(2), l(5), l(45) ) );
+    leaf->setTerminalNetlist( true );
+
+    Cell* block = Cell::create( library, "block" );
+    block->setAbutmentBox( Box( 0, 0, l(80), l(50) ) );
+    Net*  input = Net::create( block, "i" );
+    input->setExternal( true );
+    Net*  previous = input;
+    for ( unsigned int i=0 ; i<8 ; ++i ) {
+      Instance* instance = Instance::create( block, "leaf_"+getString(i), leaf
+                                           , Transformation( l(10*i), 0 )
+                                           , Instance::PlacementStatus::PLACED );
+      instance->getPlug( leafI )->setNet( previous );
+      previous = Net::create( block, (i<7) ? "n_"+getString(i) : string("q") );
+      instance->getPlug( leafQ )->setNet( previous );
+    }
+    previous->setExternal( true );
+
+    unsigned int side = size*8;
+    Cell*        top  = Cell::create( library, "top" );
+    top->setAbutmentBox( Box( 0, 0, l(80)*side, l(50)*side ) );
+    previous = NULL;
+    for ( unsigned int i=0 ; i<side*side ; ++i ) {
+      Instance* instance = Instance::create( top, "block_"+getString(i), block
+                                           , Transformation( l(80)*(i%side), l(50)*(i/side) )
+                                           , Instance::PlacementStatus::PLACED );
+      if (previous) instance->getPlug( input )->setNet( previous );
+      previous = Net::create( top, "n_"+getString(i) );
+      instance->getPlug( block->getNet("q") )->setNet( previous );
+    }
+    UpdateSession::close();
+
+    top->flattenNets( Cell::Flags::NoFlags );
+    UpdateSession::open();
+    for ( Net* net : top->getNets() ) {
+      vector<RoutingPad*>  rps;
+      for ( RoutingPad* rp : net->getRoutingPads() ) rps.push_back( rp );
+      if (rps.size() < 2) continue;
+      Contact* source = Contact::create( rps[0], metal1, 0, 0, l(2), l(2) );
+      Contact* target = Contact::create( rps[1], metal1, 0, 0, l(2), l(2) );
+      Contact* turn   = Contact::create( net, metal2, target->getX(), source->getY(), l(2), l(2) );
+      Horizontal::create( source, turn  , metal2, source->getY(), l(2) );
+      Vertical  ::create( turn  , target, metal1, target->getX(), l(2) );
+    }
+    UpdateSession::close();
+
+    string original = snapshotSignature( top );
+    auto   start    = std::chrono::steady_clock::now();
+    Snapshot::save( top, path );
+    std::chrono::duration<double> saveTime = std::chrono::steady_clock::now() - start;
+
+    double loadTimes [2];
+    string loadeds   [2];
+    for ( size_t lazy=0 ; lazy<2 ; ++lazy ) {
+      UpdateSession::open();
+      top  ->destroy();
+      block->destroy();
+      UpdateSession::close();
+
+      start = std::chrono::steady_clock::now();
+      top   = Snapshot::load( path, (lazy) ? Snapshot::LazyComponents : Snapshot::NoFlags );
+      std::chrono::duration<double> loadTime = std::chrono::steady_clock::now() - start;
+      loadTimes[lazy] = loadTime.count();
+      block = library->getCell( "block" );
+      Snapshot::materialize( top );
+      loadeds[lazy] = snapshotSignature( top );
+    }
+
+    std::ifstream file ( path, std::ios::binary|std::ios::ate );
+    cerr << "Snapshot of " << original << ":" << endl;
+    cerr << "  file size            " << setw(8) << file.tellg()/1024 << " Kb" << endl;
+    cerr << "  save                 " << setw(8) << fixed << setprecision(3) << saveTime.count() << "s" << endl;
+    cerr << "  load                 " << setw(8) << setprecision(3) << loadTimes[0] << "s" << endl;
+    cerr << "  load (lazy)          " << setw(8) << setprecision(3) << loadTimes[1] << "s"
+         << " (top components not created)" << endl;
+    std::remove( path.c_str() );
+
+    for ( const string& loaded : loadeds ) {
+      if (loaded != original) {
+        cerr << "  [ERROR] Reloaded Cell differs: " << loaded << "." << endl;
+        return 1;
+      }
+    }
+    return 0;
+  }
+
   
 }  // Anonymous namespace.
   
@@ -149,6 +2070,24 @@ int main ( int argc, char* argv[] )
     bool coreDump = false;
     bool rbTree   = false;
     bool intvTree = false;
+    bool packedRT = false;
+    bool benchQ   = false;
+    bool benchX   = false;
+    bool benchGR  = false;
+    bool batchGR  = false;
+    bool astarGR  = false;
+    bool gridView = false;
+    bool requeue  = false;
+    bool benchGDS = false;
+    bool gdsShort = false;
+    bool netMapIt = false;
+    bool bulkBld  = false;
+    bool benchNM  = false;
+    bool benchSP  = false;
+    bool benchFN  = false;
+    bool benchUS  = false;
+    bool benchSN  = false;
+    unsigned int benchSize = 16;
 
     boptions::options_description options ("Command line arguments & options");
     options.add_options()
@@ -158,7 +2097,43 @@ int main ( int argc, char* argv[] )
       ( "rb-tree"    , boptions::bool_switch(&rbTree  )->default_value(false)
                      , "Test of the red/black tree \"hurricane/RbTree.h\".")
       ( "intv-tree"  , boptions::bool_switch(&intvTree)->default_value(false)
-                     , "Test of the interval tree \"hurricane/IntervalTree.h\".");
+                     , "Test of the interval tree \"hurricane/IntervalTree.h\".")
+      ( "test-packed-rtree", boptions::bool_switch(&packedRT)->default_value(false)
+                     , "Test of the packed R-Tree (queries & modification while iterating).")
+      ( "bench-query", boptions::bool_switch(&benchQ  )->default_value(false)
+                     , "Benchmark of Query vs. ParallelQuery, hierarchical vs. flattened.")
+      ( "bench-extract", boptions::bool_switch(&benchX)->default_value(false)
+                     , "Benchmark of the Tramontana extraction (tiles, memory & threads).")
+      ( "bench-global-route", boptions::bool_switch(&benchGR)->default_value(false)
+                     , "Benchmark of the Katana global routing, Dijkstra multiset vs. d-ary heap queue.")
+      ( "test-global-batch", boptions::bool_switch(&batchGR)->default_value(false)
+                     , "Test of the Katana parallel global routing (same wiring as sequential).")
+      ( "test-global-astar", boptions::bool_switch(&astarGR)->default_value(false)
+                     , "Test of the Katana A* global routing (same costs, less expansions).")
+      ( "test-grid-view", boptions::bool_switch(&gridView)->default_value(false)
+                     , "Test of the Anabatic GridView (rebuild after a grid change, Edges copies).")
+      ( "test-event-requeue", boptions::bool_switch(&requeue)->default_value(false)
+                     , "Test of the Katana RoutingEventQueue (re-queue of queued events).")
+      ( "bench-gds"  , boptions::bool_switch(&benchGDS)->default_value(false)
+                     , "Benchmark of the GDSII loading (mapped file reader).")
+      ( "test-gds-short", boptions::bool_switch(&gdsShort)->default_value(false)
+                     , "Test of the GDSII reader on records too short for their fields.")
+      ( "bench-netmap", boptions::bool_switch(&benchNM)->default_value(false)
+                     , "Benchmark of the Cell Net map (creation & getNet() lookups).")
+      ( "test-netmap-iterate", boptions::bool_switch(&netMapIt)->default_value(false)
+                     , "Test of the Cell NetMap iteration while Nets are destroyed, renamed or created.")
+      ( "test-bulk-build", boptions::bool_switch(&bulkBld)->default_value(false)
+                     , "Test of the Cell bulk build sessions (nested & error path).")
+      ( "bench-paths", boptions::bool_switch(&benchSP )->default_value(false)
+                     , "Benchmark of the SharedPath hash-consing (deep hierarchy walk & memory).")
+      ( "bench-flatten", boptions::bool_switch(&benchFN)->default_value(false)
+                     , "Benchmark of Cell::flattenNets(), serial vs. parallel.")
+      ( "bench-update", boptions::bool_switch(&benchUS)->default_value(false)
+                     , "Benchmark of the UpdateSession (batched QuadTree rebalancing).")
+      ( "bench-snapshot", boptions::bool_switch(&benchSN)->default_value(false)
+                     , "Benchmark of the binary Snapshot save & (lazy) load.")
+      ( "bench-size" , boptions::value<unsigned int>(&benchSize)->default_value(16)
+                     , "Side of the benchmark designs, in blocks of 8x8 leaf cells.");
 
     boptions::variables_map arguments;
     boptions::store ( boptions::parse_command_line(argc,argv,options), arguments );
@@ -175,6 +2150,23 @@ int main ( int argc, char* argv[] )
 
     if (rbTree  ) returnCode += testRbTree();
     if (intvTree) returnCode += testIntervalTree();
+    if (packedRT) returnCode += testPackedRTree();
+    if (benchQ  ) returnCode += benchQuery( benchSize );
+    if (benchX  ) returnCode += benchExtract( benchSize );
+    if (benchGR ) returnCode += benchGlobalRoute( benchSize );
+    if (batchGR ) returnCode += testGlobalBatch();
+    if (astarGR ) returnCode += testGlobalAStar();
+    if (gridView) returnCode += testGridView();
+    if (requeue ) returnCode += testEventRequeue();
+    if (benchGDS) returnCode += benchGds( benchSize );
+    if (gdsShort) returnCode += testGdsShortRecords();
+    if (benchNM ) returnCode += benchNetMap( benchSize );
+    if (netMapIt) returnCode += testNetMapIterate();
+    if (bulkBld ) returnCode += testBulkBuild();
+    if (benchSP ) returnCode += benchPaths( benchSize );
+    if (benchFN ) returnCode += benchFlatten( benchSize );
+    if (benchUS ) returnCode += benchUpdate( benchSize );
+    if (benchSN ) returnCode += benchSnapshot( benchSize );
 
     DebugSession::close();
   }